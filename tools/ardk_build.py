@@ -9,8 +9,9 @@ Builds ARDK projects for multiple target platforms from a single codebase.
 
 Features:
   - Single command builds for any/all platforms
-  - Asset pipeline integration (calls unified_pipeline.py)
-  - Dependency tracking (only rebuild what changed)
+  - Asset pipeline integration (unified_pipeline.py, run in-process on a
+    worker pool)
+  - Dependency tracking (only rebuild what changed; mtime/size fast path)
   - Parallel builds for multiple targets
   - Validation of platform constraints
 
@@ -20,6 +21,7 @@ Usage:
   python ardk_build.py --all              # Build all platforms
   python ardk_build.py --clean            # Clean build artifacts
   python ardk_build.py --validate         # Validate without building
+  python ardk_build.py --jobs 4           # Limit asset workers
 
 Configuration:
   Project settings in ardk_project.json (auto-generated if missing)
@@ -28,12 +30,17 @@ Configuration:
 """
 
 import argparse
+import importlib.util
+import io
 import json
-import subprocess
+import os
 import sys
+from concurrent.futures import ProcessPoolExecutor
+from contextlib import redirect_stdout
+from multiprocessing import get_context
 from pathlib import Path
 from dataclasses import dataclass, field
-from typing import List, Dict, Optional
+from typing import List, Dict, Optional, Tuple
 import hashlib
 import shutil
 
@@ -313,6 +320,73 @@ def load_project_config(project_root: Path) -> dict:
         return DEFAULT_PROJECT_CONFIG.copy()
 
 
+# =============================================================================
+# Asset Jobs
+# =============================================================================
+
+# Read size for hashing changed files
+HASH_CHUNK_SIZE = 1 << 20
+
+
+@dataclass
+class AssetJob:
+    """One PNG to run through unified_pipeline.py."""
+    source: Path
+    key: str            # Path relative to the project root (hash cache key)
+    staging_dir: Path   # Private output directory, merged after the build
+
+
+# Per-worker UnifiedPipeline, built once by _init_asset_worker
+_asset_pipeline = None
+
+
+def _load_asset_pipeline(pipeline_script: Path, platform: str):
+    """
+    Import unified_pipeline.py and build a UnifiedPipeline with the same
+    settings as `unified_pipeline.py <png> -o <dir> --platform <platform>`.
+    """
+    spec = importlib.util.spec_from_file_location("unified_pipeline", pipeline_script)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+
+    with redirect_stdout(io.StringIO()):
+        pipeline = module.UnifiedPipeline(target_size=32, platform=platform)
+
+    # CLI defaults applied by unified_pipeline.main()
+    pipeline.optimize_tiles = False
+    pipeline.reserved_status_height = 0
+    pipeline.generate_res = False
+    pipeline.pixellab_v2 = False
+    pipeline.pixellab_resize = False
+    pipeline.pixellab_8dir = False
+    pipeline.pixellab_tileset = False
+    return pipeline
+
+
+def _init_asset_worker(pipeline_script: Path, platform: str):
+    """Pool initializer: import the pipeline once per worker."""
+    global _asset_pipeline
+    _asset_pipeline = _load_asset_pipeline(pipeline_script, platform)
+
+
+def _run_asset_job(source: Path, staging_dir: Path) -> Tuple[Optional[str], str]:
+    """
+    Process one PNG into its staging directory.
+
+    Returns:
+        (error message or None, captured pipeline output)
+    """
+    log = io.StringIO()
+    try:
+        with redirect_stdout(log):
+            staging_dir.mkdir(parents=True, exist_ok=True)
+            _asset_pipeline.process(str(source), str(staging_dir),
+                                    _asset_pipeline._infer_type(str(source)))
+    except (Exception, SystemExit) as e:
+        return f"{type(e).__name__}: {e}", log.getvalue()
+    return None, log.getvalue()
+
+
 # =============================================================================
 # Build System
 # =============================================================================
@@ -320,12 +394,22 @@ def load_project_config(project_root: Path) -> dict:
 class ARDKBuilder:
     """Main build orchestrator."""
 
-    def __init__(self, project_root: Path, config: dict):
+    def __init__(self, project_root: Path, config: dict, jobs: int = 0):
+        """
+        Args:
+            project_root: Project root directory
+            config: Project configuration (ardk_project.json)
+            jobs: Asset worker processes (0 = CPU count, 1 = in this process)
+        """
         self.root = project_root
         self.config = config
+        self.jobs = jobs or os.cpu_count() or 1
         self.output_dir = project_root / config["output_dir"]
         self.cache_dir = self.output_dir / ".cache"
-        self.file_hashes: Dict[str, str] = {}
+        # Relative path -> {"mtime_ns", "size", "md5"}
+        self.file_hashes: Dict[str, dict] = {}
+        # Fingerprints of changed files, recorded once their job succeeds
+        self._pending_hashes: Dict[str, dict] = {}
         self._load_cache()
 
     def _load_cache(self):
@@ -346,19 +430,45 @@ class ARDKBuilder:
         """Calculate MD5 hash of a file."""
         if not path.exists():
             return ""
+        digest = hashlib.md5()
         with open(path, 'rb') as f:
-            return hashlib.md5(f.read()).hexdigest()
+            for chunk in iter(lambda: f.read(HASH_CHUNK_SIZE), b""):
+                digest.update(chunk)
+        return digest.hexdigest()
 
     def _file_changed(self, path: Path) -> bool:
-        """Check if file has changed since last build."""
+        """
+        Check if file has changed since last build.
+
+        An unchanged mtime and size skip hashing. Otherwise the file is
+        hashed; a changed hash is held back until _record_built() so a
+        failed asset is retried on the next build.
+        """
         key = str(path.relative_to(self.root))
-        current_hash = self._hash_file(path)
-        cached_hash = self.file_hashes.get(key, "")
+        cached = self.file_hashes.get(key)
+        stat = path.stat()
 
-        if current_hash != cached_hash:
-            self.file_hashes[key] = current_hash
-            return True
-        return False
+        # Older caches store the bare hash
+        if not isinstance(cached, dict):
+            cached = {"md5": cached or ""}
+        if cached.get("mtime_ns") == stat.st_mtime_ns and cached.get("size") == stat.st_size:
+            return False
+
+        entry = {"mtime_ns": stat.st_mtime_ns, "size": stat.st_size,
+                 "md5": self._hash_file(path)}
+        if entry["md5"] == cached.get("md5"):
+            # Touched but identical: refresh the fast path
+            self.file_hashes[key] = entry
+            return False
+
+        self._pending_hashes[key] = entry
+        return True
+
+    def _record_built(self, key: str):
+        """Mark a changed file as built."""
+        entry = self._pending_hashes.pop(key, None)
+        if entry is not None:
+            self.file_hashes[key] = entry
 
     def clean(self, platform: Optional[str] = None):
         """Clean build artifacts."""
@@ -409,43 +519,104 @@ class ARDKBuilder:
         return True
 
     def process_assets(self, platform: str) -> bool:
-        """Run asset pipeline for platform."""
+        """
+        Run asset pipeline for platform.
+
+        Changed PNGs are processed in parallel worker processes, each
+        importing unified_pipeline.py once instead of starting an
+        interpreter per file. Every job writes to a private staging
+        directory; staged outputs are then merged into the asset directory
+        in source order, so files that several PNGs write (metadata.json)
+        end up exactly as a sequential build leaves them. Failures do not
+        stop the build early: every error is reported at the end.
+        """
         pipeline_script = self.root / "tools" / "unified_pipeline.py"
         if not pipeline_script.exists():
             print("WARNING: unified_pipeline.py not found, skipping assets")
             return True
 
-        plat = PLATFORMS[platform]
         output_dir = self.output_dir / platform / "assets"
         output_dir.mkdir(parents=True, exist_ok=True)
+        staging_root = self.cache_dir / "staging" / platform
+        shutil.rmtree(staging_root, ignore_errors=True)
 
-        # Process each asset directory
+        # Collect changed PNGs from each asset directory
+        jobs: List[AssetJob] = []
         for asset_dir in self.config["asset_dirs"]:
             asset_path = self.root / asset_dir
             if not asset_path.exists():
                 continue
 
-            # Find all PNG files
             for png_file in asset_path.glob("**/*.png"):
-                if not self._file_changed(png_file):
-                    continue
-
-                print(f"Processing: {png_file.name}")
-                cmd = [
-                    sys.executable,
-                    str(pipeline_script),
-                    str(png_file),
-                    "-o", str(output_dir),
-                    "--platform", platform,
-                ]
-
-                result = subprocess.run(cmd, capture_output=True, text=True)
-                if result.returncode != 0:
-                    print(f"Asset pipeline error: {result.stderr}")
-                    return False
+                if self._file_changed(png_file):
+                    jobs.append(AssetJob(
+                        source=png_file,
+                        key=str(png_file.relative_to(self.root)),
+                        staging_dir=staging_root / str(len(jobs)),
+                    ))
+
+        if not jobs:
+            return True
 
+        outcomes = self._run_asset_jobs(jobs, pipeline_script, platform)
+
+        # Merge staged outputs in source order
+        errors = []
+        for job, (error, log) in zip(jobs, outcomes):
+            if error is not None:
+                errors.append((job, error, log))
+                continue
+            if job.staging_dir.exists():
+                shutil.copytree(job.staging_dir, output_dir, dirs_exist_ok=True)
+            self._record_built(job.key)
+        shutil.rmtree(staging_root, ignore_errors=True)
+        # Keep finished assets even if the build stops here
+        self._save_cache()
+
+        print(f"Assets: {len(jobs) - len(errors)}/{len(jobs)} processed")
+        if errors:
+            print(f"\nAsset pipeline errors ({len(errors)}):")
+            for job, error, log in errors:
+                print(f"  {job.key}: {error}")
+                for line in log.strip().splitlines()[-5:]:
+                    print(f"      {line}")
+            return False
         return True
 
+    def _run_asset_jobs(self, jobs: List[AssetJob], pipeline_script: Path,
+                        platform: str) -> List[Tuple[Optional[str], str]]:
+        """Run jobs in a process pool if worthwhile; results in job order."""
+        for job in jobs:
+            print(f"Processing: {job.source.name}")
+
+        if self.jobs > 1 and len(jobs) > 1:
+            try:
+                # Spawned workers: Numba's thread pools are not fork-safe
+                with ProcessPoolExecutor(
+                        max_workers=min(self.jobs, len(jobs)),
+                        mp_context=get_context('spawn'),
+                        initializer=_init_asset_worker,
+                        initargs=(pipeline_script, platform)) as pool:
+                    futures = [pool.submit(_run_asset_job, job.source, job.staging_dir)
+                               for job in jobs]
+                    outcomes = []
+                    for future in futures:
+                        try:
+                            outcomes.append(future.result())
+                        except Exception as e:
+                            # Worker crashed or the pipeline failed to import
+                            outcomes.append((f"{type(e).__name__}: {e}", ""))
+                    return outcomes
+            except OSError as e:
+                # No process support (sandboxes, some embedded interpreters)
+                print(f"[WARN] Process pool unavailable, processing assets serially: {e}")
+
+        try:
+            _init_asset_worker(pipeline_script, platform)
+        except Exception as e:
+            return [(f"{type(e).__name__}: {e}", "")] * len(jobs)
+        return [_run_asset_job(job.source, job.staging_dir) for job in jobs]
+
     def build(self, platform: str, skip_assets: bool = False) -> bool:
         """Build project for specified platform."""
         if not self.validate(platform):
@@ -598,6 +769,12 @@ Examples:
         action="store_true",
         help="Skip asset processing"
     )
+    parser.add_argument(
+        "--jobs", "-j",
+        type=int,
+        default=0,
+        help="Asset worker processes (default: CPU count, 1 = no pool)"
+    )
     parser.add_argument(
         "--project", "-P",
         type=Path,
@@ -638,7 +815,7 @@ Examples:
 
     # Load config
     config = load_project_config(project_root)
-    builder = ARDKBuilder(project_root, config)
+    builder = ARDKBuilder(project_root, config, jobs=args.jobs)
 
     # Execute command
     if args.clean:
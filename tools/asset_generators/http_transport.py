@@ -0,0 +1,332 @@
+"""
+Pooled HTTP Transport - Keep-alive connections for API clients.
+
+Generation APIs are slow (seconds per call) and billed per call, so the
+transport is built around three rules:
+- Reuse connections: HTTP/1.1 keep-alive, one TCP/TLS handshake per
+  pooled connection instead of one per request
+- Bound concurrency: at most max_per_host requests in flight per host,
+  so fanning out sub-requests never floods the API
+- Retry only what is safe: 429/5xx responses back off with full jitter
+  (honouring Retry-After). A non-idempotent request (POST: may already
+  have been billed) is only resent after 429, or 503 with Retry-After,
+  where the server says it did no work. A connection error on a reused
+  keep-alive connection is retried once on a fresh one if the request
+  was never sent (or is idempotent). Timeouts and other network errors
+  are raised.
+
+Uses only http.client, so it adds no dependencies. request() is blocking
+and thread-safe; request_async() awaits it on a worker thread, and
+gather() runs independent calls concurrently.
+
+Usage:
+    transport = PooledHTTPTransport(max_per_host=4)
+    response = transport.request("POST", url, body=data, headers=headers)
+    results = transport.gather([lambda: fetch(a), lambda: fetch(b)])
+"""
+
+import asyncio
+import functools
+import http.client
+import json
+import logging
+import random
+import select
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor, wait
+from contextlib import contextmanager
+from dataclasses import dataclass, field
+from typing import Any, Callable, Dict, List, Optional, Sequence, Tuple, TypeVar
+from urllib.parse import urlsplit
+
+logger = logging.getLogger('HTTPTransport')
+
+T = TypeVar('T')
+
+# Responses worth retrying: rate limited or transient server trouble
+RETRY_STATUSES = frozenset({429, 500, 502, 503, 504})
+
+# Methods safe to resend after the server may have acted on them
+IDEMPOTENT_METHODS = frozenset({'GET', 'HEAD', 'OPTIONS', 'PUT', 'DELETE'})
+
+
+# =============================================================================
+# Data Classes
+# =============================================================================
+
+@dataclass
+class RetryPolicy:
+    """Retry schedule for rate-limited and failed requests."""
+    max_attempts: int = 4           # Total attempts, including the first
+    base_delay: float = 1.0         # Backoff cap for the first retry (seconds)
+    max_delay: float = 30.0         # Upper bound for any single wait
+    statuses: frozenset = RETRY_STATUSES
+
+    def should_retry(self, status: int, headers: Dict[str, str], idempotent: bool) -> bool:
+        """
+        Whether a response with this status may be retried.
+
+        A 500/502/504 may come after the work was done (and billed), so
+        non-idempotent requests only retry when the server refused
+        outright: 429, or 503 with a Retry-After header.
+        """
+        if status not in self.statuses:
+            return False
+        if idempotent:
+            return True
+        return status == 429 or (status == 503 and 'retry-after' in headers)
+
+    def delay(self, attempt: int, retry_after: Optional[str] = None) -> float:
+        """
+        Wait before retry number attempt + 1.
+
+        Full jitter (uniform in [0, base * 2^attempt]) spreads out clients
+        that were throttled together. A numeric Retry-After header is used
+        as a lower bound.
+        """
+        delay = random.uniform(0, min(self.max_delay, self.base_delay * (2 ** attempt)))
+        if retry_after:
+            try:
+                delay = max(delay, min(float(retry_after), self.max_delay))
+            except ValueError:
+                pass  # HTTP-date form: fall back to the jittered delay
+        return delay
+
+
+@dataclass
+class HTTPResponse:
+    """A fully read HTTP response."""
+    status: int
+    headers: Dict[str, str] = field(default_factory=dict)  # Lower-case names
+    body: bytes = b""
+    attempts: int = 1
+
+    @property
+    def ok(self) -> bool:
+        return 200 <= self.status < 300
+
+    def text(self) -> str:
+        return self.body.decode('utf-8', errors='replace')
+
+    def json(self) -> Any:
+        return json.loads(self.body.decode('utf-8'))
+
+
+# =============================================================================
+# Transport
+# =============================================================================
+
+class PooledHTTPTransport:
+    """
+    Thread-safe HTTP/1.1 client with per-host connection pools.
+
+    Example:
+        transport = PooledHTTPTransport(max_per_host=4, timeout=180)
+        response = transport.request("GET", "https://api.example.com/v1/balance")
+        print(response.status, response.json())
+        transport.close()
+    """
+
+    def __init__(
+        self,
+        max_per_host: int = 4,
+        timeout: float = 180.0,
+        retry: Optional[RetryPolicy] = None,
+    ):
+        """
+        Initialize the transport.
+
+        Args:
+            max_per_host: Concurrent requests (and pooled connections) per host
+            timeout: Default socket timeout in seconds
+            retry: Retry policy (default RetryPolicy())
+        """
+        self.max_per_host = max(1, max_per_host)
+        self.timeout = timeout
+        self.retry = retry or RetryPolicy()
+        self.stats = {'requests': 0, 'connections': 0, 'retries': 0}
+
+        self._idle: Dict[Tuple[str, str, int], List[http.client.HTTPConnection]] = {}
+        self._limits: Dict[Tuple[str, str, int], threading.BoundedSemaphore] = {}
+        self._lock = threading.Lock()
+        self._executor: Optional[ThreadPoolExecutor] = None
+
+    # =========================================================================
+    # Requests
+    # =========================================================================
+
+    def request(
+        self,
+        method: str,
+        url: str,
+        body: Optional[bytes] = None,
+        headers: Optional[Dict[str, str]] = None,
+        timeout: Optional[float] = None,
+        idempotent: Optional[bool] = None,
+    ) -> HTTPResponse:
+        """
+        Send a request, retrying 429/5xx per the retry policy.
+
+        Args:
+            idempotent: Safe to resend after the server may have acted on
+                it (default: by method, so POST is not)
+
+        Returns the final response whatever its status; only network
+        errors raise.
+        """
+        parts = urlsplit(url)
+        key = (parts.scheme, parts.hostname, parts.port or (443 if parts.scheme == 'https' else 80))
+        path = (parts.path or '/') + (f'?{parts.query}' if parts.query else '')
+        timeout = self.timeout if timeout is None else timeout
+        if idempotent is None:
+            idempotent = method.upper() in IDEMPOTENT_METHODS
+
+        attempt = 0
+        while True:
+            with self._host_slot(key):
+                response = self._send(key, method, path, body, headers or {}, timeout, idempotent)
+            response.attempts = attempt + 1
+
+            if (not self.retry.should_retry(response.status, response.headers, idempotent)
+                    or attempt + 1 >= self.retry.max_attempts):
+                return response
+
+            wait = self.retry.delay(attempt, response.headers.get('retry-after'))
+            logger.warning(
+                f"[HTTP] {method} {parts.path} -> {response.status}, "
+                f"retry {attempt + 1}/{self.retry.max_attempts - 1} in {wait:.1f}s"
+            )
+            with self._lock:
+                self.stats['retries'] += 1
+            time.sleep(wait)  # Slot released: other requests may proceed
+            attempt += 1
+
+    async def request_async(self, method: str, url: str, **kwargs) -> HTTPResponse:
+        """Awaitable request() running on the transport's worker threads."""
+        loop = asyncio.get_running_loop()
+        return await loop.run_in_executor(
+            self._workers(), functools.partial(self.request, method, url, **kwargs)
+        )
+
+    def gather(self, calls: Sequence[Callable[[], T]]) -> List[T]:
+        """
+        Run independent calls concurrently and return results in order.
+
+        The first exception raised by a call is re-raised after all calls
+        have finished. Per-host limits still apply to the requests they make.
+        """
+        if len(calls) <= 1:
+            return [call() for call in calls]
+        futures = [self._workers().submit(call) for call in calls]
+        wait(futures)
+        return [future.result() for future in futures]
+
+    def close(self) -> None:
+        """Close pooled connections and stop worker threads."""
+        with self._lock:
+            idle, self._idle = self._idle, {}
+            executor, self._executor = self._executor, None
+        for connections in idle.values():
+            for conn in connections:
+                conn.close()
+        if executor:
+            executor.shutdown(wait=False)
+
+    # =========================================================================
+    # Connection Pool
+    # =========================================================================
+
+    @contextmanager
+    def _host_slot(self, key):
+        with self._lock:
+            limit = self._limits.setdefault(key, threading.BoundedSemaphore(self.max_per_host))
+        with limit:
+            yield
+
+    def _workers(self) -> ThreadPoolExecutor:
+        with self._lock:
+            if self._executor is None:
+                # Enough threads to fill a few hosts; limits are per host anyway
+                self._executor = ThreadPoolExecutor(
+                    max_workers=self.max_per_host * 4, thread_name_prefix='http'
+                )
+            return self._executor
+
+    def _checkout(self, key, timeout: float) -> Tuple[http.client.HTTPConnection, bool]:
+        """Idle connection for key (reused=True) or a new one."""
+        while True:
+            with self._lock:
+                idle = self._idle.get(key)
+                conn = idle.pop() if idle else None
+            if conn is None:
+                return self._connect(key, timeout), False
+            if self._closed_by_peer(conn):
+                conn.close()
+                continue
+            if conn.sock is not None:
+                conn.sock.settimeout(timeout)
+            conn.timeout = timeout
+            return conn, True
+
+    @staticmethod
+    def _closed_by_peer(conn: http.client.HTTPConnection) -> bool:
+        """An idle connection is readable only once the server has hung up."""
+        if conn.sock is None:
+            return False
+        try:
+            readable, _, _ = select.select([conn.sock], [], [], 0)
+        except (OSError, ValueError):
+            return True
+        return bool(readable)
+
+    def _connect(self, key, timeout: float) -> http.client.HTTPConnection:
+        with self._lock:
+            self.stats['connections'] += 1
+        scheme, host, port = key
+        cls = http.client.HTTPSConnection if scheme == 'https' else http.client.HTTPConnection
+        return cls(host, port, timeout=timeout)
+
+    def _checkin(self, key, conn: http.client.HTTPConnection) -> None:
+        with self._lock:
+            idle = self._idle.setdefault(key, [])
+            if len(idle) < self.max_per_host:
+                idle.append(conn)
+                return
+        conn.close()
+
+    def _send(self, key, method, path, body, headers, timeout, idempotent) -> HTTPResponse:
+        conn, reused = self._checkout(key, timeout)
+        while True:
+            sent = False
+            try:
+                conn.request(method, path, body=body, headers=headers)
+                sent = True
+                raw = conn.getresponse()
+                data = raw.read()
+                break
+            except (ConnectionError, http.client.RemoteDisconnected,
+                    http.client.BadStatusLine) as e:
+                conn.close()
+                # Once sent, a non-idempotent request may have been acted on
+                if not reused or (sent and not idempotent):
+                    raise
+                # The server dropped an idle keep-alive connection before
+                # handling the request, so one fresh attempt is safe
+                logger.debug(f"[HTTP] Stale pooled connection ({e}), reconnecting")
+                conn, reused = self._connect(key, timeout), False
+            except Exception:
+                conn.close()
+                raise
+
+        with self._lock:
+            self.stats['requests'] += 1
+        if raw.will_close:
+            conn.close()
+        else:
+            self._checkin(key, conn)
+        return HTTPResponse(
+            status=raw.status,
+            headers={k.lower(): v for k, v in raw.getheaders()},
+            body=data,
+        )
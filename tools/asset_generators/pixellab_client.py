@@ -49,9 +49,9 @@ Usage:
 
 import json
 import base64
-import urllib.request
-import urllib.error
+import functools
 import logging
+import threading
 import time
 from dataclasses import dataclass, field
 from typing import Dict, List, Optional, Tuple, Any, Union
@@ -68,6 +68,7 @@ except ImportError:
 import sys
 sys.path.insert(0, str(Path(__file__).parent.parent))
 from configs.api_keys import PIXELLAB_API_KEY
+from asset_generators.http_transport import PooledHTTPTransport, RetryPolicy
 
 # Configure logging
 logger = logging.getLogger('PixelLabClient')
@@ -250,13 +251,22 @@ class PixelLabClient:
     # Session lock file for preventing multiple concurrent sessions
     LOCK_FILE = Path(__file__).parent.parent / ".pixellab_session.lock"
     
-    def __init__(self, api_key: Optional[str] = None, max_calls: int = 1):
+    def __init__(
+        self,
+        api_key: Optional[str] = None,
+        max_calls: int = 1,
+        max_concurrency: int = 8,
+        transport: Optional[PooledHTTPTransport] = None,
+    ):
         """
         Initialize PixelLab client.
 
         Args:
             api_key: PixelLab API key. If not provided, uses PIXELLAB_API_KEY.
             max_calls: Maximum API calls per session (default 1 for safety).
+            max_concurrency: Requests in flight at once (independent sub-requests
+                such as per-direction rotations run in parallel up to this)
+            transport: Shared HTTP transport (default: a private keep-alive pool)
         """
         self.api_key = api_key or PIXELLAB_API_KEY
         if not self.api_key:
@@ -265,6 +275,12 @@ class PixelLabClient:
         self._session_cost = 0.0
         self._call_count = 0
         self._max_calls = max_calls
+        # Concurrent sub-requests share the call budget and cost total
+        self._state_lock = threading.Lock()
+        self._owns_transport = transport is None
+        self._transport = transport or PooledHTTPTransport(
+            max_per_host=max_concurrency, timeout=180, retry=RetryPolicy()
+        )
         
         # Check for existing session lock
         if self.LOCK_FILE.exists():
@@ -289,7 +305,9 @@ class PixelLabClient:
             pass
     
     def close(self):
-        """Explicitly release session lock."""
+        """Explicitly release session lock and pooled connections."""
+        if self._owns_transport:
+            self._transport.close()
         if self.LOCK_FILE.exists():
             self.LOCK_FILE.unlink()
             logger.info("[PIXELLAB] Session closed, lock released.")
@@ -441,15 +459,19 @@ class PixelLabClient:
         Returns:
             Response JSON as dict
         """
-        # SAFEGUARD: Check call counter
-        if self._call_count >= self._max_calls:
-            logger.error(f"[PIXELLAB SAFEGUARD] Call limit reached: {self._call_count}/{self._max_calls}")
+        # SAFEGUARD: Check call counter (reserved atomically, calls may run concurrently)
+        with self._state_lock:
+            limit_reached = self._call_count >= self._max_calls
+            if not limit_reached:
+                self._call_count += 1
+            call_number = self._call_count
+        if limit_reached:
+            logger.error(f"[PIXELLAB SAFEGUARD] Call limit reached: {call_number}/{self._max_calls}")
             logger.error(f"[PIXELLAB SAFEGUARD] Endpoint was: {endpoint}")
             logger.error(f"[PIXELLAB SAFEGUARD] Payload: {json.dumps(payload, indent=2) if payload else 'None'}")
-            raise RuntimeError(f"PixelLab call limit exceeded: {self._call_count}/{self._max_calls}")
-        
-        self._call_count += 1
-        logger.info(f"[PIXELLAB] API call {self._call_count}/{self._max_calls}: {endpoint}")
+            raise RuntimeError(f"PixelLab call limit exceeded: {call_number}/{self._max_calls}")
+
+        logger.info(f"[PIXELLAB] API call {call_number}/{self._max_calls}: {endpoint}")
         logger.debug(f"[PIXELLAB] Payload: {json.dumps(payload, indent=2) if payload else 'None'}")
         
         if not self.api_key:
@@ -466,36 +488,46 @@ class PixelLabClient:
 
         data = json.dumps(payload).encode('utf-8') if payload else None
 
-        req = urllib.request.Request(url, data=data, headers=headers, method=method)
-
         try:
-            with urllib.request.urlopen(req, timeout=180) as response:
-                result = json.loads(response.read().decode('utf-8'))
-                
-                # v2 API wraps everything in {"success": true, "data": {...}, "usage": {...}}
-                # Unwrap for consistent handling
-                if api_version == 2 and isinstance(result, dict):
-                    if result.get("success") is False:
-                        error = result.get("error", "Unknown error")
-                        raise RuntimeError(f"PixelLab v2 API error: {error}")
-                    # Unwrap data but preserve usage at top level
-                    if "data" in result:
-                        unwrapped = result["data"]
-                        if isinstance(unwrapped, dict):
-                            unwrapped["usage"] = result.get("usage", {})
-                            return unwrapped
-                    # Some endpoints return data directly
-                    return result
-                    
+            response = self._transport.request(method, url, body=data, headers=headers)
+            if response.status >= 400:
+                error_body = response.text()
+                logger.error(f"PixelLab API error {response.status}: {error_body}")
+                raise RuntimeError(f"PixelLab API error {response.status}: {error_body}")
+
+            result = response.json()
+
+            # v2 API wraps everything in {"success": true, "data": {...}, "usage": {...}}
+            # Unwrap for consistent handling
+            if api_version == 2 and isinstance(result, dict):
+                if result.get("success") is False:
+                    error = result.get("error", "Unknown error")
+                    raise RuntimeError(f"PixelLab v2 API error: {error}")
+                # Unwrap data but preserve usage at top level
+                if "data" in result:
+                    unwrapped = result["data"]
+                    if isinstance(unwrapped, dict):
+                        unwrapped["usage"] = result.get("usage", {})
+                        return unwrapped
+                # Some endpoints return data directly
                 return result
-        except urllib.error.HTTPError as e:
-            error_body = e.read().decode('utf-8') if e.fp else str(e)
-            logger.error(f"PixelLab API error {e.code}: {error_body}")
-            raise RuntimeError(f"PixelLab API error {e.code}: {error_body}")
+
+            return result
+        except RuntimeError:
+            raise
         except Exception as e:
             logger.error(f"PixelLab request failed: {e}")
             raise
 
+    def _run_parallel(self, calls: List[Any]) -> List[Any]:
+        """Run independent sub-requests concurrently (bounded by max_concurrency)."""
+        return self._transport.gather(calls)
+
+    def _add_cost(self, cost: float) -> None:
+        """Add to the session cost (safe from concurrent sub-requests)."""
+        with self._state_lock:
+            self._session_cost += cost
+
     def get_balance(self) -> float:
         """Get current credit balance in USD (subscription generations are separate)."""
         if not self.api_key:
@@ -507,13 +539,13 @@ class PixelLabClient:
             'Accept': 'application/json',
         }
 
-        req = urllib.request.Request(url, headers=headers, method='GET')
-
         try:
-            with urllib.request.urlopen(req, timeout=30) as response:
-                result = json.loads(response.read().decode('utf-8'))
-                # API returns {"usd": X} per official docs
-                return float(result.get('usd', result.get('balance', 0)))
+            response = self._transport.request('GET', url, headers=headers, timeout=30)
+            if response.status >= 400:
+                raise RuntimeError(f"HTTP {response.status}: {response.text()}")
+            result = response.json()
+            # API returns {"usd": X} per official docs
+            return float(result.get('usd', result.get('balance', 0)))
         except Exception as e:
             logger.error(f"Failed to get balance: {e}")
             return 0.0
@@ -610,7 +642,7 @@ class PixelLabClient:
             image_b64 = image_data.get("base64") if isinstance(image_data, dict) else image_data
             usage = result.get("usage", {})
             cost = float(usage.get("usd", 0)) if isinstance(usage, dict) else 0
-            self._session_cost += cost
+            self._add_cost(cost)
 
             if image_b64:
                 image = self._base64_to_image(image_b64)
@@ -716,7 +748,7 @@ class PixelLabClient:
 
             image_b64 = result.get("image")
             cost = float(result.get("cost_usd", 0))
-            self._session_cost += cost
+            self._add_cost(cost)
 
             if image_b64:
                 image = self._base64_to_image(image_b64)
@@ -798,7 +830,7 @@ class PixelLabClient:
 
             images_b64 = result.get("images", [])
             cost = float(result.get("cost_usd", 0))
-            self._session_cost += cost
+            self._add_cost(cost)
 
             if images_b64:
                 images = [self._base64_to_image(b64) for b64 in images_b64]
@@ -867,7 +899,7 @@ class PixelLabClient:
 
             images_b64 = result.get("images", [])
             cost = float(result.get("cost_usd", 0))
-            self._session_cost += cost
+            self._add_cost(cost)
 
             if images_b64:
                 images = [self._base64_to_image(b64) for b64 in images_b64]
@@ -947,7 +979,7 @@ class PixelLabClient:
 
             image_b64 = result.get("image")
             cost = float(result.get("cost_usd", 0))
-            self._session_cost += cost
+            self._add_cost(cost)
 
             if image_b64:
                 image = self._base64_to_image(image_b64)
@@ -987,6 +1019,7 @@ class PixelLabClient:
             return {"error": GenerationResult(success=False, error="directions must be 4 or 8")}
 
         results = {}
+        pending = []
 
         for to_dir in target_dirs:
             if to_dir.value == (from_direction.value if isinstance(from_direction, Direction) else from_direction):
@@ -997,14 +1030,24 @@ class PixelLabClient:
                     cost_usd=0,
                 )
             else:
-                results[to_dir.value] = self.rotate(
-                    from_image=reference_image,
-                    width=width,
-                    height=height,
-                    from_direction=from_direction,
-                    to_direction=to_dir,
-                )
-                time.sleep(0.5)  # Rate limit
+                results[to_dir.value] = None  # Keep direction order
+                pending.append(to_dir)
+
+        # Rotations are independent: run them concurrently. The transport caps
+        # requests in flight and backs off on 429, replacing the fixed sleep.
+        rotated = self._run_parallel([
+            functools.partial(
+                self.rotate,
+                from_image=reference_image,
+                width=width,
+                height=height,
+                from_direction=from_direction,
+                to_direction=to_dir,
+            )
+            for to_dir in pending
+        ])
+        for to_dir, result in zip(pending, rotated):
+            results[to_dir.value] = result
 
         return results
 
@@ -1076,7 +1119,7 @@ class PixelLabClient:
 
             image_b64 = result.get("image")
             cost = float(result.get("cost_usd", 0))
-            self._session_cost += cost
+            self._add_cost(cost)
 
             if image_b64:
                 image = self._base64_to_image(image_b64)
@@ -1116,7 +1159,7 @@ class PixelLabClient:
 
             keypoints_data = result.get("keypoints", [])
             cost = float(result.get("cost_usd", 0))
-            self._session_cost += cost
+            self._add_cost(cost)
 
             keypoints = [
                 Keypoint(
@@ -1227,7 +1270,7 @@ class PixelLabClient:
 
             usage = result.get("usage", {})
             cost = float(usage.get("usd", 0)) if isinstance(usage, dict) else 0
-            self._session_cost += cost
+            self._add_cost(cost)
 
             if image_b64:
                 image = self._base64_to_image(image_b64)
@@ -1283,7 +1326,7 @@ class PixelLabClient:
             image_b64 = image_data.get("base64") if isinstance(image_data, dict) else image_data
             usage = result.get("usage", {})
             cost = float(usage.get("usd", 0)) if isinstance(usage, dict) else 0
-            self._session_cost += cost
+            self._add_cost(cost)
 
             if image_b64:
                 image = self._base64_to_image(image_b64)
@@ -1367,7 +1410,7 @@ class PixelLabClient:
             images_data = result.get("images", {})
             usage = result.get("usage", {})
             cost = float(usage.get("usd", 0)) if isinstance(usage, dict) else 0
-            self._session_cost += cost
+            self._add_cost(cost)
 
             images = []
             metadata_dirs = []
@@ -1520,7 +1563,7 @@ class PixelLabClient:
                     images_data = last_response.get("images", {})
                     usage = status_result.get("usage", {})
                     cost = float(usage.get("usd", 0)) if isinstance(usage, dict) else 0
-                    self._session_cost += cost
+                    self._add_cost(cost)
                     
                     # Convert base64 images
                     images = []
@@ -1632,7 +1675,7 @@ class PixelLabClient:
             images_data = result.get("images", [])
             usage = result.get("usage", {})
             cost = float(usage.get("usd", 0)) if isinstance(usage, dict) else 0
-            self._session_cost += cost
+            self._add_cost(cost)
 
             if images_data:
                 images = []
@@ -1693,7 +1736,7 @@ class PixelLabClient:
             image_b64 = image_data.get("base64") if isinstance(image_data, dict) else image_data
             usage = result.get("usage", {})
             cost = float(usage.get("usd", 0)) if isinstance(usage, dict) else 0
-            self._session_cost += cost
+            self._add_cost(cost)
 
             if image_b64:
                 image = self._base64_to_image(image_b64)
@@ -1747,7 +1790,7 @@ class PixelLabClient:
             image_b64 = image_data.get("base64") if isinstance(image_data, dict) else image_data
             usage = result.get("usage", {})
             cost = float(usage.get("usd", 0)) if isinstance(usage, dict) else 0
-            self._session_cost += cost
+            self._add_cost(cost)
 
             if image_b64:
                 image = self._base64_to_image(image_b64)
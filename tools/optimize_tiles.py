@@ -52,6 +52,9 @@ def optimize_single(args, config, verbosity):
         allow_mirror_x=not args.no_flip_h,
         allow_mirror_y=not args.no_flip_v,
         platform=platform,
+        merge_threshold=args.merge_threshold,
+        fit_vram_budget=args.fit_vram,
+        max_merge_distance=args.max_merge_distance,
     )
 
     # Optimize
@@ -118,6 +121,8 @@ def optimize_single(args, config, verbosity):
                 "h_flip_matches": result.stats.h_flip_matches,
                 "v_flip_matches": result.stats.v_flip_matches,
                 "hv_flip_matches": result.stats.hv_flip_matches,
+                "lossy_merges": result.stats.lossy_merges,
+                "max_merge_error": result.stats.max_merge_error,
             }
         }
         if args.json == '-':
@@ -141,6 +146,9 @@ def optimize_single(args, config, verbosity):
         print(f"  V-Flip Matches: {result.stats.v_flip_matches}")
     if result.stats.hv_flip_matches > 0:
         print(f"  HV-Flip Matches: {result.stats.hv_flip_matches}")
+    if result.stats.lossy_merges > 0:
+        print(f"  Lossy Merges:   {result.stats.lossy_merges} "
+              f"(max {result.stats.max_merge_error} px differ)")
 
     print(f"  Time:           {duration_ms:.1f}ms")
 
@@ -187,6 +195,9 @@ def optimize_batch(args, config, verbosity):
         allow_mirror_x=not args.no_flip_h,
         allow_mirror_y=not args.no_flip_v,
         platform=platform,
+        merge_threshold=args.merge_threshold,
+        fit_vram_budget=args.fit_vram,
+        max_merge_distance=args.max_merge_distance,
     )
 
     # Track totals
@@ -266,6 +277,9 @@ Examples:
   # Optimize for specific platform
   python optimize_tiles.py sprite.png --platform nes --check-vram
 
+  # Merge near-duplicate tiles until the stage fits VRAM
+  python optimize_tiles.py stage.png --fit-vram --max-merge-distance 6 --check-vram
+
   # Show detailed summary
   python optimize_tiles.py assets/*.png --batch --summary
     """
@@ -296,6 +310,15 @@ Examples:
     flip_group.add_argument('--no-flip-v', action='store_true',
                        help='Disable vertical flip detection')
 
+    # Lossy merging
+    merge_group = parser.add_argument_group('lossy merging')
+    merge_group.add_argument('--merge-threshold', type=int, default=0, metavar='PIXELS',
+                       help='Merge tiles differing in at most PIXELS pixels (default: 0, lossless)')
+    merge_group.add_argument('--fit-vram', action='store_true',
+                       help='Merge the closest tiles until the bank fits the VRAM budget')
+    merge_group.add_argument('--max-merge-distance', type=int, default=None, metavar='PIXELS',
+                       help='Never merge tiles differing in more than PIXELS pixels with --fit-vram')
+
     # Platform
     platform_group = parser.add_argument_group('platform')
     platform_group.add_argument('--check-vram', action='store_true',
@@ -58,9 +58,11 @@ from .sheet_assembler import (
     SheetLayout,
     DetectedSprite,
     PackingAlgorithm,
+    MaxRectsHeuristic,
     AIProvider,
     # Assembler
     SpriteSheetAssembler,
+    MaxRectsBin,
     # Dissectors
     SheetDissector,
     GridDissector,
@@ -135,6 +137,10 @@ from .performance import (
     PerformanceReport,
     PerformanceBudgetCalculator,
     analyze_sprite_performance,
+    SpriteTimeline,
+    FrameSummary,
+    TimelineReport,
+    analyze_sprite_timeline,
 )
 
 # Collision visualization (Phase 2.2.3)
@@ -298,8 +304,10 @@ __all__ = [
     'SheetLayout',
     'DetectedSprite',
     'PackingAlgorithm',
+    'MaxRectsHeuristic',
     'AIProvider',
     'SpriteSheetAssembler',
+    'MaxRectsBin',
     'SheetDissector',
     'GridDissector',
     'assemble_sheet',
@@ -357,6 +365,10 @@ __all__ = [
     'PerformanceReport',
     'PerformanceBudgetCalculator',
     'analyze_sprite_performance',
+    'SpriteTimeline',
+    'FrameSummary',
+    'TimelineReport',
+    'analyze_sprite_timeline',
     # Collision visualization (Phase 2.2.3)
     'CollisionBox',
     'CollisionVisualizer',
@@ -1,12 +1,10 @@
 import os
 import json
-import hashlib
 import time
 import urllib.request
 import urllib.error
 import urllib.parse
 from pathlib import Path
-from datetime import datetime
 from typing import List, Tuple, Optional, Dict, Any
 from abc import ABC, abstractmethod
 from PIL import Image
@@ -33,6 +31,7 @@ try:
         GenerationConfig,
         GenerationResult,
         NoProvidersAvailableError,
+        GenerationCache,
     )
     AI_PROVIDERS_AVAILABLE = True
 except ImportError:
@@ -2612,11 +2611,15 @@ class AIAnalyzer:
     # Do not hardcode keys here - use .env file or environment variables
     DEFAULT_POLLINATIONS_KEY = None
 
+    # Analyses are re-requested after this long, in case the models improved
+    CACHE_MAX_AGE = 86400
+
     def __init__(self, preferred_provider: str = None, cache_dir: str = ".cache/ai",
                  pollinations_key: str = None, pollinations_model: str = "openai-large",
                  offline_mode: bool = False):
         self.cache_dir = Path(cache_dir)
         self.cache_dir.mkdir(parents=True, exist_ok=True)
+        self._cache = GenerationCache(self.cache_dir) if AI_PROVIDERS_AVAILABLE else None
         self.offline_mode = offline_mode
 
         # In offline mode, don't initialize any providers
@@ -2678,40 +2681,33 @@ class AIAnalyzer:
                 return p.name
         return "None"
 
-    def _get_cache_key(self, img: Image.Image) -> str:
-        """Generate cache key from image content"""
-        import io
-        buffer = io.BytesIO()
-        img.save(buffer, format='PNG')
-        return hashlib.md5(buffer.getvalue()).hexdigest()
+    def _get_cache_key(self, img: Image.Image, operation: str = "analyze",
+                       prompt: str = "", params: Dict[str, Any] = None) -> Optional[str]:
+        """Cache key from image pixels, request and the configured providers"""
+        if self._cache is None:
+            return None
+        return self._cache.make_key(
+            operation,
+            provider=",".join(p.name for p in self.providers if p.available),
+            prompt=prompt,
+            images=[img],
+            params=params,
+        )
 
-    def _load_cache(self, cache_key: str) -> Optional[Dict]:
-        """Load cached analysis result"""
-        cache_file = self.cache_dir / f"{cache_key}.json"
-        if cache_file.exists():
-            try:
-                with open(cache_file) as f:
-                    data = json.load(f)
-                    # Check if cache is recent (24 hours)
-                    if 'timestamp' in data:
-                        cache_time = datetime.fromisoformat(data['timestamp'])
-                        age = datetime.now() - cache_time
-                        if age.total_seconds() < 86400:  # 24 hours
-                            return data.get('result')
-            except Exception:
-                pass
-        return None
+    def _load_cache(self, cache_key: Optional[str]) -> Optional[Dict]:
+        """Load cached analysis result (fresher than CACHE_MAX_AGE)"""
+        if cache_key is None:
+            return None
+        record = self._cache.get_record(cache_key, max_age=self.CACHE_MAX_AGE)
+        return record.get('result') if record else None
 
-    def _save_cache(self, cache_key: str, result: Dict):
+    def _save_cache(self, cache_key: Optional[str], result: Dict):
         """Save analysis result to cache"""
-        cache_file = self.cache_dir / f"{cache_key}.json"
+        if cache_key is None:
+            return
         try:
-            with open(cache_file, 'w') as f:
-                json.dump({
-                    'timestamp': datetime.now().isoformat(),
-                    'result': result
-                }, f)
-        except Exception:
+            self._cache.put_record(cache_key, {'result': result})
+        except (OSError, TypeError, ValueError):
             pass
 
     def analyze(self, img: Image.Image, sprites: List['SpriteInfo'],
@@ -2730,20 +2726,20 @@ class AIAnalyzer:
             print(f"      [OFFLINE] Skipping AI, using fallback analysis...")
             return self._use_fallback(img, sprites, filename)
 
+        # Prepare sprite positions for prompt
+        positions = [
+            {'id': s.id, 'x': s.bbox.x, 'y': s.bbox.y, 'w': s.bbox.width, 'h': s.bbox.height}
+            for s in sprites
+        ]
+
         # Check cache first
         if use_cache:
-            cache_key = self._get_cache_key(img)
+            cache_key = self._get_cache_key(img, params={'positions': positions})
             cached = self._load_cache(cache_key)
             if cached:
                 print(f"      [CACHE] Using cached AI analysis")
                 return cached
 
-        # Prepare sprite positions for prompt
-        positions = [
-            {'id': s.id, 'x': s.bbox.x, 'y': s.bbox.y, 'w': s.bbox.width, 'h': s.bbox.height}
-            for s in sprites
-        ]
-
         # Try providers in order
         result = {}
         for provider in self.providers:
@@ -2797,6 +2793,12 @@ class AIAnalyzer:
 
     def analyze_prompt(self, img: Image.Image, prompt: str) -> Dict[str, Any]:
         """Generic analysis using available provider"""
+        cache_key = self._get_cache_key(img, operation="analyze_prompt", prompt=prompt)
+        cached = self._load_cache(cache_key)
+        if cached:
+            print(f"      [CACHE] Using cached AI answer")
+            return cached
+
         for provider in self.providers:
             if not provider.available:
                 continue
@@ -2806,6 +2808,7 @@ class AIAnalyzer:
             try:
                 res = provider.analyze_prompt(img, prompt)
                 if res:
+                    self._save_cache(cache_key, res)
                     return res
             except Exception as e:
                 print(f"      [WARN] {provider.name} failed prompt: {e}")
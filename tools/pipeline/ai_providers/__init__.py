@@ -39,10 +39,17 @@ Upscaling:
     >>> if result.success:
     ...     result.image.save("sprite_64x64.png")  # 2x upscaled
 
+Generation Cache:
+    >>> from pipeline.ai_providers import GenerationCache, enable_generation_cache
+    >>> enable_generation_cache(GenerationCache(".ardk_cache/generations"))
+    >>> # Re-running a script replays identical requests without API calls
+
 Fallback Chain:
     >>> from pipeline.ai_providers import generate_with_fallback
     >>> result = generate_with_fallback("dragon boss", config, preferred="pixie_haus")
     >>> # Tries: pixie_haus -> pollinations -> sd_local
+    >>> result = generate_with_fallback("dragon boss", config, hedge=HedgePolicy())
+    >>> # Same order, but a slow provider is raced against the next one
 
 Integration:
     This module is used by:
@@ -58,6 +65,9 @@ from .base import (
     ProviderCapability,
 )
 
+from .cache import GenerationCache, CachedProvider
+from .hedging import HedgePolicy, LatencyHistogram
+from .health import HealthMonitor, ProviderHealth
 from .pollinations import PollinationsGenerationProvider
 from .pixie_haus import PixieHausProvider
 from .stable_diffusion import StableDiffusionLocalProvider
@@ -67,6 +77,9 @@ from .registry import (
     register_provider,
     generate_with_fallback,
     provider_status,
+    provider_latency,
+    enable_generation_cache,
+    enable_health_monitor,
     ProviderRegistry,
     NoProvidersAvailableError,
 )
@@ -81,12 +94,24 @@ __all__ = [
     'PollinationsGenerationProvider',
     'PixieHausProvider',
     'StableDiffusionLocalProvider',
+    # Cache
+    'GenerationCache',
+    'CachedProvider',
+    # Hedging
+    'HedgePolicy',
+    'LatencyHistogram',
+    # Health
+    'HealthMonitor',
+    'ProviderHealth',
     # Registry
     'get_generation_provider',
     'get_available_providers',
     'register_provider',
     'generate_with_fallback',
     'provider_status',
+    'provider_latency',
+    'enable_generation_cache',
+    'enable_health_monitor',
     'ProviderRegistry',
     'NoProvidersAvailableError',
 ]
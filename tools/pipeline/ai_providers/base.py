@@ -111,6 +111,7 @@ class GenerationResult:
     # Cost tracking
     cost_usd: float = 0.0
     tokens_used: int = 0
+    cached: bool = False  # Replayed from a GenerationCache, no provider call
 
     # Raw response (for debugging)
     raw_response: Optional[Any] = None
@@ -294,6 +295,19 @@ class GenerationProvider(ABC):
             errors=["Upscaling not implemented"]
         )
 
+    def probe(self) -> Tuple[bool, str]:
+        """
+        Cheap liveness check used by HealthMonitor; never generates.
+
+        Override when is_available caches a network check, so probes see
+        the provider come back (or go away).
+
+        Returns:
+            Tuple of (is_up, message)
+        """
+        available = self.is_available
+        return available, f"{self.name} {'available' if available else 'unavailable'}"
+
     def health_check(self) -> Tuple[bool, str]:
         """
         Check if the provider is healthy and responding.
@@ -0,0 +1,543 @@
+"""
+Persistent generation cache shared by all providers.
+
+Every generation request is reduced to a content-addressed key:
+
+    key = sha256(operation | provider | model | canonical prompt |
+                 full GenerationConfig | input image hashes | version)
+
+A hit replays the stored GenerationResult without touching the network,
+so re-running a generation script after a crash (or re-running a batch
+with a few edited prompts) only pays for the requests that changed.
+
+Only seeded requests (config.seed set) are cached. Without a seed the
+caller is asking for a fresh random result each time (e.g. cycling
+prompts for tileset variants), so replaying one stored image would be
+wrong.
+
+Images are stored once in a blob store keyed by pixel content, so frames
+shared between results (e.g. an idle pose reused across animations) take
+space once. Blobs are PNG-compressed. The store is bounded by max_bytes:
+when a put exceeds it, least recently used results are evicted and blobs
+no longer referenced are deleted.
+
+Cache structure:
+    .ardk_cache/generations/
+      records/{key[:2]}/{key}.json    # Result fields + blob hashes
+      blobs/{hash[:2]}/{hash}.png     # Deduplicated images
+
+Record mtimes track last use. All writes are atomic (temp file + rename),
+so concurrent scripts can share one cache.
+
+Usage:
+    >>> from pipeline.ai_providers import ProviderRegistry, GenerationCache
+    >>> registry = ProviderRegistry(cache=GenerationCache(".ardk_cache/generations"))
+    >>> provider = registry.get("pollinations")      # Cached transparently
+    >>> result = provider.generate("pixel art knight", GenerationConfig(seed=42))
+"""
+
+import dataclasses
+import hashlib
+import io
+import json
+import os
+import threading
+import time
+import unicodedata
+from collections import Counter
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Sequence, Union
+
+from PIL import Image
+
+from .base import GenerationConfig, GenerationProvider, GenerationResult
+
+
+# Bump when the key recipe or the record format changes
+CACHE_VERSION = 1
+
+DEFAULT_CACHE_DIR = ".ardk_cache/generations"
+DEFAULT_MAX_BYTES = 512 * 1024 * 1024
+
+# Evict down to this fraction of max_bytes, so evictions are not per-put
+LOW_WATERMARK = 0.9
+
+
+# =============================================================================
+# Key Building
+# =============================================================================
+
+def canonical_prompt(prompt: str) -> str:
+    """Unicode-normalised prompt with runs of whitespace collapsed."""
+    return " ".join(unicodedata.normalize("NFC", prompt or "").split())
+
+
+def image_hash(image: Image.Image) -> str:
+    """Hash of an image's pixels, mode and size (independent of encoding)."""
+    digest = hashlib.sha256(f"{image.mode}|{image.width}x{image.height}|".encode())
+    digest.update(image.tobytes())
+    return digest.hexdigest()
+
+
+def _canonical(value: Any) -> Any:
+    """JSON-stable form of config values; images and files become hashes."""
+    if isinstance(value, Image.Image):
+        return {"image": image_hash(value)}
+    if isinstance(value, Path):
+        try:
+            return {"file": hashlib.sha256(Path(value).read_bytes()).hexdigest()}
+        except OSError:
+            return str(value)
+    if isinstance(value, dict):
+        return {str(k): _canonical(v) for k, v in value.items()}
+    if isinstance(value, (list, tuple)):
+        return [_canonical(v) for v in value]
+    if isinstance(value, (str, int, float, bool)) or value is None:
+        return value
+    return repr(value)
+
+
+def config_fingerprint(config: Optional[GenerationConfig]) -> Dict[str, Any]:
+    """Every GenerationConfig field in canonical form."""
+    config = config or GenerationConfig()
+    fingerprint = {}
+    for f in dataclasses.fields(config):
+        value = getattr(config, f.name)
+        if f.name == "style_reference" and isinstance(value, str):
+            value = Path(value)  # A path: key on the reference's content
+        fingerprint[f.name] = _canonical(value)
+    return fingerprint
+
+
+# =============================================================================
+# Generation Cache
+# =============================================================================
+
+class GenerationCache:
+    """On-disk cache of GenerationResults with a deduplicated image store."""
+
+    def __init__(self,
+                 cache_dir: Union[str, Path] = DEFAULT_CACHE_DIR,
+                 max_bytes: int = DEFAULT_MAX_BYTES):
+        """
+        Args:
+            cache_dir: Cache root (created on first write)
+            max_bytes: Size budget for records and blobs together
+        """
+        self.cache_dir = Path(cache_dir)
+        self.records_dir = self.cache_dir / "records"
+        self.blobs_dir = self.cache_dir / "blobs"
+        self.max_bytes = max_bytes
+        self.hits = 0
+        self.misses = 0
+        self.evictions = 0
+        self._lock = threading.Lock()
+        self._size: Optional[int] = None  # Scanned lazily on first write
+
+    @staticmethod
+    def make_key(operation: str,
+                 provider: str,
+                 model: str = "",
+                 prompt: str = "",
+                 config: Optional[GenerationConfig] = None,
+                 images: Sequence[Image.Image] = (),
+                 params: Optional[Dict[str, Any]] = None) -> str:
+        """
+        Key for one request.
+
+        Args:
+            operation: generate, img2img, animation, views, upscale, ...
+            provider: Provider name
+            model: Model identifier
+            prompt: Prompt text (canonicalised)
+            config: Generation configuration (all fields are part of the key)
+            images: Input images (hashed by pixels)
+            params: Other arguments that affect the output
+        """
+        tag = json.dumps({
+            "op": operation,
+            "provider": provider,
+            "model": model,
+            "prompt": canonical_prompt(prompt),
+            "config": config_fingerprint(config),
+            "images": [image_hash(img) for img in images],
+            "params": _canonical(params or {}),
+            "v": CACHE_VERSION,
+        }, sort_keys=True)
+        return hashlib.sha256(tag.encode()).hexdigest()
+
+    # =========================================================================
+    # Results
+    # =========================================================================
+
+    def get(self, key: str) -> Optional[GenerationResult]:
+        """
+        Replay a cached result, or None on a miss.
+
+        Replays cost nothing, so cost_usd and tokens_used are zero; the
+        original cost is noted in the warnings.
+        """
+        try:
+            record = self._read(key)
+            fields = record["result"]
+            images = {h: self._load_blob(h) for h in record.get("blobs", [])}
+            result = GenerationResult(
+                success=True,
+                images=[images[h] for h in fields.pop("images")],
+                frames=[images[h] for h in fields.pop("frames")],
+                views={name: images[h] for name, h in fields.pop("views").items()},
+                **fields,
+            )
+        except (KeyError, TypeError, OSError, ValueError):
+            # Missing, or a blob was evicted or damaged under us
+            self.misses += 1
+            return None
+
+        self.hits += 1
+        result.warnings.append(f"Replayed from generation cache (original cost ${result.cost_usd:.4f})")
+        result.cost_usd = 0.0
+        result.tokens_used = 0
+        result.cached = True
+        return result
+
+    def put(self, key: str, result: GenerationResult) -> None:
+        """Store a successful result; failures only cost a future miss."""
+        if not result.success:
+            return
+
+        blobs: Dict[str, Image.Image] = {}
+
+        def ref(image: Image.Image) -> str:
+            digest = image_hash(image)
+            blobs[digest] = image
+            return digest
+
+        images = result.images or ([result.image] if result.image else [])
+        fields = {
+            "images": [ref(img) for img in images],
+            "frames": [ref(img) for img in result.frames],
+            "views": {name: ref(img) for name, img in result.views.items()},
+            "provider": result.provider,
+            "model": result.model,
+            "seed_used": result.seed_used,
+            "generation_time_ms": result.generation_time_ms,
+            "frame_durations": list(result.frame_durations),
+            "warnings": list(result.warnings),
+            "cost_usd": result.cost_usd,
+            "tokens_used": result.tokens_used,
+        }
+
+        self.size()  # Scan before writing so new files are not counted twice
+        try:
+            # Budget is enforced after the record lands, so eviction never
+            # sees this result's blobs as unreferenced
+            written = sum(self._store_blob(digest, image) for digest, image in blobs.items())
+            written += self._write_record(key, {"result": fields, "blobs": sorted(blobs)})
+            self._grow(written)
+        except (OSError, TypeError, ValueError) as e:
+            print(f"[WARN] Could not write generation cache entry: {e}")
+
+    # =========================================================================
+    # Records (also used directly for JSON analysis responses)
+    # =========================================================================
+
+    def get_record(self, key: str, max_age: Optional[float] = None) -> Optional[Dict[str, Any]]:
+        """
+        Load a JSON record and mark it recently used.
+
+        Args:
+            key: Record key
+            max_age: Ignore records older than this many seconds
+        """
+        try:
+            record = self._read(key, max_age)
+        except (OSError, ValueError):
+            self.misses += 1
+            return None
+        self.hits += 1
+        return record
+
+    def put_record(self, key: str, record: Dict[str, Any]) -> None:
+        """Write a JSON record atomically, then enforce the size budget."""
+        self.size()
+        self._grow(self._write_record(key, record))
+
+    # =========================================================================
+    # Maintenance
+    # =========================================================================
+
+    def size(self) -> int:
+        """Bytes used by records and blobs."""
+        with self._lock:
+            if self._size is None:
+                self._size = sum(p.stat().st_size for p in self._files())
+            return self._size
+
+    def clear(self) -> int:
+        """
+        Delete all records and blobs.
+
+        Returns:
+            Number of records removed
+        """
+        removed = 0
+        for path in self._files():
+            try:
+                path.unlink()
+            except OSError:
+                continue
+            if path.suffix == ".json":
+                removed += 1
+        with self._lock:
+            self._size = 0
+        return removed
+
+    def stats(self) -> Dict[str, int]:
+        """Hit/miss/eviction counters for this instance."""
+        return {"hits": self.hits, "misses": self.misses, "evictions": self.evictions}
+
+    def evict(self, target_bytes: Optional[int] = None) -> int:
+        """
+        Remove least recently used records, with the blobs only they use,
+        until under target_bytes (default: LOW_WATERMARK of max_bytes).
+
+        Returns:
+            Number of records evicted
+        """
+        target = int(self.max_bytes * LOW_WATERMARK) if target_bytes is None else target_bytes
+
+        records = []
+        refs: Counter = Counter()
+        for path in self.records_dir.glob("*/*.json"):
+            try:
+                stat = path.stat()
+                blobs = set(json.loads(path.read_text(encoding="utf-8")).get("blobs", []))
+            except (OSError, ValueError):
+                continue
+            records.append((stat.st_mtime, stat.st_size, path, blobs))
+            refs.update(blobs)
+        records.sort(key=lambda r: r[0])
+
+        blob_sizes = {}
+        for path in self.blobs_dir.glob("*/*.png"):
+            try:
+                blob_sizes[path.stem] = path.stat().st_size
+            except OSError:
+                pass
+        total = sum(r[1] for r in records) + sum(blob_sizes.values())
+
+        def drop(path: Path, size: int) -> int:
+            try:
+                path.unlink()
+                return size
+            except OSError:
+                return 0
+
+        # Orphans (left by an interrupted put) first, then whole results
+        for digest, size in blob_sizes.items():
+            if not refs[digest]:
+                total -= drop(self._blob_path(digest), size)
+
+        evicted = 0
+        for _, size, path, blobs in records:
+            if total <= target:
+                break
+            if not drop(path, size):
+                continue
+            total -= size
+            evicted += 1
+            for digest in blobs:
+                refs[digest] -= 1
+                if not refs[digest] and digest in blob_sizes:
+                    total -= drop(self._blob_path(digest), blob_sizes[digest])
+
+        with self._lock:
+            self._size = total
+        self.evictions += evicted
+        return evicted
+
+    # =========================================================================
+    # Storage Helpers
+    # =========================================================================
+
+    def _read(self, key: str, max_age: Optional[float] = None) -> Dict[str, Any]:
+        """Load a record and mark it recently used; raises on a miss."""
+        path = self._record_path(key)
+        with open(path, "r", encoding="utf-8") as f:
+            record = json.load(f)
+        if record.get("v") != CACHE_VERSION:
+            raise ValueError("stale cache version")
+        if max_age is not None and time.time() - record.get("created", 0) > max_age:
+            raise ValueError("expired")
+        os.utime(path)  # LRU: mtime is last use
+        return record
+
+    def _write_record(self, key: str, record: Dict[str, Any]) -> int:
+        """Write a record; returns the change in bytes stored."""
+        record = dict(record, v=CACHE_VERSION, created=time.time())
+        data = json.dumps(record).encode("utf-8")
+        path = self._record_path(key)
+        old_size = path.stat().st_size if path.exists() else 0
+        self._write_atomic(path, data)
+        return len(data) - old_size
+
+    def _record_path(self, key: str) -> Path:
+        return self.records_dir / key[:2] / f"{key}.json"
+
+    def _blob_path(self, digest: str) -> Path:
+        return self.blobs_dir / digest[:2] / f"{digest}.png"
+
+    def _files(self):
+        return list(self.records_dir.glob("*/*.json")) + list(self.blobs_dir.glob("*/*.png"))
+
+    def _load_blob(self, digest: str) -> Image.Image:
+        with Image.open(self._blob_path(digest)) as img:
+            img.load()
+            return img.copy()
+
+    def _store_blob(self, digest: str, image: Image.Image) -> int:
+        """Write a blob unless present; returns bytes added."""
+        path = self._blob_path(digest)
+        if path.exists():
+            return 0
+        buffer = io.BytesIO()
+        image.save(buffer, format="PNG", optimize=True)
+        self._write_atomic(path, buffer.getvalue())
+        return buffer.tell()
+
+    def _write_atomic(self, path: Path, data: bytes) -> None:
+        path.parent.mkdir(parents=True, exist_ok=True)
+        tmp_path = path.with_name(f"{path.name}.{os.getpid()}.{threading.get_ident()}.tmp")
+        try:
+            tmp_path.write_bytes(data)
+            os.replace(tmp_path, path)
+        finally:
+            if tmp_path.exists():
+                tmp_path.unlink()
+
+    def _grow(self, delta: int) -> None:
+        total = self.size()
+        with self._lock:
+            self._size = total + delta
+            over = self._size > self.max_bytes
+        if over:
+            self.evict()
+
+
+# =============================================================================
+# Cached Provider
+# =============================================================================
+
+class CachedProvider(GenerationProvider):
+    """
+    Wraps a provider so every generation call goes through a GenerationCache.
+
+    Only successful results of seeded requests are stored; unseeded calls
+    go straight to the provider. Attributes not defined here are forwarded
+    to the wrapped provider.
+    """
+
+    def __init__(self, provider: GenerationProvider, cache: GenerationCache,
+                 registry_name: str = ""):
+        self._provider = provider
+        self._cache = cache
+        self._registry_name = registry_name
+
+    @property
+    def wrapped(self) -> GenerationProvider:
+        return self._provider
+
+    @property
+    def name(self) -> str:
+        return self._provider.name
+
+    @property
+    def capabilities(self):
+        return self._provider.capabilities
+
+    @property
+    def is_available(self) -> bool:
+        return self._provider.is_available
+
+    def __getattr__(self, attr):
+        # Only reached for attributes CachedProvider itself lacks
+        return getattr(self._provider, attr)
+
+    def _cached(self, operation: str, call, prompt: str = "",
+                config: Optional[GenerationConfig] = None,
+                images: Sequence[Image.Image] = (),
+                params: Optional[Dict[str, Any]] = None) -> GenerationResult:
+        if config is None or config.seed is None:
+            return call()  # Random by request: never replay
+        key = GenerationCache.make_key(
+            operation,
+            provider=self._registry_name,
+            # Provider names embed the model/checkpoint, e.g. "Pollinations (flux)"
+            model=self._provider.name,
+            prompt=prompt, config=config, images=images, params=params,
+        )
+        result = self._cache.get(key)
+        if result is not None:
+            return result
+        result = call()
+        self._cache.put(key, result)
+        return result
+
+    def generate(self, prompt: str, config: Optional[GenerationConfig] = None) -> GenerationResult:
+        return self._cached("generate", lambda: self._provider.generate(prompt, config),
+                            prompt=prompt, config=config)
+
+    def generate_from_image(self, source: Image.Image, prompt: str,
+                            config: Optional[GenerationConfig] = None,
+                            strength: float = 0.7) -> GenerationResult:
+        return self._cached(
+            "img2img",
+            lambda: self._provider.generate_from_image(source, prompt, config, strength),
+            prompt=prompt, config=config, images=[source], params={"strength": strength},
+        )
+
+    def generate_animation(self, source: Image.Image, action: str,
+                           config: Optional[GenerationConfig] = None) -> GenerationResult:
+        return self._cached(
+            "animation",
+            lambda: self._provider.generate_animation(source, action, config),
+            config=config, images=[source], params={"action": action},
+        )
+
+    def generate_views(self, source: Image.Image, views: List[str],
+                       config: Optional[GenerationConfig] = None) -> GenerationResult:
+        return self._cached(
+            "views",
+            lambda: self._provider.generate_views(source, views, config),
+            config=config, images=[source], params={"views": list(views)},
+        )
+
+    def upscale(self, source: Image.Image, scale: int = 2,
+                config: Optional[GenerationConfig] = None) -> GenerationResult:
+        return self._cached(
+            "upscale",
+            lambda: self._provider.upscale(source, scale, config),
+            config=config, images=[source], params={"scale": scale},
+        )
+
+    def probe(self):
+        return self._provider.probe()
+
+    def health_check(self):
+        # Never answer health checks from the cache
+        return self._provider.health_check()
+
+    def estimate_cost(self, config: GenerationConfig) -> float:
+        return self._provider.estimate_cost(config)
+
+
+def default_generation_cache() -> Optional[GenerationCache]:
+    """
+    Cache for the global registry.
+
+    ARDK_GENERATION_CACHE selects the directory; "0" or "off" disables it.
+    """
+    setting = os.environ.get("ARDK_GENERATION_CACHE", DEFAULT_CACHE_DIR)
+    if setting.strip().lower() in ("", "0", "off", "false", "none"):
+        return None
+    return GenerationCache(setting)
@@ -0,0 +1,215 @@
+"""
+Provider health monitoring.
+
+Routing decisions (get_best_provider, get_available, fallback chains)
+need to know which providers are up. Asking each provider on every
+request puts network probes on the hot path; a batch of thousands of
+generations pays for thousands of probes.
+
+HealthMonitor keeps a table of provider health in memory:
+- Entries are refreshed by probes, either inline when an entry is older
+  than ttl or from a background thread every interval seconds (so the
+  table never goes stale and lookups never probe)
+- Probes use GenerationProvider.probe(), a cheap liveness check, never
+  a billed generation
+- Results of real generation calls are reported back; a provider that
+  fails failure_threshold times in a row is marked unhealthy and stays
+  so until a probe succeeds again
+
+Usage:
+    >>> from pipeline.ai_providers import ProviderRegistry, HealthMonitor
+    >>> registry = ProviderRegistry()
+    >>> registry.enable_health_monitor(HealthMonitor(interval=30, ttl=90))
+    >>> registry.get_best_provider()     # Reads the table, no probe
+"""
+
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass
+from typing import Callable, Dict, Optional
+
+from .base import GenerationProvider
+
+
+# =============================================================================
+# Health Table Entry
+# =============================================================================
+
+@dataclass
+class ProviderHealth:
+    """Last known health of one provider."""
+    healthy: bool
+    message: str = ""
+    checked_at: float = 0.0            # time.monotonic() of the last probe
+    probe_latency: float = 0.0         # Seconds taken by the last probe
+    consecutive_failures: int = 0      # Failed probes/calls since the last success
+    probes: int = 0
+    failures: int = 0
+
+    @property
+    def age(self) -> float:
+        """Seconds since the last probe."""
+        return time.monotonic() - self.checked_at
+
+    def to_dict(self) -> Dict:
+        return {
+            "healthy": self.healthy,
+            "message": self.message,
+            "age_s": round(self.age, 1),
+            "probe_latency_ms": round(self.probe_latency * 1000, 1),
+            "consecutive_failures": self.consecutive_failures,
+        }
+
+
+# =============================================================================
+# Health Monitor
+# =============================================================================
+
+class HealthMonitor:
+    """
+    TTL'd, optionally background-refreshed provider health table.
+
+    Thread-safe. Lookups only probe when an entry is missing or older than
+    ttl, which does not happen while the background thread is running.
+    """
+
+    def __init__(self,
+                 interval: float = 30.0,
+                 ttl: float = 90.0,
+                 failure_threshold: int = 3,
+                 max_workers: int = 4):
+        """
+        Args:
+            interval: Seconds between background probe rounds
+            ttl: Age after which an entry is re-probed on lookup
+            failure_threshold: Consecutive failed calls that mark a provider unhealthy
+            max_workers: Providers probed concurrently
+        """
+        self.interval = interval
+        self.ttl = ttl
+        self.failure_threshold = max(1, failure_threshold)
+        self.max_workers = max(1, max_workers)
+
+        self._table: Dict[str, ProviderHealth] = {}
+        self._lock = threading.Lock()
+        self._stop = threading.Event()
+        self._thread: Optional[threading.Thread] = None
+
+    # =========================================================================
+    # Lookups
+    # =========================================================================
+
+    def is_healthy(self, name: str, provider: GenerationProvider) -> bool:
+        """Healthy according to the table; probes only if the entry is stale."""
+        entry = self.get(name)
+        if entry is None or entry.age > self.ttl:
+            entry = self.probe(name, provider)
+        return entry.healthy
+
+    def get(self, name: str) -> Optional[ProviderHealth]:
+        with self._lock:
+            return self._table.get(name)
+
+    def table(self) -> Dict[str, ProviderHealth]:
+        """Snapshot of all entries."""
+        with self._lock:
+            return dict(self._table)
+
+    # =========================================================================
+    # Updates
+    # =========================================================================
+
+    def probe(self, name: str, provider: GenerationProvider) -> ProviderHealth:
+        """
+        Probe a provider now and record the result.
+
+        A failed probe marks the provider unhealthy at once (the provider
+        itself says it is down); a successful one clears any failures.
+        """
+        start = time.monotonic()
+        try:
+            ok, message = provider.probe()
+        except Exception as e:
+            ok, message = False, f"probe error: {e}"
+        now = time.monotonic()
+
+        with self._lock:
+            entry = self._table.setdefault(name, ProviderHealth(healthy=ok))
+            entry.healthy = bool(ok)
+            entry.message = message
+            entry.checked_at = now
+            entry.probe_latency = now - start
+            entry.probes += 1
+            if ok:
+                entry.consecutive_failures = 0
+            else:
+                entry.consecutive_failures += 1
+                entry.failures += 1
+            return entry
+
+    def report(self, name: str, success: bool, message: str = "") -> None:
+        """
+        Record the outcome of a real generation call.
+
+        Failures count towards failure_threshold; successes reset the count
+        but do not clear an unhealthy mark, only a probe does.
+        """
+        with self._lock:
+            entry = self._table.get(name)
+            if entry is None:
+                return  # Never probed: nothing to update yet
+            if success:
+                entry.consecutive_failures = 0
+                return
+            entry.consecutive_failures += 1
+            entry.failures += 1
+            if entry.healthy and entry.consecutive_failures >= self.failure_threshold:
+                entry.healthy = False
+                entry.message = f"{entry.consecutive_failures} consecutive failures: {message}"
+
+    def probe_all(self, providers: Dict[str, GenerationProvider]) -> None:
+        """Probe every provider, concurrently, so one slow probe does not hold up the rest."""
+        if not providers:
+            return
+        with ThreadPoolExecutor(max_workers=min(self.max_workers, len(providers)),
+                                thread_name_prefix="health") as pool:
+            for name, provider in providers.items():
+                pool.submit(self.probe, name, provider)
+
+    # =========================================================================
+    # Background Probing
+    # =========================================================================
+
+    @property
+    def running(self) -> bool:
+        return self._thread is not None and self._thread.is_alive()
+
+    def start(self, providers: Callable[[], Dict[str, GenerationProvider]]) -> None:
+        """
+        Probe now, then every interval seconds on a daemon thread.
+
+        Args:
+            providers: Returns the current {name: provider} map on each round
+        """
+        if self.running:
+            return
+        self._stop.clear()
+        self.probe_all(providers())
+
+        def loop():
+            while not self._stop.wait(self.interval):
+                try:
+                    self.probe_all(providers())
+                except Exception as e:
+                    print(f"[WARN] Health probe round failed: {e}")
+
+        self._thread = threading.Thread(target=loop, name="provider-health", daemon=True)
+        self._thread.start()
+
+    def stop(self, timeout: Optional[float] = None) -> None:
+        """Stop the background thread."""
+        self._stop.set()
+        if self._thread is not None:
+            self._thread.join(timeout)
+            self._thread = None
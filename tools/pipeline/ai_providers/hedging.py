@@ -0,0 +1,128 @@
+"""
+Hedged requests for the provider registry.
+
+Generation latency has a long tail: most requests return in seconds, a
+few hang until the provider's timeout. Trying providers strictly in
+series makes the worst case the sum of every timeout. A hedged request
+starts the next provider once the current one is slower than it usually
+is, and takes whichever answers first:
+
+    t=0          preferred provider starts
+    t=p90(pref)  still no answer -> next capable provider starts
+    first success wins; requests not yet started are cancelled
+
+"Usually" comes from a per-provider LatencyHistogram, so the hedge delay
+adapts as providers speed up or slow down. Until a provider has enough
+samples, HedgePolicy.default_delay is used.
+
+Usage:
+    >>> from pipeline.ai_providers import ProviderRegistry, HedgePolicy
+    >>> registry = ProviderRegistry()
+    >>> result = registry.generate_with_fallback(
+    ...     "pixel art knight", config, hedge=HedgePolicy(percentile=0.9), budget=budget)
+"""
+
+import math
+import threading
+from dataclasses import dataclass
+from typing import Dict, List, Optional
+
+
+# =============================================================================
+# Latency Histogram
+# =============================================================================
+
+class LatencyHistogram:
+    """
+    Log-bucketed latency histogram with exponential decay.
+
+    Buckets grow by `growth` from `min_seconds`, so percentiles are
+    accurate to a few percent from 10 ms to hours in ~60 buckets. When the
+    sample count reaches max_samples all counts are halved, so old
+    behaviour fades and percentiles follow the provider's current speed.
+    """
+
+    def __init__(self, min_seconds: float = 0.01, growth: float = 1.25,
+                 max_samples: int = 500):
+        self.min_seconds = min_seconds
+        self.growth = growth
+        self.max_samples = max_samples
+        self._counts: Dict[int, float] = {}
+        self._total = 0.0
+        self._samples = 0
+        self._lock = threading.Lock()
+
+    @property
+    def count(self) -> int:
+        """Samples recorded (before decay)."""
+        return self._samples
+
+    def record(self, seconds: float) -> None:
+        """Add one latency sample."""
+        bucket = self._bucket(seconds)
+        with self._lock:
+            self._counts[bucket] = self._counts.get(bucket, 0.0) + 1.0
+            self._total += 1.0
+            self._samples += 1
+            if self._total >= self.max_samples:
+                self._counts = {b: c / 2 for b, c in self._counts.items() if c >= 1.0}
+                self._total = sum(self._counts.values())
+
+    def percentile(self, p: float) -> Optional[float]:
+        """
+        Latency (upper bucket bound) below which a fraction p of samples fall.
+
+        Returns:
+            Seconds, or None with no samples
+        """
+        with self._lock:
+            if not self._total:
+                return None
+            target = p * self._total
+            seen = 0.0
+            for bucket in sorted(self._counts):
+                seen += self._counts[bucket]
+                if seen >= target:
+                    return self._upper(bucket)
+            return self._upper(max(self._counts))
+
+    def _bucket(self, seconds: float) -> int:
+        if seconds <= self.min_seconds:
+            return 0
+        return int(math.ceil(math.log(seconds / self.min_seconds, self.growth)))
+
+    def _upper(self, bucket: int) -> float:
+        return self.min_seconds * self.growth ** bucket
+
+
+# =============================================================================
+# Hedge Policy
+# =============================================================================
+
+@dataclass
+class HedgePolicy:
+    """When to start a backup request."""
+    percentile: float = 0.9         # Hedge once slower than this fraction of past calls
+    min_samples: int = 5            # Samples needed before trusting the histogram
+    default_delay: float = 10.0     # Hedge delay (seconds) until then
+    min_delay: float = 0.25         # Never hedge sooner than this
+    max_delay: float = 120.0        # Never wait longer than this
+    max_parallel: int = 2           # Requests in flight at once
+
+    def delay_for(self, histogram: Optional[LatencyHistogram]) -> float:
+        """Seconds to wait on a provider before starting the next one."""
+        delay = None
+        if histogram is not None and histogram.count >= self.min_samples:
+            delay = histogram.percentile(self.percentile)
+        if delay is None:
+            delay = self.default_delay
+        return min(self.max_delay, max(self.min_delay, delay))
+
+
+def latency_summary(histogram: LatencyHistogram,
+                    percentiles: List[float] = (0.5, 0.9, 0.99)) -> Dict[str, float]:
+    """{"p50": s, "p90": s, ...} for status reports."""
+    return {
+        f"p{int(round(p * 100))}": histogram.percentile(p)
+        for p in percentiles
+    }
@@ -18,6 +18,9 @@ Key Functions:
     - generate_with_fallback(prompt, config): Generate with automatic fallback
     - provider_status(): Get status of all registered providers
     - register_provider(name, provider): Add custom provider
+    - enable_generation_cache(cache): Replay repeated requests from disk
+    - provider_latency(name): Latency histogram behind hedge delays
+    - enable_health_monitor(monitor): Route on a background-probed health table
 
 Usage:
     >>> from pipeline.ai_providers import generate_with_fallback, GenerationConfig
@@ -28,6 +31,22 @@ Usage:
     ... else:
     ...     print(f"Failed: {result.errors}")
 
+Generation Cache:
+    The global registry wraps providers in a CachedProvider backed by
+    .ardk_cache/generations (set ARDK_GENERATION_CACHE to another directory,
+    or to "off" to disable). Identical seeded requests replay from disk for
+    free; requests with seed=None always generate.
+
+Hedged Requests:
+    >>> from pipeline.ai_providers import HedgePolicy
+    >>> result = generate_with_fallback("dragon boss", config, hedge=HedgePolicy(), budget=budget)
+    >>> # Starts the next provider if the first is slower than its usual p90
+
+Health Monitoring:
+    >>> from pipeline.ai_providers import enable_health_monitor, HealthMonitor
+    >>> enable_health_monitor(HealthMonitor(interval=30, ttl=90))
+    >>> # Provider selection now reads an in-memory table; probes run in the background
+
 Provider Status Check:
     >>> from pipeline.ai_providers import provider_status
     >>> for name, info in provider_status().items():
@@ -35,7 +54,10 @@ Provider Status Check:
 """
 
 import os
-from typing import Optional, List, Dict, Type, Callable
+import threading
+import time
+from concurrent.futures import FIRST_COMPLETED, Future, ThreadPoolExecutor, wait
+from typing import Any, Optional, List, Dict, Tuple, Type, Callable
 
 from .base import (
     GenerationProvider,
@@ -43,6 +65,9 @@ from .base import (
     GenerationConfig,
     ProviderCapability,
 )
+from .cache import CachedProvider, GenerationCache, default_generation_cache
+from .health import HealthMonitor
+from .hedging import HedgePolicy, LatencyHistogram, latency_summary
 from .pollinations import PollinationsGenerationProvider
 from .pixie_haus import PixieHausProvider
 from .stable_diffusion import StableDiffusionLocalProvider
@@ -67,10 +92,55 @@ class ProviderRegistry:
         "sd_local",        # Free, requires local setup
     ]
 
-    def __init__(self):
+    def __init__(self, cache: Optional[GenerationCache] = None,
+                 health: Optional[HealthMonitor] = None):
+        """
+        Args:
+            cache: Generation cache wrapped around every provider (None = uncached)
+            health: Health table used for routing (None = ask providers directly)
+        """
         self._providers: Dict[str, GenerationProvider] = {}
+        self._cached: Dict[str, CachedProvider] = {}
         self._fallback_order: List[str] = self.DEFAULT_FALLBACK_ORDER.copy()
         self._initialized = False
+        self._cache = cache
+        self._latency: Dict[str, LatencyHistogram] = {}
+        self._budget_lock = threading.Lock()
+        self._health = health
+
+    @property
+    def cache(self) -> Optional[GenerationCache]:
+        return self._cache
+
+    @property
+    def health(self) -> Optional[HealthMonitor]:
+        return self._health
+
+    def enable_health_monitor(self, monitor: Optional[HealthMonitor], background: bool = True):
+        """
+        Route on a health table instead of asking providers per request.
+
+        Args:
+            monitor: Health monitor (None stops and removes the current one)
+            background: Probe on the monitor's interval from a daemon thread
+        """
+        if self._health is not None and self._health is not monitor:
+            self._health.stop()
+        self._health = monitor
+        if monitor is not None and background:
+            self._ensure_initialized()
+            monitor.start(lambda: dict(self._providers))
+
+    def _healthy(self, name: str, provider: GenerationProvider) -> bool:
+        """Availability for routing: from the health table when monitored."""
+        if self._health is None:
+            return provider.is_available
+        return self._health.is_healthy(name, provider)
+
+    def enable_cache(self, cache: Optional[GenerationCache]):
+        """Set (or with None, remove) the generation cache for all providers."""
+        self._cache = cache
+        self._cached.clear()
 
     def _ensure_initialized(self):
         """Lazy initialization of default providers."""
@@ -93,10 +163,20 @@ class ProviderRegistry:
             provider: Provider instance
         """
         self._providers[name.lower()] = provider
+        self._cached.pop(name.lower(), None)
 
     def unregister(self, name: str):
         """Remove a provider from the registry."""
         self._providers.pop(name.lower(), None)
+        self._cached.pop(name.lower(), None)
+
+    def _wrap(self, name: str, provider: GenerationProvider) -> GenerationProvider:
+        """Provider as handed out: behind the cache when one is set."""
+        if self._cache is None:
+            return provider
+        if name not in self._cached:
+            self._cached[name] = CachedProvider(provider, self._cache, name)
+        return self._cached[name]
 
     def get(self, name: str) -> Optional[GenerationProvider]:
         """
@@ -109,7 +189,8 @@ class ProviderRegistry:
             Provider instance or None if not found
         """
         self._ensure_initialized()
-        return self._providers.get(name.lower())
+        provider = self._providers.get(name.lower())
+        return self._wrap(name.lower(), provider) if provider else None
 
     def get_available(self) -> List[GenerationProvider]:
         """
@@ -119,12 +200,13 @@ class ProviderRegistry:
             List of available provider instances
         """
         self._ensure_initialized()
-        return [p for p in self._providers.values() if p.is_available]
+        return [self._wrap(name, p) for name, p in self._providers.items()
+                if self._healthy(name, p)]
 
     def get_available_names(self) -> List[str]:
         """Get names of all available providers."""
         self._ensure_initialized()
-        return [name for name, p in self._providers.items() if p.is_available]
+        return [name for name, p in self._providers.items() if self._healthy(name, p)]
 
     def get_with_capability(self, capability: ProviderCapability) -> List[GenerationProvider]:
         """
@@ -138,10 +220,14 @@ class ProviderRegistry:
         """
         self._ensure_initialized()
         return [
-            p for p in self._providers.values()
-            if p.is_available and (p.capabilities & capability)
+            self._wrap(name, p) for name, p in self._providers.items()
+            if (p.capabilities & capability) and self._healthy(name, p)
         ]
 
+    def latency(self, name: str) -> LatencyHistogram:
+        """Latency histogram of successful generate() calls for a provider."""
+        return self._latency.setdefault(name.lower(), LatencyHistogram())
+
     def set_fallback_order(self, order: List[str]):
         """
         Set custom fallback order for providers.
@@ -172,14 +258,14 @@ class ProviderRegistry:
         # Try preferred provider first
         if preferred:
             provider = self.get(preferred)
-            if provider and provider.is_available:
+            if provider and self._healthy(preferred.lower(), provider):
                 if capability is None or (provider.capabilities & capability):
                     return provider
 
         # Try fallback chain
         for name in self._fallback_order:
             provider = self.get(name)
-            if provider and provider.is_available:
+            if provider and self._healthy(name, provider):
                 if capability is None or (provider.capabilities & capability):
                     return provider
 
@@ -201,7 +287,9 @@ class ProviderRegistry:
                                prompt: str,
                                config: Optional[GenerationConfig] = None,
                                preferred: Optional[str] = None,
-                               max_retries: int = 2) -> GenerationResult:
+                               max_retries: int = 2,
+                               hedge: Optional[HedgePolicy] = None,
+                               budget: Optional[Any] = None) -> GenerationResult:
         """
         Generate with automatic fallback to other providers on failure.
 
@@ -210,6 +298,10 @@ class ProviderRegistry:
             config: Generation configuration
             preferred: Preferred provider to try first
             max_retries: Number of fallback attempts
+            hedge: Start the next provider when one is slower than usual
+                   (None = strictly one provider at a time)
+            budget: BudgetTracker checked before each request and charged
+                    for each provider call that succeeds
 
         Returns:
             GenerationResult from first successful provider
@@ -218,7 +310,6 @@ class ProviderRegistry:
         config = config or GenerationConfig()
 
         errors = []
-        tried = set()
 
         # Build provider order
         provider_order = []
@@ -229,25 +320,25 @@ class ProviderRegistry:
             if name not in provider_order:
                 provider_order.append(name)
 
-        # Try each provider
+        candidates = []
         for name in provider_order:
-            if len(tried) >= max_retries + 1:
-                break
-
             provider = self.get(name)
-            if not provider or not provider.is_available:
-                continue
-
-            tried.add(name)
-
-            try:
-                result = provider.generate(prompt, config)
-                if result.success:
+            if provider and self._healthy(name, provider):
+                candidates.append((name, provider))
+        candidates = candidates[:max_retries + 1]
+
+        if hedge is not None:
+            result = self._generate_hedged(candidates, prompt, config, hedge, budget, errors)
+            if result is not None:
+                return result
+        else:
+            # Try each provider
+            for name, provider in candidates:
+                if self._affordable(name, provider, config, budget, [], errors) is None:
+                    continue
+                result = self._attempt(name, provider, prompt, config, budget, errors)
+                if result is not None and result.success:
                     return result
-                else:
-                    errors.extend([f"[{name}] {e}" for e in result.errors])
-            except Exception as e:
-                errors.append(f"[{name}] Exception: {e}")
 
         # All providers failed
         return GenerationResult(
@@ -256,6 +347,107 @@ class ProviderRegistry:
             provider="fallback_chain",
         )
 
+    def _generate_hedged(self,
+                         candidates: List[Tuple[str, GenerationProvider]],
+                         prompt: str,
+                         config: GenerationConfig,
+                         hedge: HedgePolicy,
+                         budget: Optional[Any],
+                         errors: List[str]) -> Optional[GenerationResult]:
+        """
+        Race providers: the next one starts when the newest is slower than
+        its hedge delay, or at once when one fails. First success wins.
+
+        Providers not yet started are cancelled. A request already in
+        flight cannot be interrupted; its result is discarded, but its
+        latency and (on success) its cost are still recorded.
+        """
+        queue = list(candidates)
+        pending: Dict[Future, float] = {}  # Future -> estimated cost
+        executor = ThreadPoolExecutor(max_workers=max(1, hedge.max_parallel),
+                                      thread_name_prefix="hedge")
+        next_start = time.monotonic()
+        try:
+            while pending or queue:
+                can_start = bool(queue) and len(pending) < hedge.max_parallel
+                if can_start and time.monotonic() >= next_start:
+                    name, provider = queue.pop(0)
+                    estimate = self._affordable(name, provider, config, budget,
+                                                list(pending.values()), errors)
+                    if estimate is not None:
+                        future = executor.submit(self._attempt, name, provider,
+                                                 prompt, config, budget, errors)
+                        pending[future] = estimate
+                        next_start = time.monotonic() + hedge.delay_for(self._latency.get(name))
+                    continue
+
+                timeout = max(0.0, next_start - time.monotonic()) if can_start else None
+                done, _ = wait(list(pending), timeout=timeout, return_when=FIRST_COMPLETED)
+                for future in done:
+                    del pending[future]
+                    result = future.result()
+                    if result is not None and result.success:
+                        for other in pending:
+                            other.cancel()
+                        return result
+                if done:
+                    next_start = time.monotonic()  # A failure: fall back now
+            return None
+        finally:
+            executor.shutdown(wait=False, cancel_futures=True)
+
+    def _affordable(self,
+                    name: str,
+                    provider: GenerationProvider,
+                    config: GenerationConfig,
+                    budget: Optional[Any],
+                    in_flight: List[float],
+                    errors: List[str]) -> Optional[float]:
+        """
+        Estimated cost if the budget allows one more request on top of
+        those in flight, else None (noted in errors).
+        """
+        if budget is None:
+            return 0.0
+        estimate = provider.estimate_cost(config)
+        with self._budget_lock:
+            allowed = budget.can_generate()
+            remaining = budget.get_remaining()
+        if (not allowed or remaining["generations"] <= len(in_flight)
+                or estimate > remaining["cost"] - sum(in_flight)):
+            errors.append(f"[{name}] Skipped: budget exhausted "
+                          f"(${remaining['cost']:.4f} left, needs ${estimate:.4f})")
+            return None
+        return estimate
+
+    def _attempt(self,
+                 name: str,
+                 provider: GenerationProvider,
+                 prompt: str,
+                 config: GenerationConfig,
+                 budget: Optional[Any],
+                 errors: List[str]) -> Optional[GenerationResult]:
+        """One provider call: records latency and charges the budget on success."""
+        start = time.perf_counter()
+        try:
+            result = provider.generate(prompt, config)
+        except Exception as e:
+            errors.append(f"[{name}] Exception: {e}")
+            if self._health is not None:
+                self._health.report(name, False, str(e))
+            return None
+
+        if self._health is not None and not result.cached:
+            self._health.report(name, result.success, "; ".join(result.errors))
+        if not result.success:
+            errors.extend([f"[{name}] {e}" for e in result.errors])
+        elif not result.cached:
+            self.latency(name).record(time.perf_counter() - start)
+            if budget is not None:
+                with self._budget_lock:
+                    budget.record_generation(result.cost_usd)
+        return result
+
     def status(self) -> Dict[str, Dict]:
         """
         Get status of all registered providers.
@@ -269,14 +461,18 @@ class ProviderRegistry:
         for name, provider in self._providers.items():
             status[name] = {
                 "name": provider.name,
-                "available": provider.is_available,
+                "available": self._healthy(name, provider),
                 "capabilities": str(provider.capabilities),
             }
+            if self._health is not None and self._health.get(name):
+                status[name]["health"] = self._health.get(name).to_dict()
+            if name in self._latency and self._latency[name].count:
+                status[name]["latency"] = latency_summary(self._latency[name])
         return status
 
 
-# Global registry instance
-_registry = ProviderRegistry()
+# Global registry instance (cached unless ARDK_GENERATION_CACHE=off)
+_registry = ProviderRegistry(cache=default_generation_cache())
 
 
 def get_generation_provider(name: Optional[str] = None,
@@ -312,9 +508,16 @@ def register_provider(name: str, provider: GenerationProvider):
     _registry.register(name, provider)
 
 
+def enable_generation_cache(cache: Optional[GenerationCache]):
+    """Set (or with None, disable) the global registry's generation cache."""
+    _registry.enable_cache(cache)
+
+
 def generate_with_fallback(prompt: str,
                           config: Optional[GenerationConfig] = None,
-                          preferred: Optional[str] = None) -> GenerationResult:
+                          preferred: Optional[str] = None,
+                          hedge: Optional[HedgePolicy] = None,
+                          budget: Optional[Any] = None) -> GenerationResult:
     """
     Generate image with automatic fallback.
 
@@ -324,11 +527,24 @@ def generate_with_fallback(prompt: str,
         prompt: Generation prompt
         config: Generation configuration
         preferred: Preferred provider name
+        hedge: Hedge policy for racing slow providers (None = serial)
+        budget: BudgetTracker to respect and charge
 
     Returns:
         GenerationResult from first successful provider
     """
-    return _registry.generate_with_fallback(prompt, config, preferred)
+    return _registry.generate_with_fallback(prompt, config, preferred,
+                                            hedge=hedge, budget=budget)
+
+
+def provider_latency(name: str) -> LatencyHistogram:
+    """Latency histogram for a provider in the global registry."""
+    return _registry.latency(name)
+
+
+def enable_health_monitor(monitor: Optional[HealthMonitor], background: bool = True):
+    """Route the global registry on a health table (None disables it)."""
+    _registry.enable_health_monitor(monitor, background)
 
 
 def provider_status() -> Dict[str, Dict]:
@@ -84,6 +84,13 @@ class StableDiffusionLocalProvider(GenerationProvider):
             self._is_available = self._check_availability()
         return self._is_available
 
+    def probe(self) -> Tuple[bool, str]:
+        """Re-check the WebUI (is_available only checks once)."""
+        self._is_available = self._check_availability()
+        if self._is_available:
+            return True, f"SD WebUI up at {self._api_url}"
+        return False, f"SD WebUI not reachable at {self._api_url}"
+
     def _check_availability(self) -> bool:
         """Check if local SD is running and accessible."""
         try:
@@ -0,0 +1,275 @@
+"""
+Content-addressed artifact store for pipeline stages.
+
+Every stage of Pipeline._process_image stores its output under a key built
+from what the stage consumed:
+
+    key = sha256(stage name | input keys | stage config hash | version)
+
+Input keys are the content hash of the source file for the first stage and
+the keys of upstream stages after that, so a key changes exactly when the
+stage's inputs or its own parameters change. Editing an export setting
+re-runs export only; preprocess, palette, detection and conversion are
+loaded from the store.
+
+Stages that write into the output directory also record those files, and
+a cache hit writes them back, so a warm run leaves the same tree behind.
+
+Cache structure:
+    .ardk_cache/artifacts/
+      {key[:2]}/
+        {key}.pkl         # Pickled (value, {filename: bytes})
+
+Entries are written atomically (temp file + rename), so batch workers can
+share one store. The store is bounded by max_bytes: when a put takes it
+over budget, the least recently used entries (mtime is touched on every
+hit) are removed down to LOW_WATERMARK of the budget.
+
+Usage:
+    >>> store = ArtifactStore(".ardk_cache/artifacts")
+    >>> key = ArtifactStore.make_key("palette", [image_key], {"colors": 16})
+    >>> entry = store.get(key)
+    >>> if entry is None:
+    ...     store.put(key, (palette, {}))
+"""
+
+import hashlib
+import json
+import os
+import pickle
+import threading
+from pathlib import Path
+from typing import Any, Dict, Optional, Sequence, Tuple, Union
+
+
+# Bump when any stage's output format or algorithm changes
+ARTIFACT_VERSION = 1
+
+DEFAULT_MAX_BYTES = 256 * 1024 * 1024
+
+# Evict down to this fraction of max_bytes, so evictions are not per-put
+LOW_WATERMARK = 0.9
+
+# (stage return value, {filename: bytes} written to the output directory)
+Artifact = Tuple[Any, Dict[str, bytes]]
+
+
+class ArtifactStore:
+    """On-disk store of stage outputs keyed by inputs and parameters."""
+
+    def __init__(self, cache_dir: Union[str, Path],
+                 max_bytes: int = DEFAULT_MAX_BYTES):
+        """
+        Args:
+            cache_dir: Directory for store entries (created if missing)
+            max_bytes: Size budget for all entries
+        """
+        self.cache_dir = Path(cache_dir)
+        self.cache_dir.mkdir(parents=True, exist_ok=True)
+        self.max_bytes = max_bytes
+        self.hits = 0
+        self.misses = 0
+        self.evictions = 0
+        self._lock = threading.Lock()
+        self._size: Optional[int] = None  # Scanned lazily on first write
+
+    @staticmethod
+    def content_hash(data: bytes) -> str:
+        """Hash of a source file's bytes."""
+        return hashlib.sha256(data).hexdigest()
+
+    @staticmethod
+    def make_key(stage: str, inputs: Sequence[str], config: Dict[str, Any]) -> str:
+        """
+        Key for one stage run.
+
+        Args:
+            stage: Stage name
+            inputs: Content hash or upstream stage keys the stage consumed
+            config: Every parameter that affects the stage's output
+        """
+        params = json.dumps(config, sort_keys=True, default=str)
+        tag = f"{stage}|{','.join(inputs)}|{params}|v{ARTIFACT_VERSION}"
+        return hashlib.sha256(tag.encode()).hexdigest()
+
+    def _path(self, key: str) -> Path:
+        return self.cache_dir / key[:2] / f"{key}.pkl"
+
+    def get(self, key: str) -> Optional[Artifact]:
+        """Return a stored artifact, or None on a miss."""
+        path = self._path(key)
+        try:
+            with open(path, 'rb') as f:
+                artifact = pickle.load(f)
+            os.utime(path)  # LRU: mtime is last use
+        except (OSError, EOFError, pickle.UnpicklingError, AttributeError, ImportError):
+            # Missing, truncated, or written by code that no longer exists
+            self.misses += 1
+            return None
+        self.hits += 1
+        return artifact
+
+    def put(self, key: str, artifact: Artifact) -> None:
+        """
+        Store an artifact, then enforce the size budget.
+
+        Failures only cost a future miss.
+        """
+        path = self._path(key)
+        tmp_path = path.with_name(f"{path.name}.{os.getpid()}.{threading.get_ident()}.tmp")
+        self.size()
+        try:
+            path.parent.mkdir(exist_ok=True)
+            with open(tmp_path, 'wb') as f:
+                pickle.dump(artifact, f, protocol=pickle.HIGHEST_PROTOCOL)
+            old_size = path.stat().st_size if path.exists() else 0
+            new_size = tmp_path.stat().st_size
+            os.replace(tmp_path, path)
+        except (OSError, pickle.PicklingError) as e:
+            print(f"[WARN] Could not write artifact store entry: {e}")
+            try:
+                tmp_path.unlink()
+            except OSError:
+                pass
+            return
+        self._grow(new_size - old_size)
+
+    def size(self) -> int:
+        """Bytes used by all entries."""
+        with self._lock:
+            if self._size is None:
+                self._size = sum(self._entry_size(p) for p in self._entries())
+            return self._size
+
+    def evict(self, target_bytes: Optional[int] = None) -> int:
+        """
+        Remove least recently used entries until under target_bytes
+        (default: LOW_WATERMARK of max_bytes).
+
+        Returns:
+            Number of entries evicted
+        """
+        target = int(self.max_bytes * LOW_WATERMARK) if target_bytes is None else target_bytes
+
+        entries = []
+        for path in self._entries():
+            try:
+                stat = path.stat()
+            except OSError:
+                continue
+            entries.append((stat.st_mtime_ns, stat.st_size, path))
+        entries.sort(key=lambda e: e[0])
+        total = sum(e[1] for e in entries)
+
+        evicted = 0
+        for _, size, path in entries:
+            if total <= target:
+                break
+            try:
+                path.unlink()
+            except OSError:
+                continue
+            total -= size
+            evicted += 1
+
+        with self._lock:
+            self._size = total
+        self.evictions += evicted
+        return evicted
+
+    def clear(self) -> int:
+        """
+        Delete all entries.
+
+        Returns:
+            Number of entries removed
+        """
+        removed = 0
+        for entry in self._entries():
+            try:
+                entry.unlink()
+                removed += 1
+            except OSError:
+                pass
+        with self._lock:
+            self._size = 0
+        return removed
+
+    def stats(self) -> Dict[str, int]:
+        """Hit/miss/eviction counters for this instance."""
+        return {"hits": self.hits, "misses": self.misses, "evictions": self.evictions}
+
+    def _entries(self):
+        return list(self.cache_dir.glob("*/*.pkl"))
+
+    @staticmethod
+    def _entry_size(path: Path) -> int:
+        try:
+            return path.stat().st_size
+        except OSError:
+            return 0  # Removed by another worker since the glob
+
+    def _grow(self, delta: int) -> None:
+        total = self.size()
+        with self._lock:
+            self._size = total + delta
+            over = self._size > self.max_bytes
+        if over:
+            self.evict()
+
+
+# =============================================================================
+# OUTPUT FILES
+# =============================================================================
+
+# (mtime_ns, size, sha256 of contents)
+FileState = Tuple[int, int, str]
+
+
+def snapshot_dir(path: Union[str, Path]) -> Dict[str, FileState]:
+    """Stat and content hash of every file directly inside path."""
+    snapshot = {}
+    try:
+        entries = list(os.scandir(path))
+    except OSError:
+        return snapshot
+    for entry in entries:
+        if entry.is_file():
+            stat = entry.stat()
+            with open(entry.path, 'rb') as f:
+                digest = hashlib.sha256(f.read()).hexdigest()
+            snapshot[entry.name] = (stat.st_mtime_ns, stat.st_size, digest)
+    return snapshot
+
+
+def read_written(path: Union[str, Path],
+                 before: Dict[str, FileState]) -> Dict[str, bytes]:
+    """
+    Contents of the files created or rewritten since snapshot_dir().
+
+    A file counts as rewritten when its stat or its contents changed, so a
+    same-size rewrite inside the filesystem's mtime resolution is still
+    captured.
+    """
+    written = {}
+    try:
+        entries = list(os.scandir(path))
+    except OSError:
+        return written
+    for entry in entries:
+        if not entry.is_file():
+            continue
+        data = Path(entry.path).read_bytes()
+        old = before.get(entry.name)
+        stat = entry.stat()
+        if (old is None or old[:2] != (stat.st_mtime_ns, stat.st_size)
+                or old[2] != hashlib.sha256(data).hexdigest()):
+            written[entry.name] = data
+    return written
+
+
+def restore_files(path: Union[str, Path], files: Dict[str, bytes]) -> None:
+    """Write recorded output files back into path."""
+    os.makedirs(path, exist_ok=True)
+    for name, data in files.items():
+        (Path(path) / name).write_bytes(data)
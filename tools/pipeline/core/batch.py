@@ -0,0 +1,262 @@
+"""
+Concurrent Batch Execution for Pipeline.process_batch.
+
+Runs the files of a directory batch concurrently while keeping results and
+events identical to a sequential run.
+
+Scheduling:
+    - Files that write to the same output directory (sprite.png and
+      sprite.ase both export to output/sprite/) form a chain and run in
+      order on one worker; independent chains run in parallel.
+    - CPU-bound chains (PNG quantize / tile encode / compress) run in a
+      process pool, I/O-bound chains (Aseprite CLI exports, PNGs that call
+      an AI analyzer) in a thread pool. Both pools run at the same time.
+    - Chains are queued largest first and idle workers pull the next one,
+      so one slow file only holds up its own worker.
+
+Events:
+    Every worker records the events of each file. The parent replays them
+    in input order, each file preceded by the batch progress event, as
+    soon as all earlier files are done. GUI listeners see the same event
+    sequence as a sequential run, streamed as the batch progresses.
+
+Usage:
+    from tools.pipeline.core.batch import BatchExecutor, plan_batch
+
+    chains = plan_batch(files, output_dir, config)
+    summaries = BatchExecutor(config, pipeline.events, workers=8).run(chains)
+"""
+
+import os
+import threading
+from concurrent.futures import (
+    FIRST_COMPLETED, Future, ProcessPoolExecutor, ThreadPoolExecutor, wait
+)
+from dataclasses import dataclass, field, replace
+from multiprocessing import get_context
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
+from .config import PipelineConfig
+from .events import EventEmitter, PipelineEvent
+
+
+# Suffixes whose processing is dominated by external tools and file I/O
+IO_BOUND_SUFFIXES = {'.ase', '.aseprite'}
+
+
+# =============================================================================
+# PLANNING
+# =============================================================================
+
+@dataclass
+class BatchChain:
+    """
+    Files that must run in order on one worker.
+
+    Attributes:
+        indices: Position of each file in the batch
+        jobs: (input path, output dir) per file
+        cpu_bound: Run in the process pool (else the thread pool)
+        cost: Scheduling weight (input bytes)
+    """
+    indices: List[int] = field(default_factory=list)
+    jobs: List[Tuple[str, str]] = field(default_factory=list)
+    cpu_bound: bool = True
+    cost: int = 0
+
+
+def is_cpu_bound(path: Path, config: PipelineConfig) -> bool:
+    """Whether a file's processing is CPU-bound in this configuration."""
+    if path.suffix.lower() in IO_BOUND_SUFFIXES:
+        return False
+    # AI analysis waits on the network
+    return config.offline_mode or not config.ai_provider
+
+
+def plan_batch(files: List[Path], output_dir: str,
+               config: PipelineConfig) -> List[BatchChain]:
+    """
+    Group batch files into chains by output directory.
+
+    Args:
+        files: Input files, in batch order
+        output_dir: Batch output root (each file writes to output_dir/stem)
+        config: Pipeline configuration
+
+    Returns:
+        Chains, largest first
+    """
+    chains: Dict[Path, BatchChain] = {}
+    for index, path in enumerate(files):
+        target = Path(output_dir) / path.stem
+        chain = chains.setdefault(target, BatchChain())
+        chain.indices.append(index)
+        chain.jobs.append((str(path), str(target)))
+        chain.cpu_bound = chain.cpu_bound and is_cpu_bound(path, config)
+        try:
+            chain.cost += path.stat().st_size
+        except OSError:
+            pass
+    return sorted(chains.values(), key=lambda c: (-c.cost, c.indices[0]))
+
+
+# =============================================================================
+# WORKER
+# =============================================================================
+
+class RecordingEmitter(EventEmitter):
+    """EventEmitter that keeps every event for later replay."""
+
+    def __init__(self):
+        super().__init__()
+        self.events: List[PipelineEvent] = []
+
+    def emit(self, event: PipelineEvent):
+        self.events.append(event)
+
+
+# One Pipeline per worker thread or process
+_local = threading.local()
+
+
+def _init_worker(config: PipelineConfig):
+    """Pool initializer: build this worker's Pipeline."""
+    from .pipeline import Pipeline
+    _local.pipeline = Pipeline(config, event_emitter=RecordingEmitter())
+
+
+def run_file(pipeline, input_path: str, output_dir: str) -> Dict[str, Any]:
+    """
+    Process one batch file, turning exceptions into a failed result.
+
+    Returns:
+        {"success": bool} plus "error" on failure
+    """
+    try:
+        result = pipeline.process(input_path, output_dir)
+    except Exception as e:
+        return {"success": False, "error": f"{type(e).__name__}: {e}"}
+    summary = {"success": bool(result.get("success", False))}
+    if "error" in result:
+        summary["error"] = str(result["error"])
+    return summary
+
+
+def _run_chain(jobs: List[Tuple[str, str]]) -> List[Tuple[Dict[str, Any], List[PipelineEvent]]]:
+    """Pool worker: run a chain on this worker's Pipeline."""
+    pipeline = _local.pipeline
+    outputs = []
+    for input_path, output_dir in jobs:
+        recorder = RecordingEmitter()
+        pipeline.events = recorder
+        summary = run_file(pipeline, input_path, output_dir)
+        outputs.append((summary, recorder.events))
+    return outputs
+
+
+# =============================================================================
+# EXECUTOR
+# =============================================================================
+
+class BatchExecutor:
+    """
+    Runs planned chains on process and thread pools.
+
+    Example:
+        executor = BatchExecutor(config, emitter, workers=8)
+        summaries = executor.run(plan_batch(files, 'output/', config))
+    """
+
+    def __init__(self, config: PipelineConfig, events: EventEmitter,
+                 workers: int = 0,
+                 announce: Optional[Callable[[int, int], None]] = None):
+        """
+        Initialize executor.
+
+        Args:
+            config: Pipeline configuration (callbacks are not sent to workers)
+            events: Emitter that receives the replayed events
+            workers: Workers per pool (0 = CPU count)
+            announce: Called as announce(index, total) before replaying a
+                file's events (emits the batch progress event)
+        """
+        self.config = replace(config, on_progress=None, on_stage_start=None,
+                              on_stage_complete=None, on_error=None)
+        self.events = events
+        self.workers = workers or os.cpu_count() or 1
+        self.announce = announce
+
+    def run(self, chains: List[BatchChain]) -> List[Dict[str, Any]]:
+        """
+        Run every chain.
+
+        Returns:
+            Per-file summaries, in batch order
+        """
+        total = sum(len(chain.indices) for chain in chains)
+        self._summaries: List[Optional[Dict[str, Any]]] = [None] * total
+        self._events: List[Optional[List[PipelineEvent]]] = [None] * total
+        self._released = 0
+
+        cpu = [chain for chain in chains if chain.cpu_bound]
+        io = [chain for chain in chains if not chain.cpu_bound]
+
+        with ThreadPoolExecutor(max_workers=min(self.workers, max(1, len(io))),
+                                initializer=_init_worker,
+                                initargs=(self.config,)) as threads:
+            futures = {threads.submit(_run_chain, chain.jobs): chain for chain in io}
+            processes = None
+            if cpu:
+                try:
+                    # Spawned workers: Numba's thread pools are not fork-safe
+                    processes = ProcessPoolExecutor(
+                        max_workers=min(self.workers, len(cpu)),
+                        mp_context=get_context('spawn'),
+                        initializer=_init_worker, initargs=(self.config,))
+                    while cpu:
+                        futures[processes.submit(_run_chain, cpu[0].jobs)] = cpu[0]
+                        cpu.pop(0)
+                except OSError as e:
+                    # No process support (sandboxes, some embedded interpreters)
+                    print(f"[WARN] Process pool unavailable, processing serially: {e}")
+            try:
+                self._collect(futures, total)
+            finally:
+                if processes is not None:
+                    processes.shutdown()
+
+        # No process pool: CPU chains run here, after the threaded ones
+        if cpu:
+            _init_worker(self.config)
+            try:
+                for chain in cpu:
+                    self._store(chain, _run_chain(chain.jobs), total)
+            finally:
+                del _local.pipeline
+
+        return self._summaries
+
+    def _collect(self, futures: Dict[Future, BatchChain], total: int):
+        """Store chain results as they finish."""
+        pending = set(futures)
+        while pending:
+            done, pending = wait(pending, return_when=FIRST_COMPLETED)
+            for future in done:
+                self._store(futures[future], future.result(), total)
+
+    def _store(self, chain: BatchChain,
+               outputs: List[Tuple[Dict[str, Any], List[PipelineEvent]]], total: int):
+        """Record a finished chain and replay every file now in order."""
+        for index, (summary, events) in zip(chain.indices, outputs):
+            self._summaries[index] = summary
+            self._events[index] = events
+
+        while self._released < total and self._summaries[self._released] is not None:
+            index = self._released
+            if self.announce:
+                self.announce(index, total)
+            for event in self._events[index]:
+                self.events.emit(event)
+            self._events[index] = None
+            self._released += 1
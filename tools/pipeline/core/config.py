@@ -142,6 +142,14 @@ class ProcessingConfig:
     dither_method: str = "floyd-steinberg"  # floyd-steinberg, ordered, atkinson, none
     dither_strength: float = 1.0
 
+    # Batch processing (0 = one worker per CPU, 1 = sequential)
+    batch_workers: int = 0
+
+    # Reuse stage outputs from the artifact store (cache_dir/artifacts)
+    cache_stages: bool = True
+    # Size budget for the artifact store; least recently used entries go first
+    cache_stages_max_mb: int = 256
+
 
 @dataclass
 class ExportConfig:
@@ -38,6 +38,8 @@ from datetime import datetime
 from PIL import Image
 
 from .config import PipelineConfig, InputType
+from .artifacts import ArtifactStore, read_written, restore_files, snapshot_dir
+from .batch import BatchExecutor, plan_batch, run_file
 from .safeguards import Safeguards, SafeguardViolation, DryRunActive
 from .events import (
     EventEmitter, EventType, ProgressEvent, StageEvent,
@@ -101,6 +103,14 @@ class Pipeline:
             # Default console handler for CLI
             self.events.on_all(ConsoleEventHandler(verbose=config.verbose))
 
+        # Stage outputs, keyed by content (see core/artifacts.py)
+        self.artifacts = None
+        if config.processing.cache_stages:
+            self.artifacts = ArtifactStore(
+                Path(config.safeguards.cache_dir) / "artifacts",
+                max_bytes=config.processing.cache_stages_max_mb * 1024 * 1024,
+            )
+
         # Lazy-load heavy modules
         self._platform_config = None
         self._ai_analyzer = None
@@ -276,14 +286,21 @@ class Pipeline:
     def process_batch(
         self,
         input_dir: str,
-        output_dir: str
+        output_dir: str,
+        workers: Optional[int] = None
     ) -> Dict[str, Any]:
         """
         Process a batch of assets from a directory.
 
+        Files run concurrently (see core/batch.py): PNGs in worker
+        processes, Aseprite exports and AI-assisted files on threads.
+        Results and events come out in the same order as a sequential run.
+
         Args:
             input_dir: Directory containing input files
             output_dir: Output directory
+            workers: Workers per pool (default: config.processing.batch_workers;
+                0 = CPU count, 1 = sequential)
 
         Returns:
             Result dictionary with per-file results
@@ -299,24 +316,32 @@ class Pipeline:
         for ext in ['*.png', '*.ase', '*.aseprite']:
             files.extend(input_path.glob(ext))
 
-        results = {"success": True, "files": [], "failed": 0, "succeeded": 0}
+        if workers is None:
+            workers = self.config.processing.batch_workers
 
-        for i, file_path in enumerate(files):
+        def announce(i: int, total: int):
             self._emit_progress(
-                (i / len(files)) * 100,
-                f"Processing {file_path.name}...",
+                (i / total) * 100,
+                f"Processing {files[i].name}...",
                 "batch"
             )
 
-            file_output = Path(output_dir) / file_path.stem
-            result = self.process(str(file_path), str(file_output))
+        if workers == 1 or len(files) <= 1:
+            summaries = []
+            for i, file_path in enumerate(files):
+                announce(i, len(files))
+                file_output = Path(output_dir) / file_path.stem
+                summaries.append(run_file(self, str(file_path), str(file_output)))
+        else:
+            executor = BatchExecutor(self.config, self.events, workers, announce)
+            summaries = executor.run(plan_batch(files, output_dir, self.config))
 
-            results["files"].append({
-                "file": str(file_path),
-                "success": result.get("success", False),
-            })
+        results = {"success": True, "files": [], "failed": 0, "succeeded": 0}
 
-            if result.get("success"):
+        for file_path, summary in zip(files, summaries):
+            results["files"].append({"file": str(file_path), **summary})
+
+            if summary["success"]:
                 results["succeeded"] += 1
             else:
                 results["failed"] += 1
@@ -345,47 +370,136 @@ class Pipeline:
         output_dir: str,
         category: Optional[str] = None
     ) -> Dict[str, Any]:
-        """Process a PNG image through the full pipeline."""
+        """
+        Process a PNG image through the full pipeline.
+
+        Each stage after input loading is memoized in the artifact store
+        (see core/artifacts.py), keyed by the keys of the stages it
+        consumes plus its own parameters.
+        """
         os.makedirs(output_dir, exist_ok=True)
+        processing = self.config.processing
+        use_ai = bool(self.ai_analyzer) and not self.config.offline_mode
 
         # Stage 0: Input
         self._emit_stage(0, STAGES[0][1])
-        img = Image.open(input_path).convert('RGBA')
+        source = Path(input_path).read_bytes()
+        source_key = ArtifactStore.content_hash(source)
+        img = None
         self._emit_stage(0, STAGES[0][1], complete=True)
 
+        def loaded() -> Image.Image:
+            # Decoded only when a stage actually runs
+            nonlocal img
+            if img is None:
+                img = Image.open(input_path).convert('RGBA')
+            return img
+
         # Stage 1: Preprocess
         self._emit_stage(1, STAGES[1][1])
-        img = self._preprocess_image(img)
+        prep, prep_key = self._run_stage(
+            "preprocess", [source_key], {},
+            lambda: self._preprocess_image(loaded()))
         self._emit_stage(1, STAGES[1][1], complete=True)
 
         # Stage 2: Palette
         self._emit_stage(2, STAGES[2][1])
-        palette = self._extract_palette(img)
+        palette, palette_key = self._run_stage(
+            "palette", [prep_key],
+            {
+                "forced_palette": processing.forced_palette,
+                "palette_name": processing.palette_name,
+                "colors": processing.colors_per_palette,
+                "ai_provider": self.config.ai_provider if use_ai else None,
+            },
+            lambda: self._extract_palette(prep))
         self._emit_stage(2, STAGES[2][1], complete=True)
 
         # Stage 3: Detect
         self._emit_stage(3, STAGES[3][1])
-        sprites = self._detect_sprites(img, category)
+        sprites, sprites_key = self._run_stage(
+            "detect", [prep_key],
+            {"filter_text": processing.filter_text, "category": category},
+            lambda: self._detect_sprites(prep, category))
         self._emit_stage(3, STAGES[3][1], complete=True)
 
         # Stage 4: Analyze
-        if self.ai_analyzer and not self.config.offline_mode:
+        if use_ai:
             self._emit_stage(4, STAGES[4][1])
-            sprites = self._analyze_sprites(img, sprites)
+            sprites, sprites_key = self._run_stage(
+                "analyze", [prep_key, sprites_key],
+                {"ai_provider": self.config.ai_provider},
+                lambda: self._analyze_sprites(prep, sprites))
             self._emit_stage(4, STAGES[4][1], complete=True)
 
         # Stage 5: Convert
         self._emit_stage(5, STAGES[5][1])
-        results = self._convert_sprites(img, sprites, palette, output_dir)
+        results, results_key = self._run_stage(
+            "convert", [prep_key, sprites_key, palette_key],
+            {
+                "platform": self.config.platform,
+                "target_size": processing.target_size,
+                "output_dir": str(Path(output_dir).resolve()),
+            },
+            lambda: self._convert_sprites(prep, sprites, palette, output_dir),
+            output_dir)
         self._emit_stage(5, STAGES[5][1], complete=True)
 
         # Stage 6: Export
         self._emit_stage(6, STAGES[6][1])
-        metadata = self._export_results(results, palette, output_dir, input_path)
+        metadata, _ = self._run_stage(
+            "export", [results_key, palette_key],
+            {
+                "export": asdict(self.config.export),
+                "platform": self.config.platform,
+                "target_size": processing.target_size,
+                "source": input_path,
+                "output_dir": str(Path(output_dir).resolve()),
+            },
+            lambda: self._export_results(results, palette, output_dir, input_path),
+            output_dir)
         self._emit_stage(6, STAGES[6][1], complete=True)
 
         return {"success": True, "metadata": metadata, "palette": palette}
 
+    def _run_stage(
+        self,
+        name: str,
+        inputs: List[str],
+        params: Dict[str, Any],
+        compute,
+        output_dir: Optional[str] = None
+    ):
+        """
+        Run a stage, or load its output from the artifact store.
+
+        Args:
+            name: Stage name
+            inputs: Source hash / upstream stage keys the stage consumes
+            params: Parameters that affect the stage's output
+            compute: Runs the stage
+            output_dir: Directory the stage writes files into, if any
+
+        Returns:
+            (stage output, stage key)
+        """
+        key = ArtifactStore.make_key(name, inputs, params)
+        if self.artifacts is None:
+            return compute(), key
+
+        artifact = self.artifacts.get(key)
+        if artifact is not None:
+            value, files = artifact
+            if output_dir is not None:
+                restore_files(output_dir, files)
+            return value, key
+
+        before = snapshot_dir(output_dir) if output_dir is not None else {}
+        value = compute()
+        files = read_written(output_dir, before) if output_dir is not None else {}
+        self.artifacts.put(key, (value, files))
+        return value, key
+
     def _process_aseprite(
         self,
         input_path: str,
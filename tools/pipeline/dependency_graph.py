@@ -0,0 +1,463 @@
+"""
+Incremental Dependency Graph for Asset Builds.
+
+Tracks which generated files depend on which inputs so a single edit
+rebuilds exactly the affected chain:
+
+    sheet.png ──► tiles ──► resources.res ──► rescomp ──► ROM
+    palettes.json ──► palettes.h
+
+The graph is a set of build steps. Each step names a rule (a registered
+function), the files it reads and the files it writes. After a step runs,
+the content hashes of its inputs and outputs are stored, and the graph is
+saved as JSON so it survives restarts of the watcher.
+
+Update Algorithm:
+    1. Collect every step downstream of the changed files, in dependency
+       order (producers before consumers).
+    2. Run a step only if one of its inputs has different content from the
+       last build, or one of its outputs is missing.
+    3. After a step runs, hash its outputs. Outputs that come out
+       byte-identical do not mark their consumers dirty (early cutoff), so
+       a tile edit that produces the same .res stops there.
+
+Rules should write through write_if_changed(), which leaves byte-identical
+files untouched. Their mtimes do not move, so SGDK's make does not
+recompile resources that did not change.
+
+Usage:
+    >>> from pipeline.dependency_graph import DependencyGraph
+    >>>
+    >>> graph = DependencyGraph('.ardk_cache/deps.json')
+    >>> graph.register_rule('sprite', convert_sprite)
+    >>> graph.register_rule('res', write_res)
+    >>> graph.add_step('hero', 'sprite', ['assets/hero.png'], ['res/sprites/hero.png'])
+    >>> graph.add_step('res', 'res', ['res/sprites/hero.png'], ['res/resources.res'])
+    >>>
+    >>> report = graph.update(['assets/hero.png'])
+    >>> report.rebuilt         # ['hero'] or ['hero', 'res']
+    >>> report.changed_outputs # files whose bytes actually changed
+"""
+
+import hashlib
+import json
+import os
+import threading
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Callable, Dict, Iterable, List, Optional, Set, Tuple, Union
+
+
+GRAPH_VERSION = 1
+
+# Rule signature: rule(inputs, outputs, params)
+Rule = Callable[[List[Path], List[Path], Dict], None]
+
+PathLike = Union[str, Path]
+
+
+# =============================================================================
+# OUTPUT WRITING
+# =============================================================================
+
+def _comparable(data: bytes, volatile_prefix: Optional[str]) -> bytes:
+    """Drop lines that change on every run (e.g. generation timestamps)."""
+    if not volatile_prefix:
+        return data
+    prefix = volatile_prefix.encode('utf-8')
+    return b'\n'.join(line for line in data.split(b'\n')
+                      if not line.lstrip().startswith(prefix))
+
+
+def write_if_changed(path: PathLike, content: Union[str, bytes],
+                     volatile_prefix: Optional[str] = None) -> bool:
+    """
+    Write a file only when its content differs from what is on disk.
+
+    Args:
+        path: Output file
+        content: New content (str is written as UTF-8)
+        volatile_prefix: Lines starting with this (e.g. "// Generated:")
+            are ignored when comparing
+
+    Returns:
+        True if the file was written, False if it was already up to date
+    """
+    data = content.encode('utf-8') if isinstance(content, str) else content
+    path = Path(path)
+    try:
+        existing = path.read_bytes()
+    except OSError:
+        existing = None
+
+    if existing is not None and \
+            _comparable(existing, volatile_prefix) == _comparable(data, volatile_prefix):
+        return False
+
+    if path.parent != Path(''):
+        path.parent.mkdir(parents=True, exist_ok=True)
+    tmp_path = path.with_name(f"{path.name}.{os.getpid()}.tmp")
+    tmp_path.write_bytes(data)
+    os.replace(tmp_path, path)
+    return True
+
+
+# =============================================================================
+# GRAPH
+# =============================================================================
+
+@dataclass
+class BuildStep:
+    """One rule invocation: reads inputs, writes outputs."""
+    step_id: str
+    rule: str
+    inputs: List[str]
+    outputs: List[str]
+    params: Dict = field(default_factory=dict)
+
+    # Content hashes at the last successful run
+    input_hashes: Dict[str, str] = field(default_factory=dict)
+    output_hashes: Dict[str, str] = field(default_factory=dict)
+
+    def to_dict(self) -> Dict:
+        return {
+            'rule': self.rule,
+            'inputs': self.inputs,
+            'outputs': self.outputs,
+            'params': self.params,
+            'input_hashes': self.input_hashes,
+            'output_hashes': self.output_hashes,
+        }
+
+    @classmethod
+    def from_dict(cls, step_id: str, data: Dict) -> 'BuildStep':
+        return cls(
+            step_id=step_id,
+            rule=data['rule'],
+            inputs=list(data.get('inputs', [])),
+            outputs=list(data.get('outputs', [])),
+            params=dict(data.get('params', {})),
+            input_hashes=dict(data.get('input_hashes', {})),
+            output_hashes=dict(data.get('output_hashes', {})),
+        )
+
+
+@dataclass
+class BuildReport:
+    """Result of DependencyGraph.update()."""
+    rebuilt: List[str] = field(default_factory=list)
+    up_to_date: List[str] = field(default_factory=list)
+    failed: Dict[str, str] = field(default_factory=dict)    # step_id -> error
+    blocked: List[str] = field(default_factory=list)        # Downstream of a failure
+    changed_outputs: List[str] = field(default_factory=list)
+
+    @property
+    def success(self) -> bool:
+        return not self.failed
+
+    def summary(self) -> str:
+        parts = [f"{len(self.rebuilt)} rebuilt", f"{len(self.up_to_date)} up to date"]
+        if self.failed:
+            parts.append(f"{len(self.failed)} failed")
+        if self.blocked:
+            parts.append(f"{len(self.blocked)} blocked")
+        parts.append(f"{len(self.changed_outputs)} outputs changed")
+        return ", ".join(parts)
+
+
+class DependencyGraph:
+    """
+    Persistent graph of build steps with content-hash change detection.
+
+    Paths are stored relative to root, so the graph file stays valid when
+    the project is moved. All methods are thread-safe: an internal lock
+    serializes update() and guards the step table, so watcher workers may
+    query and add steps concurrently. Rules for one update run one at a
+    time in dependency order.
+    """
+
+    def __init__(self, path: Optional[PathLike] = None,
+                 root: Optional[PathLike] = None):
+        """
+        Args:
+            path: JSON file to load from and save to (None = in memory)
+            root: Directory paths are stored relative to (default: cwd)
+        """
+        self.path = Path(path) if path else None
+        self.root = Path(root or os.getcwd()).resolve()
+        self.steps: Dict[str, BuildStep] = {}
+        self._rules: Dict[str, Rule] = {}
+        self._lock = threading.RLock()
+
+        # (mtime_ns, size) -> hash, so unchanged files are not re-read
+        self._hash_cache: Dict[str, Tuple[int, int, str]] = {}
+
+        if self.path and self.path.exists():
+            self.load()
+
+    # -------------------------------------------------------------------------
+    # Definition
+    # -------------------------------------------------------------------------
+
+    def register_rule(self, name: str, func: Rule) -> None:
+        """Register the function that runs steps with this rule name."""
+        self._rules[name] = func
+
+    def add_step(self, step_id: str, rule: str,
+                 inputs: Iterable[PathLike], outputs: Iterable[PathLike],
+                 params: Optional[Dict] = None) -> BuildStep:
+        """
+        Add or redefine a step.
+
+        Redefining a step with identical rule, files and params keeps its
+        recorded hashes; any other change forces it to run next update.
+
+        Raises:
+            ValueError: If an output is already produced by another step
+        """
+        with self._lock:
+            step = BuildStep(
+                step_id=step_id,
+                rule=rule,
+                inputs=[self._key(p) for p in inputs],
+                outputs=[self._key(p) for p in outputs],
+                params=dict(params or {}),
+            )
+            for output in step.outputs:
+                producer = self.producer(output)
+                if producer and producer.step_id != step_id:
+                    raise ValueError(
+                        f"{output} is already produced by step '{producer.step_id}'"
+                    )
+
+            old = self.steps.get(step_id)
+            if old and (old.rule, old.inputs, old.outputs, old.params) == \
+                    (step.rule, step.inputs, step.outputs, step.params):
+                step.input_hashes = old.input_hashes
+                step.output_hashes = old.output_hashes
+
+            self.steps[step_id] = step
+            return step
+
+    def remove_step(self, step_id: str) -> None:
+        with self._lock:
+            self.steps.pop(step_id, None)
+
+    def producer(self, path: PathLike) -> Optional[BuildStep]:
+        """Step that writes path, if any."""
+        key = self._key(path)
+        with self._lock:
+            for step in self.steps.values():
+                if key in step.outputs:
+                    return step
+        return None
+
+    def consumers(self, path: PathLike) -> List[BuildStep]:
+        """Steps that read path."""
+        key = self._key(path)
+        with self._lock:
+            return [step for step in self.steps.values() if key in step.inputs]
+
+    def steps_with_rule(self, rule: str) -> List[BuildStep]:
+        """Steps run by a rule, ordered by step id."""
+        with self._lock:
+            return sorted((step for step in self.steps.values() if step.rule == rule),
+                          key=lambda step: step.step_id)
+
+    def tracks(self, path: PathLike) -> bool:
+        """True if some step reads path (safe while other threads add steps)."""
+        return bool(self.consumers(path))
+
+    def affected(self, changed: Iterable[PathLike]) -> List[BuildStep]:
+        """
+        Steps downstream of the changed files, producers before consumers.
+
+        Raises:
+            ValueError: If the affected steps form a cycle
+        """
+        with self._lock:
+            readers: Dict[str, List[BuildStep]] = {}
+            for step in self.steps.values():
+                for inp in step.inputs:
+                    readers.setdefault(inp, []).append(step)
+
+            # Reachable steps
+            reached: Dict[str, BuildStep] = {}
+            frontier = [self._key(p) for p in changed]
+            while frontier:
+                path = frontier.pop()
+                for step in readers.get(path, []):
+                    if step.step_id not in reached:
+                        reached[step.step_id] = step
+                        frontier.extend(step.outputs)
+
+            # Kahn's algorithm over the reached subgraph; ties keep insertion order
+            produced_by = {out: s.step_id for s in reached.values() for out in s.outputs}
+            indegree = {sid: 0 for sid in reached}
+            for step in reached.values():
+                for inp in set(step.inputs):
+                    if inp in produced_by:
+                        indegree[step.step_id] += 1
+
+            ready = [sid for sid in reached if indegree[sid] == 0]
+            order: List[BuildStep] = []
+            while ready:
+                sid = ready.pop(0)
+                order.append(reached[sid])
+                for out in reached[sid].outputs:
+                    for step in readers.get(out, []):
+                        if step.step_id in indegree:
+                            indegree[step.step_id] -= 1
+                            if indegree[step.step_id] == 0:
+                                ready.append(step.step_id)
+
+            if len(order) != len(reached):
+                cycle = sorted(sid for sid in reached if indegree[sid] > 0)
+                raise ValueError(f"Dependency cycle between steps: {', '.join(cycle)}")
+            return order
+
+    # -------------------------------------------------------------------------
+    # Update
+    # -------------------------------------------------------------------------
+
+    def update(self, changed: Iterable[PathLike]) -> BuildReport:
+        """
+        Rebuild everything affected by the changed files.
+
+        Args:
+            changed: Files that were edited (touches with identical content
+                rebuild nothing)
+
+        Returns:
+            BuildReport of what ran and which outputs changed
+        """
+        with self._lock:
+            changed = [self._key(p) for p in changed]
+            report = BuildReport()
+            dirty: Set[str] = set(changed)
+            blocked: Set[str] = set()
+
+            for step in self.affected(changed):
+                if blocked.intersection(step.inputs):
+                    report.blocked.append(step.step_id)
+                    blocked.update(step.outputs)
+                    continue
+
+                intact = self._outputs_intact(step)
+                if not dirty.intersection(step.inputs) and step.input_hashes and intact:
+                    # Upstream rebuilt but produced identical bytes
+                    report.up_to_date.append(step.step_id)
+                    continue
+
+                input_hashes = {inp: self._hash(inp) for inp in step.inputs}
+                if input_hashes == step.input_hashes and intact:
+                    report.up_to_date.append(step.step_id)
+                    continue
+
+                func = self._rules.get(step.rule)
+                if func is None:
+                    report.failed[step.step_id] = f"No rule registered for '{step.rule}'"
+                    step.input_hashes = {}
+                    blocked.update(step.outputs)
+                    continue
+
+                try:
+                    func([self.resolve(p) for p in step.inputs],
+                         [self.resolve(p) for p in step.outputs],
+                         dict(step.params))
+                except Exception as e:
+                    # Forget the last good inputs: otherwise the shortcut above
+                    # would call the step up to date and it would never retry
+                    report.failed[step.step_id] = str(e)
+                    step.input_hashes = {}
+                    blocked.update(step.outputs)
+                    continue
+
+                output_hashes = {out: self._hash(out) for out in step.outputs}
+                for out, digest in output_hashes.items():
+                    if digest != step.output_hashes.get(out):
+                        dirty.add(out)
+                        report.changed_outputs.append(out)
+
+                step.input_hashes = input_hashes
+                step.output_hashes = output_hashes
+                report.rebuilt.append(step.step_id)
+
+            self.save()
+            return report
+
+    def build_all(self) -> BuildReport:
+        """Bring every step up to date (initial build)."""
+        with self._lock:
+            sources = {inp for step in self.steps.values() for inp in step.inputs}
+            sources -= {out for step in self.steps.values() for out in step.outputs}
+            return self.update(sorted(sources))
+
+    def _outputs_intact(self, step: BuildStep) -> bool:
+        return all(self._hash(out) == step.output_hashes.get(out) for out in step.outputs)
+
+    # -------------------------------------------------------------------------
+    # Paths and Hashing
+    # -------------------------------------------------------------------------
+
+    def _key(self, path: PathLike) -> str:
+        """Root-relative POSIX key for a path."""
+        path = Path(path)
+        if not path.is_absolute():
+            path = self.root / path
+        path = Path(os.path.normpath(path))
+        try:
+            return path.relative_to(self.root).as_posix()
+        except ValueError:
+            return path.as_posix()
+
+    def resolve(self, key: str) -> Path:
+        """Filesystem path for a stored key."""
+        return self.root / key
+
+    def _hash(self, key: str) -> Optional[str]:
+        """Content hash of a file, or None if it does not exist."""
+        path = self.resolve(key)
+        try:
+            stat = path.stat()
+        except OSError:
+            return None
+
+        cached = self._hash_cache.get(key)
+        if cached and cached[:2] == (stat.st_mtime_ns, stat.st_size):
+            return cached[2]
+
+        hasher = hashlib.md5()
+        with open(path, 'rb') as f:
+            for chunk in iter(lambda: f.read(1 << 20), b''):
+                hasher.update(chunk)
+        digest = hasher.hexdigest()
+        self._hash_cache[key] = (stat.st_mtime_ns, stat.st_size, digest)
+        return digest
+
+    # -------------------------------------------------------------------------
+    # Persistence
+    # -------------------------------------------------------------------------
+
+    def save(self) -> None:
+        """Write the graph to its JSON file (no-op for in-memory graphs)."""
+        if not self.path:
+            return
+        data = {
+            'version': GRAPH_VERSION,
+            'steps': {sid: step.to_dict() for sid, step in self.steps.items()},
+        }
+        write_if_changed(self.path, json.dumps(data, indent=2, sort_keys=True))
+
+    def load(self) -> None:
+        """Load steps from the JSON file; unreadable or old files start empty."""
+        try:
+            with open(self.path, 'r', encoding='utf-8') as f:
+                data = json.load(f)
+        except (OSError, ValueError) as e:
+            print(f"[WARN] Could not load dependency graph {self.path}: {e}")
+            return
+        if data.get('version') != GRAPH_VERSION:
+            return
+        self.steps = {sid: BuildStep.from_dict(sid, step)
+                      for sid, step in data.get('steps', {}).items()}
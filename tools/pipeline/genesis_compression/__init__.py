@@ -14,12 +14,38 @@ Usage:
     >>> compressor = GenesisCompressor()
     >>> result = compressor.compress(tile_data, format=CompressionFormat.KOSINSKI)
     >>> print(f"Compressed: {result.input_size} -> {result.output_size} bytes ({result.ratio:.1%})")
+
+    >>> # Smallest output (DP parse, same bitstream)
+    >>> compressor = GenesisCompressor(level=CompressionLevel.OPTIMAL)
+
+Native Kernels:
+    An optional C extension gives identical output at native speed. Build it
+    once with `python -m pipeline.genesis_compression.build_native`; without
+    it everything falls back to pure Python.
+
+Caching:
+    >>> # Skip unchanged tile banks across builds; misses use all cores
+    >>> compressor = GenesisCompressor(cache=CompressionCache())
+    >>> reports = compressor.compare_formats_batch(tile_banks)
+
+Decompression Cost:
+    >>> # Estimated 68000 cycles to unpack a buffer at runtime
+    >>> cost = estimate_decompression_cost(result.data, result.format)
+    >>> print(f"{cost.cycles} cycles ({cost.scanlines:.1f} scanlines)")
+
+Benchmark:
+    python -m pipeline.genesis_compression.benchmark tiles.bin level.png
 """
 
+from .cache import CompressionCache
+
 from .genesis_compress import (
     CompressionFormat,
+    CompressionLevel,
     CompressionResult,
+    DecompressionCost,
     GenesisCompressor,
+    HashChainMatchFinder,
     KosinskiCompressor,
     LZSSCompressor,
     RLECompressor,
@@ -30,12 +56,19 @@ from .genesis_compress import (
     compress_rle,
     decompress_rle,
     auto_select_format,
+    estimate_decompression_cost,
+    is_native_available,
+    NATIVE_AVAILABLE,
 )
 
 __all__ = [
+    'CompressionCache',
     'CompressionFormat',
+    'CompressionLevel',
     'CompressionResult',
+    'DecompressionCost',
     'GenesisCompressor',
+    'HashChainMatchFinder',
     'KosinskiCompressor',
     'LZSSCompressor',
     'RLECompressor',
@@ -46,4 +79,7 @@ __all__ = [
     'compress_rle',
     'decompress_rle',
     'auto_select_format',
+    'estimate_decompression_cost',
+    'is_native_available',
+    'NATIVE_AVAILABLE',
 ]
@@ -0,0 +1,822 @@
+/*
+ * Native kernels for pipeline.genesis_compression.
+ *
+ * Implements the Kosinski, LZSS and RLE codecs from genesis_compress.py with
+ * byte-identical output: the same match finder semantics (longest match,
+ * earliest offset on ties), the same greedy / lazy / optimal parse rules and
+ * the same handling of malformed input when decompressing.
+ *
+ * Build in place with:
+ *     python -m pipeline.genesis_compression.build_native
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Must match CompressionLevel ordering in genesis_compress.py */
+#define LEVEL_GREEDY  0
+#define LEVEL_LAZY    1
+#define LEVEL_OPTIMAL 2
+
+/* Token costs in bits: one flag bit plus an 8-bit literal / 16-bit reference */
+#define LITERAL_BITS 9
+#define MATCH_BITS   17
+
+/* Hash table size scales with the input, up to 2^17 buckets per level */
+#define MIN_HASH_BITS 8
+#define MAX_HASH_BITS 17
+
+
+/* ========================================================================= */
+/* Growable output buffer                                                    */
+/* ========================================================================= */
+
+typedef struct {
+    uint8_t *buf;
+    Py_ssize_t len;
+    Py_ssize_t cap;
+} OutBuf;
+
+static int out_init(OutBuf *o, Py_ssize_t cap)
+{
+    o->len = 0;
+    o->cap = cap > 16 ? cap : 16;
+    o->buf = (uint8_t *)malloc((size_t)o->cap);
+    return o->buf != NULL;
+}
+
+static int out_reserve(OutBuf *o, Py_ssize_t extra)
+{
+    uint8_t *grown;
+    Py_ssize_t cap = o->cap;
+
+    if (o->len + extra <= cap)
+        return 1;
+    while (cap < o->len + extra)
+        cap *= 2;
+    grown = (uint8_t *)realloc(o->buf, (size_t)cap);
+    if (grown == NULL)
+        return 0;
+    o->buf = grown;
+    o->cap = cap;
+    return 1;
+}
+
+static PyObject *out_finish(OutBuf *o)
+{
+    PyObject *result = PyBytes_FromStringAndSize((const char *)o->buf, o->len);
+    free(o->buf);
+    o->buf = NULL;
+    return result;
+}
+
+
+/* ========================================================================= */
+/* Match finder                                                              */
+/* ========================================================================= */
+
+/*
+ * Positions are chained by a hash of their first L bytes for a few prefix
+ * lengths L (k, 6, 12, max_match). Chains run forwards in ascending position
+ * order, and each bucket keeps a cursor to its first position inside the
+ * window; queries arrive in non-decreasing order, so cursors only advance.
+ *
+ * A lookup walks the longest level first. Every position matching at least L
+ * bytes is in that level's chain, so if the walk finds one, the earliest
+ * longest match is among them. If not, no match reaches L and the next level
+ * down is walked with the length capped at L - 1; the first candidate to hit
+ * the cap is then the earliest longest match. Hash collisions only yield
+ * shorter lengths and are filtered by requiring at least `k` matching bytes.
+ *
+ * Only the k level is built up front. Typical tile data finds full-length
+ * matches early in its chains; the longer levels are built on demand once
+ * chain walks exceed WALK_BUDGET steps per query (on low-entropy data).
+ */
+#define MAX_LEVELS 4
+#define WALK_BUDGET 16
+
+typedef struct {
+    Py_ssize_t len;     /* Prefix length hashed at this level */
+    int32_t *next;      /* Next position in the same bucket (INT32_MAX = end) */
+    int32_t *cursor;    /* Per bucket: first position not behind the window */
+} Level;
+
+typedef struct {
+    const uint8_t *data;
+    uint8_t *padded;    /* Copy of data with zero slack for prefix_hash */
+    Py_ssize_t n;
+    Py_ssize_t window;
+    Py_ssize_t max_match;
+    Py_ssize_t k;
+    int hash_bits;
+    int nlevels;        /* Levels built so far */
+    int total_levels;   /* Levels available on demand */
+    Py_ssize_t lengths[MAX_LEVELS];
+    Py_ssize_t steps;   /* Chain steps walked while single-level */
+    Py_ssize_t queries;
+    Level levels[MAX_LEVELS];
+} Finder;
+
+static void finder_free(Finder *f)
+{
+    int l;
+    for (l = 0; l < f->nlevels; l++) {
+        free(f->levels[l].next);
+        free(f->levels[l].cursor);
+    }
+    f->nlevels = 0;
+    free(f->padded);
+    f->padded = NULL;
+}
+
+/* Hash of the len-byte prefix at p; reads up to 7 bytes past the prefix */
+static uint32_t prefix_hash(const uint8_t *p, Py_ssize_t len, int hash_bits)
+{
+    uint64_t h = 0, word;
+    Py_ssize_t i;
+
+    for (i = 0; i + 8 <= len; i += 8) {
+        memcpy(&word, p + i, 8);
+        h = (h ^ word) * 0x9E3779B97F4A7C15ull;
+    }
+    if (i < len) {
+        memcpy(&word, p + i, 8);
+        word &= ~0ull >> (8 * (8 - (len - i)));
+        h = (h ^ word) * 0x9E3779B97F4A7C15ull;
+    }
+    return (uint32_t)(h >> (64 - hash_bits));
+}
+
+static int level_init(Level *lv, const uint8_t *padded, Py_ssize_t n,
+                      Py_ssize_t len, int hash_bits)
+{
+    const uint32_t hash_size = 1u << hash_bits;
+    Py_ssize_t p, indexed = n - len + 1 > 0 ? n - len + 1 : 0;
+    uint32_t b;
+    int32_t *tail;
+
+    lv->len = len;
+    lv->next = (int32_t *)malloc(sizeof(int32_t) * (size_t)(indexed + 1));
+    lv->cursor = (int32_t *)malloc(sizeof(int32_t) * hash_size);
+    tail = (int32_t *)malloc(sizeof(int32_t) * hash_size);
+    if (!lv->next || !lv->cursor || !tail) {
+        free(tail);
+        return 0;
+    }
+    memset(tail, 0xFF, sizeof(int32_t) * hash_size);  /* -1 = empty */
+
+    for (p = 0; p < indexed; p++) {
+        b = prefix_hash(padded + p, len, hash_bits);
+        lv->next[p] = INT32_MAX;
+        if (tail[b] < 0)
+            lv->cursor[b] = (int32_t)p;
+        else
+            lv->next[tail[b]] = (int32_t)p;
+        tail[b] = (int32_t)p;
+    }
+
+    free(tail);
+    return 1;
+}
+
+static int finder_init(Finder *f, const uint8_t *data, Py_ssize_t n,
+                       Py_ssize_t window, Py_ssize_t max_match,
+                       Py_ssize_t min_match)
+{
+    static const Py_ssize_t extra_lengths[] = {6, 12};
+    Py_ssize_t *lengths = f->lengths;
+    int count = 0, i;
+
+    f->data = data;
+    f->n = n;
+    f->window = window;
+    f->max_match = max_match;
+    f->k = min_match < 3 ? min_match : 3;
+    if (max_match < f->k)
+        f->k = max_match;
+    if (f->k < 1)
+        f->k = 1;
+    f->nlevels = 0;
+    f->steps = 0;
+    f->queries = 0;
+
+    f->hash_bits = MIN_HASH_BITS;
+    while (f->hash_bits < MAX_HASH_BITS && ((Py_ssize_t)1 << f->hash_bits) < n)
+        f->hash_bits++;
+
+    lengths[count++] = f->k;
+    for (i = 0; i < 2; i++)
+        if (extra_lengths[i] > f->k && extra_lengths[i] < max_match)
+            lengths[count++] = extra_lengths[i];
+    if (max_match > f->k)
+        lengths[count++] = max_match;
+
+    /* Zero slack lets prefix_hash read whole words past the last prefix */
+    f->padded = (uint8_t *)malloc((size_t)n + 8);
+    if (!f->padded)
+        return 0;
+    memcpy(f->padded, data, (size_t)n);
+    memset(f->padded + n, 0, 8);
+
+    f->total_levels = count;
+    f->levels[0].next = f->levels[0].cursor = NULL;
+    f->nlevels = 1;
+    if (!level_init(&f->levels[0], f->padded, n, lengths[0], f->hash_bits)) {
+        finder_free(f);
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Build the longer levels. Chains are static, so this is exact mid-parse;
+ * on allocation failure the finder keeps working with the k level alone.
+ */
+static void finder_add_levels(Finder *f)
+{
+    int i;
+
+    for (i = 1; i < f->total_levels; i++) {
+        Level *lv = &f->levels[i];
+        lv->next = lv->cursor = NULL;
+        if (!level_init(lv, f->padded, f->n, f->lengths[i], f->hash_bits)) {
+            free(lv->next);
+            free(lv->cursor);
+            break;
+        }
+        f->nlevels = i + 1;
+    }
+    f->total_levels = f->nlevels;
+}
+
+/* First chained position at or after window_start (pos itself at worst) */
+static Py_ssize_t level_first(const Finder *f, const Level *lv, Py_ssize_t pos,
+                              Py_ssize_t window_start)
+{
+    int32_t *cursor = &lv->cursor[prefix_hash(f->padded + pos, lv->len,
+                                              f->hash_bits)];
+    Py_ssize_t c = *cursor;
+    while (c < window_start)
+        c = lv->next[c];
+    *cursor = (int32_t)c;
+    return c;
+}
+
+/*
+ * Returns the match length (0 if none of at least k bytes), offset in *off.
+ * Positions must be queried in non-decreasing order.
+ */
+static Py_ssize_t finder_find(Finder *f, Py_ssize_t pos, Py_ssize_t *off)
+{
+    const uint8_t *data = f->data;
+    Py_ssize_t max_len = f->max_match < f->n - pos ? f->max_match : f->n - pos;
+    Py_ssize_t window_start = pos - f->window;
+    Py_ssize_t cap = max_len;
+    Py_ssize_t best_len = 0, best_off = 0, steps = 0;
+    int l;
+
+    *off = 0;
+    if (max_len < f->k)
+        return 0;
+
+    if (f->nlevels < f->total_levels
+            && f->steps > WALK_BUDGET * f->queries + 4 * f->window)
+        finder_add_levels(f);
+
+    /* Quick reject: no k-byte prefix candidate inside the window */
+    if (level_first(f, &f->levels[0], pos, window_start) >= pos)
+        return 0;
+
+    for (l = f->nlevels - 1; l >= 0; l--) {
+        const Level *lv = &f->levels[l];
+        Py_ssize_t p;
+
+        /* pos itself is only chained where its prefix fits in the data */
+        if (lv->len > max_len)
+            continue;
+
+        best_len = 0;
+        best_off = 0;
+        for (p = level_first(f, lv, pos, window_start); p < pos; p = lv->next[p]) {
+            Py_ssize_t len;
+
+            steps++;
+
+            /* Can only be longer if it also matches at best_len */
+            if (data[p + best_len] != data[pos + best_len])
+                continue;
+
+            len = 0;
+            while (len < cap && data[p + len] == data[pos + len])
+                len++;
+
+            if (len > best_len) {
+                best_len = len;
+                best_off = p;
+                if (len == cap)
+                    break;
+            }
+        }
+
+        if (best_len >= lv->len)
+            break;
+
+        /* Nothing reaches this level's length: cap the next walk below it */
+        cap = lv->len - 1;
+    }
+
+    if (f->nlevels == 1) {
+        f->steps += steps;
+        f->queries++;
+    }
+
+    if (best_len < f->k)
+        return 0;
+
+    *off = best_off;
+    return best_len;
+}
+
+
+/* ========================================================================= */
+/* Parse                                                                     */
+/* ========================================================================= */
+
+/*
+ * Token arrays: tok_len[i] == 0 is a literal, otherwise a reference of that
+ * length to absolute position tok_off[i]. Mirrors lz_parse().
+ */
+static Py_ssize_t lz_parse(const uint8_t *data, Py_ssize_t n,
+                           Py_ssize_t window, Py_ssize_t min_match,
+                           Py_ssize_t max_match, int level,
+                           int32_t *tok_off, int32_t *tok_len)
+{
+    Finder f;
+    Py_ssize_t count = 0, pos = 0;
+
+    if (!finder_init(&f, data, n, window, max_match, min_match))
+        return -1;
+
+    if (level == LEVEL_OPTIMAL) {
+        int32_t *offsets = (int32_t *)malloc(sizeof(int32_t) * (size_t)n);
+        int32_t *longest = (int32_t *)malloc(sizeof(int32_t) * (size_t)n);
+        int32_t *choice = (int32_t *)malloc(sizeof(int32_t) * (size_t)n);
+        int64_t *cost = (int64_t *)malloc(sizeof(int64_t) * (size_t)(n + 1));
+
+        if (!offsets || !longest || !choice || !cost) {
+            free(offsets);
+            free(longest);
+            free(choice);
+            free(cost);
+            finder_free(&f);
+            return -1;
+        }
+
+        for (pos = 0; pos < n; pos++) {
+            Py_ssize_t off;
+            longest[pos] = (int32_t)finder_find(&f, pos, &off);
+            offsets[pos] = (int32_t)off;
+        }
+
+        cost[n] = 0;
+        for (pos = n - 1; pos >= 0; pos--) {
+            int64_t best = cost[pos + 1] + LITERAL_BITS;
+            int32_t best_len = 0;
+            Py_ssize_t length;
+            for (length = min_match; length <= longest[pos]; length++) {
+                int64_t c = cost[pos + length] + MATCH_BITS;
+                if (c <= best) {  /* Prefer longer matches on ties */
+                    best = c;
+                    best_len = (int32_t)length;
+                }
+            }
+            cost[pos] = best;
+            choice[pos] = best_len;
+        }
+
+        pos = 0;
+        while (pos < n) {
+            if (choice[pos]) {
+                tok_off[count] = offsets[pos];
+                tok_len[count++] = choice[pos];
+                pos += choice[pos];
+            } else {
+                tok_off[count] = 0;
+                tok_len[count++] = 0;
+                pos++;
+            }
+        }
+
+        free(offsets);
+        free(longest);
+        free(choice);
+        free(cost);
+    } else {
+        int have_lookahead = 0;
+        Py_ssize_t la_off = 0, la_len = 0;
+
+        while (pos < n) {
+            Py_ssize_t off, len;
+
+            if (have_lookahead) {
+                off = la_off;
+                len = la_len;
+                have_lookahead = 0;
+            } else {
+                len = finder_find(&f, pos, &off);
+            }
+
+            if (len < min_match) {
+                tok_off[count] = 0;
+                tok_len[count++] = 0;
+                pos++;
+                continue;
+            }
+
+            if (level == LEVEL_LAZY && len < max_match - 1 && pos + 1 < n) {
+                la_len = finder_find(&f, pos + 1, &la_off);
+                if (la_len > len + 1) {
+                    tok_off[count] = 0;
+                    tok_len[count++] = 0;
+                    pos++;
+                    have_lookahead = 1;
+                    continue;
+                }
+            }
+
+            tok_off[count] = (int32_t)off;
+            tok_len[count++] = (int32_t)len;
+            pos += len;
+        }
+    }
+
+    finder_free(&f);
+    return count;
+}
+
+
+/* ========================================================================= */
+/* Kosinski / LZSS encoders                                                  */
+/* ========================================================================= */
+
+#define FORMAT_KOSINSKI 0
+#define FORMAT_LZSS     1
+
+static PyObject *lz_compress(const uint8_t *data, Py_ssize_t n, int format,
+                             Py_ssize_t window, Py_ssize_t min_match,
+                             Py_ssize_t max_match, int level, int length_bits)
+{
+    int32_t *tok_off, *tok_len;
+    Py_ssize_t count, start, pos = 0;
+    OutBuf out;
+
+    tok_off = (int32_t *)malloc(sizeof(int32_t) * (size_t)(n + 1));
+    tok_len = (int32_t *)malloc(sizeof(int32_t) * (size_t)(n + 1));
+    /* Worst case: every token a 2-byte reference, plus flag bytes */
+    if (!tok_off || !tok_len || !out_init(&out, 2 * n + n / 8 + 16)) {
+        free(tok_off);
+        free(tok_len);
+        return PyErr_NoMemory();
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    count = lz_parse(data, n, window, min_match, max_match, level,
+                     tok_off, tok_len);
+
+    for (start = 0; count > 0 && start < count; start += 8) {
+        uint8_t flags = 0;
+        Py_ssize_t flag_at = out.len++;
+        int bit;
+
+        for (bit = 0; bit < 8; bit++) {
+            Py_ssize_t i = start + bit;
+
+            if (i >= count) {
+                /* Kosinski pads the last group with literal flags */
+                if (format == FORMAT_KOSINSKI)
+                    flags |= (uint8_t)(1 << bit);
+                continue;
+            }
+
+            if (tok_len[i]) {
+                Py_ssize_t distance = pos - tok_off[i];
+                Py_ssize_t length_code = tok_len[i] - min_match;
+
+                if (format == FORMAT_KOSINSKI) {
+                    out.buf[out.len++] = (uint8_t)(distance & 0xFF);
+                    out.buf[out.len++] = (uint8_t)(((distance >> 8) << 4) |
+                                                   (length_code & 0x0F));
+                } else {
+                    uint32_t ref = ((uint32_t)(distance - 1) << length_bits) |
+                                   (uint32_t)length_code;
+                    out.buf[out.len++] = (uint8_t)(ref >> 8);
+                    out.buf[out.len++] = (uint8_t)(ref & 0xFF);
+                }
+                pos += tok_len[i];
+            } else {
+                flags |= (uint8_t)(1 << bit);
+                out.buf[out.len++] = data[pos++];
+            }
+        }
+
+        out.buf[flag_at] = flags;
+    }
+    Py_END_ALLOW_THREADS
+
+    free(tok_off);
+    free(tok_len);
+
+    if (count < 0) {
+        free(out.buf);
+        return PyErr_NoMemory();
+    }
+    return out_finish(&out);
+}
+
+static PyObject *py_kosinski_compress(PyObject *self, PyObject *args)
+{
+    Py_buffer buf;
+    Py_ssize_t window, min_match, max_match;
+    int level;
+    PyObject *result;
+
+    if (!PyArg_ParseTuple(args, "y*nnni", &buf, &window, &min_match,
+                          &max_match, &level))
+        return NULL;
+    result = lz_compress((const uint8_t *)buf.buf, buf.len, FORMAT_KOSINSKI,
+                         window, min_match, max_match, level, 0);
+    PyBuffer_Release(&buf);
+    return result;
+}
+
+static PyObject *py_lzss_compress(PyObject *self, PyObject *args)
+{
+    Py_buffer buf;
+    Py_ssize_t window, min_match, max_match;
+    int level, length_bits;
+    PyObject *result;
+
+    if (!PyArg_ParseTuple(args, "y*nnnii", &buf, &window, &min_match,
+                          &max_match, &level, &length_bits))
+        return NULL;
+    result = lz_compress((const uint8_t *)buf.buf, buf.len, FORMAT_LZSS,
+                         window, min_match, max_match, level, length_bits);
+    PyBuffer_Release(&buf);
+    return result;
+}
+
+
+/* ========================================================================= */
+/* Kosinski / LZSS decoders                                                  */
+/* ========================================================================= */
+
+static PyObject *lz_decompress(const uint8_t *data, Py_ssize_t n, int format,
+                               Py_ssize_t min_match, int length_bits)
+{
+    OutBuf out;
+    Py_ssize_t pos = 0;
+    int ok = 1;
+
+    if (!out_init(&out, n * 4))
+        return PyErr_NoMemory();
+
+    Py_BEGIN_ALLOW_THREADS
+    while (ok && pos < n) {
+        uint8_t flags = data[pos++];
+        int bit;
+
+        for (bit = 0; bit < 8; bit++) {
+            Py_ssize_t distance, length, src, i;
+
+            if (pos >= n)
+                break;
+
+            if (flags & (1 << bit)) {
+                if (!(ok = out_reserve(&out, 1)))
+                    break;
+                out.buf[out.len++] = data[pos++];
+                continue;
+            }
+
+            if (pos + 2 > n)
+                break;
+
+            if (format == FORMAT_KOSINSKI) {
+                distance = data[pos] | ((Py_ssize_t)(data[pos + 1] >> 4) << 8);
+                length = (data[pos + 1] & 0x0F) + min_match;
+            } else {
+                uint32_t ref = ((uint32_t)data[pos] << 8) | data[pos + 1];
+                distance = (Py_ssize_t)(ref >> length_bits) + 1;
+                length = (Py_ssize_t)(ref & ((1u << length_bits) - 1)) + min_match;
+            }
+            pos += 2;
+
+            if (length <= 0)
+                continue;
+            if (!(ok = out_reserve(&out, length)))
+                break;
+
+            src = out.len - distance;
+            for (i = 0; i < length; i++, src++) {
+                if (src >= 0 && src < out.len)
+                    out.buf[out.len++] = out.buf[src];
+                else if (format == FORMAT_KOSINSKI)
+                    out.buf[out.len++] = 0;  /* Invalid reference */
+            }
+        }
+    }
+    Py_END_ALLOW_THREADS
+
+    if (!ok) {
+        free(out.buf);
+        return PyErr_NoMemory();
+    }
+    return out_finish(&out);
+}
+
+static PyObject *py_kosinski_decompress(PyObject *self, PyObject *args)
+{
+    Py_buffer buf;
+    Py_ssize_t min_match;
+    PyObject *result;
+
+    if (!PyArg_ParseTuple(args, "y*n", &buf, &min_match))
+        return NULL;
+    result = lz_decompress((const uint8_t *)buf.buf, buf.len, FORMAT_KOSINSKI,
+                           min_match, 0);
+    PyBuffer_Release(&buf);
+    return result;
+}
+
+static PyObject *py_lzss_decompress(PyObject *self, PyObject *args)
+{
+    Py_buffer buf;
+    Py_ssize_t min_match;
+    int length_bits;
+    PyObject *result;
+
+    if (!PyArg_ParseTuple(args, "y*ni", &buf, &min_match, &length_bits))
+        return NULL;
+    result = lz_decompress((const uint8_t *)buf.buf, buf.len, FORMAT_LZSS,
+                           min_match, length_bits);
+    PyBuffer_Release(&buf);
+    return result;
+}
+
+
+/* ========================================================================= */
+/* RLE                                                                       */
+/* ========================================================================= */
+
+static PyObject *py_rle_compress(PyObject *self, PyObject *args)
+{
+    Py_buffer buf;
+    Py_ssize_t max_run, max_literal, n, pos = 0;
+    const uint8_t *data;
+    OutBuf out;
+
+    if (!PyArg_ParseTuple(args, "y*nn", &buf, &max_run, &max_literal))
+        return NULL;
+
+    data = (const uint8_t *)buf.buf;
+    n = buf.len;
+    /* Worst case: one control byte per input byte */
+    if (!out_init(&out, 2 * n + 16)) {
+        PyBuffer_Release(&buf);
+        return PyErr_NoMemory();
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    while (pos < n) {
+        uint8_t run_byte = data[pos];
+        Py_ssize_t run_len = 1;
+
+        while (pos + run_len < n && run_len < max_run &&
+               data[pos + run_len] == run_byte)
+            run_len++;
+
+        if (run_len >= 2) {
+            out.buf[out.len++] = (uint8_t)(0x80 + run_len - 2);
+            out.buf[out.len++] = run_byte;
+            pos += run_len;
+        } else {
+            Py_ssize_t lit_len = 0;
+
+            while (pos + lit_len < n && lit_len < max_literal) {
+                Py_ssize_t next_pos = pos + lit_len;
+                if (next_pos + 1 < n) {
+                    Py_ssize_t next_run = 1;
+                    while (next_pos + next_run < n && next_run < max_run &&
+                           data[next_pos + next_run] == data[next_pos])
+                        next_run++;
+                    if (next_run >= 3)
+                        break;
+                }
+                lit_len++;
+            }
+
+            if (lit_len > 0) {
+                out.buf[out.len++] = (uint8_t)(lit_len - 1);
+                memcpy(out.buf + out.len, data + pos, (size_t)lit_len);
+                out.len += lit_len;
+                pos += lit_len;
+            }
+        }
+    }
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&buf);
+    return out_finish(&out);
+}
+
+static PyObject *py_rle_decompress(PyObject *self, PyObject *args)
+{
+    Py_buffer buf;
+    Py_ssize_t n, pos = 0;
+    const uint8_t *data;
+    OutBuf out;
+    int ok = 1;
+
+    if (!PyArg_ParseTuple(args, "y*", &buf))
+        return NULL;
+
+    data = (const uint8_t *)buf.buf;
+    n = buf.len;
+    if (!out_init(&out, n * 4)) {
+        PyBuffer_Release(&buf);
+        return PyErr_NoMemory();
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    while (pos < n) {
+        uint8_t ctrl = data[pos++];
+        Py_ssize_t count;
+
+        if (ctrl & 0x80) {
+            if (pos >= n)
+                break;
+            count = (ctrl & 0x7F) + 2;
+            if (!(ok = out_reserve(&out, count)))
+                break;
+            memset(out.buf + out.len, data[pos], (size_t)count);
+            out.len += count;
+            pos++;
+        } else {
+            count = ctrl + 1;
+            if (pos + count > n)
+                count = n - pos;
+            if (!(ok = out_reserve(&out, count)))
+                break;
+            memcpy(out.buf + out.len, data + pos, (size_t)count);
+            out.len += count;
+            pos += count;
+        }
+    }
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&buf);
+    if (!ok) {
+        free(out.buf);
+        return PyErr_NoMemory();
+    }
+    return out_finish(&out);
+}
+
+
+/* ========================================================================= */
+/* Module                                                                    */
+/* ========================================================================= */
+
+static PyMethodDef native_methods[] = {
+    {"kosinski_compress", py_kosinski_compress, METH_VARARGS,
+     "kosinski_compress(data, window_size, min_match, max_match, level) -> bytes"},
+    {"kosinski_decompress", py_kosinski_decompress, METH_VARARGS,
+     "kosinski_decompress(data, min_match) -> bytes"},
+    {"lzss_compress", py_lzss_compress, METH_VARARGS,
+     "lzss_compress(data, window_size, min_match, max_match, level, length_bits) -> bytes"},
+    {"lzss_decompress", py_lzss_decompress, METH_VARARGS,
+     "lzss_decompress(data, min_match, length_bits) -> bytes"},
+    {"rle_compress", py_rle_compress, METH_VARARGS,
+     "rle_compress(data, max_run, max_literal) -> bytes"},
+    {"rle_decompress", py_rle_decompress, METH_VARARGS,
+     "rle_decompress(data) -> bytes"},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef native_module = {
+    PyModuleDef_HEAD_INIT,
+    "_native",
+    "Native Genesis compression kernels (optional accelerator).",
+    -1,
+    native_methods
+};
+
+PyMODINIT_FUNC PyInit__native(void)
+{
+    return PyModule_Create(&native_module);
+}
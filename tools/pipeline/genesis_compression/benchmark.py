@@ -0,0 +1,231 @@
+"""
+Genesis Compression Benchmark.
+
+Measures compression ratio and throughput (MB/s) of each codec on real tile
+banks, so match-finder and codec changes can be compared on the data the
+build actually compresses.
+
+Inputs may be raw tile data (.bin, VRAM dumps) or images. Images are packed to
+Genesis 4bpp tiles first: indexed PNGs use their palette indices directly,
+anything else is quantized to 16 colors.
+
+Usage:
+    python -m pipeline.genesis_compression.benchmark res/tiles/*.bin
+    python -m pipeline.genesis_compression.benchmark level.png --repeat 5
+    python -m pipeline.genesis_compression.benchmark vram.bin --format kosinski
+    python -m pipeline.genesis_compression.benchmark vram.bin --level optimal
+"""
+
+import argparse
+import sys
+import time
+from dataclasses import dataclass
+from pathlib import Path
+from typing import List, Optional, Sequence, Union
+
+from .genesis_compress import CompressionFormat, CompressionLevel, GenesisCompressor
+
+
+IMAGE_EXTENSIONS = {'.png', '.gif', '.bmp'}
+
+BENCHMARK_FORMATS = [
+    CompressionFormat.KOSINSKI,
+    CompressionFormat.LZSS,
+    CompressionFormat.RLE,
+]
+
+
+@dataclass
+class BenchmarkResult:
+    """Timing and size for one codec on one input."""
+    name: str
+    format: CompressionFormat
+    input_size: int
+    output_size: int
+    compress_seconds: float     # Best of `repeat` runs
+    decompress_seconds: float   # Best of `repeat` runs
+    roundtrip_ok: bool
+
+    @property
+    def ratio(self) -> float:
+        """Output/input size (lower = better)."""
+        return self.output_size / self.input_size if self.input_size else 1.0
+
+    @property
+    def compress_mbps(self) -> float:
+        """Compression throughput in MB/s of input."""
+        return _mbps(self.input_size, self.compress_seconds)
+
+    @property
+    def decompress_mbps(self) -> float:
+        """Decompression throughput in MB/s of output."""
+        return _mbps(self.input_size, self.decompress_seconds)
+
+
+def _mbps(size: int, seconds: float) -> float:
+    if seconds <= 0:
+        return float('inf')
+    return size / seconds / (1024 * 1024)
+
+
+def load_tile_bank(path: Union[str, Path]) -> bytes:
+    """
+    Load a tile bank as Genesis 4bpp bytes.
+
+    Args:
+        path: Raw binary file or image
+
+    Returns:
+        Tile data (32 bytes per 8x8 tile for images, file bytes otherwise)
+    """
+    path = Path(path)
+    if path.suffix.lower() not in IMAGE_EXTENSIONS:
+        return path.read_bytes()
+
+    from PIL import Image
+
+    img = Image.open(path)
+    if img.mode != 'P':
+        img = img.convert('RGB').quantize(colors=16)
+
+    width = (img.width + 7) // 8 * 8
+    height = (img.height + 7) // 8 * 8
+    pixels = img.load()
+
+    def px(x: int, y: int) -> int:
+        if x < img.width and y < img.height:
+            return pixels[x, y] & 0x0F
+        return 0
+
+    tile_data = bytearray()
+    for ty in range(0, height, 8):
+        for tx in range(0, width, 8):
+            for y in range(ty, ty + 8):
+                for x in range(tx, tx + 8, 2):
+                    tile_data.append((px(x, y) << 4) | px(x + 1, y))
+
+    return bytes(tile_data)
+
+
+def benchmark_data(data: bytes,
+                   name: str = "data",
+                   formats: Sequence[CompressionFormat] = BENCHMARK_FORMATS,
+                   repeat: int = 3,
+                   compressor: Optional[GenesisCompressor] = None
+                   ) -> List[BenchmarkResult]:
+    """
+    Benchmark each codec on a buffer.
+
+    Args:
+        data: Uncompressed input
+        name: Label for the report
+        formats: Codecs to run
+        repeat: Runs per codec; the fastest is reported
+        compressor: Compressor instance (default: new GenesisCompressor)
+
+    Returns:
+        One BenchmarkResult per format
+    """
+    compressor = compressor or GenesisCompressor()
+    results = []
+
+    for fmt in formats:
+        best_compress = float('inf')
+        best_decompress = float('inf')
+        result = None
+        restored = b''
+
+        for _ in range(max(1, repeat)):
+            start = time.perf_counter()
+            result = compressor.compress(data, fmt)
+            best_compress = min(best_compress, time.perf_counter() - start)
+
+            start = time.perf_counter()
+            restored = compressor.decompress(result.data, result.format)
+            best_decompress = min(best_decompress, time.perf_counter() - start)
+
+        results.append(BenchmarkResult(
+            name=name,
+            format=fmt,
+            input_size=len(data),
+            output_size=result.output_size,
+            compress_seconds=best_compress,
+            decompress_seconds=best_decompress,
+            roundtrip_ok=result.success and restored == data,
+        ))
+
+    return results
+
+
+def format_report(results: Sequence[BenchmarkResult]) -> str:
+    """Format benchmark results as a text table."""
+    lines = [
+        f"{'input':<28} {'format':<9} {'size':>8} {'packed':>8} {'ratio':>7} "
+        f"{'comp MB/s':>10} {'decomp MB/s':>12}",
+        "-" * 88,
+    ]
+
+    for r in results:
+        status = "" if r.roundtrip_ok else "  ROUNDTRIP FAILED"
+        lines.append(
+            f"{r.name[-28:]:<28} {r.format.value:<9} {r.input_size:>8} "
+            f"{r.output_size:>8} {r.ratio:>7.1%} {r.compress_mbps:>10.3f} "
+            f"{r.decompress_mbps:>12.3f}{status}"
+        )
+
+    # Aggregate throughput per codec across all inputs
+    lines.append("-" * 88)
+    for fmt in dict.fromkeys(r.format for r in results):
+        rows = [r for r in results if r.format == fmt]
+        total_in = sum(r.input_size for r in rows)
+        total_out = sum(r.output_size for r in rows)
+        comp = sum(r.compress_seconds for r in rows)
+        decomp = sum(r.decompress_seconds for r in rows)
+        ratio = total_out / total_in if total_in else 1.0
+        lines.append(
+            f"{'TOTAL':<28} {fmt.value:<9} {total_in:>8} {total_out:>8} "
+            f"{ratio:>7.1%} {_mbps(total_in, comp):>10.3f} "
+            f"{_mbps(total_in, decomp):>12.3f}"
+        )
+
+    return "\n".join(lines)
+
+
+def main(argv: Optional[Sequence[str]] = None) -> int:
+    parser = argparse.ArgumentParser(
+        description="Benchmark Genesis compression codecs on tile banks")
+    parser.add_argument('inputs', nargs='+',
+                        help="Tile banks (.bin) or images (.png)")
+    parser.add_argument('--format', '-f', action='append',
+                        choices=[f.value for f in BENCHMARK_FORMATS],
+                        help="Codec to benchmark (repeatable, default: all)")
+    parser.add_argument('--repeat', '-r', type=int, default=3,
+                        help="Runs per codec; fastest is reported (default: 3)")
+    parser.add_argument('--level', '-l', default=CompressionLevel.GREEDY.value,
+                        choices=[l.value for l in CompressionLevel],
+                        help="LZ parse strategy (default: greedy)")
+    args = parser.parse_args(argv)
+
+    formats = ([CompressionFormat(f) for f in args.format]
+               if args.format else BENCHMARK_FORMATS)
+
+    compressor = GenesisCompressor(level=CompressionLevel(args.level))
+    results = []
+    for path in args.inputs:
+        data = load_tile_bank(path)
+        if not data:
+            print(f"[WARN] Skipping empty input: {path}")
+            continue
+        results.extend(benchmark_data(data, Path(path).name, formats,
+                                      args.repeat, compressor))
+
+    if not results:
+        print("[ERROR] No input data")
+        return 1
+
+    print(format_report(results))
+    return 0 if all(r.roundtrip_ok for r in results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,63 @@
+"""
+Build the optional native compression kernels in place.
+
+Compiles _native.c into pipeline/genesis_compression/_native.*.so (or .pyd on
+Windows). GenesisCompressor uses it automatically once built and falls back
+to the pure Python codecs when it is missing. Requires a C compiler and the
+Python development headers.
+
+Usage:
+    python -m pipeline.genesis_compression.build_native
+"""
+
+import sys
+import tempfile
+from pathlib import Path
+
+
+PACKAGE_DIR = Path(__file__).resolve().parent
+TOOLS_DIR = PACKAGE_DIR.parent.parent
+
+
+def build(verbose: bool = False) -> bool:
+    """
+    Compile the native extension next to this module.
+
+    Args:
+        verbose: Show compiler output
+
+    Returns:
+        True if the build succeeded
+    """
+    from setuptools import Extension, setup
+
+    extra_args = [] if sys.platform == 'win32' else ['-O3']
+    extension = Extension(
+        'pipeline.genesis_compression._native',
+        sources=[str(PACKAGE_DIR / '_native.c')],
+        extra_compile_args=extra_args,
+    )
+
+    with tempfile.TemporaryDirectory(prefix='ardk_native_') as build_temp:
+        try:
+            setup(
+                name='ardk-genesis-compression-native',
+                ext_modules=[extension],
+                script_args=[
+                    'build_ext',
+                    '--build-lib', str(TOOLS_DIR),
+                    '--build-temp', build_temp,
+                ] + ([] if verbose else ['--quiet']),
+            )
+        except (SystemExit, Exception) as e:
+            print(f"[ERROR] Native build failed: {e}")
+            return False
+
+    return True
+
+
+if __name__ == "__main__":
+    ok = build(verbose='-v' in sys.argv)
+    if ok:
+        print(f"[OK] Built native compression kernels in {PACKAGE_DIR}")
+    sys.exit(0 if ok else 1)
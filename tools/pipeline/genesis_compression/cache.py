@@ -0,0 +1,111 @@
+"""
+Content-addressed compression cache.
+
+Stores compressed output on disk keyed by a hash of the input bytes plus the
+codec parameters, so rebuilding an asset tree only re-compresses tile banks
+that actually changed.
+
+Cache structure:
+    .ardk_cache/compression/
+      {key[:2]}/
+        {key}.bin         # Compressed bytes for one (input, codec) pair
+
+Entries are written atomically (temp file + rename), so several build
+processes can share one cache directory.
+
+Usage:
+    >>> from pipeline.genesis_compression import CompressionCache, GenesisCompressor
+    >>> compressor = GenesisCompressor(cache=CompressionCache())
+    >>> results = compressor.compare_formats(tile_data)   # cold: compresses
+    >>> results = compressor.compare_formats(tile_data)   # warm: disk reads only
+"""
+
+import hashlib
+import os
+from pathlib import Path
+from typing import Dict, Optional, Union
+
+
+# Bump when any codec's bitstream or parse output changes
+CACHE_VERSION = 1
+
+DEFAULT_CACHE_DIR = ".ardk_cache/compression"
+
+
+class CompressionCache:
+    """On-disk cache of compressed buffers keyed by content and parameters."""
+
+    def __init__(self, cache_dir: Union[str, Path] = DEFAULT_CACHE_DIR):
+        """
+        Args:
+            cache_dir: Directory for cache entries (created if missing)
+        """
+        self.cache_dir = Path(cache_dir)
+        self.cache_dir.mkdir(parents=True, exist_ok=True)
+        self.hits = 0
+        self.misses = 0
+
+    @staticmethod
+    def content_hash(data: bytes) -> str:
+        """Hash of the uncompressed input (computed once per buffer)."""
+        return hashlib.sha256(data).hexdigest()
+
+    @staticmethod
+    def make_key(content_hash: str, params: str) -> str:
+        """
+        Cache key for one input under one codec configuration.
+
+        Args:
+            content_hash: Result of content_hash() for the input
+            params: Codec description, e.g. "kosinski:w4095:m3-18:greedy"
+        """
+        tag = f"{content_hash}|{params}|v{CACHE_VERSION}"
+        return hashlib.sha256(tag.encode()).hexdigest()
+
+    def _path(self, key: str) -> Path:
+        return self.cache_dir / key[:2] / f"{key}.bin"
+
+    def get(self, key: str) -> Optional[bytes]:
+        """Return cached compressed bytes, or None on a miss."""
+        try:
+            data = self._path(key).read_bytes()
+        except OSError:
+            self.misses += 1
+            return None
+        self.hits += 1
+        return data
+
+    def put(self, key: str, compressed: bytes) -> None:
+        """Store compressed bytes; failures only cost a future miss."""
+        path = self._path(key)
+        tmp_path = path.with_name(f"{path.name}.{os.getpid()}.tmp")
+        try:
+            path.parent.mkdir(exist_ok=True)
+            tmp_path.write_bytes(compressed)
+            os.replace(tmp_path, path)
+        except OSError as e:
+            print(f"[WARN] Could not write compression cache entry: {e}")
+            try:
+                tmp_path.unlink()
+            except OSError:
+                pass
+
+    def clear(self) -> int:
+        """
+        Delete all cache entries.
+
+        Returns:
+            Number of entries removed
+        """
+        removed = 0
+        for entry in self.cache_dir.glob("*/*.bin"):
+            try:
+                entry.unlink()
+                removed += 1
+            except OSError:
+                pass
+        return removed
+
+    def stats(self) -> Dict[str, int]:
+        """Hit/miss counters for this instance."""
+        return {"hits": self.hits, "misses": self.misses}
@@ -19,7 +19,31 @@ Kosinski Format Reference:
     - Inline (2 bytes): %LLLLLLLL %HHHHHHHH where L=low offset, H=high offset+length
     - Extended (3 bytes): %00000000 %OOOOOOOO %LLLLLLLL for longer matches
 
+Compression Levels:
+    Kosinski and LZSS accept a CompressionLevel: GREEDY (default, longest
+    match at each position), LAZY (one-byte lookahead) or OPTIMAL (a
+    dynamic-programming parse minimising output size). All levels emit the
+    same bitstream, so the decompressors and SGDK headers are unchanged.
+
 Performance Notes:
+    Both LZ codecs share HashChainMatchFinder, which indexes every position
+    by its 3-byte prefix and extends candidates with bytes.find instead of
+    scanning the window in Python. The parse is identical to a brute-force
+    window scan.
+
+    An optional C extension (_native.c) implements the same parse and
+    bitstreams with identical output. Build it with
+    `python -m pipeline.genesis_compression.build_native`; the compressors
+    use it automatically when present and fall back to Python otherwise.
+    On tile banks it compresses ~60x and decompresses ~100x faster.
+
+    compare_formats() and compare_formats_batch() compress large cache
+    misses in a process pool that each GenesisCompressor starts on first
+    use and keeps until close() (or interpreter exit). The workers are
+    spawned, not forked, so they re-import the calling script: scripts
+    that use a compressor with workers > 1 must keep their top-level code
+    under an `if __name__ == '__main__':` guard.
+
     Pure Python is slower than native tools but provides:
     - No external dependencies
     - Cross-platform compatibility
@@ -36,11 +60,28 @@ Example:
     >>> assert original == tile_data
 """
 
+from bisect import bisect_left
+from concurrent.futures import ProcessPoolExecutor
+from concurrent.futures.process import BrokenProcessPool
+from multiprocessing import get_context
 from dataclasses import dataclass
 from enum import Enum
 from pathlib import Path
-from typing import Optional, List, Tuple, Union
+from typing import Optional, List, Dict, Sequence, Tuple, Union
+import os
 import struct
+import threading
+import weakref
+
+from .cache import CompressionCache
+
+# Try to import the compiled kernels (see build_native.py)
+try:
+    from . import _native
+    NATIVE_AVAILABLE = True
+except ImportError:
+    _native = None
+    NATIVE_AVAILABLE = False
 
 
 # =============================================================================
@@ -55,6 +96,27 @@ class CompressionFormat(Enum):
     NONE = "none"           # Uncompressed
 
 
+class CompressionLevel(Enum):
+    """
+    Parse strategy for the LZ compressors (Kosinski, LZSS).
+
+    All levels produce the same bitstream format; only the choice of
+    literals and back-references differs, so existing decompressors are
+    unaffected.
+    """
+    GREEDY = "greedy"       # Longest match at every position (fastest)
+    LAZY = "lazy"           # Defer a match when the next byte starts a longer one
+    OPTIMAL = "optimal"     # Dynamic-programming parse, smallest output
+
+
+# Level codes understood by the native kernels
+_NATIVE_LEVELS = {
+    CompressionLevel.GREEDY: 0,
+    CompressionLevel.LAZY: 1,
+    CompressionLevel.OPTIMAL: 2,
+}
+
+
 @dataclass
 class CompressionResult:
     """Result of compression operation."""
@@ -79,6 +141,220 @@ class CompressionResult:
         return self.input_size - self.output_size
 
 
+# =============================================================================
+# Match Finder (shared by the LZ compressors)
+# =============================================================================
+
+class HashChainMatchFinder:
+    """
+    Indexed longest-match search over a sliding window.
+
+    Every position is filed under its first `prefix_len` bytes, with each
+    chain kept in ascending position order. A lookup bisects the chain to the
+    start of the window to get the earliest candidate, then extends it with
+    bytes.find, so the window is never scanned byte-by-byte in Python.
+
+    Results are identical to a brute-force scan of the window: the longest
+    match wins and ties go to the earliest (most distant) offset. Matches
+    shorter than `prefix_len` are not reported; callers set `prefix_len` to
+    at most their minimum match length so this never changes the parse.
+
+    Attributes:
+        window_size: Maximum distance back from the current position
+        max_match: Longest match length to report
+        prefix_len: Bytes used as the chain key (1-3)
+    """
+
+    def __init__(self,
+                 data: bytes,
+                 window_size: int,
+                 max_match: int,
+                 prefix_len: int = 3):
+        self.data = bytes(data)
+        self.window_size = window_size
+        self.max_match = max_match
+        self.prefix_len = max(1, min(3, prefix_len, max_match))
+        self._chains: Dict[bytes, List[int]] = {}
+        self._indexed = 0  # Next position to insert into the chains
+
+    def _index_to(self, pos: int) -> None:
+        """Insert every position before `pos` into the chains."""
+        data = self.data
+        k = self.prefix_len
+        chains = self._chains
+        data_len = len(data)
+
+        for p in range(self._indexed, pos):
+            if p + k > data_len:
+                break
+            key = data[p:p + k]
+            chain = chains.get(key)
+            if chain is None:
+                chains[key] = [p]
+            else:
+                chain.append(p)
+
+        self._indexed = max(self._indexed, pos)
+
+    def find(self, pos: int) -> Tuple[int, int]:
+        """
+        Find the best match for the bytes starting at `pos`.
+
+        Positions must be queried in non-decreasing order; everything before
+        `pos` is indexed lazily, including positions skipped over by a match.
+
+        Returns:
+            (offset, length) - absolute offset of the match and its length,
+            or (0, 0) if no match of at least `prefix_len` bytes exists.
+        """
+        data = self.data
+        k = self.prefix_len
+        max_len = min(self.max_match, len(data) - pos)
+        window_start = pos - self.window_size
+
+        self._index_to(pos)
+
+        if max_len < k:
+            return 0, 0
+
+        chain = self._chains.get(data[pos:pos + k])
+        if not chain:
+            return 0, 0
+        i = bisect_left(chain, window_start)
+        if i == len(chain):
+            return 0, 0
+
+        # Earliest prefix hit in the window, then extend: the earliest
+        # occurrence of a longer prefix can only lie at or after this one,
+        # and bytes.find locates it without a Python-level scan. A match may
+        # run into the lookahead, so the search end is pos + length.
+        target = data[pos:pos + max_len]
+        offset = chain[i]
+        length = k
+        while True:
+            while length < max_len and data[offset + length] == data[pos + length]:
+                length += 1
+            if length == max_len:
+                break
+            longer = data.find(target[:length + 1], offset + 1, pos + length)
+            if longer < 0:
+                break
+            offset = longer
+            length += 1
+
+        return offset, length
+
+
+# Token costs in bits for the flag-byte formats: one flag bit plus an 8-bit
+# literal or a 16-bit back-reference
+_LITERAL_BITS = 9
+_MATCH_BITS = 17
+
+
+def lz_parse(data: bytes,
+             window_size: int,
+             min_match: int,
+             max_match: int,
+             level: CompressionLevel = CompressionLevel.GREEDY
+             ) -> List[Tuple[int, int]]:
+    """
+    Split data into literals and back-references.
+
+    Args:
+        data: Uncompressed input bytes
+        window_size: Maximum back-reference distance
+        min_match: Shortest match worth encoding as a reference
+        max_match: Longest encodable match
+        level: Parse strategy
+
+    Returns:
+        (offset, length) tokens in stream order. A length of 0 is a literal
+        of the byte at the current position; otherwise `offset` is the
+        absolute source position of a `length`-byte match.
+    """
+    finder = HashChainMatchFinder(data, window_size, max_match, min_match)
+    data_len = len(data)
+
+    if level == CompressionLevel.OPTIMAL:
+        return _optimal_parse(finder, data_len, min_match)
+
+    tokens = []
+    pos = 0
+    lookahead = None
+
+    while pos < data_len:
+        if lookahead is not None:
+            match_offset, match_len = lookahead
+            lookahead = None
+        else:
+            match_offset, match_len = finder.find(pos)
+
+        if match_len < min_match:
+            tokens.append((0, 0))
+            pos += 1
+            continue
+
+        # Lazy: emit a literal instead if the next position matches at least
+        # two bytes further, enough to pay for the extra literal
+        if (level == CompressionLevel.LAZY and
+                match_len < max_match - 1 and pos + 1 < data_len):
+            lookahead = finder.find(pos + 1)
+            if lookahead[1] > match_len + 1:
+                tokens.append((0, 0))
+                pos += 1
+                continue
+            lookahead = None
+
+        tokens.append((match_offset, match_len))
+        pos += match_len
+
+    return tokens
+
+
+def _optimal_parse(finder: HashChainMatchFinder,
+                   data_len: int,
+                   min_match: int) -> List[Tuple[int, int]]:
+    """
+    Minimum-cost parse by dynamic programming over positions.
+
+    References cost the same regardless of distance, so the longest match at
+    each position covers every shorter length too. cost[pos] is the cheapest
+    encoding of data[pos:] in bits; the result is optimal up to the padding
+    of the final flag byte.
+    """
+    offsets = [0] * data_len
+    longest = [0] * data_len
+    for pos in range(data_len):
+        offsets[pos], longest[pos] = finder.find(pos)
+
+    cost = [0] * (data_len + 1)
+    choice = [0] * data_len
+
+    for pos in range(data_len - 1, -1, -1):
+        best = cost[pos + 1] + _LITERAL_BITS
+        best_len = 0
+        for length in range(min_match, longest[pos] + 1):
+            c = cost[pos + length] + _MATCH_BITS
+            if c <= best:  # Prefer longer matches on ties
+                best = c
+                best_len = length
+        cost[pos] = best
+        choice[pos] = best_len
+
+    tokens = []
+    pos = 0
+    while pos < data_len:
+        length = choice[pos]
+        if length:
+            tokens.append((offsets[pos], length))
+            pos += length
+        else:
+            tokens.append((0, 0))
+            pos += 1
+
+    return tokens
+
+
 # =============================================================================
 # Kosinski-style Compression (simplified LZSS variant)
 # =============================================================================
@@ -102,15 +378,28 @@ class KosinskiCompressor:
         window_size: Sliding window size for back-references (default 4096)
         min_match: Minimum match length to encode as reference (default 3)
         max_match: Maximum match length (default 18)
+        level: Parse strategy (default greedy; see CompressionLevel)
+        use_native: Use the C kernels when built (default True)
     """
 
     def __init__(self,
                  window_size: int = 4096,
                  min_match: int = 3,
-                 max_match: int = 18):
+                 max_match: int = 18,
+                 level: CompressionLevel = CompressionLevel.GREEDY,
+                 use_native: bool = True):
         self.window_size = window_size
         self.min_match = min_match
         self.max_match = max_match
+        self.level = CompressionLevel(level)
+        self._native = (use_native and NATIVE_AVAILABLE and
+                        1 <= min_match <= max_match)
+
+    @property
+    def params(self) -> str:
+        """Parameters that determine the output (for cache keys)."""
+        return (f"kosinski:w{self.window_size}:m{self.min_match}-{self.max_match}"
+                f":{self.level.value}")
 
     def compress(self, data: bytes) -> bytes:
         """
@@ -125,34 +414,44 @@ class KosinskiCompressor:
         if not data:
             return b'\xFF'  # All literals flag, but no data
 
+        if self._native:
+            return _native.kosinski_compress(
+                data, min(self.window_size, 0xFFF), self.min_match,
+                self.max_match, _NATIVE_LEVELS[self.level])
+
+        # Distance is stored in 12 bits, so 4095 is the furthest reachable byte
+        tokens = lz_parse(data,
+                          min(self.window_size, 0xFFF),
+                          self.min_match,
+                          self.max_match,
+                          self.level)
+
         output = bytearray()
         pos = 0
-        data_len = len(data)
 
-        while pos < data_len:
+        for start in range(0, len(tokens), 8):
             # Build a chunk of up to 8 operations
             flags = 0
             chunk = bytearray()
 
             for bit in range(8):
-                if pos >= data_len:
+                if start + bit >= len(tokens):
                     # Pad remaining bits as literals (but no data)
                     flags |= (1 << bit)
                     continue
 
-                # Try to find a match
-                match_offset, match_len = self._find_best_match(data, pos)
+                match_offset, match_len = tokens[start + bit]
 
-                if match_len >= self.min_match:
+                if match_len:
                     # Encode back-reference (flag bit = 0)
                     distance = pos - match_offset
-                    length_code = min(match_len, self.max_match) - self.min_match
+                    length_code = match_len - self.min_match
 
                     # Pack: [offset_low], [(offset_high << 4) | length]
                     chunk.append(distance & 0xFF)
                     chunk.append(((distance >> 8) << 4) | (length_code & 0x0F))
 
-                    pos += min(match_len, self.max_match)
+                    pos += match_len
                 else:
                     # Encode literal (flag bit = 1)
                     flags |= (1 << bit)
@@ -164,28 +463,6 @@ class KosinskiCompressor:
 
         return bytes(output)
 
-    def _find_best_match(self, data: bytes, pos: int) -> Tuple[int, int]:
-        """Find the best matching substring in the sliding window."""
-        best_offset = 0
-        best_length = 0
-
-        # Window starts at max(0, pos - window_size)
-        window_start = max(0, pos - self.window_size)
-        data_len = len(data)
-
-        for offset in range(window_start, pos):
-            length = 0
-            max_len = min(self.max_match, data_len - pos)
-
-            while length < max_len and data[offset + length] == data[pos + length]:
-                length += 1
-
-            if length > best_length:
-                best_length = length
-                best_offset = offset
-
-        return best_offset, best_length
-
     def decompress(self, data: bytes) -> bytes:
         """
         Decompress Kosinski-style LZSS data.
@@ -199,6 +476,9 @@ class KosinskiCompressor:
         if not data:
             return b''
 
+        if self._native:
+            return _native.kosinski_decompress(data, self.min_match)
+
         output = bytearray()
         pos = 0
         data_len = len(data)
@@ -258,35 +538,53 @@ class LZSSCompressor:
         window_bits: Bits for window offset (default 12 = 4096 bytes)
         length_bits: Bits for match length (default 4 = max 17)
         min_match: Minimum match length (default 3)
+        level: Parse strategy (default greedy; see CompressionLevel)
+        use_native: Use the C kernels when built (default True)
     """
 
     def __init__(self,
                  window_bits: int = 12,
                  length_bits: int = 4,
-                 min_match: int = 3):
+                 min_match: int = 3,
+                 level: CompressionLevel = CompressionLevel.GREEDY,
+                 use_native: bool = True):
         self.window_bits = window_bits
         self.length_bits = length_bits
         self.window_size = 1 << window_bits
         self.max_match = (1 << length_bits) + min_match - 1
         self.min_match = min_match
+        self.level = CompressionLevel(level)
+        # References must fit the 16-bit word the Python encoder packs
+        self._native = (use_native and NATIVE_AVAILABLE and min_match >= 1 and
+                        window_bits + length_bits <= 16)
+
+    @property
+    def params(self) -> str:
+        """Parameters that determine the output (for cache keys)."""
+        return (f"lzss:w{self.window_bits}:l{self.length_bits}:m{self.min_match}"
+                f":{self.level.value}")
 
     def compress(self, data: bytes) -> bytes:
         """Compress data using LZSS algorithm."""
         if not data:
             return b'\x00'
 
+        if self._native:
+            return _native.lzss_compress(
+                data, self.window_size, self.min_match, self.max_match,
+                _NATIVE_LEVELS[self.level], self.length_bits)
+
         output = bytearray()
         flags = 0
         flag_bit = 0
         buffer = bytearray()
 
         pos = 0
-        data_len = len(data)
-
-        while pos < data_len:
-            match_offset, match_len = self._find_match(data, pos)
+        tokens = lz_parse(data, self.window_size, self.min_match,
+                          self.max_match, self.level)
 
-            if match_len >= self.min_match:
+        for match_offset, match_len in tokens:
+            if match_len:
                 # Encode back-reference (flag bit = 0)
                 rel_offset = pos - match_offset - 1
                 length_code = match_len - self.min_match
@@ -319,32 +617,14 @@ class LZSSCompressor:
 
         return bytes(output)
 
-    def _find_match(self, data: bytes, pos: int) -> Tuple[int, int]:
-        """Find best match in sliding window."""
-        best_offset = 0
-        best_length = 0
-
-        window_start = max(0, pos - self.window_size)
-        data_len = len(data)
-
-        for offset in range(window_start, pos):
-            length = 0
-            max_len = min(self.max_match, data_len - pos)
-
-            while length < max_len and data[offset + length] == data[pos + length]:
-                length += 1
-
-            if length > best_length:
-                best_length = length
-                best_offset = offset
-
-        return best_offset, best_length
-
     def decompress(self, data: bytes) -> bytes:
         """Decompress LZSS-compressed data."""
         if not data:
             return b''
 
+        if self._native:
+            return _native.lzss_decompress(data, self.min_match, self.length_bits)
+
         output = bytearray()
         pos = 0
         data_len = len(data)
@@ -396,17 +676,30 @@ class RLECompressor:
     Attributes:
         max_run: Maximum run length (default 129)
         max_literal: Maximum literal sequence (default 128)
+        use_native: Use the C kernels when built (default True)
     """
 
-    def __init__(self, max_run: int = 129, max_literal: int = 128):
+    def __init__(self, max_run: int = 129, max_literal: int = 128,
+                 use_native: bool = True):
         self.max_run = max_run
         self.max_literal = max_literal
+        # Control bytes must fit in 8 bits
+        self._native = (use_native and NATIVE_AVAILABLE and
+                        max_run <= 129 and max_literal <= 128)
+
+    @property
+    def params(self) -> str:
+        """Parameters that determine the output (for cache keys)."""
+        return f"rle:r{self.max_run}:l{self.max_literal}"
 
     def compress(self, data: bytes) -> bytes:
         """Compress data using RLE."""
         if not data:
             return b''
 
+        if self._native:
+            return _native.rle_compress(data, self.max_run, self.max_literal)
+
         output = bytearray()
         pos = 0
         data_len = len(data)
@@ -458,6 +751,9 @@ class RLECompressor:
         if not data:
             return b''
 
+        if self._native:
+            return _native.rle_decompress(data)
+
         output = bytearray()
         pos = 0
         data_len = len(data)
@@ -505,12 +801,69 @@ class GenesisCompressor:
 
         >>> # Decompress
         >>> original = compressor.decompress(result.data, result.format)
+
+        >>> # Smallest output for ROM-bound assets (slower)
+        >>> compressor = GenesisCompressor(level=CompressionLevel.OPTIMAL)
+
+        >>> # Reuse results across builds; compare many banks on all cores
+        >>> compressor = GenesisCompressor(cache=CompressionCache())
+        >>> reports = compressor.compare_formats_batch(tile_banks)
+        >>> compressor.close()  # Stop the worker processes
+
+    The worker pool uses spawned processes, so the calling script needs an
+    `if __name__ == '__main__':` guard (see Performance Notes above).
     """
 
-    def __init__(self):
-        self._kosinski = KosinskiCompressor()
-        self._lzss = LZSSCompressor()
-        self._rle = RLECompressor()
+    def __init__(self,
+                 level: CompressionLevel = CompressionLevel.GREEDY,
+                 use_native: bool = True,
+                 cache: Optional[CompressionCache] = None,
+                 workers: Optional[int] = None):
+        """
+        Args:
+            level: Parse strategy for the Kosinski and LZSS compressors
+            use_native: Use the C kernels when built, else pure Python
+            cache: On-disk cache of compressed output (default: none)
+            workers: Processes for compare_formats on cache misses
+                (default: CPU count, 1 = serial). The pool is started on
+                first use and reused until close().
+        """
+        self.level = CompressionLevel(level)
+        self.use_native = use_native
+        self.cache = cache
+        self.workers = workers or os.cpu_count() or 1
+        self._kosinski = KosinskiCompressor(level=self.level, use_native=use_native)
+        self._lzss = LZSSCompressor(level=self.level, use_native=use_native)
+        self._rle = RLECompressor(use_native=use_native)
+        self._lock = threading.Lock()
+        self._executor: Optional[ProcessPoolExecutor] = None
+        self._shutdown: Optional[weakref.finalize] = None
+
+    def close(self) -> None:
+        """Stop the worker processes; the next parallel call starts new ones."""
+        with self._lock:
+            shutdown, self._shutdown = self._shutdown, None
+            self._executor = None
+        if shutdown:
+            shutdown()
+
+    @property
+    def native(self) -> bool:
+        """True if the compiled kernels are in use."""
+        return self._kosinski._native
+
+    def _codec(self, format: CompressionFormat):
+        """Compressor instance for a format."""
+        if format == CompressionFormat.KOSINSKI:
+            return self._kosinski
+        elif format == CompressionFormat.LZSS:
+            return self._lzss
+        elif format == CompressionFormat.RLE:
+            return self._rle
+        raise ValueError(f"Unknown format: {format}")
+
+    def _cache_key(self, content_hash: str, format: CompressionFormat) -> str:
+        return CompressionCache.make_key(content_hash, self._codec(format).params)
 
     def compress(self,
                  data: Union[bytes, bytearray],
@@ -546,37 +899,19 @@ class GenesisCompressor:
         try:
             if format == CompressionFormat.NONE:
                 compressed = data
-            elif format == CompressionFormat.KOSINSKI:
-                compressed = self._kosinski.compress(data)
-            elif format == CompressionFormat.LZSS:
-                compressed = self._lzss.compress(data)
-            elif format == CompressionFormat.RLE:
-                compressed = self._rle.compress(data)
+            elif self.cache is not None:
+                key = self._cache_key(CompressionCache.content_hash(data), format)
+                compressed = self.cache.get(key)
+                if compressed is None:
+                    compressed = self._codec(format).compress(data)
+                    self.cache.put(key, compressed)
             else:
-                raise ValueError(f"Unknown format: {format}")
-
-            output_size = len(compressed)
-            ratio = output_size / input_size if input_size > 0 else 1.0
+                compressed = self._codec(format).compress(data)
 
-            return CompressionResult(
-                success=True,
-                input_size=input_size,
-                output_size=output_size,
-                ratio=ratio,
-                format=format,
-                data=compressed
-            )
+            return _make_result(data, format, compressed)
 
         except Exception as e:
-            return CompressionResult(
-                success=False,
-                input_size=input_size,
-                output_size=0,
-                ratio=1.0,
-                format=format,
-                data=b'',
-                error=str(e)
-            )
+            return _make_result(data, format, error=str(e))
 
     def decompress(self,
                    data: bytes,
@@ -667,29 +1002,186 @@ class GenesisCompressor:
         """
         Compare all compression formats on the same data.
 
+        Results come from the cache when available; misses are compressed
+        concurrently when the input is large enough to repay process startup.
+
         Args:
             data: Input bytes to test
 
         Returns:
             Dict mapping format name to CompressionResult
         """
-        results = {}
+        return self.compare_formats_batch([data])[0]
+
+    def compare_formats_batch(self, buffers: Sequence[bytes]) -> List[dict]:
+        """
+        Compare all compression formats on many buffers at once.
+
+        Every (buffer, format) cache miss becomes one job for a shared
+        process pool, so cold runs over many tile banks scale with cores.
+
+        Args:
+            buffers: Input buffers to test
+
+        Returns:
+            One compare_formats() dict per buffer, in input order
+        """
+        buffers = [bytes(b) for b in buffers]
+        compressed: Dict[Tuple[int, CompressionFormat], bytes] = {}
+        errors: Dict[Tuple[int, CompressionFormat], str] = {}
+        keys: Dict[Tuple[int, CompressionFormat], str] = {}
+        jobs = []
+
+        for index, data in enumerate(buffers):
+            content_hash = (CompressionCache.content_hash(data)
+                            if self.cache is not None and data else None)
+            for fmt in COMPARE_FORMATS:
+                if content_hash is not None:
+                    key = self._cache_key(content_hash, fmt)
+                    cached = self.cache.get(key)
+                    if cached is not None:
+                        compressed[(index, fmt)] = cached
+                        continue
+                    keys[(index, fmt)] = key
+                jobs.append((index, fmt))
+
+        for job, output, error in self._run_jobs(buffers, jobs):
+            if error is not None:
+                errors[job] = error
+                continue
+            compressed[job] = output
+            if job in keys:
+                self.cache.put(keys[job], output)
+
+        reports = []
+        for index, data in enumerate(buffers):
+            results = {}
+            for fmt in COMPARE_FORMATS:
+                if not data:
+                    results[fmt.value] = self.compress(data, fmt)
+                elif (index, fmt) in errors:
+                    results[fmt.value] = _make_result(
+                        data, fmt, error=errors[(index, fmt)])
+                else:
+                    results[fmt.value] = _make_result(
+                        data, fmt, compressed[(index, fmt)])
+
+            # Sort by ratio (best first)
+            reports.append(dict(sorted(results.items(), key=lambda x: x[1].ratio)))
+
+        return reports
 
-        for fmt in [CompressionFormat.KOSINSKI, CompressionFormat.LZSS, CompressionFormat.RLE]:
-            result = self.compress(data, fmt)
-            results[fmt.value] = result
+    def _run_jobs(self, buffers: List[bytes],
+                  jobs: List[Tuple[int, CompressionFormat]]):
+        """
+        Compress (buffer index, format) jobs, in a process pool if worthwhile.
 
-        # Sort by ratio (best first)
-        return dict(sorted(results.items(), key=lambda x: x[1].ratio))
+        Yields:
+            (job, compressed bytes or None, error message or None)
+        """
+        jobs = [job for job in jobs if buffers[job[0]]]
+        total = sum(len(buffers[index]) for index, _ in jobs)
+        threshold = (PARALLEL_MIN_BYTES_NATIVE if self.native
+                     else PARALLEL_MIN_BYTES)
+
+        if self.workers > 1 and len(jobs) > 1 and total >= threshold:
+            # Largest first so the pool does not idle on one long tail job
+            jobs.sort(key=lambda job: -len(buffers[job[0]]))
+            try:
+                pool = self._workers()
+                futures = [
+                    (job, pool.submit(_compress_job, job[1].value,
+                                      self.level.value, self.use_native,
+                                      buffers[job[0]]))
+                    for job in jobs
+                ]
+                outputs = []
+                for job, future in futures:
+                    try:
+                        outputs.append((job, future.result(), None))
+                    except BrokenProcessPool as e:
+                        # A worker died; the pool is unusable from here on
+                        self.close()
+                        outputs.append((job, None, str(e)))
+                    except Exception as e:
+                        outputs.append((job, None, str(e)))
+                yield from outputs
+                return
+            except OSError as e:
+                # No process support (sandboxes, some embedded interpreters)
+                self.close()
+                print(f"[WARN] Process pool unavailable, compressing serially: {e}")
+
+        for index, fmt in jobs:
+            try:
+                yield (index, fmt), self._codec(fmt).compress(buffers[index]), None
+            except Exception as e:
+                yield (index, fmt), None, str(e)
+
+    def _workers(self) -> ProcessPoolExecutor:
+        """The compressor's process pool, started on first use."""
+        with self._lock:
+            if self._executor is None:
+                # Spawned workers: forking after Numba's TBB pool has started
+                # (colour / dither kernels) hangs the parent at exit
+                self._executor = ProcessPoolExecutor(
+                    max_workers=self.workers, mp_context=get_context('spawn'))
+                # Shut down when the compressor is collected or at exit,
+                # whichever comes first; holds no reference to self
+                self._shutdown = weakref.finalize(self, self._executor.shutdown)
+            return self._executor
+
+
+# Formats compared by compare_formats(), and pool thresholds (total bytes of
+# cache misses) below which process startup costs more than it saves
+COMPARE_FORMATS = [CompressionFormat.KOSINSKI, CompressionFormat.LZSS,
+                   CompressionFormat.RLE]
+PARALLEL_MIN_BYTES = 32 * 1024
+PARALLEL_MIN_BYTES_NATIVE = 4 * 1024 * 1024
+
+
+def _make_result(data: bytes,
+                 format: CompressionFormat,
+                 compressed: bytes = b'',
+                 error: Optional[str] = None) -> CompressionResult:
+    """Build a CompressionResult for compressed output or a failure."""
+    if error is not None:
+        return CompressionResult(
+            success=False,
+            input_size=len(data),
+            output_size=0,
+            ratio=1.0,
+            format=format,
+            data=b'',
+            error=error
+        )
+
+    return CompressionResult(
+        success=True,
+        input_size=len(data),
+        output_size=len(compressed),
+        ratio=len(compressed) / len(data) if data else 1.0,
+        format=format,
+        data=compressed
+    )
+
+
+def _compress_job(format: str, level: str, use_native: bool,
+                  data: bytes) -> bytes:
+    """Process pool worker: compress one buffer with one codec."""
+    compressor = GenesisCompressor(level=CompressionLevel(level),
+                                   use_native=use_native, workers=1)
+    return compressor._codec(CompressionFormat(format)).compress(data)
 
 
 # =============================================================================
 # Convenience Functions
 # =============================================================================
 
-def compress_kosinski(data: bytes) -> bytes:
+def compress_kosinski(data: bytes,
+                      level: CompressionLevel = CompressionLevel.GREEDY) -> bytes:
     """Compress data using Kosinski algorithm."""
-    return KosinskiCompressor().compress(data)
+    return KosinskiCompressor(level=level).compress(data)
 
 
 def decompress_kosinski(data: bytes) -> bytes:
@@ -697,9 +1189,10 @@ def decompress_kosinski(data: bytes) -> bytes:
     return KosinskiCompressor().decompress(data)
 
 
-def compress_lzss(data: bytes) -> bytes:
+def compress_lzss(data: bytes,
+                  level: CompressionLevel = CompressionLevel.GREEDY) -> bytes:
     """Compress data using LZSS algorithm."""
-    return LZSSCompressor().compress(data)
+    return LZSSCompressor(level=level).compress(data)
 
 
 def decompress_lzss(data: bytes) -> bytes:
@@ -717,7 +1210,14 @@ def decompress_rle(data: bytes) -> bytes:
     return RLECompressor().decompress(data)
 
 
-def auto_select_format(data: bytes) -> CompressionFormat:
+def is_native_available() -> bool:
+    """Check if the compiled compression kernels are available."""
+    return NATIVE_AVAILABLE
+
+
+def auto_select_format(data: bytes,
+                       compressor: Optional[GenesisCompressor] = None
+                       ) -> CompressionFormat:
     """
     Analyze data and recommend best compression format.
 
@@ -727,6 +1227,8 @@ def auto_select_format(data: bytes) -> CompressionFormat:
 
     Args:
         data: Input bytes to analyze
+        compressor: If given, measure every codec with it instead (uses its
+            cache and worker pool) and return the smallest
 
     Returns:
         Recommended CompressionFormat
@@ -734,6 +1236,11 @@ def auto_select_format(data: bytes) -> CompressionFormat:
     if len(data) == 0:
         return CompressionFormat.NONE
 
+    if compressor is not None:
+        for result in compressor.compare_formats(data).values():
+            if result.success:
+                return result.format
+
     # Count runs of identical bytes
     runs = 0
     total_run_bytes = 0
@@ -763,6 +1270,133 @@ def auto_select_format(data: bytes) -> CompressionFormat:
     return CompressionFormat.KOSINSKI
 
 
+# =============================================================================
+# Decompression Cost Model
+# =============================================================================
+
+# Approximate 68000 cycles for a straightforward byte-wise decoder loop
+# (move.b (a0)+,(a1)+ plus dbra/branch overhead). Estimates for budgeting
+# streaming work, not cycle-exact timings of a particular routine.
+DECODE_CYCLES = {
+    'call': 80,           # Register setup and return
+    'flag_byte': 24,      # Load a flag byte, reset the bit counter
+    'token': 18,          # Test one flag bit and branch
+    'literal': 22,        # Copy one literal byte
+    'match': 56,          # Decode a 2-byte reference, compute the source
+    'control': 34,        # RLE control byte decode and branch
+    'byte_copy': 22,      # Copy one byte of a match or literal run
+    'byte_fill': 18,      # Store one byte of an RLE run
+    'raw_byte': 5,        # Uncompressed data (move.l loop, 4 bytes per pass)
+}
+
+# 68000 cycles per NTSC scanline (7.67 MHz / 60 Hz / 262 lines)
+CYCLES_PER_SCANLINE = 488
+
+
+@dataclass
+class DecompressionCost:
+    """Estimated work to decompress one buffer on the 68000."""
+    format: CompressionFormat
+    output_size: int
+    literals: int = 0
+    matches: int = 0
+    copied_bytes: int = 0
+    cycles: int = 0
+
+    @property
+    def scanlines(self) -> float:
+        """Cost in NTSC scanlines of CPU time."""
+        return self.cycles / CYCLES_PER_SCANLINE
+
+
+def estimate_decompression_cost(data: bytes,
+                                format: CompressionFormat,
+                                compressor: Optional[GenesisCompressor] = None
+                                ) -> DecompressionCost:
+    """
+    Estimate 68000 cycles to decompress data by walking its token stream.
+
+    Args:
+        data: Compressed bytes (raw bytes for CompressionFormat.NONE)
+        format: Format of data
+        compressor: Supplies codec parameters (default: GenesisCompressor())
+
+    Returns:
+        DecompressionCost with token counts and estimated cycles
+    """
+    c = DECODE_CYCLES
+    compressor = compressor or GenesisCompressor()
+    cost = DecompressionCost(format=format, output_size=0)
+    cycles = c['call']
+    pos = 0
+    data_len = len(data)
+
+    if format == CompressionFormat.NONE:
+        cost.output_size = data_len
+        cost.cycles = cycles + c['raw_byte'] * data_len
+        return cost
+
+    if format in (CompressionFormat.KOSINSKI, CompressionFormat.LZSS):
+        # Both share the flag-byte layout; only the reference packing differs
+        if format == CompressionFormat.KOSINSKI:
+            min_match = compressor._kosinski.min_match
+            length_of = lambda b0, b1: (b1 & 0x0F) + min_match
+        else:
+            min_match = compressor._lzss.min_match
+            mask = (1 << compressor._lzss.length_bits) - 1
+            length_of = lambda b0, b1: (((b0 << 8) | b1) & mask) + min_match
+
+        while pos < data_len:
+            flags = data[pos]
+            pos += 1
+            cycles += c['flag_byte']
+            for bit in range(8):
+                if pos >= data_len:
+                    break
+                cycles += c['token']
+                if flags & (1 << bit):
+                    cost.literals += 1
+                    pos += 1
+                else:
+                    if pos + 2 > data_len:
+                        break
+                    length = length_of(data[pos], data[pos + 1])
+                    pos += 2
+                    cost.matches += 1
+                    cost.copied_bytes += length
+
+        cycles += c['literal'] * cost.literals
+        cycles += c['match'] * cost.matches + c['byte_copy'] * cost.copied_bytes
+        cost.output_size = cost.literals + cost.copied_bytes
+
+    elif format == CompressionFormat.RLE:
+        filled = 0
+        while pos < data_len:
+            ctrl = data[pos]
+            pos += 1
+            cycles += c['control']
+            if ctrl & 0x80:
+                if pos >= data_len:
+                    break
+                filled += (ctrl & 0x7F) + 2
+                cost.matches += 1
+                pos += 1
+            else:
+                count = min(ctrl + 1, data_len - pos)
+                cost.literals += count
+                pos += count
+
+        cycles += c['byte_copy'] * cost.literals + c['byte_fill'] * filled
+        cost.copied_bytes = filled
+        cost.output_size = cost.literals + filled
+
+    else:
+        raise ValueError(f"Unknown format: {format}")
+
+    cost.cycles = cycles
+    return cost
+
+
 # =============================================================================
 # SGDK Integration Helpers
 # =============================================================================
@@ -46,14 +46,23 @@ Phase Implementation:
 """
 
 import os
+from functools import lru_cache
 from typing import List, Optional, Dict, TYPE_CHECKING
 from dataclasses import dataclass
 from datetime import datetime
 
+import numpy as np
+
 if TYPE_CHECKING:
     from PIL import Image
 
 from .platforms import SpriteInfo
+from .optimization.tile_dedup import (
+    FORMAT_LAYOUTS,
+    TileLayout,
+    TileTransform,
+    dedup_tiles,
+)
 
 
 # =============================================================================
@@ -157,6 +166,10 @@ class TileOptimizationStats:
 # TILE FLIP OPERATIONS
 # =============================================================================
 
+# Byte gathers + lookup tables shared with the tile dedup core
+_GENESIS_LAYOUT = FORMAT_LAYOUTS['genesis']
+
+
 def flip_tile_h(tile_bytes: bytes) -> bytes:
     """
     Flip a Genesis 4bpp tile horizontally.
@@ -166,7 +179,7 @@ def flip_tile_h(tile_bytes: bytes) -> bytes:
 
     To flip horizontally:
     1. Reverse byte order within each row
-    2. Swap nibbles within each byte
+    2. Swap nibbles within each byte (lookup table)
 
     Args:
         tile_bytes: 32-byte Genesis tile data
@@ -177,17 +190,7 @@ def flip_tile_h(tile_bytes: bytes) -> bytes:
     if len(tile_bytes) != 32:
         raise ValueError(f"Genesis tile must be 32 bytes, got {len(tile_bytes)}")
 
-    result = bytearray(32)
-
-    for row in range(8):
-        row_start = row * 4
-        for col in range(4):
-            # Get byte from opposite side of row
-            src_byte = tile_bytes[row_start + (3 - col)]
-            # Swap nibbles (pixel order within byte)
-            result[row_start + col] = ((src_byte & 0x0F) << 4) | ((src_byte >> 4) & 0x0F)
-
-    return bytes(result)
+    return _GENESIS_LAYOUT.flip_bytes(tile_bytes, TileTransform.FLIP_H)
 
 
 def flip_tile_v(tile_bytes: bytes) -> bytes:
@@ -205,15 +208,7 @@ def flip_tile_v(tile_bytes: bytes) -> bytes:
     if len(tile_bytes) != 32:
         raise ValueError(f"Genesis tile must be 32 bytes, got {len(tile_bytes)}")
 
-    result = bytearray(32)
-
-    for row in range(8):
-        src_row = 7 - row  # Reverse row order
-        src_start = src_row * 4
-        dst_start = row * 4
-        result[dst_start:dst_start + 4] = tile_bytes[src_start:src_start + 4]
-
-    return bytes(result)
+    return _GENESIS_LAYOUT.flip_bytes(tile_bytes, TileTransform.FLIP_V)
 
 
 def flip_tile_hv(tile_bytes: bytes) -> bytes:
@@ -228,7 +223,10 @@ def flip_tile_hv(tile_bytes: bytes) -> bytes:
     Returns:
         32-byte flipped tile (both axes)
     """
-    return flip_tile_h(flip_tile_v(tile_bytes))
+    if len(tile_bytes) != 32:
+        raise ValueError(f"Genesis tile must be 32 bytes, got {len(tile_bytes)}")
+
+    return _GENESIS_LAYOUT.flip_bytes(tile_bytes, TileTransform.FLIP_HV)
 
 
 # =============================================================================
@@ -331,6 +329,27 @@ def _extract_tile_4bpp(pixels: List[int], width: int,
     return bytes(tile_bytes)
 
 
+def _extract_tiles_4bpp(indexed_img) -> np.ndarray:
+    """
+    Extract every 8x8 tile of a grid-aligned indexed image as Genesis 4bpp.
+
+    Bulk equivalent of _extract_tile_4bpp over all tiles in raster order.
+
+    Args:
+        indexed_img: PIL Image in 'P' mode, size a multiple of 8
+
+    Returns:
+        (N, 32) uint8 array of Genesis tile data
+    """
+    pixels = np.asarray(indexed_img, dtype=np.uint8) & 0x0F
+    height, width = pixels.shape
+
+    # Pack two 4-bit values (high nibble first)
+    packed = (pixels[:, 0::2] << 4) | pixels[:, 1::2]
+    tiles = packed.reshape(height // 8, 8, width // 8, 4).transpose(0, 2, 1, 3)
+    return np.ascontiguousarray(tiles).reshape(-1, 32)
+
+
 def export_collision_header(sprites: List[SpriteInfo], output_path: str,
                            sprite_name: str = "sprite") -> bool:
     """
@@ -926,34 +945,15 @@ def export_genesis_tilemap(indexed_img, output_path: str,
     total_tiles = tiles_x * tiles_y
     result['total_tiles'] = total_tiles
 
-    pixels = list(indexed_img.getdata())
-
     # Extract all tiles
-    all_tiles = []
-    for ty in range(tiles_y):
-        for tx in range(tiles_x):
-            tile_bytes = bytearray()
-            for row in range(8):
-                for col in range(0, 8, 2):
-                    px1 = tx * 8 + col
-                    px2 = tx * 8 + col + 1
-                    py = ty * 8 + row
-                    idx1 = pixels[py * width + px1] & 0x0F
-                    idx2 = pixels[py * width + px2] & 0x0F
-                    tile_bytes.append((idx1 << 4) | idx2)
-            all_tiles.append(bytes(tile_bytes))
+    tile_rows = _extract_tiles_4bpp(indexed_img)
+    all_tiles = [tile.tobytes() for tile in tile_rows]
 
-    # Deduplicate tiles
+    # Deduplicate tiles (exact matches only)
     if optimize_duplicates:
-        unique_tiles = []
-        tile_to_index = {}
-        tilemap = []
-
-        for tile in all_tiles:
-            if tile not in tile_to_index:
-                tile_to_index[tile] = len(unique_tiles)
-                unique_tiles.append(tile)
-            tilemap.append(tile_to_index[tile])
+        dedup = dedup_tiles(tile_rows, _GENESIS_LAYOUT, allow_h=False, allow_v=False)
+        unique_tiles = [all_tiles[i] for i in dedup.unique_indices]
+        tilemap = dedup.tile_indices.tolist()
     else:
         unique_tiles = all_tiles
         tilemap = list(range(len(all_tiles)))
@@ -1153,58 +1153,27 @@ def export_genesis_tilemap_optimized(indexed_img, output_path: str,
     tiles_y = height // 8
     total_tiles = tiles_x * tiles_y
 
-    pixels = list(indexed_img.getdata())
-
-    # Extract all tiles as 4bpp data
-    all_tiles = []
-    for ty in range(tiles_y):
-        for tx in range(tiles_x):
-            tile = _extract_tile_4bpp(pixels, width, tx, ty)
-            all_tiles.append(tile)
-
-    # Deduplicate with mirror detection
-    unique_tiles = []
-    tile_lookup = {}  # bytes -> index
-    tilemap_entries = []  # List of TileMatch objects
-
-    # Statistics
-    exact_matches = 0
-    h_flip_matches = 0
-    v_flip_matches = 0
-    hv_flip_matches = 0
-
-    for tile in all_tiles:
-        # Try to find match in existing unique tiles
-        match = find_tile_match(tile, unique_tiles, tile_lookup, check_mirrors=use_mirroring)
-
-        if match is not None:
-            # Track match type for stats
-            if not match.h_flip and not match.v_flip:
-                exact_matches += 1
-            elif match.h_flip and not match.v_flip:
-                h_flip_matches += 1
-            elif not match.h_flip and match.v_flip:
-                v_flip_matches += 1
-            else:
-                hv_flip_matches += 1
-
-            # Adjust index for base_tile offset
-            tilemap_entries.append(TileMatch(
-                index=match.index + base_tile,
-                h_flip=match.h_flip,
-                v_flip=match.v_flip
-            ))
-        else:
-            # New unique tile
-            new_index = len(unique_tiles)
-            tile_lookup[tile] = new_index
-            unique_tiles.append(tile)
+    # Extract all tiles as 4bpp data and deduplicate them in bulk
+    all_tiles = _extract_tiles_4bpp(indexed_img)
+    dedup = dedup_tiles(all_tiles, _GENESIS_LAYOUT,
+                        allow_h=use_mirroring, allow_v=use_mirroring)
+
+    unique_tiles = [all_tiles[i].tobytes() for i in dedup.unique_indices]
+    tilemap_entries = [
+        TileMatch(
+            index=index + base_tile,
+            h_flip=transform in (TileTransform.FLIP_H, TileTransform.FLIP_HV),
+            v_flip=transform in (TileTransform.FLIP_V, TileTransform.FLIP_HV)
+        )
+        for index, transform in zip(dedup.tile_indices.tolist(), dedup.transforms.tolist())
+    ]
 
-            tilemap_entries.append(TileMatch(
-                index=new_index + base_tile,
-                h_flip=False,
-                v_flip=False
-            ))
+    # Statistics (unique tiles themselves are not matches)
+    counts = dedup.transform_counts()
+    exact_matches = counts[TileTransform.NORMAL] - dedup.unique_count
+    h_flip_matches = counts[TileTransform.FLIP_H]
+    v_flip_matches = counts[TileTransform.FLIP_V]
+    hv_flip_matches = counts[TileTransform.FLIP_HV]
 
     # Build statistics
     stats = TileOptimizationStats(
@@ -1330,6 +1299,14 @@ extern const u16 {c_name}_map[];
 # CROSS-PLATFORM TILE FLIP FUNCTIONS (NES, SNES, GameBoy, etc.)
 # =============================================================================
 
+_SNES_LAYOUT = FORMAT_LAYOUTS['snes']
+
+
+@lru_cache(maxsize=None)
+def _planar_2bpp_layout(tile_size: int) -> TileLayout:
+    """NES/GB layout for 8 x tile_size tiles (plane 0 rows, then plane 1 rows)."""
+    return TileLayout.planar(height=tile_size, groups=2, planes_per_group=1, name='nes')
+
 def flip_tile_2bpp_h(tile_bytes: bytes, tile_size: int = 8) -> bytes:
     """
     Flip a 2bpp tile horizontally (NES/GameBoy format).
@@ -1339,7 +1316,7 @@ def flip_tile_2bpp_h(tile_bytes: bytes, tile_size: int = 8) -> bytes:
     - Plane 0 (low bits): bytes 0-7
     - Plane 1 (high bits): bytes 8-15
 
-    To flip horizontally, reverse bit order within each byte.
+    To flip horizontally, reverse bit order within each byte (lookup table).
 
     Args:
         tile_bytes: 16-byte NES/GB tile data
@@ -1353,18 +1330,7 @@ def flip_tile_2bpp_h(tile_bytes: bytes, tile_size: int = 8) -> bytes:
     if len(tile_bytes) != bytes_per_plane * 2:
         raise ValueError(f"NES/GB tile must be {bytes_per_plane * 2} bytes, got {len(tile_bytes)}")
 
-    result = bytearray(len(tile_bytes))
-
-    # Reverse bits in each byte (both planes)
-    for i, byte_val in enumerate(tile_bytes):
-        # Reverse bits: 76543210 -> 01234567
-        reversed_byte = 0
-        for bit in range(8):
-            if byte_val & (1 << bit):
-                reversed_byte |= (1 << (7 - bit))
-        result[i] = reversed_byte
-
-    return bytes(result)
+    return _planar_2bpp_layout(tile_size).flip_bytes(tile_bytes, TileTransform.FLIP_H)
 
 
 def flip_tile_2bpp_v(tile_bytes: bytes, tile_size: int = 8) -> bytes:
@@ -1385,22 +1351,15 @@ def flip_tile_2bpp_v(tile_bytes: bytes, tile_size: int = 8) -> bytes:
     if len(tile_bytes) != bytes_per_plane * 2:
         raise ValueError(f"NES/GB tile must be {bytes_per_plane * 2} bytes, got {len(tile_bytes)}")
 
-    result = bytearray(len(tile_bytes))
-
-    # Reverse row order in plane 0
-    for row in range(tile_size):
-        result[row] = tile_bytes[tile_size - 1 - row]
-
-    # Reverse row order in plane 1
-    for row in range(tile_size):
-        result[tile_size + row] = tile_bytes[tile_size + tile_size - 1 - row]
-
-    return bytes(result)
+    return _planar_2bpp_layout(tile_size).flip_bytes(tile_bytes, TileTransform.FLIP_V)
 
 
 def flip_tile_2bpp_hv(tile_bytes: bytes, tile_size: int = 8) -> bytes:
     """Flip a 2bpp tile both horizontally and vertically."""
-    return flip_tile_2bpp_h(flip_tile_2bpp_v(tile_bytes, tile_size), tile_size)
+    if len(tile_bytes) != tile_size * 2:
+        raise ValueError(f"NES/GB tile must be {tile_size * 2} bytes, got {len(tile_bytes)}")
+
+    return _planar_2bpp_layout(tile_size).flip_bytes(tile_bytes, TileTransform.FLIP_HV)
 
 
 def flip_tile_snes_h(tile_bytes: bytes) -> bytes:
@@ -1420,20 +1379,10 @@ def flip_tile_snes_h(tile_bytes: bytes) -> bytes:
     if len(tile_bytes) != 32:
         raise ValueError(f"SNES tile must be 32 bytes, got {len(tile_bytes)}")
 
-    result = bytearray(32)
-
     # SNES format: bytes 0-15 are bitplanes 0-1, bytes 16-31 are bitplanes 2-3
     # Within each 16-byte section: even bytes are plane 0/2, odd bytes are plane 1/3
     # To flip horizontally, reverse bits in every byte
-    for i, byte_val in enumerate(tile_bytes):
-        # Reverse bits: 76543210 -> 01234567
-        reversed_byte = 0
-        for bit in range(8):
-            if byte_val & (1 << bit):
-                reversed_byte |= (1 << (7 - bit))
-        result[i] = reversed_byte
-
-    return bytes(result)
+    return _SNES_LAYOUT.flip_bytes(tile_bytes, TileTransform.FLIP_H)
 
 
 def flip_tile_snes_v(tile_bytes: bytes) -> bytes:
@@ -1449,23 +1398,16 @@ def flip_tile_snes_v(tile_bytes: bytes) -> bytes:
     if len(tile_bytes) != 32:
         raise ValueError(f"SNES tile must be 32 bytes, got {len(tile_bytes)}")
 
-    result = bytearray(32)
-
-    # Reverse row order within each 16-byte section
-    for section in range(2):  # Bitplanes 0-1, then 2-3
-        section_offset = section * 16
-        for row in range(8):
-            src_row = 7 - row
-            # Copy both bytes of the row (plane 0/2 and plane 1/3)
-            result[section_offset + row * 2] = tile_bytes[section_offset + src_row * 2]
-            result[section_offset + row * 2 + 1] = tile_bytes[section_offset + src_row * 2 + 1]
-
-    return bytes(result)
+    # Reverse row order within each 16-byte section (row = plane 0/2 + plane 1/3 byte)
+    return _SNES_LAYOUT.flip_bytes(tile_bytes, TileTransform.FLIP_V)
 
 
 def flip_tile_snes_hv(tile_bytes: bytes) -> bytes:
     """Flip a SNES tile both horizontally and vertically."""
-    return flip_tile_snes_h(flip_tile_snes_v(tile_bytes))
+    if len(tile_bytes) != 32:
+        raise ValueError(f"SNES tile must be 32 bytes, got {len(tile_bytes)}")
+
+    return _SNES_LAYOUT.flip_bytes(tile_bytes, TileTransform.FLIP_HV)
 
 
 # =============================================================================
@@ -1488,6 +1430,9 @@ class TileFormat:
         GAMEBOY: 16,
     }
 
+    # Byte layouts for the shared dedup core (pipeline.optimization.dedup_tiles)
+    LAYOUTS = FORMAT_LAYOUTS
+
     FLIP_FUNCTIONS = {
         GENESIS: (flip_tile_h, flip_tile_v, flip_tile_hv),
         NES: (flip_tile_2bpp_h, flip_tile_2bpp_v, flip_tile_2bpp_hv),
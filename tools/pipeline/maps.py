@@ -10,6 +10,8 @@ Features:
     - Object layer parsing for spawn points, triggers, collision
     - Collision map generation (per-tile collision types)
     - SGDK resource file generation
+    - Chunked export for streaming scrollers (deduplicated, per-chunk
+      compression, chunk index table, decompression cost report)
     - Map visualization and debug tools
 
 Dependencies:
@@ -28,15 +30,20 @@ Example:
 from dataclasses import dataclass, field
 from enum import IntEnum, Enum
 from pathlib import Path
-from typing import List, Dict, Optional, Tuple, Any, Union
+from typing import List, Dict, Optional, Tuple, Any, Union, Callable
 import xml.etree.ElementTree as ET
 import json
+import re
 import base64
 import zlib
 import gzip
-import struct
+import numpy as np
 from PIL import Image
 
+from .genesis_compression import (
+    CompressionFormat, GenesisCompressor, estimate_decompression_cost
+)
+
 # =============================================================================
 # Enums and Constants
 # =============================================================================
@@ -82,6 +89,75 @@ FLIPPED_DIAGONALLY_FLAG = 0x20000000
 GID_MASK = 0x1FFFFFFF
 
 
+def split_gids(gids: np.ndarray) -> Tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
+    """
+    Split raw Tiled GIDs into (gid, flip_h, flip_v, flip_d) arrays.
+
+    Args:
+        gids: Raw 32-bit GIDs as stored in TMX/JSON (flags in the top bits)
+
+    Returns:
+        Clean uint32 GIDs and three bool flag arrays
+    """
+    gids = np.asarray(gids, dtype=np.uint32)
+    return (
+        gids & np.uint32(GID_MASK),
+        (gids & np.uint32(FLIPPED_HORIZONTALLY_FLAG)) != 0,
+        (gids & np.uint32(FLIPPED_VERTICALLY_FLAG)) != 0,
+        (gids & np.uint32(FLIPPED_DIAGONALLY_FLAG)) != 0,
+    )
+
+
+def decode_tile_data(payload: str, encoding: str, compression: str = '',
+                     expected_count: Optional[int] = None) -> np.ndarray:
+    """
+    Decode a Tiled layer data payload into raw uint32 GIDs.
+
+    Args:
+        payload: Element text (CSV or base64)
+        encoding: 'csv' or 'base64'
+        compression: '', 'zlib' or 'gzip' (base64 only)
+        expected_count: Required number of GIDs (layer width * height)
+
+    Returns:
+        Raw GIDs in row-major order, flip flags included
+
+    Raises:
+        ValueError: For unsupported encodings or compression, malformed
+            CSV, or a GID count other than expected_count
+    """
+    if encoding == 'csv':
+        # Tiled breaks rows with newlines and may leave a trailing comma
+        fields = [field for field in re.split(r'[\s,]+', payload) if field]
+        try:
+            gids = np.array(fields, dtype=np.uint32)
+        except (ValueError, OverflowError) as e:
+            raise ValueError(f"Malformed CSV tile data: {e}") from None
+    elif encoding == 'base64':
+        gids = _decode_base64_tile_data(payload, compression)
+    else:
+        raise ValueError(f"Unsupported tile data encoding: {encoding}")
+
+    if expected_count is not None and len(gids) != expected_count:
+        raise ValueError(f"Tile data has {len(gids)} GIDs, expected {expected_count}")
+    return gids
+
+
+def _decode_base64_tile_data(payload: str, compression: str) -> np.ndarray:
+    """Decode (and decompress) a base64 payload of little-endian uint32 GIDs."""
+    raw_data = base64.b64decode(payload.strip())
+    if compression == 'gzip':
+        raw_data = gzip.decompress(raw_data)
+    elif compression == 'zlib':
+        raw_data = zlib.decompress(raw_data)
+    elif compression:
+        raise ValueError(f"Unsupported tile data compression: {compression}")
+
+    # Little-endian 32-bit integers; astype copies out of the read-only buffer
+    usable = len(raw_data) - len(raw_data) % 4
+    return np.frombuffer(raw_data[:usable], dtype='<u4').astype(np.uint32)
+
+
 # =============================================================================
 # Data Classes
 # =============================================================================
@@ -91,13 +167,18 @@ class TileLayer:
     """
     A tile layer from a Tiled map.
 
+    Tile data is stored as flat row-major NumPy arrays (one entry per cell)
+    so large maps decode and export without per-tile Python objects.
+    Lists passed to the constructor are converted.
+
     Attributes:
         name: Layer name as defined in Tiled
         width: Layer width in tiles
         height: Layer height in tiles
-        data: Tile GIDs (with flip flags stripped)
-        flip_h: Horizontal flip flags per tile
-        flip_v: Vertical flip flags per tile
+        data: Tile GIDs with flip flags stripped (uint32)
+        flip_h: Horizontal flip flags per tile (bool)
+        flip_v: Vertical flip flags per tile (bool)
+        flip_d: Diagonal (anti-diagonal) flip flags per tile (bool)
         properties: Custom properties defined in Tiled
         visible: Whether layer is visible
         opacity: Layer opacity (0.0-1.0)
@@ -107,28 +188,53 @@ class TileLayer:
     name: str
     width: int
     height: int
-    data: List[int]
-    flip_h: List[bool] = field(default_factory=list)
-    flip_v: List[bool] = field(default_factory=list)
+    data: np.ndarray
+    flip_h: Optional[np.ndarray] = None
+    flip_v: Optional[np.ndarray] = None
     properties: Dict[str, Any] = field(default_factory=dict)
     visible: bool = True
     opacity: float = 1.0
     offset_x: int = 0
     offset_y: int = 0
+    flip_d: Optional[np.ndarray] = None
+
+    def __post_init__(self):
+        self.data = np.asarray(self.data, dtype=np.uint32).ravel()
+        count = len(self.data)
+        # Missing or short flag arrays mean "not flipped"
+        for attr in ('flip_h', 'flip_v', 'flip_d'):
+            flags = getattr(self, attr)
+            flags = np.zeros(0, dtype=bool) if flags is None else \
+                np.asarray(flags, dtype=bool).ravel()
+            if len(flags) < count:
+                flags = np.concatenate([flags, np.zeros(count - len(flags), dtype=bool)])
+            setattr(self, attr, flags)
+
+    @classmethod
+    def from_gids(cls, name: str, width: int, height: int,
+                  gids: np.ndarray, **kwargs) -> 'TileLayer':
+        """Create a layer from raw Tiled GIDs (flip flags still set)."""
+        data, flip_h, flip_v, flip_d = split_gids(gids)
+        return cls(name=name, width=width, height=height, data=data,
+                   flip_h=flip_h, flip_v=flip_v, flip_d=flip_d, **kwargs)
+
+    @property
+    def grid(self) -> np.ndarray:
+        """GIDs as a (height, width) view."""
+        return self.data[:self.width * self.height].reshape(self.height, self.width)
 
     def get_tile(self, x: int, y: int) -> int:
         """Get tile GID at position (0 = empty)."""
         if 0 <= x < self.width and 0 <= y < self.height:
-            return self.data[y * self.width + x]
+            return int(self.data[y * self.width + x])
         return 0
 
     def get_flip(self, x: int, y: int) -> Tuple[bool, bool]:
         """Get flip flags (h_flip, v_flip) at position."""
         if 0 <= x < self.width and 0 <= y < self.height:
             idx = y * self.width + x
-            h = self.flip_h[idx] if idx < len(self.flip_h) else False
-            v = self.flip_v[idx] if idx < len(self.flip_v) else False
-            return (h, v)
+            if idx < len(self.data):
+                return (bool(self.flip_h[idx]), bool(self.flip_v[idx]))
         return (False, False)
 
 
@@ -605,15 +711,13 @@ class TiledParser:
 
         # Parse tile data
         data_elem = elem.find('data')
-        data, flip_h, flip_v = self._parse_tile_data_xml(data_elem, width * height)
+        gids = self._parse_tile_data_xml(data_elem, width * height)
 
-        return TileLayer(
+        return TileLayer.from_gids(
             name=name,
             width=width,
             height=height,
-            data=data,
-            flip_h=flip_h,
-            flip_v=flip_v,
+            gids=gids,
             properties=properties,
             visible=visible,
             opacity=opacity,
@@ -622,63 +726,26 @@ class TiledParser:
         )
 
     def _parse_tile_data_xml(self, elem: ET.Element,
-                              expected_count: int) -> Tuple[List[int], List[bool], List[bool]]:
-        """Parse tile data from a data element."""
+                              expected_count: int) -> np.ndarray:
+        """Parse raw GIDs (flip flags included) from a data element."""
         if elem is None:
-            return ([0] * expected_count, [False] * expected_count, [False] * expected_count)
+            return np.zeros(expected_count, dtype=np.uint32)
 
         encoding = elem.get('encoding', '')
         compression = elem.get('compression', '')
 
-        raw_data: bytes
-
-        if encoding == 'base64':
-            # Base64 encoded data
-            raw_data = base64.b64decode(elem.text.strip())
-
-            # Decompress if needed
-            if compression == 'gzip':
-                raw_data = gzip.decompress(raw_data)
-            elif compression == 'zlib':
-                raw_data = zlib.decompress(raw_data)
-
-            # Unpack as 32-bit integers (little-endian)
-            gids = list(struct.unpack(f'<{len(raw_data) // 4}I', raw_data))
-
-        elif encoding == 'csv':
-            # CSV encoded data
-            csv_text = elem.text.strip()
-            gids = [int(x.strip()) for x in csv_text.split(',') if x.strip()]
-
+        if encoding:
+            gids = decode_tile_data(elem.text or '', encoding, compression, expected_count)
         else:
             # Uncompressed XML tile elements
-            gids = []
-            for tile_elem in elem.findall('tile'):
-                gid = int(tile_elem.get('gid', 0))
-                gids.append(gid)
-
-        # Extract flip flags and clean GIDs
-        data = []
-        flip_h = []
-        flip_v = []
-
-        for gid in gids:
-            h_flip = bool(gid & FLIPPED_HORIZONTALLY_FLAG)
-            v_flip = bool(gid & FLIPPED_VERTICALLY_FLAG)
-            # Note: Diagonal flip not commonly used, ignored for simplicity
-            clean_gid = gid & GID_MASK
-
-            data.append(clean_gid)
-            flip_h.append(h_flip)
-            flip_v.append(v_flip)
+            gids = np.array([int(tile_elem.get('gid', 0))
+                             for tile_elem in elem.findall('tile')], dtype=np.uint32)
 
         # Pad if necessary
-        while len(data) < expected_count:
-            data.append(0)
-            flip_h.append(False)
-            flip_v.append(False)
+        if len(gids) < expected_count:
+            gids = np.concatenate([gids, np.zeros(expected_count - len(gids), dtype=np.uint32)])
 
-        return (data, flip_h, flip_v)
+        return gids
 
     def _parse_object_layer_xml(self, elem: ET.Element) -> ObjectLayer:
         """Parse an object layer element."""
@@ -935,30 +1002,19 @@ class TiledParser:
         if isinstance(properties, list):
             properties = {p['name']: p['value'] for p in properties}
 
-        # Get tile data (already decoded in JSON format)
-        gids = data.get('data', [])
-
-        # Extract flip flags
-        tile_data = []
-        flip_h = []
-        flip_v = []
-
-        for gid in gids:
-            h_flip = bool(gid & FLIPPED_HORIZONTALLY_FLAG)
-            v_flip = bool(gid & FLIPPED_VERTICALLY_FLAG)
-            clean_gid = gid & GID_MASK
-
-            tile_data.append(clean_gid)
-            flip_h.append(h_flip)
-            flip_v.append(v_flip)
+        # Tile data is a GID array, or a base64 string like TMX
+        payload = data.get('data', [])
+        if isinstance(payload, str):
+            gids = decode_tile_data(payload, data.get('encoding', 'base64'),
+                                    data.get('compression', ''), width * height)
+        else:
+            gids = np.array(payload, dtype=np.uint32)
 
-        return TileLayer(
+        return TileLayer.from_gids(
             name=name,
             width=width,
             height=height,
-            data=tile_data,
-            flip_h=flip_h,
-            flip_v=flip_v,
+            gids=gids,
             properties=properties,
             visible=visible,
             opacity=opacity,
@@ -1018,6 +1074,48 @@ class TiledParser:
         return CollisionType.NONE
 
 
+# =============================================================================
+# Vectorized Helpers
+# =============================================================================
+
+# Above this value lookup tables are built from np.unique instead of indexed directly
+DENSE_TABLE_LIMIT = 1 << 20
+
+
+def _lookup(values: np.ndarray, func: Callable[[int], Any], dtype) -> np.ndarray:
+    """
+    Apply func to every cell, calling it once per distinct value.
+
+    Maps reuse a few hundred distinct GIDs across hundreds of thousands of
+    cells, so the results are gathered from a lookup table. Small values
+    (GIDs, VDP words) index the table directly, which avoids sorting the
+    whole layer.
+    """
+    values = np.asarray(values).ravel()
+    if not len(values):
+        return np.zeros(0, dtype=dtype)
+
+    if 0 <= int(values.min()) and int(values.max()) < DENSE_TABLE_LIMIT:
+        index = values.astype(np.intp)
+        distinct = np.flatnonzero(np.bincount(index))
+        slots = distinct
+    else:
+        distinct, index = np.unique(values, return_inverse=True)
+        index = index.ravel()
+        slots = np.arange(len(distinct))
+
+    table = np.zeros(int(slots[-1]) + 1, dtype=dtype)
+    table[slots] = [func(int(value)) for value in distinct]
+    return table[index]
+
+
+def _format_rows(values: np.ndarray, width: int, fmt: str) -> List[str]:
+    """Format values as C initializer rows of `width` entries each."""
+    text = _lookup(values, fmt.format, object)
+    return ["    " + ", ".join(text[start:start + width].tolist()) + ","
+            for start in range(0, len(text), width)]
+
+
 # =============================================================================
 # Collision Exporter
 # =============================================================================
@@ -1060,31 +1158,30 @@ class CollisionExporter:
         if layer is None:
             return [0] * (tiled_map.width * tiled_map.height)
 
-        collision = []
-        for gid in layer.data:
-            # For collision layers, the GID IS the collision type
-            # (assuming collision tileset starts at GID 1)
-            if gid == 0:
-                collision.append(CollisionType.NONE.value)
-            else:
-                # Map GID to collision type (GID 1 = SOLID, etc.)
-                # Find the tileset and get local ID
-                tileset = tiled_map.get_tileset_for_gid(gid)
-                if tileset:
-                    local_id = tileset.gid_to_local(gid)
-                    # Check if tile has collision property
-                    if local_id in tileset.tile_properties:
-                        collision.append(tileset.tile_properties[local_id].collision.value)
-                    else:
-                        # Use local ID as collision type directly
-                        if local_id < len(CollisionType):
-                            collision.append(local_id)
-                        else:
-                            collision.append(CollisionType.SOLID.value)
-                else:
-                    collision.append(CollisionType.SOLID.value)
+        return _lookup(layer.data, lambda gid: self._tile_collision_value(tiled_map, gid),
+                       np.int64).tolist()
 
-        return collision
+    def _tile_collision_value(self, tiled_map: TiledMap, gid: int) -> int:
+        """Collision type for one GID of a dedicated collision layer."""
+        # For collision layers, the GID IS the collision type
+        # (assuming collision tileset starts at GID 1)
+        if gid == 0:
+            return CollisionType.NONE.value
+
+        # Map GID to collision type (GID 1 = SOLID, etc.)
+        # Find the tileset and get local ID
+        tileset = tiled_map.get_tileset_for_gid(gid)
+        if tileset is None:
+            return CollisionType.SOLID.value
+
+        local_id = tileset.gid_to_local(gid)
+        # Check if tile has collision property
+        if local_id in tileset.tile_properties:
+            return tileset.tile_properties[local_id].collision.value
+        # Use local ID as collision type directly
+        if local_id < len(CollisionType):
+            return local_id
+        return CollisionType.SOLID.value
 
     def extract_from_tileset_properties(self, tiled_map: TiledMap,
                                          layer_name: str = "main") -> List[int]:
@@ -1104,22 +1201,15 @@ class CollisionExporter:
         if layer is None:
             return [0] * (tiled_map.width * tiled_map.height)
 
-        collision = []
-        for gid in layer.data:
+        def property_collision(gid: int) -> int:
             if gid == 0:
-                collision.append(CollisionType.NONE.value)
-                continue
-
+                return CollisionType.NONE.value
             tileset = tiled_map.get_tileset_for_gid(gid)
             if tileset is None:
-                collision.append(CollisionType.NONE.value)
-                continue
-
-            local_id = tileset.gid_to_local(gid)
-            coll_type = tileset.get_tile_collision(local_id)
-            collision.append(coll_type.value)
+                return CollisionType.NONE.value
+            return tileset.get_tile_collision(tileset.gid_to_local(gid)).value
 
-        return collision
+        return _lookup(layer.data, property_collision, np.int64).tolist()
 
     def extract_object_collision(self, tiled_map: TiledMap,
                                   layer_name: str = "collision") -> List[Dict]:
@@ -1244,14 +1334,8 @@ class CollisionExporter:
         ])
 
         # Format collision data
-        row_data = []
-        for y in range(tiled_map.height):
-            row_start = y * tiled_map.width
-            row_end = row_start + tiled_map.width
-            row_values = [str(v) for v in collision[row_start:row_end]]
-            row_data.append("    " + ", ".join(row_values) + ",")
-
-        lines.extend(row_data)
+        rows = np.asarray(collision)[:tiled_map.width * tiled_map.height]
+        lines.extend(_format_rows(rows, tiled_map.width, "{}"))
         lines.extend([
             "};",
             "",
@@ -1279,6 +1363,58 @@ class MapExportConfig:
     metatile_size: int = 1          # 1 = 8x8, 2 = 16x16 metatiles
     base_tile_index: int = 0        # First tile index in VRAM
     palette_index: int = 0          # Default palette (0-3)
+    chunk_size: int = 0             # Chunk edge in tiles for streaming (0 = whole layers)
+    chunk_format: str = "auto"      # Chunk codec: auto, kosinski, lzss, rle, none
+
+
+@dataclass
+class MapChunk:
+    """One distinct chunk of a chunked layer."""
+    index: int                      # Entry in the layer's chunk table
+    offset: int                     # Byte offset in the layer's chunk data
+    raw_size: int                   # Decompressed bytes
+    size: int                       # Stored bytes
+    format: CompressionFormat
+    cycles: int                     # Estimated 68000 decompression cycles
+    uses: int = 0                   # Grid cells showing this chunk
+
+
+@dataclass
+class ChunkedLayer:
+    """A tile layer split into fixed-size, deduplicated, compressed chunks."""
+    name: str
+    chunks_x: int
+    chunks_y: int
+    chunk_map: List[int]            # Row-major grid cell -> chunk index
+    chunks: List[MapChunk]
+    data_path: str = ""
+
+    @property
+    def raw_bytes(self) -> int:
+        """Size of the layer as uncompressed, undeduplicated chunks."""
+        return sum(chunk.raw_size * chunk.uses for chunk in self.chunks)
+
+    @property
+    def stored_bytes(self) -> int:
+        """Size of the chunk data actually stored."""
+        return sum(chunk.size for chunk in self.chunks)
+
+    @property
+    def max_cycles(self) -> int:
+        """Worst-case cost of bringing one chunk into view."""
+        return max((chunk.cycles for chunk in self.chunks), default=0)
+
+    def summary(self) -> str:
+        formats: Dict[str, int] = {}
+        for chunk in self.chunks:
+            formats[chunk.format.value] = formats.get(chunk.format.value, 0) + 1
+        used = ", ".join(f"{count} {name}" for name, count in sorted(formats.items()))
+        return (
+            f"{self.name}: {self.chunks_x}x{self.chunks_y} chunks, "
+            f"{len(self.chunks)} unique ({used}), "
+            f"{self.raw_bytes} -> {self.stored_bytes} bytes, "
+            f"worst chunk {self.max_cycles} cycles"
+        )
 
 
 @dataclass
@@ -1290,6 +1426,7 @@ class MapExportResult:
     res_entry: Optional[str] = None
     tilemap_bin: Optional[str] = None
     collision_bin: Optional[str] = None
+    chunked_layers: List[ChunkedLayer] = field(default_factory=list)
     errors: List[str] = field(default_factory=list)
 
 
@@ -1338,17 +1475,26 @@ class SGDKMapExporter:
             base_name = f"{config.prefix}_{base_name}"
 
         try:
-            # Export main tilemap
-            map_header = self._export_tilemap_header(
-                tiled_map, base_name, config, output_dir
-            )
-            result.map_header = str(output_dir / f"{base_name}.h")
+            if config.chunk_size > 0:
+                # Streaming layout: chunk tables header + one data file per layer
+                result.chunked_layers = self._export_chunked(
+                    tiled_map, base_name, config, output_dir
+                )
+                result.map_header = str(output_dir / f"{base_name}_chunks.h")
+                if result.chunked_layers:
+                    result.tilemap_bin = result.chunked_layers[0].data_path
+            else:
+                # Export main tilemap
+                map_header = self._export_tilemap_header(
+                    tiled_map, base_name, config, output_dir
+                )
+                result.map_header = str(output_dir / f"{base_name}.h")
 
-            # Export tilemap binary
-            tilemap_bin = self._export_tilemap_binary(
-                tiled_map, base_name, config, output_dir
-            )
-            result.tilemap_bin = tilemap_bin
+                # Export tilemap binary
+                tilemap_bin = self._export_tilemap_binary(
+                    tiled_map, base_name, config, output_dir
+                )
+                result.tilemap_bin = tilemap_bin
 
             # Export collision
             if config.include_collision:
@@ -1405,25 +1551,9 @@ class SGDKMapExporter:
             ])
 
             # Generate tilemap entries with VDP attributes
-            for y in range(layer.height):
-                row_values = []
-                for x in range(layer.width):
-                    idx = y * layer.width + x
-                    gid = layer.data[idx]
-                    h_flip = layer.flip_h[idx] if idx < len(layer.flip_h) else False
-                    v_flip = layer.flip_v[idx] if idx < len(layer.flip_v) else False
-
-                    # Build VDP tilemap entry
-                    # Bits 15: Priority, 14-13: Palette, 12: VFlip, 11: HFlip, 10-0: Tile
-                    entry = self._build_tilemap_entry(
-                        gid, h_flip, v_flip,
-                        config.palette_index,
-                        config.base_tile_index,
-                        tiled_map
-                    )
-                    row_values.append(f"0x{entry:04X}")
-
-                lines.append("    " + ", ".join(row_values) + ",")
+            entries = self._build_tilemap_entries(layer, config, tiled_map)
+            lines.extend(_format_rows(entries[:layer.width * layer.height],
+                                      layer.width, "0x{:04X}"))
 
             lines.extend(["};", ""])
 
@@ -1442,27 +1572,213 @@ class SGDKMapExporter:
             if not layer.visible:
                 continue
 
-            data = bytearray()
-            for idx in range(len(layer.data)):
-                gid = layer.data[idx]
-                h_flip = layer.flip_h[idx] if idx < len(layer.flip_h) else False
-                v_flip = layer.flip_v[idx] if idx < len(layer.flip_v) else False
-
-                entry = self._build_tilemap_entry(
-                    gid, h_flip, v_flip,
-                    config.palette_index,
-                    config.base_tile_index,
-                    tiled_map
-                )
-                # Little-endian 16-bit
-                data.extend(struct.pack('<H', entry))
+            entries = self._build_tilemap_entries(layer, config, tiled_map)
 
+            # Little-endian 16-bit
             bin_path = output_dir / f"{base_name}_{layer.name}.bin"
-            bin_path.write_bytes(bytes(data))
+            bin_path.write_bytes(entries.astype('<u2').tobytes())
             return str(bin_path)
 
         return ""
 
+    def _export_chunked(self, tiled_map: TiledMap, base_name: str,
+                        config: MapExportConfig, output_dir: Path) -> List[ChunkedLayer]:
+        """
+        Export visible layers as fixed-size chunks for streaming scrollers.
+
+        Each layer is cut into chunk_size x chunk_size tile blocks (edge
+        chunks are padded with empty tiles so every chunk has the same
+        shape). Identical blocks are stored once, and each distinct block
+        is compressed on its own so the game can unpack just the chunks
+        entering the view. Chunk words are big-endian VDP tilemap entries,
+        ready to copy to a plane.
+
+        Writes {base}_{layer}_chunks.bin per layer and {base}_chunks.h with
+        the chunk grid and the offset/size/format table.
+        """
+        fmt = config.chunk_format.lower()
+        if fmt != "auto":
+            fmt = CompressionFormat(fmt)
+        compressor = GenesisCompressor()
+
+        layers = []
+        for layer in tiled_map.layers:
+            if not layer.visible:
+                continue
+
+            blocks, chunks_x, chunks_y = self._split_chunks(layer, config, tiled_map)
+
+            # Deduplicate: grid cell -> first block with the same bytes
+            distinct: Dict[bytes, int] = {}
+            chunk_map = [distinct.setdefault(block, len(distinct)) for block in blocks]
+            uses = np.bincount(chunk_map, minlength=len(distinct))
+            encoded = self._compress_chunks(list(distinct), fmt, compressor)
+
+            data = bytearray()
+            chunks = []
+            for index, (raw, (chunk_format, payload)) in enumerate(zip(distinct, encoded)):
+                cost = estimate_decompression_cost(payload, chunk_format, compressor)
+                chunks.append(MapChunk(
+                    index=index, offset=len(data), raw_size=len(raw), size=len(payload),
+                    format=chunk_format, cycles=cost.cycles, uses=int(uses[index]),
+                ))
+                data.extend(payload)
+                if len(data) % 2:
+                    data.append(0)  # Keep every chunk word-aligned for the 68000
+
+            data_path = output_dir / f"{base_name}_{layer.name}_chunks.bin"
+            data_path.write_bytes(bytes(data))
+            layers.append(ChunkedLayer(
+                name=layer.name, chunks_x=chunks_x, chunks_y=chunks_y,
+                chunk_map=chunk_map, chunks=chunks, data_path=str(data_path),
+            ))
+
+        header_path = output_dir / f"{base_name}_chunks.h"
+        header_path.write_text(
+            self._chunk_header(tiled_map, base_name, config, layers), encoding='utf-8'
+        )
+        return layers
+
+    def _split_chunks(self, layer: TileLayer, config: MapExportConfig,
+                      tiled_map: TiledMap) -> Tuple[List[bytes], int, int]:
+        """Cut a layer into row-major chunk blocks of big-endian VDP words."""
+        size = config.chunk_size
+        chunks_x = -(-layer.width // size)
+        chunks_y = -(-layer.height // size)
+
+        entries = self._build_tilemap_entries(layer, config, tiled_map)
+        grid = np.zeros((chunks_y * size, chunks_x * size), dtype='>u2')
+        grid[:layer.height, :layer.width] = \
+            entries[:layer.width * layer.height].reshape(layer.height, layer.width)
+
+        # (cy, y, cx, x) -> (cy, cx, y, x): one contiguous block per chunk
+        blocks = grid.reshape(chunks_y, size, chunks_x, size).swapaxes(1, 2)
+        blocks = np.ascontiguousarray(blocks).reshape(chunks_y * chunks_x, -1)
+        return [block.tobytes() for block in blocks], chunks_x, chunks_y
+
+    def _compress_chunks(self, blocks: List[bytes], fmt: Union[str, CompressionFormat],
+                         compressor: GenesisCompressor
+                         ) -> List[Tuple[CompressionFormat, bytes]]:
+        """
+        Compress each distinct chunk on its own.
+
+        "auto" keeps the smallest codec per chunk, and stores a chunk raw
+        when no codec makes it smaller (raw chunks also unpack fastest).
+        """
+        if fmt == "auto":
+            encoded = []
+            for raw, report in zip(blocks, compressor.compare_formats_batch(blocks)):
+                best = next((r for r in report.values()
+                             if r.success and r.output_size < len(raw)), None)
+                encoded.append((best.format, best.data) if best
+                               else (CompressionFormat.NONE, raw))
+            return encoded
+
+        encoded = []
+        for raw in blocks:
+            result = compressor.compress(raw, fmt)
+            if not result.success:
+                raise ValueError(f"Chunk compression failed: {result.error}")
+            encoded.append((result.format, result.data))
+        return encoded
+
+    def _chunk_header(self, tiled_map: TiledMap, base_name: str,
+                      config: MapExportConfig, layers: List[ChunkedLayer]) -> str:
+        """Generate C header with chunk grids and chunk tables."""
+        upper = base_name.upper()
+        format_ids = {CompressionFormat.NONE: 0, CompressionFormat.KOSINSKI: 1,
+                      CompressionFormat.LZSS: 2, CompressionFormat.RLE: 3}
+        lines = [
+            "// Auto-generated chunked tilemap data",
+            f"// Source: {tiled_map.source_path}",
+            "",
+            f"#ifndef _{upper}_CHUNKS_H_",
+            f"#define _{upper}_CHUNKS_H_",
+            "",
+            "#include <genesis.h>",
+            "",
+            f"#define {upper}_WIDTH {tiled_map.width}",
+            f"#define {upper}_HEIGHT {tiled_map.height}",
+            f"#define {upper}_CHUNK_SIZE {config.chunk_size}",
+            "",
+            "#ifndef MAP_CHUNK_DEFINED",
+            "#define MAP_CHUNK_DEFINED",
+            "// Chunk formats",
+        ]
+        for fmt, value in format_ids.items():
+            lines.append(f"#define MAP_CHUNK_{fmt.name} {value}")
+        lines.extend([
+            "",
+            "typedef struct {",
+            "    u32 offset;     // Byte offset in the layer's chunk data",
+            "    u16 size;       // Stored bytes",
+            "    u8 format;      // MAP_CHUNK_*",
+            "    u8 reserved;",
+            "} MapChunk;",
+            "#endif",
+            "",
+        ])
+
+        for chunked in layers:
+            name = f"{base_name}_{chunked.name}".replace(" ", "_").replace("-", "_")
+            prefix = name.upper()
+            lines.extend([
+                f"// Layer: {chunked.name}",
+                f"// {chunked.summary()}",
+                f"#define {prefix}_CHUNKS_X {chunked.chunks_x}",
+                f"#define {prefix}_CHUNKS_Y {chunked.chunks_y}",
+                f"#define {prefix}_CHUNK_COUNT {len(chunked.chunks)}",
+                "",
+                f"const u16 {name}_chunk_map[{len(chunked.chunk_map)}] = {{",
+            ])
+            lines.extend(_format_rows(np.asarray(chunked.chunk_map), chunked.chunks_x, "{}"))
+            lines.extend([
+                "};",
+                "",
+                f"const MapChunk {name}_chunks[{len(chunked.chunks)}] = {{",
+            ])
+            for chunk in chunked.chunks:
+                if chunk.size > 0xFFFF:
+                    raise ValueError(
+                        f"Chunk {chunk.index} of layer '{chunked.name}' is {chunk.size} bytes; "
+                        f"MapChunk.size is u16 (use a smaller chunk_size)")
+                lines.append(
+                    f"    {{ 0x{chunk.offset:06X}, {chunk.size}, "
+                    f"MAP_CHUNK_{chunk.format.name}, 0 }},  "
+                    f"// {chunk.index}: {chunk.uses} uses, ~{chunk.cycles} cycles"
+                )
+            lines.extend(["};", ""])
+
+        lines.append(f"#endif // _{upper}_CHUNKS_H_")
+        return "\n".join(lines)
+
+    def _build_tilemap_entries(self, layer: TileLayer, config: MapExportConfig,
+                               tiled_map: TiledMap) -> np.ndarray:
+        """
+        Build VDP tilemap entries for a whole layer in one pass.
+
+        Equivalent to _build_tilemap_entry per cell: the tile index and
+        palette bits come from a per-GID lookup table, and flip bits are
+        applied to every cell that maps to a tile.
+
+        Returns:
+            uint16 entries in row-major order
+        """
+        def base_entry(gid: int) -> int:
+            # Bit 16 marks GIDs that map to a tile and so take flip bits
+            entry = self._build_tilemap_entry(gid, False, False, config.palette_index,
+                                              config.base_tile_index, tiled_map)
+            if gid != 0 and tiled_map.get_tileset_for_gid(gid) is not None:
+                entry |= 0x10000
+            return entry
+
+        looked_up = _lookup(layer.data, base_entry, np.uint32)
+        tiled = looked_up >= 0x10000
+        entries = (looked_up & 0xFFFF).astype(np.uint16)
+        entries[tiled & layer.flip_h] |= 0x0800  # Bit 11
+        entries[tiled & layer.flip_v] |= 0x1000  # Bit 12
+        return entries
+
     def _build_tilemap_entry(self, gid: int, h_flip: bool, v_flip: bool,
                               palette: int, base_tile: int,
                               tiled_map: TiledMap) -> int:
@@ -1581,9 +1897,15 @@ class SGDKMapExporter:
             if not layer.visible:
                 continue
             layer_name = f"{base_name}_{layer.name}".replace(" ", "_").replace("-", "_")
-            lines.append(
-                f"BIN {layer_name}_data \"{base_name}_{layer.name}.bin\" {compression}"
-            )
+            if config.chunk_size > 0:
+                # Chunks are already compressed individually
+                lines.append(
+                    f"BIN {layer_name}_chunk_data \"{base_name}_{layer.name}_chunks.bin\" NONE"
+                )
+            else:
+                lines.append(
+                    f"BIN {layer_name}_data \"{base_name}_{layer.name}.bin\" {compression}"
+                )
 
         return "\n".join(lines)
 
@@ -1625,6 +1947,15 @@ class SGDKMapExporter:
                 f"(Genesis uses 8x8 tiles)"
             )
 
+        # The VDP can mirror tiles but not rotate them
+        for layer in tiled_map.layers:
+            rotated = int(np.count_nonzero(layer.flip_d))
+            if rotated:
+                result.add_warning(
+                    f"Layer '{layer.name}' has {rotated} rotated tiles "
+                    f"(diagonal flip is ignored on Genesis)"
+                )
+
         # Check total unique tiles across all tilesets
         total_tiles = sum(ts.tile_count for ts in tiled_map.tilesets)
         if total_tiles > 2047:
@@ -1821,37 +2152,34 @@ class MapVisualizer:
         tile_w = tiled_map.tile_width
         tile_h = tiled_map.tile_height
 
-        for y in range(layer.height):
-            for x in range(layer.width):
-                idx = y * layer.width + x
-                gid = layer.data[idx]
+        # Only non-empty cells need a paste
+        for idx in np.flatnonzero(layer.data[:layer.width * layer.height]):
+            y, x = divmod(int(idx), layer.width)
+            gid = int(layer.data[idx])
 
-                if gid == 0:
-                    continue
+            # Get tile image
+            tile_img = self._get_tile_image(tiled_map, gid, tile_w, tile_h)
+            if tile_img is None:
+                continue
 
-                # Get tile image
-                tile_img = self._get_tile_image(tiled_map, gid, tile_w, tile_h)
-                if tile_img is None:
-                    continue
+            # Apply flips
+            h_flip, v_flip = layer.get_flip(x, y)
+            if h_flip:
+                tile_img = tile_img.transpose(Image.FLIP_LEFT_RIGHT)
+            if v_flip:
+                tile_img = tile_img.transpose(Image.FLIP_TOP_BOTTOM)
+
+            # Scale if needed
+            if scale != 1:
+                tile_img = tile_img.resize(
+                    (tile_w * scale, tile_h * scale),
+                    Image.NEAREST
+                )
 
-                # Apply flips
-                h_flip, v_flip = layer.get_flip(x, y)
-                if h_flip:
-                    tile_img = tile_img.transpose(Image.FLIP_LEFT_RIGHT)
-                if v_flip:
-                    tile_img = tile_img.transpose(Image.FLIP_TOP_BOTTOM)
-
-                # Scale if needed
-                if scale != 1:
-                    tile_img = tile_img.resize(
-                        (tile_w * scale, tile_h * scale),
-                        Image.NEAREST
-                    )
-
-                # Paste tile
-                dest_x = x * tile_w * scale
-                dest_y = y * tile_h * scale
-                img.paste(tile_img, (dest_x, dest_y), tile_img)
+            # Paste tile
+            dest_x = x * tile_w * scale
+            dest_y = y * tile_h * scale
+            img.paste(tile_img, (dest_x, dest_y), tile_img)
 
         return img
 
@@ -1933,7 +2261,7 @@ def load_tiled_map(path: str) -> TiledMap:
 
 
 def export_map_to_sgdk(tiled_map: TiledMap, output_dir: str,
-                        prefix: str = "") -> MapExportResult:
+                        prefix: str = "", chunk_size: int = 0) -> MapExportResult:
     """
     Export Tiled map to SGDK format.
 
@@ -1943,12 +2271,13 @@ def export_map_to_sgdk(tiled_map: TiledMap, output_dir: str,
         tiled_map: Parsed Tiled map
         output_dir: Output directory
         prefix: Optional prefix for generated files
+        chunk_size: Chunk edge in tiles for streaming export (0 = whole layers)
 
     Returns:
         MapExportResult
     """
     exporter = SGDKMapExporter()
-    config = MapExportConfig(output_dir=output_dir, prefix=prefix)
+    config = MapExportConfig(output_dir=output_dir, prefix=prefix, chunk_size=chunk_size)
     return exporter.export_map(tiled_map, config)
 
 
@@ -1989,11 +2318,16 @@ __all__ = [
     'ValidationResult',
     'MapExportConfig',
     'MapExportResult',
+    'MapChunk',
+    'ChunkedLayer',
     # Classes
     'TiledParser',
     'CollisionExporter',
     'SGDKMapExporter',
     'MapVisualizer',
+    # Tile data decoding
+    'split_gids',
+    'decode_tile_data',
     # Convenience functions
     'load_tiled_map',
     'export_map_to_sgdk',
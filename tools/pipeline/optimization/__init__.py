@@ -12,6 +12,18 @@ from .tile_optimizer import (
     OptimizationStats,
     BatchTileOptimizer,
 )
+from .tile_dedup import (
+    TileLayout,
+    DedupResult,
+    dedup_tiles,
+    tiles_from_bytes,
+    FORMAT_LAYOUTS,
+)
+from .tile_merge import (
+    BKTree,
+    MergeResult,
+    merge_similar_tiles,
+)
 
 __all__ = [
     'TileOptimizer',
@@ -20,4 +32,12 @@ __all__ = [
     'OptimizedTileBank',
     'OptimizationStats',
     'BatchTileOptimizer',
+    'TileLayout',
+    'DedupResult',
+    'dedup_tiles',
+    'tiles_from_bytes',
+    'FORMAT_LAYOUTS',
+    'BKTree',
+    'MergeResult',
+    'merge_similar_tiles',
 ]
@@ -0,0 +1,342 @@
+"""
+Tile Deduplication Core.
+
+One dedup engine shared by every tile front-end in the toolchain:
+TileOptimizer (RGBA tiles), the Genesis tilemap exporter (packed 4bpp) and
+tile_optimizers.TileDeduplicator (indexed tiles).
+
+A TileLayout describes how the bytes of one tile move under a flip. A
+vertical flip is a byte permutation (row order). A horizontal flip is a byte
+permutation followed by a 256-entry byte table: nibble swap for Genesis
+4bpp, bit reversal for NES/GB/SNES planar rows, identity for chunky pixels.
+Flipping a whole batch of tiles is one gather plus one table lookup.
+
+Tiles are grouped by a flip-invariant key (the lexicographic minimum of
+their allowed orientations) hashed to a 64-bit integer, so grouping is an
+integer sort rather than a dict of byte strings. Groups are verified against
+the full key and regrouped exactly if two keys ever share a hash.
+
+Usage:
+    >>> from pipeline.optimization import TileLayout, dedup_tiles
+    >>> layout = TileLayout.for_format('genesis')
+    >>> result = dedup_tiles(tile_rows, layout)       # (N, 32) uint8
+    >>> unique = tile_rows[result.unique_indices]
+"""
+
+from dataclasses import dataclass
+from enum import IntEnum
+from operator import itemgetter
+from typing import Dict, List, Optional, Tuple
+
+import numpy as np
+
+
+class TileTransform(IntEnum):
+    """Tile transformation flags."""
+    NORMAL = 0
+    FLIP_H = 1  # Horizontal flip
+    FLIP_V = 2  # Vertical flip
+    FLIP_HV = 3  # Both flips (180° rotation)
+
+
+# =============================================================================
+# Byte Tables
+# =============================================================================
+
+_BYTES = np.arange(256, dtype=np.uint8)
+
+#: Swap the two 4bpp pixels packed in a byte (Genesis chunky rows)
+NIBBLE_SWAP = (_BYTES << 4) | (_BYTES >> 4)
+
+#: Reverse the 8 pixels of one bitplane row (NES/GB/SNES planar rows)
+BIT_REVERSE = np.array([int(f'{b:08b}'[::-1], 2) for b in range(256)], dtype=np.uint8)
+
+
+# =============================================================================
+# Tile Layouts
+# =============================================================================
+
+class TileLayout:
+    """
+    Byte layout of one tile, expressed as the gathers that flip it.
+
+    Attributes:
+        name: Layout name (format name for packed layouts)
+        tile_bytes: Bytes per tile
+    """
+
+    def __init__(self, name: str, tile_bytes: int,
+                 h_order: np.ndarray, v_order: np.ndarray,
+                 h_table: Optional[np.ndarray] = None):
+        """
+        Initialize a layout from its flip gathers.
+
+        Args:
+            name: Layout name
+            tile_bytes: Bytes per tile
+            h_order: Source byte index of each output byte under an H flip
+            v_order: Source byte index of each output byte under a V flip
+            h_table: Optional byte table applied after the H gather
+        """
+        self.name = name
+        self.tile_bytes = tile_bytes
+        identity = np.arange(tile_bytes, dtype=np.intp)
+        h_order = np.asarray(h_order, dtype=np.intp)
+        v_order = np.asarray(v_order, dtype=np.intp)
+
+        self._orders = {
+            TileTransform.NORMAL: identity,
+            TileTransform.FLIP_H: h_order,
+            TileTransform.FLIP_V: v_order,
+            TileTransform.FLIP_HV: v_order[h_order],
+        }
+        self._tables = {
+            TileTransform.NORMAL: None,
+            TileTransform.FLIP_H: h_table,
+            TileTransform.FLIP_V: None,
+            TileTransform.FLIP_HV: h_table,
+        }
+        # Scalar path: itemgetter gathers, bytes.translate applies the table
+        self._getters = {t: itemgetter(*order.tolist()) for t, order in self._orders.items()}
+        self._translations = {t: (table.tobytes() if table is not None else None)
+                              for t, table in self._tables.items()}
+
+    def __repr__(self) -> str:
+        return f"TileLayout({self.name!r}, tile_bytes={self.tile_bytes})"
+
+    @classmethod
+    def chunky(cls, width: int = 8, height: int = 8, bytes_per_pixel: int = 1,
+               name: str = 'chunky') -> 'TileLayout':
+        """
+        Layout for one or more whole bytes per pixel, rows top to bottom.
+
+        Covers indexed (1 byte) and RGBA (4 byte) pixel tiles.
+        """
+        grid = np.arange(width * height * bytes_per_pixel).reshape(height, width, bytes_per_pixel)
+        return cls(name, grid.size, grid[:, ::-1].ravel(), grid[::-1].ravel())
+
+    @classmethod
+    def packed_4bpp(cls, width: int = 8, height: int = 8,
+                    name: str = 'genesis') -> 'TileLayout':
+        """Layout for 4bpp chunky tiles, two pixels per byte, high nibble first."""
+        grid = np.arange(width * height // 2).reshape(height, width // 2)
+        return cls(name, grid.size, grid[:, ::-1].ravel(), grid[::-1].ravel(), NIBBLE_SWAP)
+
+    @classmethod
+    def planar(cls, height: int = 8, groups: int = 2, planes_per_group: int = 1,
+               name: str = 'planar') -> 'TileLayout':
+        """
+        Layout for 8-pixel-wide bitplane tiles.
+
+        The tile is `groups` blocks stored one after another. Each block holds
+        `height` rows of `planes_per_group` interleaved plane bytes.
+        NES/GB (as exported here) is 2 groups of 1 plane, SNES 4bpp is
+        2 groups of 2 planes.
+        """
+        grid = np.arange(groups * height * planes_per_group).reshape(
+            groups, height, planes_per_group)
+        return cls(name, grid.size, grid.ravel(), grid[:, ::-1].ravel(), BIT_REVERSE)
+
+    @classmethod
+    def for_format(cls, fmt: str) -> 'TileLayout':
+        """
+        Layout for a packed platform tile format.
+
+        Args:
+            fmt: Format name ('genesis', 'nes', 'snes', 'gameboy')
+
+        Raises:
+            ValueError: Unknown format
+        """
+        try:
+            return FORMAT_LAYOUTS[fmt]
+        except KeyError:
+            raise ValueError(f"Unknown tile format: {fmt!r}. "
+                             f"Valid: {', '.join(FORMAT_LAYOUTS)}") from None
+
+    def flip(self, tiles: np.ndarray, transform: TileTransform) -> np.ndarray:
+        """
+        Apply a transform to a batch of tiles.
+
+        Args:
+            tiles: (N, tile_bytes) uint8 array
+            transform: Transform to apply
+
+        Returns:
+            (N, tile_bytes) uint8 array
+        """
+        rows = tiles[:, self._orders[transform]]
+        table = self._tables[transform]
+        return table[rows] if table is not None else rows
+
+    def flip_bytes(self, tile: bytes, transform: TileTransform) -> bytes:
+        """Apply a transform to a single tile's bytes."""
+        flipped = bytes(self._getters[transform](tile))
+        translation = self._translations[transform]
+        return flipped.translate(translation) if translation is not None else flipped
+
+    def transforms(self, allow_h: bool = True, allow_v: bool = True) -> List[TileTransform]:
+        """Transforms checked for a flip setting, in match precedence order."""
+        transforms = [TileTransform.NORMAL]
+        if allow_h:
+            transforms.append(TileTransform.FLIP_H)
+        if allow_v:
+            transforms.append(TileTransform.FLIP_V)
+        if allow_h and allow_v:
+            transforms.append(TileTransform.FLIP_HV)
+        return transforms
+
+
+#: Layouts of the packed formats in genesis_export.TileFormat
+FORMAT_LAYOUTS: Dict[str, TileLayout] = {
+    'genesis': TileLayout.packed_4bpp(name='genesis'),
+    'nes': TileLayout.planar(groups=2, planes_per_group=1, name='nes'),
+    'snes': TileLayout.planar(groups=2, planes_per_group=2, name='snes'),
+    'gameboy': TileLayout.planar(groups=2, planes_per_group=1, name='gameboy'),
+}
+
+
+# =============================================================================
+# Deduplication
+# =============================================================================
+
+@dataclass
+class DedupResult:
+    """
+    Result of dedup_tiles.
+
+    The first tile of each group (input order) is the stored unique tile.
+    Other tiles reference it with the first matching transform in the order
+    NORMAL, FLIP_H, FLIP_V, FLIP_HV.
+
+    Attributes:
+        unique_indices: Input index of each unique tile
+        tile_indices: Unique tile index for every input tile
+        transforms: TileTransform value for every input tile
+    """
+    unique_indices: np.ndarray
+    tile_indices: np.ndarray
+    transforms: np.ndarray
+
+    @property
+    def unique_count(self) -> int:
+        """Number of unique tiles."""
+        return len(self.unique_indices)
+
+    def transform_counts(self) -> Dict[TileTransform, int]:
+        """Number of tiles using each transform (unique tiles count as NORMAL)."""
+        counts = np.bincount(self.transforms.astype(np.intp), minlength=len(TileTransform))
+        return {t: int(counts[t]) for t in TileTransform}
+
+    def reference_counts(self) -> np.ndarray:
+        """How many input tiles reference each unique tile."""
+        return np.bincount(self.tile_indices, minlength=self.unique_count)
+
+
+def dedup_tiles(tiles: np.ndarray, layout: TileLayout,
+                allow_h: bool = True, allow_v: bool = True) -> DedupResult:
+    """
+    Group tiles that are identical up to the allowed flips.
+
+    Matches the classic raster-order search: a tile joins the first earlier
+    unique tile equal to any of its allowed orientations.
+
+    Args:
+        tiles: (N, ...) uint8 array with layout.tile_bytes bytes per tile
+        layout: Byte layout of the tiles
+        allow_h: Allow horizontal flip matches
+        allow_v: Allow vertical flip matches
+
+    Returns:
+        DedupResult
+    """
+    n = len(tiles)
+    if n == 0:
+        return DedupResult(np.empty(0, dtype=np.intp), np.empty(0, dtype=np.intp),
+                           np.empty(0, dtype=np.int8))
+    tiles = np.ascontiguousarray(tiles, dtype=np.uint8).reshape(n, layout.tile_bytes)
+
+    orientations = [(t, _as_words(layout.flip(tiles, t)))
+                    for t in layout.transforms(allow_h, allow_v)]
+
+    # Canonical key: lexicographic minimum over the allowed orientations
+    canonical = orientations[0][1]
+    for _, rows in orientations[1:]:
+        canonical = _lex_min(canonical, rows)
+
+    unique_indices, tile_indices = _group_first_seen(_hash_rows(canonical))
+    if not (canonical == canonical[unique_indices[tile_indices]]).all():
+        # 64-bit hash collision: regroup on the full key
+        _, first, inverse = np.unique(canonical, axis=0, return_index=True, return_inverse=True)
+        unique_indices, tile_indices = _first_seen_order(first, inverse.reshape(-1))
+
+    # Transform: first orientation of each tile equal to its unique tile
+    reference = orientations[0][1][unique_indices[tile_indices]]
+    transforms = np.full(n, -1, dtype=np.int8)
+    for transform, rows in orientations:
+        hit = (transforms < 0) & (rows == reference).all(axis=1)
+        transforms[hit] = transform
+
+    return DedupResult(unique_indices, tile_indices, transforms)
+
+
+def tiles_from_bytes(data: bytes, layout: TileLayout) -> np.ndarray:
+    """View concatenated tile data as an (N, tile_bytes) uint8 array."""
+    if len(data) % layout.tile_bytes:
+        raise ValueError(f"{layout.name} tile data must be a multiple of "
+                         f"{layout.tile_bytes} bytes, got {len(data)}")
+    return np.frombuffer(data, dtype=np.uint8).reshape(-1, layout.tile_bytes)
+
+
+# =============================================================================
+# Helpers
+# =============================================================================
+
+_HASH_SEED = np.uint64(0xCBF29CE484222325)
+_HASH_MULTIPLIER = np.uint64(0x9E3779B97F4A7C15)
+
+
+def _as_words(rows: np.ndarray) -> np.ndarray:
+    """View (N, L) uint8 rows as uint64 words, zero-padding L to a multiple of 8."""
+    pad = -rows.shape[1] % 8
+    if pad:
+        rows = np.pad(rows, ((0, 0), (0, pad)))
+    return np.ascontiguousarray(rows).view(np.uint64)
+
+
+def _lex_min(a: np.ndarray, b: np.ndarray) -> np.ndarray:
+    """
+    Row-wise lexicographic minimum of two (N, L) arrays.
+
+    Over uint64 words this is not byte order, but it is still a total order
+    on rows, which is all a flip-invariant key needs.
+    """
+    differ = a != b
+    first = differ.argmax(axis=1)
+    rows = np.arange(len(a))
+    take_b = differ[rows, first] & (b[rows, first] < a[rows, first])
+    return np.where(take_b[:, np.newaxis], b, a)
+
+
+def _hash_rows(words: np.ndarray) -> np.ndarray:
+    """64-bit multiply-xorshift hash of each row of uint64 words."""
+    h = np.full(len(words), _HASH_SEED, dtype=np.uint64)
+    for column in words.T:
+        h ^= column
+        h *= _HASH_MULTIPLIER
+        h ^= h >> np.uint64(32)
+    return h
+
+
+def _group_first_seen(keys: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
+    """Group equal keys, numbering groups by first occurrence."""
+    _, first, inverse = np.unique(keys, return_index=True, return_inverse=True)
+    return _first_seen_order(first, inverse.reshape(-1))
+
+
+def _first_seen_order(first: np.ndarray, inverse: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
+    """Renumber np.unique groups (sorted by key) into first-occurrence order."""
+    order = np.argsort(first, kind='stable')
+    rank = np.empty_like(order)
+    rank[order] = np.arange(len(order))
+    return first[order].astype(np.intp), rank[inverse].astype(np.intp)
@@ -0,0 +1,331 @@
+"""
+Lossy Tile Merging.
+
+Merges unique tiles that differ in only a few pixels, so a tile bank that
+overshoots its VRAM budget can be brought back under it without manual
+repainting.
+
+Tile distance is the number of differing pixels, minimized over the allowed
+flips. Pixels are re-coded to the fewest bits that keep colours distinct,
+tiles are packed into Python ints and compared with XOR, a per-pixel bit
+fold and int.bit_count(), and neighbours are found with a BK-tree, so only
+a fraction of the bank is compared for small radii.
+
+Two modes, usable together:
+    - Threshold: cluster tiles within `threshold` pixels of a more-used
+      representative tile.
+    - Target count: merge the closest clusters, radius 1 upwards and
+      least-used first, until at most `target_count` tiles remain.
+
+Every tile ends up within the final radius (threshold or max_distance) of
+the tile that replaces it; merges are never chained past that bound.
+
+Usage:
+    >>> from pipeline.optimization.tile_merge import merge_similar_tiles
+    >>> merge = merge_similar_tiles(unique_tiles, weights, target_count=256)
+    >>> bank = unique_tiles[merge.kept]
+"""
+
+from dataclasses import dataclass
+from typing import Callable, Dict, List, Optional, Tuple
+
+import numpy as np
+
+from .tile_dedup import TileLayout, TileTransform
+
+
+# =============================================================================
+# BK-Tree
+# =============================================================================
+
+class BKTree:
+    """
+    Burkhard-Keller tree over an integer metric.
+
+    Nodes are [key, value, children] lists; children map the distance to
+    the parent onto the child node.
+    """
+
+    def __init__(self, distance: Callable[[int, int], int]):
+        """
+        Initialize an empty tree.
+
+        Args:
+            distance: Metric between two values
+        """
+        self.distance = distance
+        self._root: Optional[list] = None
+        self._size = 0
+
+    def __len__(self) -> int:
+        return self._size
+
+    def add(self, key: int, value: int):
+        """Insert a value under an integer key."""
+        self._size += 1
+        if self._root is None:
+            self._root = [key, value, {}]
+            return
+        node = self._root
+        while True:
+            d = self.distance(value, node[1])
+            child = node[2].get(d)
+            if child is None:
+                node[2][d] = [key, value, {}]
+                return
+            node = child
+
+    def nearest(self, value: int, radius: int,
+                accept: Optional[Callable[[int], bool]] = None) -> Optional[Tuple[int, int]]:
+        """
+        Closest accepted entry within radius.
+
+        Args:
+            value: Query value
+            radius: Maximum distance
+            accept: Optional key filter
+
+        Returns:
+            (distance, key), smallest key on ties, or None
+        """
+        if self._root is None:
+            return None
+        best: Optional[Tuple[int, int]] = None
+        stack = [self._root]
+        while stack:
+            key, node_value, children = stack.pop()
+            d = self.distance(value, node_value)
+            if d <= radius and (accept is None or accept(key)):
+                if best is None or (d, key) < best:
+                    best = (d, key)
+                    radius = d
+            for edge, child in children.items():
+                if d - radius <= edge <= d + radius:
+                    stack.append(child)
+        return best
+
+
+# =============================================================================
+# Pixel Distance
+# =============================================================================
+
+def pixel_distance(pixel_count: int, bits_per_pixel: int) -> Callable[[int, int], int]:
+    """
+    Metric counting differing pixels between tiles packed into ints.
+
+    XOR leaves non-zero bits in every differing pixel. Folding each pixel's
+    bits onto its lowest bit and masking leaves one bit per differing pixel.
+
+    Args:
+        pixel_count: Pixels per tile
+        bits_per_pixel: Packed pixel width (a power of two)
+    """
+    shifts = []
+    shift = 1
+    while shift < bits_per_pixel:
+        shifts.append(shift)
+        shift *= 2
+    mask = sum(1 << (bits_per_pixel * i) for i in range(pixel_count))
+
+    def distance(a: int, b: int) -> int:
+        x = a ^ b
+        for s in shifts:
+            x |= x >> s
+        return (x & mask).bit_count()
+
+    return distance
+
+
+def pack_tiles(pixels: np.ndarray) -> Tuple[np.ndarray, int]:
+    """
+    Re-code tile pixels with the fewest bits that keep colours distinct.
+
+    Only pixel equality matters to the distance, so each distinct pixel
+    value is replaced by a small code and packed `8 // bits` codes per byte.
+    With more than 256 colours codes take 16 (or 32) bits each, so the
+    width stays a power of two as pixel_distance requires.
+
+    Args:
+        pixels: (N, P, C) uint8 tile pixels
+
+    Returns:
+        ((N, bytes) uint8 packed rows, bits per pixel)
+    """
+    n, count, channels = pixels.shape
+    flat = np.ascontiguousarray(pixels).view(np.dtype((np.void, channels))).reshape(-1)
+    _, codes = np.unique(flat, return_inverse=True)
+    codes = codes.reshape(n, count)
+
+    bits = 1
+    while (1 << bits) <= codes.max():
+        bits *= 2
+    if bits > 8:
+        wide = np.dtype('<u2') if codes.max() <= 0xFFFF else np.dtype('<u4')
+        return codes.astype(wide).view(np.uint8).reshape(n, -1), wide.itemsize * 8
+
+    per_byte = 8 // bits
+    codes = np.pad(codes, ((0, 0), (0, -count % per_byte)))
+    codes = codes.reshape(n, -1, per_byte).astype(np.uint8)
+    packed = np.zeros(codes.shape[:2], dtype=np.uint8)
+    for j in range(per_byte):
+        packed |= codes[:, :, j] << (bits * j)
+    return packed, bits
+
+
+# =============================================================================
+# Merging
+# =============================================================================
+
+@dataclass
+class MergeResult:
+    """
+    Result of merge_similar_tiles.
+
+    Tile i is approximated by kept tile mapping[i] with transforms[i]
+    applied, which differs from it in errors[i] pixels.
+
+    Attributes:
+        kept: Input indices of the surviving tiles, ascending
+        mapping: Index into `kept` for every input tile
+        transforms: TileTransform value for every input tile
+        errors: Differing pixels for every input tile
+    """
+    kept: np.ndarray
+    mapping: np.ndarray
+    transforms: np.ndarray
+    errors: np.ndarray
+
+    @property
+    def merged_count(self) -> int:
+        """Number of tiles merged away."""
+        return len(self.mapping) - len(self.kept)
+
+    @property
+    def max_error(self) -> int:
+        """Largest pixel difference introduced for any tile."""
+        return int(self.errors.max()) if len(self.errors) else 0
+
+
+def merge_similar_tiles(tiles: np.ndarray,
+                        weights: Optional[np.ndarray] = None,
+                        allow_h: bool = True,
+                        allow_v: bool = True,
+                        threshold: int = 0,
+                        target_count: Optional[int] = None,
+                        max_distance: Optional[int] = None) -> MergeResult:
+    """
+    Merge near-duplicate tiles.
+
+    Args:
+        tiles: (N, H, W[, C]) uint8 unique tiles
+        weights: Usage count per tile (more-used tiles survive), default 1
+        allow_h: Allow horizontal flips when comparing
+        allow_v: Allow vertical flips when comparing
+        threshold: Merge tiles within this many differing pixels
+        target_count: Keep merging closest tiles until at most this many remain
+        max_distance: Largest radius target mode may reach (default: tile
+            pixel count); the target may then be missed
+
+    Returns:
+        MergeResult
+    """
+    n = len(tiles)
+    if n == 0:
+        empty = np.empty(0, dtype=np.intp)
+        return MergeResult(empty, empty, np.empty(0, dtype=np.int8), np.empty(0, dtype=np.int32))
+    tiles = np.ascontiguousarray(tiles, dtype=np.uint8)
+    if tiles.ndim == 3:
+        tiles = tiles[..., np.newaxis]
+    weights = np.ones(n, dtype=np.int64) if weights is None else np.asarray(weights)
+
+    height, width, channels = tiles.shape[1:]
+    pixel_count = height * width
+    layout = TileLayout.chunky(width, height, channels)
+    rows = tiles.reshape(n, -1)
+
+    # Each tile packed as an int, for every allowed orientation
+    transforms = layout.transforms(allow_h, allow_v)
+    packed: Dict[TileTransform, List[int]] = {}
+    for t in transforms:
+        codes, bits = pack_tiles(layout.flip(rows, t).reshape(n, pixel_count, channels))
+        packed[t] = [int.from_bytes(row.tobytes(), 'little') for row in codes]
+    distance = pixel_distance(pixel_count, bits)
+
+    # members[rep] = [(tile, transform)] with tile ~ transform(rep)
+    members: Dict[int, List[Tuple[int, int]]] = {}
+    weight = [int(w) for w in weights]
+
+    def find_nearest(tree: BKTree, i: int, radius: int,
+                     accept: Optional[Callable[[int], bool]] = None) -> Optional[Tuple[int, int, int]]:
+        best = None
+        for t in transforms:
+            hit = tree.nearest(packed[t][i], radius, accept)
+            if hit is not None and (best is None or hit < best[:2]):
+                best = (hit[0], hit[1], int(t))
+                radius = hit[0]
+        return best
+
+    # Threshold mode: leader clustering, most-used tiles lead
+    tree = BKTree(distance)
+    for i in sorted(range(n), key=lambda i: (-weight[i], i)):
+        hit = find_nearest(tree, i, threshold) if threshold > 0 else None
+        if hit is not None:
+            _, rep, t = hit
+            members[rep].append((i, t))
+            weight[rep] += weight[i]
+        else:
+            tree.add(i, packed[TileTransform.NORMAL][i])
+            members[i] = [(i, 0)]
+
+    # Target mode: merge closest clusters, least used first. A cluster only
+    # merges if every member stays within the radius of the new
+    # representative (flips compose by XOR of the H/V bits).
+    alive = set(members)
+    limit = pixel_count if max_distance is None else max_distance
+    radius = max(threshold, 0)
+    while target_count is not None and len(alive) > target_count and radius < limit:
+        radius += 1
+        tree = BKTree(distance)
+        for rep in sorted(alive):
+            tree.add(rep, packed[TileTransform.NORMAL][rep])
+
+        received = set()
+        for rep in sorted(alive, key=lambda i: (weight[i], -i)):
+            if len(alive) <= target_count:
+                break
+            if rep in received:
+                continue
+            hit = find_nearest(tree, rep, radius,
+                               accept=lambda k, rep=rep: k != rep and k in alive)
+            if hit is None:
+                continue
+            _, into, t = hit
+            target = packed[TileTransform.NORMAL][into]
+            if any(distance(packed[tm ^ t][m], target) > radius for m, tm in members[rep]):
+                continue
+            members[into].extend((m, tm ^ t) for m, tm in members.pop(rep))
+            weight[into] += weight[rep]
+            alive.discard(rep)
+            received.add(into)
+
+    resolved_rep = np.empty(n, dtype=np.intp)
+    resolved_t = np.zeros(n, dtype=np.int8)
+    for rep, group in members.items():
+        for m, t in group:
+            resolved_rep[m], resolved_t[m] = rep, t
+
+    kept = np.array(sorted(alive), dtype=np.intp)
+    slot = np.empty(n, dtype=np.intp)
+    slot[kept] = np.arange(len(kept))
+
+    # Actual error of every tile against its flipped representative
+    errors = np.zeros(n, dtype=np.int32)
+    for t in range(len(TileTransform)):
+        members = np.flatnonzero(resolved_t == t)
+        if len(members):
+            approx = layout.flip(rows[resolved_rep[members]], TileTransform(t))
+            diff = (approx != rows[members]).reshape(len(members), pixel_count, channels)
+            errors[members] = diff.any(axis=2).sum(axis=1)
+
+    return MergeResult(kept=kept, mapping=slot[resolved_rep],
+                       transforms=resolved_t, errors=errors)
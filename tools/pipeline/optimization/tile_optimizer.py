@@ -10,23 +10,24 @@ Usage:
     >>> result = optimizer.optimize_image(sprite_image)
     >>> print(f"Reduced from {result.original_tile_count} to {result.unique_tile_count} tiles")
     >>> print(f"VRAM savings: {result.savings_bytes} bytes")
+
+Performance Notes:
+    The image is reshaped into an (N, H, W, C) tile tensor in one step and
+    grouped by the shared dedup core (tile_dedup.dedup_tiles), which also
+    backs the Genesis and NES exporters. Only unique tiles become PIL images.
 """
 
 from typing import List, Dict, Any, Optional, Tuple
 from pathlib import Path
 from PIL import Image
 from dataclasses import dataclass
-from enum import IntEnum
 import hashlib
 import json
 
+import numpy as np
 
-class TileTransform(IntEnum):
-    """Tile transformation flags."""
-    NORMAL = 0
-    FLIP_H = 1  # Horizontal flip
-    FLIP_V = 2  # Vertical flip
-    FLIP_HV = 3  # Both flips (180° rotation)
+from .tile_dedup import TileLayout, TileTransform, dedup_tiles
+from .tile_merge import merge_similar_tiles
 
 
 @dataclass
@@ -77,6 +78,8 @@ class OptimizationStats:
     savings_percent: float
     vram_used_bytes: int
     vram_used_percent: float
+    lossy_merges: int = 0
+    max_merge_error: int = 0
 
     def to_dict(self) -> Dict[str, Any]:
         """Convert to dictionary format."""
@@ -91,10 +94,16 @@ class OptimizationStats:
             'savings_percent': round(self.savings_percent, 2),
             'vram_used_bytes': self.vram_used_bytes,
             'vram_used_percent': round(self.vram_used_percent, 2),
+            'lossy_merges': self.lossy_merges,
+            'max_merge_error': self.max_merge_error,
         }
 
     def __str__(self) -> str:
         """Human-readable statistics."""
+        lossy = ""
+        if self.lossy_merges:
+            lossy = (f"\n  Lossy Merges: {self.lossy_merges} "
+                     f"(max {self.max_merge_error} px differ)")
         return (
             f"Tile Optimization Results:\n"
             f"  Original Tiles: {self.original_tile_count}\n"
@@ -105,6 +114,7 @@ class OptimizationStats:
             f"  HV-Flip Matches: {self.hv_flip_matches}\n"
             f"  Savings: {self.savings_bytes} bytes ({self.savings_percent:.1f}%)\n"
             f"  VRAM Used: {self.vram_used_bytes} bytes ({self.vram_used_percent:.1f}%)"
+            f"{lossy}"
         )
 
 
@@ -204,6 +214,8 @@ class TileOptimizer:
     - Flip detection (use H/V flip instead of storing duplicates)
     - Palette remapping (share tiles across sprites)
     - VRAM budget tracking (Genesis: 64KB, NES: 8KB CHR-ROM per bank)
+    - Lossy merging of near-duplicate tiles, optionally until the bank fits
+      the VRAM budget
 
     Usage:
         >>> optimizer = TileOptimizer(tile_width=8, tile_height=8)
@@ -220,13 +232,26 @@ class TileOptimizer:
         'gba': 96 * 1024,          # 96KB tile VRAM
     }
 
+    # Bits per pixel of each platform's native tile format (VRAM is spent
+    # on converted tiles, not on the RGBA working copies)
+    TILE_BPP = {
+        'genesis': 4,
+        'nes': 2,
+        'snes': 4,
+        'gameboy': 2,
+        'gba': 4,
+    }
+
     def __init__(self,
                  tile_width: int = 8,
                  tile_height: int = 8,
                  allow_mirror_x: bool = True,
                  allow_mirror_y: bool = True,
                  platform: str = 'genesis',
-                 vram_budget: Optional[int] = None):
+                 vram_budget: Optional[int] = None,
+                 merge_threshold: int = 0,
+                 fit_vram_budget: bool = False,
+                 max_merge_distance: Optional[int] = None):
         """
         Initialize tile optimizer.
 
@@ -237,12 +262,21 @@ class TileOptimizer:
             allow_mirror_y: Allow vertical flip for matching
             platform: Target platform for VRAM limits
             vram_budget: Override VRAM budget (bytes)
+            merge_threshold: Merge tiles differing in at most this many pixels
+                (0 = lossless)
+            fit_vram_budget: Merge the closest tiles until the bank fits the
+                VRAM budget
+            max_merge_distance: Never merge tiles differing in more pixels
+                than this when fitting the budget (default: no limit)
         """
         self.tile_width = tile_width
         self.tile_height = tile_height
         self.allow_mirror_x = allow_mirror_x
         self.allow_mirror_y = allow_mirror_y
         self.platform = platform.lower()
+        self.merge_threshold = merge_threshold
+        self.fit_vram_budget = fit_vram_budget
+        self.max_merge_distance = max_merge_distance
 
         # Set VRAM budget
         if vram_budget is not None:
@@ -282,38 +316,31 @@ class TileOptimizer:
         grid_height = padded_height // self.tile_height
         total_tiles = grid_width * grid_height
 
-        # Reset statistics
-        self._h_flip_count = 0
-        self._v_flip_count = 0
-        self._hv_flip_count = 0
-
-        # Extract and deduplicate tiles
-        unique_tiles = []
-        tile_map = []
-        seen_hashes = {}  # Hash -> (index, transform)
+        # Extract all tiles in raster order and deduplicate them in bulk
+        tiles = extract_tiles(padded_img, self.tile_width, self.tile_height)
+        first_indices, tile_indices, transforms = self._dedup_tiles(tiles)
 
-        for row in range(grid_height):
-            for col in range(grid_width):
-                # Extract tile
-                x = col * self.tile_width
-                y = row * self.tile_height
-                tile = padded_img.crop((x, y, x + self.tile_width, y + self.tile_height))
+        # Optional lossy pass over the exact-dedup bank
+        lossy_merges, max_merge_error = 0, 0
+        if self.merge_threshold > 0 or self.fit_vram_budget:
+            first_indices, tile_indices, transforms, merge = self._merge_tiles(
+                tiles, first_indices, tile_indices, transforms)
+            lossy_merges, max_merge_error = merge.merged_count, merge.max_error
 
-                # Try to find existing match
-                tile_ref = self._find_tile_match(tile, unique_tiles, seen_hashes)
+        unique_tiles = [Image.fromarray(tiles[i]) for i in first_indices]
+        members = list(TileTransform)
+        tile_map = [TileReference(idx, members[transform])
+                    for idx, transform in zip(tile_indices.tolist(), transforms.tolist())]
 
-                if tile_ref is None:
-                    # New unique tile
-                    idx = len(unique_tiles)
-                    unique_tiles.append(tile)
-                    tile_hash = self._hash_tile(tile)
-                    seen_hashes[tile_hash] = (idx, TileTransform.NORMAL)
-                    tile_ref = TileReference(idx, TileTransform.NORMAL)
-
-                tile_map.append(tile_ref)
+        # Flip statistics
+        self._h_flip_count = int(np.count_nonzero(transforms == TileTransform.FLIP_H))
+        self._v_flip_count = int(np.count_nonzero(transforms == TileTransform.FLIP_V))
+        self._hv_flip_count = int(np.count_nonzero(transforms == TileTransform.FLIP_HV))
 
         # Calculate statistics
         stats = self._calculate_stats(total_tiles, len(unique_tiles))
+        stats.lossy_merges = lossy_merges
+        stats.max_merge_error = max_merge_error
 
         return OptimizedTileBank(
             unique_tiles=unique_tiles,
@@ -350,6 +377,52 @@ class TileOptimizer:
 
         return img, width, height
 
+    def _dedup_tiles(self, tiles: np.ndarray) -> Tuple[List[int], np.ndarray, np.ndarray]:
+        """
+        Group tiles that are identical up to the allowed flips.
+
+        The first tile of each group (raster order) is the stored unique
+        tile. Other tiles reference it with the first matching transform in
+        the order NORMAL, FLIP_H, FLIP_V, FLIP_HV.
+
+        Args:
+            tiles: (N, tile_height, tile_width, C) uint8 tile tensor
+
+        Returns:
+            (tensor index of each unique tile, unique index per tile,
+            TileTransform value per tile)
+        """
+        channels = tiles.shape[-1] if tiles.ndim == 4 else 1
+        layout = TileLayout.chunky(self.tile_width, self.tile_height, channels, name='rgba')
+        result = dedup_tiles(tiles, layout, self.allow_mirror_x, self.allow_mirror_y)
+        return result.unique_indices.tolist(), result.tile_indices, result.transforms
+
+    def _merge_tiles(self, tiles: np.ndarray, first_indices: List[int],
+                     tile_indices: np.ndarray, transforms: np.ndarray):
+        """
+        Merge near-duplicate unique tiles (see tile_merge.merge_similar_tiles).
+
+        Returns:
+            (first_indices, tile_indices, transforms, MergeResult) remapped
+            onto the surviving tiles
+        """
+        target = self.get_max_tiles_for_budget() if self.fit_vram_budget else None
+        merge = merge_similar_tiles(
+            tiles[np.asarray(first_indices, dtype=np.intp)],
+            weights=np.bincount(tile_indices, minlength=len(first_indices)),
+            allow_h=self.allow_mirror_x,
+            allow_v=self.allow_mirror_y,
+            threshold=self.merge_threshold,
+            target_count=target,
+            max_distance=self.max_merge_distance,
+        )
+
+        # Flips compose by XOR of the H/V bits
+        transforms = transforms ^ merge.transforms[tile_indices]
+        tile_indices = merge.mapping[tile_indices]
+        first_indices = [first_indices[i] for i in merge.kept.tolist()]
+        return first_indices, tile_indices, transforms, merge
+
     def _hash_tile(self, tile: Image.Image) -> str:
         """Generate hash of tile pixels."""
         return hashlib.sha256(tile.tobytes()).hexdigest()
@@ -414,8 +487,9 @@ class TileOptimizer:
         savings_bytes = original_bytes - optimized_bytes
         savings_percent = (savings_bytes / original_bytes * 100) if original_bytes > 0 else 0.0
 
-        # Calculate VRAM usage
-        vram_used_percent = (optimized_bytes / self.vram_budget * 100) if self.vram_budget > 0 else 0.0
+        # Calculate VRAM usage (in the platform's tile format)
+        vram_used_bytes = unique_count * self.vram_bytes_per_tile
+        vram_used_percent = (vram_used_bytes / self.vram_budget * 100) if self.vram_budget > 0 else 0.0
 
         return OptimizationStats(
             original_tile_count=original_count,
@@ -426,7 +500,7 @@ class TileOptimizer:
             hv_flip_matches=self._hv_flip_count,
             savings_bytes=savings_bytes,
             savings_percent=savings_percent,
-            vram_used_bytes=optimized_bytes,
+            vram_used_bytes=vram_used_bytes,
             vram_used_percent=vram_used_percent,
         )
 
@@ -440,8 +514,7 @@ class TileOptimizer:
         Returns:
             (fits_in_budget, used_bytes, available_bytes)
         """
-        bytes_per_tile = self.tile_width * self.tile_height * 4
-        used_bytes = tile_count * bytes_per_tile
+        used_bytes = tile_count * self.vram_bytes_per_tile
         fits = used_bytes <= self.vram_budget
 
         return fits, used_bytes, self.vram_budget
@@ -453,8 +526,40 @@ class TileOptimizer:
         Returns:
             Maximum tile count
         """
-        bytes_per_tile = self.tile_width * self.tile_height * 4
-        return self.vram_budget // bytes_per_tile
+        return self.vram_budget // self.vram_bytes_per_tile
+
+    @property
+    def vram_bytes_per_tile(self) -> int:
+        """Bytes one tile occupies in VRAM in the platform's tile format."""
+        bpp = self.TILE_BPP.get(self.platform, 4)
+        return max(1, self.tile_width * self.tile_height * bpp // 8)
+
+
+# =============================================================================
+# Tile Tensor Helpers
+# =============================================================================
+
+def extract_tiles(img: Image.Image, tile_width: int = 8, tile_height: int = 8) -> np.ndarray:
+    """
+    Split a grid-aligned image into a tile tensor in raster order.
+
+    Args:
+        img: Image whose size is a multiple of the tile size
+        tile_width: Tile width in pixels
+        tile_height: Tile height in pixels
+
+    Returns:
+        (N, tile_height, tile_width, C) uint8 array
+    """
+    pixels = np.asarray(img)
+    if pixels.ndim == 2:
+        pixels = pixels[:, :, np.newaxis]
+
+    height, width, channels = pixels.shape
+    grid_h, grid_w = height // tile_height, width // tile_width
+    tiles = pixels.reshape(grid_h, tile_height, grid_w, tile_width, channels)
+    return np.ascontiguousarray(tiles.transpose(0, 2, 1, 3, 4)).reshape(
+        grid_h * grid_w, tile_height, tile_width, channels)
 
 
 # =============================================================================
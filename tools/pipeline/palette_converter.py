@@ -25,6 +25,11 @@ from typing import List, Tuple, Optional, Dict
 from datetime import datetime
 import math
 
+import numpy as np
+
+from .quantization.color_kernels import srgb_to_lab, delta_e_cie76
+from .quantization.palette_lookup import get_palette_lookup
+
 
 # =============================================================================
 # PALETTE FORMAT DEFINITIONS
@@ -170,43 +175,10 @@ def rgb_to_lab(r: int, g: int, b: int) -> Tuple[float, float, float]:
     Convert RGB to CIE LAB color space for perceptual color distance.
 
     LAB is device-independent and better represents human color perception.
+    Scalar wrapper around quantization.color_kernels.srgb_to_lab.
     """
-    # Normalize RGB to 0-1
-    r_lin = r / 255.0
-    g_lin = g / 255.0
-    b_lin = b / 255.0
-
-    # Convert to linear RGB (remove gamma)
-    def linearize(c):
-        if c > 0.04045:
-            return ((c + 0.055) / 1.055) ** 2.4
-        return c / 12.92
-
-    r_lin = linearize(r_lin)
-    g_lin = linearize(g_lin)
-    b_lin = linearize(b_lin)
-
-    # Convert to XYZ (D65 illuminant)
-    x = r_lin * 0.4124564 + g_lin * 0.3575761 + b_lin * 0.1804375
-    y = r_lin * 0.2126729 + g_lin * 0.7151522 + b_lin * 0.0721750
-    z = r_lin * 0.0193339 + g_lin * 0.1191920 + b_lin * 0.9503041
-
-    # Normalize for D65 white point
-    x /= 0.95047
-    y /= 1.00000
-    z /= 1.08883
-
-    # Convert to LAB
-    def f(t):
-        if t > 0.008856:
-            return t ** (1/3)
-        return (7.787 * t) + (16/116)
-
-    l = (116 * f(y)) - 16
-    a = 500 * (f(x) - f(y))
-    b_val = 200 * (f(y) - f(z))
-
-    return (l, a, b_val)
+    L, a, b_val = srgb_to_lab(np.array([r, g, b], dtype=np.float64)).tolist()
+    return (L, a, b_val)
 
 
 def color_distance_lab(c1: Tuple[int, int, int], c2: Tuple[int, int, int]) -> float:
@@ -215,14 +187,8 @@ def color_distance_lab(c1: Tuple[int, int, int], c2: Tuple[int, int, int]) -> fl
 
     Lower values = more similar colors.
     """
-    lab1 = rgb_to_lab(*c1)
-    lab2 = rgb_to_lab(*c2)
-
-    dl = lab1[0] - lab2[0]
-    da = lab1[1] - lab2[1]
-    db = lab1[2] - lab2[2]
-
-    return math.sqrt(dl*dl + da*da + db*db)
+    lab = srgb_to_lab(np.array([c1[:3], c2[:3]], dtype=np.float64))
+    return float(delta_e_cie76(lab[0], lab[1]))
 
 
 def color_distance_rgb(c1: Tuple[int, int, int], c2: Tuple[int, int, int]) -> float:
@@ -253,7 +219,7 @@ class PaletteConverter:
             use_perceptual: Use LAB color space for matching (slower but better)
         """
         self.use_perceptual = use_perceptual
-        self._distance_func = color_distance_lab if use_perceptual else color_distance_rgb
+        self._nes_lookup = get_palette_lookup(NES_PALETTE, 'CIELab' if use_perceptual else 'RGB')
 
     # =========================================================================
     # MAIN CONVERSION API
@@ -418,16 +384,7 @@ class PaletteConverter:
         Returns:
             NES palette index (0-63)
         """
-        best_idx = 0
-        best_dist = float('inf')
-
-        for idx, nes_color in enumerate(NES_PALETTE):
-            dist = self._distance_func(rgb, nes_color)
-            if dist < best_dist:
-                best_dist = dist
-                best_idx = idx
-
-        return best_idx
+        return self._nes_lookup.nearest_one(tuple(rgb[:3]))
 
     def find_nearest_nes(self, rgb: Tuple[int, int, int]) -> int:
         """Public API for finding nearest NES palette index."""
@@ -63,61 +63,23 @@ Phase Implementation:
 
 import json
 import os
-import math
 from typing import List, Tuple, Dict, Optional, Set
 from dataclasses import dataclass, field
 from enum import Enum
 from datetime import datetime
 from pathlib import Path
 
+from .quantization.palette_lookup import get_palette_lookup
+from .dependency_graph import write_if_changed
+
 # Import from sibling modules
 try:
-    from .palette_converter import (
-        PaletteConverter, PaletteFormat, rgb_to_lab, color_distance_lab
-    )
+    from .palette_converter import PaletteConverter, PaletteFormat
 except ImportError:
     # Fallback for standalone testing
     PaletteConverter = None
     PaletteFormat = None
 
-    def rgb_to_lab(r: int, g: int, b: int) -> Tuple[float, float, float]:
-        """Convert RGB to CIE LAB for perceptual color comparison."""
-        # Normalize RGB to 0-1
-        r, g, b = r / 255.0, g / 255.0, b / 255.0
-
-        # sRGB to linear
-        def linearize(c):
-            return c / 12.92 if c <= 0.04045 else ((c + 0.055) / 1.055) ** 2.4
-
-        r, g, b = linearize(r), linearize(g), linearize(b)
-
-        # Linear RGB to XYZ
-        x = r * 0.4124564 + g * 0.3575761 + b * 0.1804375
-        y = r * 0.2126729 + g * 0.7151522 + b * 0.0721750
-        z = r * 0.0193339 + g * 0.1191920 + b * 0.9503041
-
-        # XYZ to LAB (D65 illuminant)
-        xn, yn, zn = 0.95047, 1.0, 1.08883
-        x, y, z = x / xn, y / yn, z / zn
-
-        def f(t):
-            return t ** (1/3) if t > 0.008856 else (7.787 * t) + (16 / 116)
-
-        L = (116 * f(y)) - 16
-        a = 500 * (f(x) - f(y))
-        b_val = 200 * (f(y) - f(z))
-
-        return (L, a, b_val)
-
-    def color_distance_lab(lab1: Tuple[float, float, float],
-                           lab2: Tuple[float, float, float]) -> float:
-        """Calculate perceptual color distance (Delta E)."""
-        return math.sqrt(
-            (lab1[0] - lab2[0]) ** 2 +
-            (lab1[1] - lab2[1]) ** 2 +
-            (lab1[2] - lab2[2]) ** 2
-        )
-
 
 class PalettePurpose(Enum):
     """
@@ -148,9 +110,9 @@ class PaletteSlot:
     - SNES: 16 colors per slot
     - GameBoy: 4 grayscale levels
 
-    The slot includes cached CIE LAB color values for fast perceptual
-    color matching, allowing efficient nearest-color lookups without
-    repeated RGB-to-LAB conversions.
+    Nearest-color matching uses the shared PaletteLookup for the slot's
+    colors, so LAB values and answered colors are cached per palette
+    rather than per slot.
 
     Attributes:
         index: Hardware palette index (0-3 for Genesis, determines CRAM offset).
@@ -175,17 +137,6 @@ class PaletteSlot:
     locked: bool = False
     description: str = ""
 
-    # Pre-computed LAB values for O(1) perceptual color matching
-    _lab_cache: List[Tuple[float, float, float]] = field(default_factory=list, repr=False)
-
-    def __post_init__(self):
-        """Build LAB cache for color matching."""
-        self._rebuild_lab_cache()
-
-    def _rebuild_lab_cache(self):
-        """Rebuild LAB color cache after color changes."""
-        self._lab_cache = [rgb_to_lab(*c) for c in self.colors]
-
     @property
     def max_colors(self) -> int:
         """Maximum colors in this slot."""
@@ -212,19 +163,13 @@ class PaletteSlot:
         Returns:
             Tuple of (palette_index, distance)
         """
-        target_lab = rgb_to_lab(*rgb)
-        best_idx = 0
-        best_dist = float('inf')
-
         start_idx = 1 if skip_transparent else 0
+        if len(self.colors) <= start_idx:
+            return 0, float('inf')
 
-        for i in range(start_idx, len(self._lab_cache)):
-            dist = color_distance_lab(target_lab, self._lab_cache[i])
-            if dist < best_dist:
-                best_dist = dist
-                best_idx = i
-
-        return best_idx, best_dist
+        lookup = get_palette_lookup(self.colors[start_idx:], 'CIELab')
+        idx, dist = lookup.nearest_one_with_distance(tuple(rgb))
+        return idx + start_idx, dist
 
     def contains_color(self, rgb: Tuple[int, int, int],
                        tolerance: float = 0.0) -> bool:
@@ -925,12 +870,9 @@ class PaletteManager:
 
         content = "\n".join(lines)
 
-        output_dir = os.path.dirname(output_path)
-        if output_dir:
-            os.makedirs(output_dir, exist_ok=True)
-
-        with open(output_path, 'w', encoding='utf-8') as f:
-            f.write(content)
+        # Unchanged palettes keep the header's mtime, so C files including
+        # it are not recompiled
+        write_if_changed(output_path, content, volatile_prefix="// Generated:")
 
         return content
 
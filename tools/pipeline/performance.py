@@ -53,12 +53,31 @@ Integration with Pipeline:
         for s in detected_sprites
     ]
     report = calculator.analyze_sprite_layout(sprites_for_analysis)
+
+Timeline Analysis:
+    analyze_sprite_layout() checks one hand-built layout. For recorded
+    gameplay, analyze_timeline() takes every frame of a capture at once
+    (thousands of frames x 80 sprites) and works on arrays: per-line
+    sprite counts and pixel coverage come from prefix sums, and drop-outs
+    are resolved in VDP link order, so the report names the sprites that
+    actually vanish.
+
+    timeline = SpriteTimeline.from_file("capture.sat")   # Raw SAT dumps
+    report = calculator.analyze_timeline(timeline)
+    print(report.summary())                               # Worst frames
+    calculator.generate_timeline_heatmap(report).save("timeline.png")
+
+    From the command line (exit status 1 on drop-outs, for CI):
+        python -m pipeline.performance capture.sat [timeline.png]
 """
 
 from dataclasses import dataclass, field
-from typing import Dict, List, Optional, Tuple, Any
+from pathlib import Path
+from typing import Dict, List, Optional, Sequence, Tuple, Any, Union
 from enum import Enum
 
+import numpy as np
+
 # Optional PIL import for heatmap generation
 try:
     from PIL import Image, ImageDraw
@@ -184,6 +203,242 @@ class PerformanceReport:
         return "\n".join(lines)
 
 
+# =============================================================================
+# SPRITE TIMELINES
+# =============================================================================
+
+# Sprite Attribute Table entry: 4 big-endian words per sprite
+SAT_ENTRY_BYTES = 8
+SAT_POSITION_OFFSET = 128  # VDP coordinates start 128 pixels off-screen
+
+
+@dataclass
+class SpriteTimeline:
+    """Sprite positions for a sequence of frames, in VDP link order.
+
+    All arrays are (frames, slots). Slot k of a frame is the k-th sprite
+    the VDP visits when following the link chain from sprite 0, which is
+    the order that decides who is dropped on a busy scanline.
+
+    Attributes:
+        x, y: Screen position of each sprite (pixels, may be off-screen).
+        width, height: Sprite size in pixels.
+        visible: False for unused slots (past the end of the link chain).
+        sat_index: SAT entry of each slot (for reporting dropped sprites).
+    """
+    x: np.ndarray
+    y: np.ndarray
+    width: np.ndarray
+    height: np.ndarray
+    visible: np.ndarray
+    sat_index: np.ndarray
+
+    @property
+    def frame_count(self) -> int:
+        return self.y.shape[0]
+
+    @property
+    def slots(self) -> int:
+        return self.y.shape[1]
+
+    @classmethod
+    def from_frames(cls, frames: Sequence[Sequence[Dict[str, Any]]]) -> 'SpriteTimeline':
+        """Build from per-frame sprite dict lists (list order = link order)."""
+        count = len(frames)
+        slots = max((len(f) for f in frames), default=0)
+        x = np.zeros((count, slots), dtype=np.int32)
+        y = np.zeros_like(x)
+        width = np.zeros_like(x)
+        height = np.zeros_like(x)
+        visible = np.zeros((count, slots), dtype=bool)
+
+        for i, sprites in enumerate(frames):
+            n = len(sprites)
+            if not n:
+                continue
+            x[i, :n] = [s.get('x', 0) for s in sprites]
+            y[i, :n] = [s.get('y', 0) for s in sprites]
+            width[i, :n] = [s.get('width', 8) for s in sprites]
+            height[i, :n] = [s.get('height', 8) for s in sprites]
+            visible[i, :n] = True
+
+        sat_index = np.broadcast_to(np.arange(slots, dtype=np.int32), (count, slots)).copy()
+        return cls(x, y, width, height, visible, sat_index)
+
+    @classmethod
+    def from_sat(cls, data: bytes, sprites: int = 80) -> 'SpriteTimeline':
+        """Build from consecutive raw VDP Sprite Attribute Table dumps.
+
+        Each frame is `sprites` 8-byte entries as they sit in VRAM:
+            word 0: Y + 128 (10 bits)
+            word 1: size (hs:2 vs:2 in bits 11-8), link (bits 6-0)
+            word 2: tile attributes (ignored)
+            word 3: X + 128 (9 bits)
+
+        The link chain is followed from sprite 0 until a link of 0 (or an
+        out-of-range link), for all frames at once.
+        """
+        frame_bytes = sprites * SAT_ENTRY_BYTES
+        if len(data) % frame_bytes:
+            raise ValueError(
+                f"SAT capture is {len(data)} bytes, not a multiple of {frame_bytes} "
+                f"({sprites} sprites per frame)"
+            )
+        words = np.frombuffer(data, dtype='>u2').reshape(-1, sprites, 4).astype(np.int32)
+        count = words.shape[0]
+
+        y = (words[..., 0] & 0x3FF) - SAT_POSITION_OFFSET
+        size = (words[..., 1] >> 8) & 0xF
+        width = ((size >> 2) + 1) * 8
+        height = ((size & 3) + 1) * 8
+        link = words[..., 1] & 0x7F
+        x = (words[..., 3] & 0x1FF) - SAT_POSITION_OFFSET
+
+        # Walk every frame's chain in lockstep: one step per slot
+        rows = np.arange(count)
+        order = np.zeros((count, sprites), dtype=np.int32)
+        visible = np.zeros((count, sprites), dtype=bool)
+        current = np.zeros(count, dtype=np.int32)
+        alive = np.ones(count, dtype=bool)
+        for k in range(sprites):
+            order[:, k] = current
+            visible[:, k] = alive
+            nxt = link[rows, current]
+            alive &= (nxt != 0) & (nxt < sprites)
+            current = np.where(alive, nxt, 0)
+
+        def in_order(a: np.ndarray) -> np.ndarray:
+            return np.take_along_axis(a, order, axis=1)
+
+        return cls(in_order(x), in_order(y), in_order(width), in_order(height), visible, order)
+
+    @classmethod
+    def from_file(cls, path: Union[str, Path], sprites: int = 80) -> 'SpriteTimeline':
+        """Load a capture: .npz (arrays named like the fields) or raw SAT dumps."""
+        path = Path(path)
+        if path.suffix.lower() == '.npz':
+            with np.load(path) as data:
+                y = data['y']
+                return cls(
+                    x=data['x'], y=y, width=data['width'], height=data['height'],
+                    visible=data['visible'] if 'visible' in data else np.ones(y.shape, dtype=bool),
+                    sat_index=(data['sat_index'] if 'sat_index' in data else
+                               np.broadcast_to(np.arange(y.shape[1]), y.shape).copy()),
+                )
+        return cls.from_sat(path.read_bytes(), sprites)
+
+
+@dataclass
+class FrameSummary:
+    """Worst-case details for one frame of a timeline.
+
+    Attributes:
+        frame: Frame index in the capture.
+        sprites: Sprites in the link chain.
+        peak_sprites: Highest sprite count on any scanline.
+        peak_line: Scanline with that count.
+        peak_pixels: Highest sprite pixel coverage on any scanline.
+        dropped_lines: Scanlines where at least one sprite is dropped.
+        dropped_sprites: SAT indices of sprites losing at least one line.
+    """
+    frame: int
+    sprites: int
+    peak_sprites: int
+    peak_line: int
+    peak_pixels: int
+    dropped_lines: int = 0
+    dropped_sprites: List[int] = field(default_factory=list)
+
+
+@dataclass
+class TimelineReport:
+    """Per-frame, per-scanline analysis of a sprite timeline.
+
+    Attributes:
+        sprite_counts: (frames, lines) sprites on each scanline.
+        pixel_counts: (frames, lines) sprite pixels on each scanline.
+        dropped: (frames, lines) sprites the VDP drops on each scanline.
+        dropped_by_slot: (frames, slots) scanlines lost per link slot.
+        sprites_per_frame: (frames,) sprites in each frame's link chain.
+        worst_frames: Frames with the most drop-outs, then the busiest lines.
+        warnings: Timeline-level warnings.
+        passed: True if no frame drops sprites or exceeds the sprite limit.
+    """
+    sprite_counts: np.ndarray
+    pixel_counts: np.ndarray
+    dropped: np.ndarray
+    dropped_by_slot: np.ndarray
+    sprites_per_frame: np.ndarray
+    worst_frames: List[FrameSummary] = field(default_factory=list)
+    warnings: List[PerformanceWarning] = field(default_factory=list)
+    passed: bool = True
+
+    @property
+    def frame_count(self) -> int:
+        return self.sprite_counts.shape[0]
+
+    @property
+    def frames_with_drops(self) -> int:
+        return int(np.count_nonzero(self.dropped.any(axis=1)))
+
+    def summary(self) -> str:
+        """Generate a human-readable summary of the report."""
+        lines = [
+            "=" * 50,
+            "GENESIS TIMELINE REPORT",
+            "=" * 50,
+            f"Frames: {self.frame_count}",
+            f"Peak Sprites/Frame: {int(self.sprites_per_frame.max(initial=0))}",
+            f"Peak Sprites/Line: {int(self.sprite_counts.max(initial=0))}",
+            f"Peak Pixels/Line: {int(self.pixel_counts.max(initial=0))}",
+            f"Frames With Drop-outs: {self.frames_with_drops}",
+            "-" * 50,
+        ]
+
+        if self.worst_frames:
+            lines.append("WORST FRAMES:")
+            for f in self.worst_frames:
+                dropped = ""
+                if f.dropped_lines:
+                    dropped = (f", {f.dropped_lines} lines drop sprites "
+                               f"{f.dropped_sprites[:8]}{'...' if len(f.dropped_sprites) > 8 else ''}")
+                lines.append(f"  Frame {f.frame}: {f.peak_sprites} sprites on line {f.peak_line}, "
+                             f"{f.peak_pixels}px{dropped}")
+
+        if self.warnings:
+            lines.append("")
+            lines.append("WARNINGS:")
+            for warning in self.warnings:
+                lines.append(f"  [{warning.category}] {warning.message}")
+
+        lines.append("=" * 50)
+        lines.append(f"STATUS: {'PASS' if self.passed else 'FAIL'}")
+        lines.append("=" * 50)
+
+        return "\n".join(lines)
+
+
+def _density_color(count: int) -> Tuple[int, int, int]:
+    """Heatmap color for a scanline sprite count (traffic-light scheme)."""
+    if count == 0:
+        return (32, 32, 32)  # Dark gray - no sprites
+    elif count <= 10:
+        # Green gradient (safe)
+        intensity = int(100 + (count / 10) * 155)
+        return (0, intensity, 0)
+    elif count <= 15:
+        # Yellow gradient (caution)
+        progress = (count - 10) / 5
+        return (int(200 + progress * 55), int(200 - progress * 50), 0)
+    elif count <= 19:
+        # Orange gradient (near limit)
+        progress = (count - 15) / 4
+        return (255, int(150 - progress * 100), 0)
+    else:
+        # Red (overflow!)
+        return (255, 0, 0)
+
+
 class PerformanceBudgetCalculator:
     """Analyze sprite layouts against Genesis VDP hardware limits.
 
@@ -461,33 +716,10 @@ class PerformanceBudgetCalculator:
         img = Image.new('RGB', (width * scale, height * scale), (32, 32, 32))
         draw = ImageDraw.Draw(img)
 
-        # Color gradient function: maps sprite count to color
-        # Uses a traffic-light scheme: green=safe, yellow=caution, orange=warning, red=overflow
-        def get_color(count: int) -> Tuple[int, int, int]:
-            if count == 0:
-                return (32, 32, 32)  # Dark gray - no sprites
-            elif count <= 10:
-                # Green gradient (safe)
-                intensity = int(100 + (count / 10) * 155)
-                return (0, intensity, 0)
-            elif count <= 15:
-                # Yellow gradient (caution)
-                progress = (count - 10) / 5
-                return (int(200 + progress * 55), int(200 - progress * 50), 0)
-            elif count <= 19:
-                # Orange gradient (near limit)
-                progress = (count - 15) / 4
-                return (255, int(150 - progress * 100), 0)
-            else:
-                # Red (overflow!)
-                overflow = min(count - 20, 10)
-                intensity = 255 - (overflow * 10)
-                return (255, 0, 0)
-
         # Draw scanline colors
         for scanline in range(height):
             count = report.sprites_per_scanline.get(scanline, 0)
-            color = get_color(count)
+            color = _density_color(count)
 
             y_start = scanline * scale
             y_end = y_start + scale
@@ -522,6 +754,171 @@ class PerformanceBudgetCalculator:
 
         return img
 
+    # Elements of the (frames, slots, lines) drop-out cube processed at once
+    TIMELINE_CHUNK_CELLS = 1 << 22
+
+    def analyze_timeline(self,
+                         timeline: Union[SpriteTimeline, Sequence[Sequence[Dict[str, Any]]]],
+                         screen_height: int = None,
+                         worst: int = 10) -> TimelineReport:
+        """Analyze every frame of a recorded sprite sequence.
+
+        Per-line sprite counts and pixel coverage are built for all frames
+        at once from difference arrays and a prefix sum down the screen.
+        Frames whose busiest line stays within both limits cannot drop
+        sprites and skip the rest. For the others, a prefix sum along the
+        link chain gives each sprite's position among the sprites on each
+        line; the VDP drops a sprite on a line once max_per_line sprites
+        or MAX_PIXELS_PER_LINE pixels precede it there.
+
+        Args:
+            timeline: SpriteTimeline, or a list of per-frame sprite dict lists.
+            screen_height: Screen height for analysis (default 224).
+            worst: Number of worst frames to summarize.
+
+        Returns:
+            TimelineReport with (frames, lines) arrays and worst frames.
+
+        Example:
+            timeline = SpriteTimeline.from_file("capture.sat")
+            report = calculator.analyze_timeline(timeline)
+            assert report.passed, report.summary()
+        """
+        if not isinstance(timeline, SpriteTimeline):
+            timeline = SpriteTimeline.from_frames(timeline)
+        height = screen_height or self.screen_height
+        frames, slots = timeline.frame_count, timeline.slots
+
+        # Covered scanlines [top, bottom) per sprite; unused slots cover none
+        top = np.clip(timeline.y, 0, height)
+        bottom = np.clip(timeline.y + timeline.height, 0, height)
+        bottom = np.where(timeline.visible, np.maximum(bottom, top), top)
+        width = np.where(timeline.visible, timeline.width, 0)
+
+        # Difference arrays (+1 at top, -1 at bottom) then a prefix sum per frame
+        row = np.arange(frames)[:, None] * (height + 1)
+        cells = frames * (height + 1)
+
+        def per_line(weights: np.ndarray) -> np.ndarray:
+            diff = (np.bincount((row + top).ravel(), weights.ravel(), minlength=cells)
+                    - np.bincount((row + bottom).ravel(), weights.ravel(), minlength=cells))
+            return np.cumsum(diff.reshape(frames, height + 1), axis=1)[:, :height].astype(np.int32)
+
+        sprite_counts = per_line(np.ones_like(width))
+        pixel_counts = per_line(width)
+
+        # Link-order drop-outs, only where a limit is exceeded
+        dropped = np.zeros((frames, height), dtype=np.int32)
+        dropped_by_slot = np.zeros((frames, slots), dtype=np.int32)
+        busy = np.flatnonzero((sprite_counts.max(axis=1, initial=0) > self.max_per_line) |
+                              (pixel_counts.max(axis=1, initial=0) > self.MAX_PIXELS_PER_LINE))
+        lines = np.arange(height)
+        step = max(1, self.TIMELINE_CHUNK_CELLS // max(1, slots * height))
+        for start in range(0, len(busy), step):
+            idx = busy[start:start + step]
+            cover = ((lines >= top[idx, :, None]) & (lines < bottom[idx, :, None]))
+            rank = np.cumsum(cover, axis=1, dtype=np.int16)
+            covered_px = cover * width[idx, :, None]
+            pixels_before = np.cumsum(covered_px, axis=1, dtype=np.int32) - covered_px
+            lost = cover & ((rank > self.max_per_line) |
+                            (pixels_before >= self.MAX_PIXELS_PER_LINE))
+            dropped[idx] = lost.sum(axis=1)
+            dropped_by_slot[idx] = lost.sum(axis=2)
+
+        sprites_per_frame = timeline.visible.sum(axis=1)
+
+        # Worst frames: most dropped lines, then busiest line, then pixels
+        peak_line = sprite_counts.argmax(axis=1) if height else np.zeros(frames, dtype=int)
+        peak_sprites = sprite_counts.max(axis=1, initial=0)
+        peak_pixels = pixel_counts.max(axis=1, initial=0)
+        dropped_lines = np.count_nonzero(dropped, axis=1)
+        ranking = np.lexsort((-peak_pixels, -peak_sprites, -dropped_lines))
+        worst_frames = []
+        for f in ranking[:worst]:
+            lost_slots = np.flatnonzero(dropped_by_slot[f])
+            worst_frames.append(FrameSummary(
+                frame=int(f),
+                sprites=int(sprites_per_frame[f]),
+                peak_sprites=int(peak_sprites[f]),
+                peak_line=int(peak_line[f]),
+                peak_pixels=int(peak_pixels[f]),
+                dropped_lines=int(dropped_lines[f]),
+                dropped_sprites=sorted(int(i) for i in timeline.sat_index[f, lost_slots]),
+            ))
+
+        warnings = []
+        drop_frames = int(np.count_nonzero(dropped_lines))
+        if drop_frames:
+            warnings.append(PerformanceWarning(
+                severity=SeverityLevel.ERROR,
+                category="scanline",
+                message=f"{drop_frames}/{frames} frames drop sprites "
+                        f"(worst: frame {worst_frames[0].frame}, {worst_frames[0].dropped_lines} lines)",
+                value=drop_frames,
+            ))
+        over = np.flatnonzero(sprites_per_frame > self.max_sprites)
+        if len(over):
+            warnings.append(PerformanceWarning(
+                severity=SeverityLevel.CRITICAL,
+                category="total",
+                message=f"{len(over)} frames exceed {self.max_sprites} sprites (first: frame {over[0]})",
+                value=int(sprites_per_frame.max()),
+                limit=self.max_sprites,
+            ))
+
+        return TimelineReport(
+            sprite_counts=sprite_counts,
+            pixel_counts=pixel_counts,
+            dropped=dropped,
+            dropped_by_slot=dropped_by_slot,
+            sprites_per_frame=sprites_per_frame,
+            worst_frames=worst_frames,
+            warnings=warnings,
+            passed=not warnings,
+        )
+
+    def generate_timeline_heatmap(self,
+                                  report: TimelineReport,
+                                  max_width: int = 1024,
+                                  scale: int = 2) -> Optional['Image.Image']:
+        """Generate a frame-by-scanline heatmap of a timeline.
+
+        Columns are frames (left to right) and rows are scanlines, colored
+        like generate_heatmap(). Lines where sprites are dropped are drawn
+        magenta, so pixel-limit drop-outs below 20 sprites still stand out.
+        Captures wider than max_width are binned, keeping each bin's worst
+        value.
+
+        Args:
+            report: TimelineReport from analyze_timeline().
+            max_width: Maximum number of frame columns before binning.
+            scale: Vertical scale factor for output image (default 2x).
+
+        Returns:
+            PIL Image with heatmap visualization, or None if PIL unavailable.
+        """
+        if not HAS_PIL:
+            return None
+
+        counts, dropped = report.sprite_counts, report.dropped
+        bin_size = max(1, -(-counts.shape[0] // max_width))
+        if bin_size > 1:
+            pad = (-counts.shape[0]) % bin_size
+            counts = np.pad(counts, ((0, pad), (0, 0)))
+            dropped = np.pad(dropped, ((0, pad), (0, 0)))
+            counts = counts.reshape(-1, bin_size, counts.shape[1]).max(axis=1)
+            dropped = dropped.reshape(-1, bin_size, dropped.shape[1]).max(axis=1)
+
+        top = int(counts.max(initial=0))
+        lut = np.array([_density_color(c) for c in range(top + 1)], dtype=np.uint8)
+        rgb = lut[counts.T]
+        rgb[dropped.T > 0] = (255, 0, 255)
+
+        img = Image.fromarray(rgb, 'RGB')
+        if scale > 1:
+            img = img.resize((img.width * scale, img.height * scale), Image.NEAREST)
+        return img
+
     def suggest_optimizations(self, report: PerformanceReport) -> List[str]:
         """Generate optimization suggestions based on analysis results.
 
@@ -675,3 +1072,39 @@ def analyze_sprite_performance(sprites: List[Dict[str, Any]],
     """
     calculator = PerformanceBudgetCalculator()
     return calculator.analyze_sprite_layout(sprites, screen_height)
+
+
+def analyze_sprite_timeline(timeline: Union[SpriteTimeline, Sequence[Sequence[Dict[str, Any]]]],
+                            screen_height: int = 224) -> TimelineReport:
+    """Quick analysis of a recorded sprite sequence (see analyze_timeline).
+
+    Example:
+        report = analyze_sprite_timeline(SpriteTimeline.from_file("capture.sat"))
+        print(report.summary())
+    """
+    calculator = PerformanceBudgetCalculator()
+    return calculator.analyze_timeline(timeline, screen_height)
+
+
+# =============================================================================
+# CLI ENTRY POINT (for CI runs over gameplay captures)
+# =============================================================================
+
+if __name__ == "__main__":
+    import sys
+
+    if len(sys.argv) < 2:
+        print("Usage: python -m pipeline.performance <capture.sat|capture.npz> [heatmap.png]")
+        print("\nAnalyzes every frame of a sprite capture; exits 1 if any frame drops sprites.")
+        sys.exit(1)
+
+    calculator = PerformanceBudgetCalculator()
+    result = calculator.analyze_timeline(SpriteTimeline.from_file(sys.argv[1]))
+    print(result.summary())
+
+    if len(sys.argv) > 2:
+        heatmap = calculator.generate_timeline_heatmap(result)
+        if heatmap:
+            heatmap.save(sys.argv[2])
+
+    sys.exit(0 if result.passed else 1)
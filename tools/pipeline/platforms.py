@@ -22,6 +22,59 @@ def load_platform_specs() -> Dict[str, Any]:
 
 PLATFORM_SPECS = load_platform_specs()
 
+
+# =============================================================================
+# VECTORIZED TILE ENCODING
+# =============================================================================
+# generate_tile_data implementations reshape the indexed image into tiles and
+# pack nibbles/bitplanes with array ops instead of looping per pixel.
+
+def _indexed_pixels(indexed_img: Image.Image) -> np.ndarray:
+    """Pixel values of an indexed image as a 2D array (same values as getdata())."""
+    pixels = np.asarray(indexed_img)
+    if pixels.dtype == bool:
+        pixels = pixels.astype(np.uint8) * 255
+    return pixels
+
+
+def _tile_grid(pixels: np.ndarray, tile_width: int, tile_height: int) -> np.ndarray:
+    """Whole tiles in raster order as (N, tile_height, tile_width); partial edge tiles are dropped."""
+    tiles_y, tiles_x = pixels.shape[0] // tile_height, pixels.shape[1] // tile_width
+    grid = pixels[:tiles_y * tile_height, :tiles_x * tile_width]
+    grid = grid.reshape(tiles_y, tile_height, tiles_x, tile_width).transpose(0, 2, 1, 3)
+    return grid.reshape(tiles_y * tiles_x, tile_height, tile_width)
+
+
+def _pack_nibbles(pixels: np.ndarray, low_first: bool = False) -> np.ndarray:
+    """Pack 4bpp pixel pairs along the last axis; an odd last pixel pairs with 0."""
+    pixels = (pixels & 0x0F).astype(np.uint8)
+    if pixels.shape[-1] % 2:
+        pixels = np.concatenate([pixels, np.zeros_like(pixels[..., :1])], axis=-1)
+    first, second = pixels[..., 0::2], pixels[..., 1::2]
+    return (second << 4) | first if low_first else (first << 4) | second
+
+
+def _bitplanes(pixels: np.ndarray, planes: int) -> np.ndarray:
+    """Bitplane bytes, MSB = leftmost pixel: (..., W) -> (..., planes, ceil(W / 8))."""
+    shifts = np.arange(planes, dtype=np.uint8).reshape(planes, 1)
+    bits = (pixels.astype(np.uint8)[..., np.newaxis, :] >> shifts) & 1
+    return np.packbits(bits, axis=-1)
+
+
+def _tile_bitplanes(pixels: np.ndarray, planes: int,
+                    tile_width: int = 8, tile_height: int = 8) -> np.ndarray:
+    """
+    Bitplane bytes of every whole tile: (N, tile_height, planes, tile_width // 8).
+
+    Planes are packed over whole image rows first (long contiguous rows pack
+    much faster than 8-pixel tile rows), then regrouped into tiles.
+    """
+    tiles_y, tiles_x = pixels.shape[0] // tile_height, pixels.shape[1] // tile_width
+    rows = _bitplanes(pixels[:tiles_y * tile_height, :tiles_x * tile_width], planes)
+    row_bytes = tile_width // 8
+    rows = rows.reshape(tiles_y, tile_height, planes, tiles_x, row_bytes).transpose(0, 3, 1, 2, 4)
+    return rows.reshape(tiles_y * tiles_x, tile_height, planes, row_bytes)
+
 class PlatformConfig:
     """
     Base class for platform-specific configuration.
@@ -381,29 +434,9 @@ class NESConfig(PlatformConfig):
     @classmethod
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """NES CHR format: 2 bitplanes, 8 bytes each per 8x8 tile"""
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
-        tiles_x = width // 8
-        tiles_y = height // 8
-
-        chr_data = bytearray()
-        for ty in range(tiles_y):
-            for tx in range(tiles_x):
-                plane0 = bytearray(8)
-                plane1 = bytearray(8)
-                for row in range(8):
-                    for col in range(8):
-                        px = tx * 8 + col
-                        py = ty * 8 + row
-                        if px < width and py < height:
-                            color = pixels[py * width + px] & 0x03
-                            if color & 1:
-                                plane0[row] |= (0x80 >> col)
-                            if color & 2:
-                                plane1[row] |= (0x80 >> col)
-                chr_data.extend(plane0)
-                chr_data.extend(plane1)
-        return bytes(chr_data)
+        # (N, row, plane) -> plane 0 rows, then plane 1 rows
+        planes = _tile_bitplanes(_indexed_pixels(indexed_img) & 0x03, 2)[..., 0]
+        return planes.transpose(0, 2, 1).tobytes()
 
     @staticmethod
     def _encode_tile(pixels, width, x, y):
@@ -639,23 +672,8 @@ class GenesisConfig(PlatformConfig):
     @classmethod
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """Genesis tile format: 4bpp planar, 32 bytes per 8x8 tile"""
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
-        tiles_x = width // 8
-        tiles_y = height // 8
-
-        tile_data = bytearray()
-        for ty in range(tiles_y):
-            for tx in range(tiles_x):
-                for row in range(8):
-                    for col in range(0, 8, 2):
-                        px1 = tx * 8 + col
-                        px2 = tx * 8 + col + 1
-                        py = ty * 8 + row
-                        c1 = pixels[py * width + px1] & 0x0F if px1 < width and py < height else 0
-                        c2 = pixels[py * width + px2] & 0x0F if px2 < width and py < height else 0
-                        tile_data.append((c1 << 4) | c2)
-        return bytes(tile_data)
+        tiles = _tile_grid(_indexed_pixels(indexed_img), 8, 8)
+        return _pack_nibbles(tiles).tobytes()
 
 
 class SNESConfig(PlatformConfig):
@@ -697,32 +715,10 @@ class SNESConfig(PlatformConfig):
     @classmethod
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """SNES 4bpp format: interleaved bitplanes"""
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
-        tiles_x = width // 8
-        tiles_y = height // 8
-
-        tile_data = bytearray()
-        for ty in range(tiles_y):
-            for tx in range(tiles_x):
-                # SNES 4bpp: planes 0&1 interleaved, then planes 2&3
-                planes = [bytearray(8) for _ in range(4)]
-                for row in range(8):
-                    for col in range(8):
-                        px = tx * 8 + col
-                        py = ty * 8 + row
-                        color = pixels[py * width + px] & 0x0F if px < width and py < height else 0
-                        for plane in range(4):
-                            if color & (1 << plane):
-                                planes[plane][row] |= (0x80 >> col)
-                # Interleave: row0_p0, row0_p1, row1_p0, row1_p1, ...
-                for row in range(8):
-                    tile_data.append(planes[0][row])
-                    tile_data.append(planes[1][row])
-                for row in range(8):
-                    tile_data.append(planes[2][row])
-                    tile_data.append(planes[3][row])
-        return bytes(tile_data)
+        # SNES 4bpp: planes 0&1 interleaved per row, then planes 2&3
+        planes = _tile_bitplanes(_indexed_pixels(indexed_img) & 0x0F, 4)[..., 0]
+        planes = planes.reshape(len(planes), 8, 2, 2)
+        return planes.transpose(0, 2, 1, 3).tobytes()
 
 
 class AmigaConfig(PlatformConfig):
@@ -767,33 +763,11 @@ class AmigaConfig(PlatformConfig):
     @classmethod
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """Amiga planar format: 5 separate bitplanes for 32 colors"""
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
         num_planes = cls.bits_per_pixel  # 5 for OCS/ECS, 8 for AGA
+        pixels = _indexed_pixels(indexed_img) & ((1 << num_planes) - 1)
 
-        # Amiga stores bitplanes separately
-        planes = [bytearray() for _ in range(num_planes)]
-        for y in range(height):
-            for plane in range(num_planes):
-                row_data = 0
-                for x in range(width):
-                    color = pixels[y * width + x] & ((1 << num_planes) - 1)
-                    if color & (1 << plane):
-                        row_data |= (1 << (7 - (x % 8)))
-                    if (x + 1) % 8 == 0:
-                        planes[plane].append(row_data)
-                        row_data = 0
-                if width % 8 != 0:
-                    planes[plane].append(row_data)
-
-        # Interleave planes (common Amiga format)
-        result = bytearray()
-        bytes_per_row = (width + 7) // 8
-        for y in range(height):
-            for plane in range(num_planes):
-                start = y * bytes_per_row
-                result.extend(planes[plane][start:start + bytes_per_row])
-        return bytes(result)
+        # Interleave planes per row (common Amiga format): (row, plane, bytes)
+        return _bitplanes(pixels, num_planes).tobytes()
 
 
 class AmigaAGAConfig(AmigaConfig):
@@ -908,30 +882,18 @@ class C64Config(PlatformConfig):
     @classmethod
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """C64 sprite format: 24x21 pixels, 3 bytes per row, MSB first"""
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
+        pixels = _indexed_pixels(indexed_img)
 
         # C64 sprites are 24x21, pad/crop as needed
         sprite_w, sprite_h = 24, 21
-        sprite_data = bytearray()
-
-        for y in range(sprite_h):
-            for byte_x in range(3):  # 3 bytes per row (24 pixels)
-                byte_val = 0
-                for bit in range(8):
-                    x = byte_x * 8 + bit
-                    if x < width and y < height:
-                        color = pixels[y * width + x] & 0x03
-                        # Multicolor mode: 2 bits per pixel, but we use hires for simplicity
-                        if color > 0:
-                            byte_val |= (0x80 >> bit)
-                sprite_data.append(byte_val)
+        # Multicolor mode: 2 bits per pixel, but we use hires for simplicity
+        mask = np.zeros((sprite_h, sprite_w), dtype=bool)
+        crop = pixels[:sprite_h, :sprite_w] & 0x03
+        mask[:crop.shape[0], :crop.shape[1]] = crop > 0
+        sprite_data = np.packbits(mask, axis=1).tobytes()
 
         # Pad to 64 bytes (standard C64 sprite block)
-        while len(sprite_data) < 64:
-            sprite_data.append(0)
-
-        return bytes(sprite_data)
+        return sprite_data.ljust(64, b'\x00')
 
 
 class CGAConfig(PlatformConfig):
@@ -967,20 +929,15 @@ class CGAConfig(PlatformConfig):
     @classmethod
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """CGA 2bpp format: 4 pixels per byte, MSB first"""
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
+        pixels = (_indexed_pixels(indexed_img) & 0x03).astype(np.uint8)
+        height, width = pixels.shape
 
-        tile_data = bytearray()
-        for y in range(height):
-            for x in range(0, width, 4):
-                byte_val = 0
-                for px in range(4):
-                    if x + px < width:
-                        color = pixels[y * width + x + px] & 0x03
-                        byte_val |= (color << (6 - px * 2))
-                tile_data.append(byte_val)
-
-        return bytes(tile_data)
+        # 4 pixels per byte, first pixel in the top bits
+        padded = np.zeros((height, -(-width // 4) * 4), dtype=np.uint8)
+        padded[:, :width] = pixels
+        quads = padded.reshape(height, -1, 4)
+        packed = (quads[..., 0] << 6) | (quads[..., 1] << 4) | (quads[..., 2] << 2) | quads[..., 3]
+        return packed.tobytes()
 
 
 class GameBoyConfig(PlatformConfig):
@@ -1094,31 +1051,8 @@ class GameBoyConfig(PlatformConfig):
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """Game Boy 2bpp format: identical to NES CHR (2 bitplanes interleaved per row)"""
         # GB uses same 2bpp format as NES
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
-        tiles_x = width // 8
-        tiles_y = height // 8
-
-        tile_data = bytearray()
-        for ty in range(tiles_y):
-            for tx in range(tiles_x):
-                for row in range(8):
-                    # Low bits first, then high bits (per row)
-                    low_byte = 0
-                    high_byte = 0
-                    for col in range(8):
-                        px = tx * 8 + col
-                        py = ty * 8 + row
-                        if px < width and py < height:
-                            color = pixels[py * width + px] & 0x03
-                            if color & 1:
-                                low_byte |= (0x80 >> col)
-                            if color & 2:
-                                high_byte |= (0x80 >> col)
-                    tile_data.append(low_byte)
-                    tile_data.append(high_byte)
-
-        return bytes(tile_data)
+        # Low bits first, then high bits (per row)
+        return _tile_bitplanes(_indexed_pixels(indexed_img) & 0x03, 2).tobytes()
 
 
 class GameBoyColorConfig(PlatformConfig):
@@ -1204,29 +1138,8 @@ class MasterSystemConfig(PlatformConfig):
     @classmethod
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """SMS 4bpp planar format: 4 bitplanes interleaved per row"""
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
-        tiles_x = width // 8
-        tiles_y = height // 8
-
-        tile_data = bytearray()
-        for ty in range(tiles_y):
-            for tx in range(tiles_x):
-                for row in range(8):
-                    # SMS: 4 bitplanes per row, interleaved
-                    planes = [0, 0, 0, 0]
-                    for col in range(8):
-                        px = tx * 8 + col
-                        py = ty * 8 + row
-                        if px < width and py < height:
-                            color = pixels[py * width + px] & 0x0F
-                            for plane in range(4):
-                                if color & (1 << plane):
-                                    planes[plane] |= (0x80 >> col)
-                    for plane in planes:
-                        tile_data.append(plane)
-
-        return bytes(tile_data)
+        # SMS: 4 bitplanes per row, interleaved
+        return _tile_bitplanes(_indexed_pixels(indexed_img) & 0x0F, 4).tobytes()
 
 
 class Atari2600Config(PlatformConfig):
@@ -1265,19 +1178,10 @@ class Atari2600Config(PlatformConfig):
     @classmethod
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """Atari 2600 player graphics: 1bpp, one byte per scanline"""
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
+        pixels = _indexed_pixels(indexed_img)
 
         # Output 8 pixels wide, full height
-        sprite_data = bytearray()
-        for y in range(height):
-            byte_val = 0
-            for x in range(min(8, width)):
-                if x < width and pixels[y * width + x] > 0:
-                    byte_val |= (0x80 >> x)
-            sprite_data.append(byte_val)
-
-        return bytes(sprite_data)
+        return np.packbits(pixels[:, :8] > 0, axis=1).tobytes()
 
 
 class GBAConfig(PlatformConfig):
@@ -1400,25 +1304,9 @@ class GBAConfig(PlatformConfig):
     @classmethod
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """GBA 4bpp tile format: linear, 2 pixels per byte, little-endian"""
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
-        tiles_x = width // 8
-        tiles_y = height // 8
-
-        tile_data = bytearray()
-        for ty in range(tiles_y):
-            for tx in range(tiles_x):
-                for row in range(8):
-                    for col in range(0, 8, 2):
-                        px1 = tx * 8 + col
-                        px2 = tx * 8 + col + 1
-                        py = ty * 8 + row
-                        c1 = pixels[py * width + px1] & 0x0F if px1 < width and py < height else 0
-                        c2 = pixels[py * width + px2] & 0x0F if px2 < width and py < height else 0
-                        # GBA stores low nibble first (opposite of Genesis)
-                        tile_data.append((c2 << 4) | c1)
-
-        return bytes(tile_data)
+        tiles = _tile_grid(_indexed_pixels(indexed_img), 8, 8)
+        # GBA stores low nibble first (opposite of Genesis)
+        return _pack_nibbles(tiles, low_first=True).tobytes()
 
 
 class NeoGeoConfig(PlatformConfig):
@@ -1484,40 +1372,10 @@ class NeoGeoConfig(PlatformConfig):
     @classmethod
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """Neo Geo sprite format: planar, 16x16 tiles"""
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
-
         # Neo Geo uses planar format with specific bit arrangement
-        # Each 16x16 tile is stored as 4 bitplanes
-        tile_data = bytearray()
-
-        tiles_x = width // 16
-        tiles_y = height // 16
-
-        for ty in range(tiles_y):
-            for tx in range(tiles_x):
-                # 4 bitplanes, each is 16 rows of 2 bytes (16 bits per row)
-                planes = [[0] * 32 for _ in range(4)]
-
-                for row in range(16):
-                    for col in range(16):
-                        px = tx * 16 + col
-                        py = ty * 16 + row
-                        if px < width and py < height:
-                            color = pixels[py * width + px] & 0x0F
-                            byte_idx = row * 2 + (col // 8)
-                            bit = 7 - (col % 8)
-                            for plane in range(4):
-                                if color & (1 << plane):
-                                    planes[plane][byte_idx] |= (1 << bit)
-
-                # Output planes interleaved
-                for row in range(16):
-                    for plane in range(4):
-                        tile_data.append(planes[plane][row * 2])
-                        tile_data.append(planes[plane][row * 2 + 1])
-
-        return bytes(tile_data)
+        # Each 16x16 tile is stored as 4 bitplanes, 2 bytes per plane row
+        # Output planes interleaved: (N, row, plane, 2 bytes)
+        return _tile_bitplanes(_indexed_pixels(indexed_img) & 0x0F, 4, 16, 16).tobytes()
 
 
 class MSXConfig(PlatformConfig):
@@ -1572,28 +1430,11 @@ class MSXConfig(PlatformConfig):
     @classmethod
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """MSX sprite format: similar to SMS, 1bpp with color per line"""
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
-
         # MSX sprites are 1bpp with color attribute
         # For simplicity, output as pattern data (1bpp)
-        tile_data = bytearray()
-        tiles_x = width // 8
-        tiles_y = height // 8
-
-        for ty in range(tiles_y):
-            for tx in range(tiles_x):
-                for row in range(8):
-                    byte_val = 0
-                    for col in range(8):
-                        px = tx * 8 + col
-                        py = ty * 8 + row
-                        if px < width and py < height:
-                            if pixels[py * width + px] > 0:
-                                byte_val |= (0x80 >> col)
-                    tile_data.append(byte_val)
-
-        return bytes(tile_data)
+        pixels = _indexed_pixels(indexed_img)
+        rows = np.packbits(pixels[:, :pixels.shape[1] // 8 * 8] > 0, axis=-1)
+        return _tile_grid(rows, 1, 8).tobytes()
 
 
 class AtariLynxConfig(PlatformConfig):
@@ -1649,17 +1490,7 @@ class AtariLynxConfig(PlatformConfig):
     def generate_tile_data(cls, indexed_img: Image.Image) -> bytes:
         """Lynx sprite format: packed 4bpp, run-length encoded in hardware"""
         # For raw output, just do packed 4bpp (2 pixels per byte)
-        pixels = list(indexed_img.getdata())
-        width, height = indexed_img.size
-
-        tile_data = bytearray()
-        for y in range(height):
-            for x in range(0, width, 2):
-                c1 = pixels[y * width + x] & 0x0F if x < width else 0
-                c2 = pixels[y * width + x + 1] & 0x0F if x + 1 < width else 0
-                tile_data.append((c1 << 4) | c2)
-
-        return bytes(tile_data)
+        return _pack_nibbles(_indexed_pixels(indexed_img)).tobytes()
 
 
 # Platform registry
@@ -6,6 +6,7 @@ from PIL import Image, ImageDraw, ImageChops
 import numpy as np
 
 from .platforms import PlatformConfig, NESConfig, GenesisConfig, SNESConfig, GameBoyConfig
+from .quantization.palette_lookup import get_palette_lookup
 from .ai import AIAnalyzer, GenerativeResizer
 
 # Import new advanced tile optimizer
@@ -932,17 +933,10 @@ class SpriteConverter:
 
     def index_sprite(self, img: Image.Image) -> Image.Image:
         """Convert RGBA image to indexed palette image with platform-appropriate dithering"""
-        indexed = Image.new('P', img.size)
-
-        # Build palette data for PIL
-        pal_data = []
-        for rgb in self.palette_rgb:
-            pal_data.extend(rgb)
-        pal_data.extend([0] * (768 - len(pal_data)))
-        indexed.putpalette(pal_data)
-
-        src_pixels = img.load()
-        dst_pixels = indexed.load()
+        if img.mode != 'RGBA':
+            img = img.convert('RGBA')
+        pixels = np.asarray(img)
+        height, width = pixels.shape[:2]
 
         # Get dithering settings from platform config
         dither_method = getattr(self.platform, 'dither_method', 'none')
@@ -976,57 +970,65 @@ class SpriteConverter:
         else:
             bayer = BAYER_4X4
 
-        # Error diffusion buffer for Floyd-Steinberg
-        if dither_method == 'floyd':
-            error = np.zeros((img.height + 1, img.width + 1, 3), dtype=np.float32)
-
         # Quantize colors to palette with dithering
         max_color = min(self.colors, len(self.palette_rgb))
         dither_scale = 64.0 * dither_strength
-
-        for y in range(img.height):
-            for x in range(img.width):
-                r, g, b, a = src_pixels[x, y]
-
-                if a < 128:
-                    dst_pixels[x, y] = 0  # Transparent = color 0
-                    continue
-
-                # Apply dithering adjustment
-                if dither_method == 'ordered':
-                    # Ordered (Bayer) dithering
-                    threshold = bayer[y % bayer.shape[0], x % bayer.shape[1]]
-                    r = max(0, min(255, r + threshold * dither_scale))
-                    g = max(0, min(255, g + threshold * dither_scale))
-                    b = max(0, min(255, b + threshold * dither_scale))
-                elif dither_method == 'floyd':
-                    # Floyd-Steinberg error diffusion
+        lookup = get_palette_lookup(self.palette_rgb[:max_color], 'RGB')
+        opaque = pixels[..., 3] >= 128  # Transparent = color 0
+
+        if dither_method == 'ordered':
+            # Ordered (Bayer) dithering, whole image at once
+            size = bayer.shape[0]
+            threshold = bayer[np.arange(height)[:, None] % size, np.arange(width)[None, :] % size]
+            rgb = np.clip(pixels[..., :3] + (threshold * dither_scale)[..., None], 0, 255)
+            indices = lookup.nearest(rgb)
+        elif dither_method == 'floyd':
+            # Floyd-Steinberg error diffusion (sequential by nature)
+            indices = np.zeros((height, width), dtype=np.intp)
+            error = np.zeros((height + 1, width + 1, 3), dtype=np.float32)
+            palette = self.palette_rgb
+            for y in range(height):
+                for x in range(width):
+                    if not opaque[y, x]:
+                        continue
+                    r, g, b = (int(c) for c in pixels[y, x, :3])
                     r = max(0, min(255, r + error[y, x, 0]))
                     g = max(0, min(255, g + error[y, x, 1]))
                     b = max(0, min(255, b + error[y, x, 2]))
 
-                # Find closest palette color
-                min_dist = float('inf')
-                best_idx = 0
-                for i, pal_rgb in enumerate(self.palette_rgb[:max_color]):
-                    dist = (r - pal_rgb[0])**2 + (g - pal_rgb[1])**2 + (b - pal_rgb[2])**2
-                    if dist < min_dist:
-                        min_dist = dist
-                        best_idx = i
-                dst_pixels[x, y] = best_idx
-
-                # Distribute error for Floyd-Steinberg
-                if dither_method == 'floyd':
-                    pr, pg, pb = self.palette_rgb[best_idx]
+                    # Closest palette color among the cell's candidates
+                    min_dist = float('inf')
+                    best_idx = 0
+                    for i in lookup.cell_candidates(r, g, b):
+                        pal_rgb = palette[i]
+                        dist = (r - pal_rgb[0])**2 + (g - pal_rgb[1])**2 + (b - pal_rgb[2])**2
+                        if dist < min_dist:
+                            min_dist = dist
+                            best_idx = i
+                    indices[y, x] = best_idx
+
+                    # Distribute error for Floyd-Steinberg
+                    pr, pg, pb = palette[best_idx]
                     err_r, err_g, err_b = r - pr, g - pg, b - pb
-                    if x + 1 < img.width:
+                    if x + 1 < width:
                         error[y, x + 1] += [err_r * 7/16, err_g * 7/16, err_b * 7/16]
-                    if y + 1 < img.height:
+                    if y + 1 < height:
                         if x > 0:
                             error[y + 1, x - 1] += [err_r * 3/16, err_g * 3/16, err_b * 3/16]
                         error[y + 1, x] += [err_r * 5/16, err_g * 5/16, err_b * 5/16]
-                        if x + 1 < img.width:
+                        if x + 1 < width:
                             error[y + 1, x + 1] += [err_r * 1/16, err_g * 1/16, err_b * 1/16]
+        else:
+            indices = lookup.nearest(pixels[..., :3])
+
+        indexed = Image.fromarray(np.where(opaque, indices, 0).astype(np.uint8), 'P')
+
+        # Build palette data for PIL
+        pal_data = []
+        for rgb in self.palette_rgb:
+            pal_data.extend(rgb)
+        pal_data.extend([0] * (768 - len(pal_data)))
+        indexed.putpalette(pal_data)
 
         return indexed
 
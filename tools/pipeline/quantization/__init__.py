@@ -5,6 +5,8 @@ This module provides:
 - Perceptual color matching (CIEDE2000, CAM02-UCS)
 - Optimal palette extraction via k-means clustering
 - Numba-accelerated Floyd-Steinberg dithering
+- Cached nearest-color lookup shared by every quantizer
+- Array Lab conversion and Delta E kernels (built-in CIEDE2000)
 
 Phase: 0.7-0.8 (Foundation)
 
@@ -17,7 +19,8 @@ Usage:
 
 Dependencies:
     Required: numpy, pillow
-    Optional: colour-science (for CIEDE2000), numba (for JIT dithering)
+    Optional: colorspacious (for CAM02-UCS), scikit-learn (for k-means),
+              numba (for JIT dithering and Delta E matrices)
 """
 
 from .perceptual import (
@@ -30,6 +33,22 @@ from .perceptual import (
     PerceptualQuantizer,
 )
 
+# Array color-science kernels
+from .color_kernels import (
+    srgb_to_lab,
+    lab_to_srgb,
+    delta_e_cie76,
+    delta_e_ciede2000,
+    delta_e_matrix,
+)
+
+# Shared nearest-color lookup
+from .palette_lookup import (
+    PaletteLookup,
+    get_palette_lookup,
+    clear_palette_lookups,
+)
+
 # Dithering algorithms (always available, numba optional for acceleration)
 from .dither_numba import (
     floyd_steinberg_numba,
@@ -54,6 +73,18 @@ __all__ = [
     'calculate_color_distance',
     'PerceptualQuantizer',
 
+    # Color kernels
+    'srgb_to_lab',
+    'lab_to_srgb',
+    'delta_e_cie76',
+    'delta_e_ciede2000',
+    'delta_e_matrix',
+
+    # Nearest-color lookup
+    'PaletteLookup',
+    'get_palette_lookup',
+    'clear_palette_lookups',
+
     # Dithering algorithms (Phase 0.8)
     'floyd_steinberg_numba',
     'ordered_dither_numba',
@@ -0,0 +1,334 @@
+"""
+Array Color-Science Kernels.
+
+Whole-image sRGB <-> CIELab conversion and Delta E distance matrices. These
+are the single implementation behind rgb_to_lab()/lab_to_rgb() in
+perceptual.py, palette_converter and palette_manager, the palette lookup
+and k-means palette extraction.
+
+Key Features:
+- srgb_to_lab / lab_to_srgb on (..., 3) arrays; uint8 input linearizes
+  through a 256-entry table instead of a power per channel
+- delta_e_cie76 / delta_e_ciede2000 with NumPy broadcasting
+- delta_e_matrix: (N, M) distances between two color sets, with a
+  parallel Numba CIEDE2000 kernel when numba is installed
+
+CIEDE2000 follows Sharma, Wu & Dalal (2005) with kL = kC = kH = 1, and
+needs no optional dependencies.
+
+Usage:
+    from tools.pipeline.quantization.color_kernels import srgb_to_lab, delta_e_matrix
+
+    lab = srgb_to_lab(np.asarray(image))                 # (H, W, 3)
+    dist = delta_e_matrix(lab.reshape(-1, 3), palette_lab)  # (H*W, K)
+"""
+
+import math
+
+import numpy as np
+
+# Try to import numba for JIT compilation
+try:
+    from numba import jit, prange
+    NUMBA_AVAILABLE = True
+except ImportError:
+    NUMBA_AVAILABLE = False
+    # Create dummy decorator
+    def jit(*args, **kwargs):
+        def decorator(func):
+            return func
+        return decorator
+    prange = range
+
+
+# =============================================================================
+# CONSTANTS
+# =============================================================================
+
+# sRGB (linear) -> XYZ, D65; rows are R, G, B contributions
+SRGB_TO_XYZ = np.array([
+    [0.4124564, 0.2126729, 0.0193339],
+    [0.3575761, 0.7151522, 0.1191920],
+    [0.1804375, 0.0721750, 0.9503041],
+])
+
+# XYZ -> sRGB (linear), D65
+XYZ_TO_SRGB = np.array([
+    [3.2404542, -0.9692660, 0.0556434],
+    [-1.5371385, 1.8760108, -0.2040259],
+    [-0.4985314, 0.0415560, 1.0572252],
+])
+
+# Reference white D65
+WHITE_D65 = np.array([0.95047, 1.0, 1.08883])
+
+# 25^7, used by the CIEDE2000 chroma terms
+_POW25_7 = 25.0 ** 7
+
+# Rows per NumPy CIEDE2000 pass (bounds the (rows, M) temporaries)
+_CHUNK = 1 << 12
+
+
+def _linearize(c: np.ndarray) -> np.ndarray:
+    """sRGB gamma (0-1) -> linear light."""
+    return np.where(c > 0.04045, ((c + 0.055) / 1.055) ** 2.4, c / 12.92)
+
+
+# Linear light for every 8-bit channel value
+_LINEAR_U8 = _linearize(np.arange(256) / 255.0)
+
+
+# =============================================================================
+# COLOR SPACE CONVERSION
+# =============================================================================
+
+def srgb_to_lab(rgb: np.ndarray) -> np.ndarray:
+    """
+    Convert sRGB (0-255) to CIELab.
+
+    Args:
+        rgb: (..., 3) colors; uint8 takes the table path, other dtypes may
+            be fractional
+
+    Returns:
+        (..., 3) float64 Lab (L: 0-100, a/b: about -128 to 128)
+    """
+    rgb = np.asarray(rgb)
+    if rgb.dtype == np.uint8:
+        lin = _LINEAR_U8[rgb]
+    else:
+        lin = _linearize(rgb.astype(np.float64) / 255.0)
+
+    t = (lin @ SRGB_TO_XYZ) / WHITE_D65
+    f = np.where(t > 0.008856, np.cbrt(t), (903.3 * t + 16) / 116)
+
+    lab = np.empty_like(f)
+    lab[..., 0] = 116 * f[..., 1] - 16
+    lab[..., 1] = 500 * (f[..., 0] - f[..., 1])
+    lab[..., 2] = 200 * (f[..., 1] - f[..., 2])
+    return lab
+
+
+def lab_to_srgb(lab: np.ndarray) -> np.ndarray:
+    """
+    Convert CIELab to sRGB (0-255), clamped to the valid range.
+
+    Args:
+        lab: (..., 3) Lab colors
+
+    Returns:
+        (..., 3) float64 RGB; truncate with astype(int) for 8-bit values
+    """
+    lab = np.asarray(lab, dtype=np.float64)
+    fy = (lab[..., 0] + 16) / 116
+    f = np.stack([lab[..., 1] / 500 + fy, fy, fy - lab[..., 2] / 200], axis=-1)
+
+    xyz = WHITE_D65 * np.where(f > 0.206893, f ** 3, (116 * f - 16) / 903.3)
+    lin = xyz @ XYZ_TO_SRGB
+
+    srgb = np.where(lin > 0.0031308,
+                    1.055 * np.abs(lin) ** (1 / 2.4) - 0.055,
+                    12.92 * lin)
+    return np.clip(srgb * 255, 0, 255)
+
+
+# =============================================================================
+# COLOR DIFFERENCE
+# =============================================================================
+
+def delta_e_cie76(lab1: np.ndarray, lab2: np.ndarray) -> np.ndarray:
+    """Euclidean Lab distance (Delta E 1976), broadcasting over leading axes."""
+    diff = np.asarray(lab1, dtype=np.float64) - np.asarray(lab2, dtype=np.float64)
+    return np.sqrt((diff * diff).sum(axis=-1))
+
+
+def delta_e_ciede2000(lab1: np.ndarray, lab2: np.ndarray) -> np.ndarray:
+    """
+    CIEDE2000 color difference, broadcasting over leading axes.
+
+    Args:
+        lab1: (..., 3) Lab colors
+        lab2: (..., 3) Lab colors
+
+    Returns:
+        (...) float64 Delta E 2000
+    """
+    lab1 = np.asarray(lab1, dtype=np.float64)
+    lab2 = np.asarray(lab2, dtype=np.float64)
+    L1, a1, b1 = lab1[..., 0], lab1[..., 1], lab1[..., 2]
+    L2, a2, b2 = lab2[..., 0], lab2[..., 1], lab2[..., 2]
+
+    # Chroma-dependent a* stretch
+    c_bar = (np.hypot(a1, b1) + np.hypot(a2, b2)) / 2
+    c_bar7 = c_bar ** 7
+    g = 0.5 * (1 - np.sqrt(c_bar7 / (c_bar7 + _POW25_7)))
+    a1p, a2p = (1 + g) * a1, (1 + g) * a2
+    c1p, c2p = np.hypot(a1p, b1), np.hypot(a2p, b2)
+
+    # Hue angles in degrees, 0 for achromatic colors
+    h1p = np.degrees(np.arctan2(b1, a1p)) % 360
+    h2p = np.degrees(np.arctan2(b2, a2p)) % 360
+    chroma_product = c1p * c2p
+    achromatic = chroma_product == 0
+
+    dh = h2p - h1p
+    dh = np.where(dh > 180, dh - 360, np.where(dh < -180, dh + 360, dh))
+    dh = np.where(achromatic, 0.0, dh)
+
+    dL = L2 - L1
+    dC = c2p - c1p
+    dH = 2 * np.sqrt(chroma_product) * np.sin(np.radians(dh) / 2)
+
+    # Mean hue, wrapping around 0/360
+    h_sum = h1p + h2p
+    h_bar = np.where(np.abs(h1p - h2p) <= 180, h_sum / 2,
+                     np.where(h_sum < 360, (h_sum + 360) / 2, (h_sum - 360) / 2))
+    h_bar = np.where(achromatic, h_sum, h_bar)
+
+    L_bar = (L1 + L2) / 2
+    c_bar_p = (c1p + c2p) / 2
+
+    t = (1 - 0.17 * np.cos(np.radians(h_bar - 30))
+         + 0.24 * np.cos(np.radians(2 * h_bar))
+         + 0.32 * np.cos(np.radians(3 * h_bar + 6))
+         - 0.20 * np.cos(np.radians(4 * h_bar - 63)))
+    d_theta = 30 * np.exp(-((h_bar - 275) / 25) ** 2)
+    c_bar_p7 = c_bar_p ** 7
+    r_c = 2 * np.sqrt(c_bar_p7 / (c_bar_p7 + _POW25_7))
+    l50 = (L_bar - 50) ** 2
+    s_l = 1 + 0.015 * l50 / np.sqrt(20 + l50)
+    s_c = 1 + 0.045 * c_bar_p
+    s_h = 1 + 0.015 * c_bar_p * t
+    r_t = -np.sin(np.radians(2 * d_theta)) * r_c
+
+    tl, tc, th = dL / s_l, dC / s_c, dH / s_h
+    return np.sqrt(tl * tl + tc * tc + th * th + r_t * tc * th)
+
+
+# Angle terms of T, expanded from cos/sin of the mean hue in the Numba kernel
+_COS_6, _SIN_6 = math.cos(math.radians(6)), math.sin(math.radians(6))
+_COS_30, _SIN_30 = math.cos(math.radians(30)), math.sin(math.radians(30))
+_COS_63, _SIN_63 = math.cos(math.radians(63)), math.sin(math.radians(63))
+
+
+@jit(nopython=True, cache=True)
+def _ciede2000_pair(L1, a1, b1, c1, L2, a2, b2, c2):
+    """
+    Scalar CIEDE2000 for the Numba matrix kernel.
+
+    Same steps as delta_e_ciede2000, in radians, with the input chromas c1/c2
+    precomputed per color, 7th powers as products, and cos(k*h_bar + offset)
+    expanded from a single cos/sin pair.
+    """
+    c_bar = (c1 + c2) / 2
+    c_bar2 = c_bar * c_bar
+    c_bar7 = c_bar2 * c_bar2 * c_bar2 * c_bar
+    g = 0.5 * (1 - math.sqrt(c_bar7 / (c_bar7 + _POW25_7)))
+    a1p = (1 + g) * a1
+    a2p = (1 + g) * a2
+    c1p = math.sqrt(a1p * a1p + b1 * b1)
+    c2p = math.sqrt(a2p * a2p + b2 * b2)
+
+    h1p = math.atan2(b1, a1p)
+    if h1p < 0:
+        h1p += 2 * math.pi
+    h2p = math.atan2(b2, a2p)
+    if h2p < 0:
+        h2p += 2 * math.pi
+    chroma_product = c1p * c2p
+
+    h_sum = h1p + h2p
+    if chroma_product == 0:
+        dh = 0.0
+        h_bar = h_sum
+    else:
+        dh = h2p - h1p
+        if dh > math.pi:
+            dh -= 2 * math.pi
+        elif dh < -math.pi:
+            dh += 2 * math.pi
+        if abs(h1p - h2p) <= math.pi:
+            h_bar = h_sum / 2
+        elif h_sum < 2 * math.pi:
+            h_bar = (h_sum + 2 * math.pi) / 2
+        else:
+            h_bar = (h_sum - 2 * math.pi) / 2
+
+    dL = L2 - L1
+    dC = c2p - c1p
+    dH = 2 * math.sqrt(chroma_product) * math.sin(dh / 2)
+
+    L_bar = (L1 + L2) / 2
+    c_bar_p = (c1p + c2p) / 2
+
+    c = math.cos(h_bar)
+    s = math.sin(h_bar)
+    cos2 = 2 * c * c - 1
+    sin2 = 2 * s * c
+    cos3 = 4 * c * c * c - 3 * c
+    sin3 = 3 * s - 4 * s * s * s
+    cos4 = 2 * cos2 * cos2 - 1
+    sin4 = 2 * sin2 * cos2
+    t = (1 - 0.17 * (c * _COS_30 + s * _SIN_30)
+         + 0.24 * cos2
+         + 0.32 * (cos3 * _COS_6 - sin3 * _SIN_6)
+         - 0.20 * (cos4 * _COS_63 + sin4 * _SIN_63))
+    d_theta = 30 * math.exp(-((math.degrees(h_bar) - 275) / 25) ** 2)
+    c_bar_p2 = c_bar_p * c_bar_p
+    c_bar_p7 = c_bar_p2 * c_bar_p2 * c_bar_p2 * c_bar_p
+    r_c = 2 * math.sqrt(c_bar_p7 / (c_bar_p7 + _POW25_7))
+    l50 = (L_bar - 50) ** 2
+    s_l = 1 + 0.015 * l50 / math.sqrt(20 + l50)
+    s_c = 1 + 0.045 * c_bar_p
+    s_h = 1 + 0.015 * c_bar_p * t
+    r_t = -math.sin(math.radians(2 * d_theta)) * r_c
+
+    tl = dL / s_l
+    tc = dC / s_c
+    th = dH / s_h
+    return math.sqrt(tl * tl + tc * tc + th * th + r_t * tc * th)
+
+
+@jit(nopython=True, cache=True, parallel=True)
+def _ciede2000_matrix_numba(lab1: np.ndarray, lab2: np.ndarray) -> np.ndarray:
+    """(N, M) CIEDE2000 matrix, rows in parallel."""
+    n, m = lab1.shape[0], lab2.shape[0]
+    c1 = np.sqrt(lab1[:, 1] * lab1[:, 1] + lab1[:, 2] * lab1[:, 2])
+    c2 = np.sqrt(lab2[:, 1] * lab2[:, 1] + lab2[:, 2] * lab2[:, 2])
+    out = np.empty((n, m), dtype=np.float64)
+    for i in prange(n):
+        for j in range(m):
+            out[i, j] = _ciede2000_pair(lab1[i, 0], lab1[i, 1], lab1[i, 2], c1[i],
+                                        lab2[j, 0], lab2[j, 1], lab2[j, 2], c2[j])
+    return out
+
+
+def delta_e_matrix(lab1: np.ndarray, lab2: np.ndarray,
+                   method: str = 'CIEDE2000') -> np.ndarray:
+    """
+    Distances between every pair of two Lab color sets.
+
+    Args:
+        lab1: (N, 3) Lab colors
+        lab2: (M, 3) Lab colors
+        method: 'CIEDE2000' or 'CIE76'
+
+    Returns:
+        (N, M) float64 distances
+    """
+    lab1 = np.ascontiguousarray(lab1, dtype=np.float64).reshape(-1, 3)
+    lab2 = np.ascontiguousarray(lab2, dtype=np.float64).reshape(-1, 3)
+
+    if method == 'CIE76':
+        return delta_e_cie76(lab1[:, np.newaxis], lab2[np.newaxis])
+    if method != 'CIEDE2000':
+        raise ValueError(f"Unknown Delta E method: {method}")
+
+    if NUMBA_AVAILABLE:
+        return _ciede2000_matrix_numba(lab1, lab2)
+
+    out = np.empty((len(lab1), len(lab2)))
+    for start in range(0, len(lab1), _CHUNK):
+        out[start:start + _CHUNK] = delta_e_ciede2000(
+            lab1[start:start + _CHUNK, np.newaxis], lab2[np.newaxis])
+    return out
@@ -10,7 +10,8 @@ Key Features:
 - Floyd-Steinberg error diffusion (best quality)
 - Ordered/Bayer dithering (consistent patterns)
 - Atkinson dithering (Mac-style, softer)
-- Batch processing support
+- Wavefront-parallel error diffusion on large images, optional serpentine scan
+- Process-pool batch dithering over shared memory
 
 Dependencies:
     Required: numpy
@@ -43,6 +44,9 @@ import math
 import numpy as np
 from PIL import Image
 
+from .frame_pool import map_frames
+from .palette_lookup import CELL_BITS, CELL_SHIFT, CELLS_PER_AXIS, get_palette_lookup
+
 # Try to import numba for JIT compilation
 try:
     import numba
@@ -62,6 +66,13 @@ except ImportError:
 RGB = Tuple[int, int, int]
 DitherMethod = Literal['floyd-steinberg', 'ordered', 'atkinson', 'none']
 
+# Palettes larger than this use RGB cell candidates instead of a full scan
+CELL_SEARCH_MIN_COLORS = 16
+
+# dither_batch totals below this many pixels run in-process (worker
+# start-up costs more than the dithering)
+BATCH_PARALLEL_MIN_PIXELS = 1 << 22
+
 
 # =============================================================================
 # BAYER MATRICES FOR ORDERED DITHERING
@@ -134,70 +145,47 @@ def _find_nearest_color_fast(
     return best_idx
 
 
-@jit(nopython=True, cache=True, parallel=True)
-def floyd_steinberg_numba(
-    pixels: np.ndarray,
-    palette: np.ndarray
-) -> np.ndarray:
+@jit(nopython=True, cache=True)
+def _find_nearest_color_cells(
+    r: float, g: float, b: float,
+    palette: np.ndarray,
+    offsets: np.ndarray,
+    candidates: np.ndarray
+) -> int:
     """
-    Floyd-Steinberg error diffusion dithering with Numba JIT.
+    Find nearest palette color using precomputed RGB cell candidates.
 
-    10-50x faster than pure Python for large images.
-
-    Args:
-        pixels: Input image as (H, W, 3) float32 array, values 0-255
-        palette: Palette as (N, 3) float32 array, values 0-255
-
-    Returns:
-        Indexed image as (H, W) uint8 array
+    Same result as _find_nearest_color_fast for colours in 0-255, but only
+    scans the few palette entries that can win inside the colour's cell
+    (see PaletteLookup.rgb_cells).
     """
-    height, width = pixels.shape[:2]
-    output = np.zeros((height, width), dtype=np.uint8)
-    error = pixels.astype(np.float32).copy()
-
-    for y in range(height):
-        for x in range(width):
-            # Get current pixel (clamped)
-            old_r = max(0.0, min(255.0, error[y, x, 0]))
-            old_g = max(0.0, min(255.0, error[y, x, 1]))
-            old_b = max(0.0, min(255.0, error[y, x, 2]))
+    cell = ((min(int(r) >> CELL_SHIFT, CELLS_PER_AXIS - 1) << (2 * CELL_BITS))
+            | (min(int(g) >> CELL_SHIFT, CELLS_PER_AXIS - 1) << CELL_BITS)
+            | min(int(b) >> CELL_SHIFT, CELLS_PER_AXIS - 1))
 
-            # Find nearest palette color
-            best_idx = _find_nearest_color_fast(old_r, old_g, old_b, palette)
-            output[y, x] = best_idx
-
-            # Get new color
-            new_r = palette[best_idx, 0]
-            new_g = palette[best_idx, 1]
-            new_b = palette[best_idx, 2]
-
-            # Calculate error
-            err_r = old_r - new_r
-            err_g = old_g - new_g
-            err_b = old_b - new_b
+    min_dist = 1e10
+    best_idx = 0
 
-            # Distribute error (Floyd-Steinberg coefficients)
-            if x + 1 < width:
-                error[y, x + 1, 0] += err_r * 0.4375  # 7/16
-                error[y, x + 1, 1] += err_g * 0.4375
-                error[y, x + 1, 2] += err_b * 0.4375
+    for j in range(offsets[cell], offsets[cell + 1]):
+        i = candidates[j]
+        dr = r - palette[i, 0]
+        dg = g - palette[i, 1]
+        db = b - palette[i, 2]
+        dist = dr*dr + dg*dg + db*db
 
-            if y + 1 < height:
-                if x > 0:
-                    error[y + 1, x - 1, 0] += err_r * 0.1875  # 3/16
-                    error[y + 1, x - 1, 1] += err_g * 0.1875
-                    error[y + 1, x - 1, 2] += err_b * 0.1875
+        if dist < min_dist:
+            min_dist = dist
+            best_idx = i
 
-                error[y + 1, x, 0] += err_r * 0.3125  # 5/16
-                error[y + 1, x, 1] += err_g * 0.3125
-                error[y + 1, x, 2] += err_b * 0.3125
+    return best_idx
 
-                if x + 1 < width:
-                    error[y + 1, x + 1, 0] += err_r * 0.0625  # 1/16
-                    error[y + 1, x + 1, 1] += err_g * 0.0625
-                    error[y + 1, x + 1, 2] += err_b * 0.0625
 
-    return output
+@jit(nopython=True, cache=True)
+def _find_nearest(r: float, g: float, b: float, palette: np.ndarray, cells) -> int:
+    """Nearest palette index, through RGB cells when they are given."""
+    if cells is None:
+        return _find_nearest_color_fast(r, g, b, palette)
+    return _find_nearest_color_cells(r, g, b, palette, cells[0], cells[1])
 
 
 @jit(nopython=True, cache=True, parallel=True)
@@ -205,7 +193,8 @@ def ordered_dither_numba(
     pixels: np.ndarray,
     palette: np.ndarray,
     bayer: np.ndarray,
-    strength: float = 1.0
+    strength: float = 1.0,
+    cells=None
 ) -> np.ndarray:
     """
     Ordered (Bayer) dithering with Numba JIT.
@@ -218,6 +207,7 @@ def ordered_dither_numba(
         palette: Palette as (N, 3) float32 array
         bayer: Bayer matrix as (M, M) float32 array
         strength: Dithering intensity (0.0 to 2.0)
+        cells: Optional (offsets, candidates) from PaletteLookup.rgb_cells()
 
     Returns:
         Indexed image as (H, W) uint8 array
@@ -240,69 +230,271 @@ def ordered_dither_numba(
             b = max(0.0, min(255.0, pixels[y, x, 2] + threshold))
 
             # Find nearest palette color
-            output[y, x] = _find_nearest_color_fast(r, g, b, palette)
+            if cells is None:
+                output[y, x] = _find_nearest_color_fast(r, g, b, palette)
+            else:
+                output[y, x] = _find_nearest_color_cells(r, g, b, palette, cells[0], cells[1])
 
     return output
 
 
+# =============================================================================
+# ERROR DIFFUSION
+# =============================================================================
+#
+# Each error-diffusion method has a serial kernel, which pushes the error of
+# every pixel into its neighbours in scan order, and a wavefront kernel.
+#
+# The wavefront kernel runs rows in lock-step, each one block plus
+# WAVEFRONT_REACH columns behind the row above, so every neighbour a pixel
+# depends on was finished in an earlier step and all rows active in a step
+# run in parallel. Each pixel pulls the error of its finished neighbours
+# and adds it in the order the serial kernel would have pushed it, rounding
+# to float32 after each add as the serial error buffer does, so both give
+# identical output.
+#
+# Serpentine scans reverse every other row. A reversed row needs the whole
+# row above first, so serpentine always runs the serial kernel.
+
+# Columns ahead of a pixel that it reads in earlier rows (both kernels)
+WAVEFRONT_REACH = 1
+
+# Images smaller than this dither serially (scheduling costs more than it saves)
+WAVEFRONT_MIN_PIXELS = 1 << 14
+
+# Widest column block per row and step
+WAVEFRONT_MAX_BLOCK = 64
+
+
+def _wavefront_block(height: int, width: int, serpentine: bool) -> int:
+    """
+    Column block width for the wavefront kernels, or 0 to run serially.
+
+    Blocks are narrow enough that about two rows per thread are active at
+    once in a full-width band.
+    """
+    if not NUMBA_AVAILABLE or serpentine or height < 2:
+        return 0
+    threads = numba.get_num_threads()
+    if threads < 2 or height * width < WAVEFRONT_MIN_PIXELS:
+        return 0
+    return max(1, min(WAVEFRONT_MAX_BLOCK, width // (2 * threads)))
+
+
 @jit(nopython=True, cache=True)
-def atkinson_dither_numba(
+def _wavefront_steps(height: int, width: int, block: int) -> int:
+    """Steps until the last row has passed the right edge."""
+    lag = block + WAVEFRONT_REACH
+    return (width + (height - 1) * lag + block - 1) // block
+
+
+@jit(nopython=True, cache=True)
+def _wavefront_rows(step: int, height: int, width: int, block: int):
+    """
+    First and last row with columns to process in a step.
+
+    Row y covers columns [step * block - y * lag, + block) at each step.
+    """
+    lag = block + WAVEFRONT_REACH
+    first = max(0, (step * block - width) // lag + 1)
+    last = min(height - 1, (step * block + block - 1) // lag)
+    return first, last
+
+
+@jit(nopython=True, cache=True)
+def _floyd_steinberg_serial(
     pixels: np.ndarray,
-    palette: np.ndarray
+    palette: np.ndarray,
+    cells,
+    serpentine: bool
+) -> np.ndarray:
+    """Floyd-Steinberg in scan order, odd rows right-to-left if serpentine."""
+    height, width = pixels.shape[:2]
+    output = np.zeros((height, width), dtype=np.uint8)
+    error = pixels.astype(np.float32).copy()
+
+    for y in range(height):
+        # Scan direction; the kernel is mirrored on reversed rows
+        d = -1 if serpentine and y % 2 == 1 else 1
+        for i in range(width):
+            x = width - 1 - i if d < 0 else i
+
+            # Get current pixel (clamped)
+            old_r = max(0.0, min(255.0, error[y, x, 0]))
+            old_g = max(0.0, min(255.0, error[y, x, 1]))
+            old_b = max(0.0, min(255.0, error[y, x, 2]))
+
+            # Find nearest palette color
+            best_idx = _find_nearest(old_r, old_g, old_b, palette, cells)
+            output[y, x] = best_idx
+
+            # Calculate error
+            err_r = old_r - palette[best_idx, 0]
+            err_g = old_g - palette[best_idx, 1]
+            err_b = old_b - palette[best_idx, 2]
+
+            ahead = x + d
+            behind = x - d
+            has_ahead = 0 <= ahead < width
+            has_behind = 0 <= behind < width
+
+            # Distribute error (Floyd-Steinberg coefficients)
+            if has_ahead:
+                error[y, ahead, 0] += err_r * 0.4375  # 7/16
+                error[y, ahead, 1] += err_g * 0.4375
+                error[y, ahead, 2] += err_b * 0.4375
+
+            if y + 1 < height:
+                if has_behind:
+                    error[y + 1, behind, 0] += err_r * 0.1875  # 3/16
+                    error[y + 1, behind, 1] += err_g * 0.1875
+                    error[y + 1, behind, 2] += err_b * 0.1875
+
+                error[y + 1, x, 0] += err_r * 0.3125  # 5/16
+                error[y + 1, x, 1] += err_g * 0.3125
+                error[y + 1, x, 2] += err_b * 0.3125
+
+                if has_ahead:
+                    error[y + 1, ahead, 0] += err_r * 0.0625  # 1/16
+                    error[y + 1, ahead, 1] += err_g * 0.0625
+                    error[y + 1, ahead, 2] += err_b * 0.0625
+
+    return output
+
+
+@jit(nopython=True, cache=True)
+def _floyd_steinberg_gather(
+    pixels: np.ndarray,
+    errors: np.ndarray,
+    y: int, x: int, c: int
+) -> float:
+    """Channel value of (y, x) after the error of its finished neighbours."""
+    width = pixels.shape[1]
+    v = pixels[y, x, c]
+    if y > 0:
+        if x > 0:
+            v = np.float32(v + errors[y - 1, x - 1, c] * 0.0625)
+        v = np.float32(v + errors[y - 1, x, c] * 0.3125)
+        if x + 1 < width:
+            v = np.float32(v + errors[y - 1, x + 1, c] * 0.1875)
+    if x > 0:
+        v = np.float32(v + errors[y, x - 1, c] * 0.4375)
+    return v
+
+
+@jit(nopython=True, cache=True, parallel=True)
+def _floyd_steinberg_wavefront(
+    pixels: np.ndarray,
+    palette: np.ndarray,
+    cells,
+    block: int
+) -> np.ndarray:
+    """Floyd-Steinberg on a skewed row schedule; pixels must be float32."""
+    height, width = pixels.shape[:2]
+    output = np.zeros((height, width), dtype=np.uint8)
+    errors = np.zeros((height, width, 3), dtype=np.float64)
+    lag = block + WAVEFRONT_REACH
+
+    for step in range(_wavefront_steps(height, width, block)):
+        first, last = _wavefront_rows(step, height, width, block)
+        for y in prange(first, last + 1):
+            start = step * block - y * lag
+            for x in range(max(0, start), min(width, start + block)):
+                old_r = max(0.0, min(255.0, _floyd_steinberg_gather(pixels, errors, y, x, 0)))
+                old_g = max(0.0, min(255.0, _floyd_steinberg_gather(pixels, errors, y, x, 1)))
+                old_b = max(0.0, min(255.0, _floyd_steinberg_gather(pixels, errors, y, x, 2)))
+
+                best_idx = _find_nearest(old_r, old_g, old_b, palette, cells)
+                output[y, x] = best_idx
+
+                errors[y, x, 0] = old_r - palette[best_idx, 0]
+                errors[y, x, 1] = old_g - palette[best_idx, 1]
+                errors[y, x, 2] = old_b - palette[best_idx, 2]
+
+    return output
+
+
+def floyd_steinberg_numba(
+    pixels: np.ndarray,
+    palette: np.ndarray,
+    cells=None,
+    serpentine: bool = False
 ) -> np.ndarray:
     """
-    Atkinson dithering - softer than Floyd-Steinberg.
+    Floyd-Steinberg error diffusion dithering with Numba JIT.
 
-    Only diffuses 3/4 of the error, resulting in higher contrast
-    and a distinctive "Mac-like" appearance.
+    10-50x faster than pure Python for large images. Large images run on
+    the wavefront schedule across all Numba threads, with the same output
+    as the serial scan.
 
     Args:
-        pixels: Input image as (H, W, 3) float32 array
-        palette: Palette as (N, 3) float32 array
+        pixels: Input image as (H, W, 3) float32 array, values 0-255
+        palette: Palette as (N, 3) float32 array, values 0-255
+        cells: Optional (offsets, candidates) from PaletteLookup.rgb_cells()
+        serpentine: Scan odd rows right-to-left (serial only)
 
     Returns:
         Indexed image as (H, W) uint8 array
     """
+    block = _wavefront_block(pixels.shape[0], pixels.shape[1], serpentine)
+    if block:
+        return _floyd_steinberg_wavefront(pixels.astype(np.float32), palette, cells, block)
+    return _floyd_steinberg_serial(pixels, palette, cells, serpentine)
+
+
+@jit(nopython=True, cache=True)
+def _atkinson_serial(
+    pixels: np.ndarray,
+    palette: np.ndarray,
+    cells,
+    serpentine: bool
+) -> np.ndarray:
+    """Atkinson in scan order, odd rows right-to-left if serpentine."""
     height, width = pixels.shape[:2]
     output = np.zeros((height, width), dtype=np.uint8)
     error = pixels.astype(np.float32).copy()
 
     for y in range(height):
-        for x in range(width):
+        d = -1 if serpentine and y % 2 == 1 else 1
+        for i in range(width):
+            x = width - 1 - i if d < 0 else i
+
             old_r = max(0.0, min(255.0, error[y, x, 0]))
             old_g = max(0.0, min(255.0, error[y, x, 1]))
             old_b = max(0.0, min(255.0, error[y, x, 2]))
 
-            best_idx = _find_nearest_color_fast(old_r, old_g, old_b, palette)
+            best_idx = _find_nearest(old_r, old_g, old_b, palette, cells)
             output[y, x] = best_idx
 
-            new_r = palette[best_idx, 0]
-            new_g = palette[best_idx, 1]
-            new_b = palette[best_idx, 2]
-
             # Atkinson: only diffuse 3/4 of error (1/8 each to 6 neighbors)
-            err_r = (old_r - new_r) / 8.0
-            err_g = (old_g - new_g) / 8.0
-            err_b = (old_b - new_b) / 8.0
+            err_r = (old_r - palette[best_idx, 0]) / 8.0
+            err_g = (old_g - palette[best_idx, 1]) / 8.0
+            err_b = (old_b - palette[best_idx, 2]) / 8.0
+
+            ahead = x + d
+            ahead2 = x + 2 * d
+            behind = x - d
+            has_ahead = 0 <= ahead < width
+            has_behind = 0 <= behind < width
 
             # Right
-            if x + 1 < width:
-                error[y, x + 1, 0] += err_r
-                error[y, x + 1, 1] += err_g
-                error[y, x + 1, 2] += err_b
+            if has_ahead:
+                error[y, ahead, 0] += err_r
+                error[y, ahead, 1] += err_g
+                error[y, ahead, 2] += err_b
 
             # Two right
-            if x + 2 < width:
-                error[y, x + 2, 0] += err_r
-                error[y, x + 2, 1] += err_g
-                error[y, x + 2, 2] += err_b
+            if 0 <= ahead2 < width:
+                error[y, ahead2, 0] += err_r
+                error[y, ahead2, 1] += err_g
+                error[y, ahead2, 2] += err_b
 
             if y + 1 < height:
                 # Below left
-                if x > 0:
-                    error[y + 1, x - 1, 0] += err_r
-                    error[y + 1, x - 1, 1] += err_g
-                    error[y + 1, x - 1, 2] += err_b
+                if has_behind:
+                    error[y + 1, behind, 0] += err_r
+                    error[y + 1, behind, 1] += err_g
+                    error[y + 1, behind, 2] += err_b
 
                 # Below
                 error[y + 1, x, 0] += err_r
@@ -310,10 +502,10 @@ def atkinson_dither_numba(
                 error[y + 1, x, 2] += err_b
 
                 # Below right
-                if x + 1 < width:
-                    error[y + 1, x + 1, 0] += err_r
-                    error[y + 1, x + 1, 1] += err_g
-                    error[y + 1, x + 1, 2] += err_b
+                if has_ahead:
+                    error[y + 1, ahead, 0] += err_r
+                    error[y + 1, ahead, 1] += err_g
+                    error[y + 1, ahead, 2] += err_b
 
             # Two below
             if y + 2 < height:
@@ -324,6 +516,90 @@ def atkinson_dither_numba(
     return output
 
 
+@jit(nopython=True, cache=True)
+def _atkinson_gather(
+    pixels: np.ndarray,
+    errors: np.ndarray,
+    y: int, x: int, c: int
+) -> float:
+    """Channel value of (y, x) after the error of its finished neighbours."""
+    width = pixels.shape[1]
+    v = pixels[y, x, c]
+    if y > 1:
+        v = np.float32(v + errors[y - 2, x, c])
+    if y > 0:
+        if x > 0:
+            v = np.float32(v + errors[y - 1, x - 1, c])
+        v = np.float32(v + errors[y - 1, x, c])
+        if x + 1 < width:
+            v = np.float32(v + errors[y - 1, x + 1, c])
+    if x > 1:
+        v = np.float32(v + errors[y, x - 2, c])
+    if x > 0:
+        v = np.float32(v + errors[y, x - 1, c])
+    return v
+
+
+@jit(nopython=True, cache=True, parallel=True)
+def _atkinson_wavefront(
+    pixels: np.ndarray,
+    palette: np.ndarray,
+    cells,
+    block: int
+) -> np.ndarray:
+    """Atkinson on a skewed row schedule; pixels must be float32."""
+    height, width = pixels.shape[:2]
+    output = np.zeros((height, width), dtype=np.uint8)
+    errors = np.zeros((height, width, 3), dtype=np.float64)
+    lag = block + WAVEFRONT_REACH
+
+    for step in range(_wavefront_steps(height, width, block)):
+        first, last = _wavefront_rows(step, height, width, block)
+        for y in prange(first, last + 1):
+            start = step * block - y * lag
+            for x in range(max(0, start), min(width, start + block)):
+                old_r = max(0.0, min(255.0, _atkinson_gather(pixels, errors, y, x, 0)))
+                old_g = max(0.0, min(255.0, _atkinson_gather(pixels, errors, y, x, 1)))
+                old_b = max(0.0, min(255.0, _atkinson_gather(pixels, errors, y, x, 2)))
+
+                best_idx = _find_nearest(old_r, old_g, old_b, palette, cells)
+                output[y, x] = best_idx
+
+                errors[y, x, 0] = (old_r - palette[best_idx, 0]) / 8.0
+                errors[y, x, 1] = (old_g - palette[best_idx, 1]) / 8.0
+                errors[y, x, 2] = (old_b - palette[best_idx, 2]) / 8.0
+
+    return output
+
+
+def atkinson_dither_numba(
+    pixels: np.ndarray,
+    palette: np.ndarray,
+    cells=None,
+    serpentine: bool = False
+) -> np.ndarray:
+    """
+    Atkinson dithering - softer than Floyd-Steinberg.
+
+    Only diffuses 3/4 of the error, resulting in higher contrast
+    and a distinctive "Mac-like" appearance. Large images run on the
+    wavefront schedule, like floyd_steinberg_numba.
+
+    Args:
+        pixels: Input image as (H, W, 3) float32 array
+        palette: Palette as (N, 3) float32 array
+        cells: Optional (offsets, candidates) from PaletteLookup.rgb_cells()
+        serpentine: Scan odd rows right-to-left (serial only)
+
+    Returns:
+        Indexed image as (H, W) uint8 array
+    """
+    block = _wavefront_block(pixels.shape[0], pixels.shape[1], serpentine)
+    if block:
+        return _atkinson_wavefront(pixels.astype(np.float32), palette, cells, block)
+    return _atkinson_serial(pixels, palette, cells, serpentine)
+
+
 # =============================================================================
 # DITHER ENGINE CLASS
 # =============================================================================
@@ -349,7 +625,7 @@ class DitherEngine:
         # Dither single image
         result = engine.dither(image, palette)
 
-        # Batch dither
+        # Batch dither (worker processes for large batches)
         results = engine.dither_batch(images, palette)
     """
 
@@ -357,7 +633,8 @@ class DitherEngine:
         self,
         method: DitherMethod = 'floyd-steinberg',
         strength: float = 1.0,
-        bayer_size: int = 4
+        bayer_size: int = 4,
+        serpentine: bool = False
     ):
         """
         Initialize dither engine.
@@ -366,10 +643,13 @@ class DitherEngine:
             method: Dithering algorithm
             strength: Dithering intensity (0.0-2.0, default 1.0)
             bayer_size: Bayer matrix size for ordered dithering (2, 4, or 8)
+            serpentine: Alternate scan direction per row for error diffusion
+                (fewer directional artifacts, but always single-threaded)
         """
         self.method = method
         self.strength = strength
         self.bayer_matrix = get_bayer_matrix(bayer_size)
+        self.serpentine = serpentine
         self._numba_available = NUMBA_AVAILABLE
 
     def dither(
@@ -391,20 +671,8 @@ class DitherEngine:
         if image.mode != 'RGB':
             image = image.convert('RGB')
 
-        pixels = np.array(image, dtype=np.float32)
-        palette_array = np.array(palette, dtype=np.float32)
-
-        # Apply dithering
-        if self.method == 'none':
-            indices = self._dither_none(pixels, palette_array)
-        elif self.method == 'ordered':
-            indices = ordered_dither_numba(
-                pixels, palette_array, self.bayer_matrix, self.strength
-            )
-        elif self.method == 'atkinson':
-            indices = atkinson_dither_numba(pixels, palette_array)
-        else:  # floyd-steinberg
-            indices = floyd_steinberg_numba(pixels, palette_array)
+        palette_array, cells = self._prepare_palette(palette)
+        indices = self._dither_array(np.asarray(image), palette, palette_array, cells)
 
         # Create indexed PIL image
         result_img = self._create_indexed_image(indices, palette)
@@ -419,45 +687,83 @@ class DitherEngine:
         self,
         images: List[Image.Image],
         palette: List[RGB],
-        show_progress: bool = False
+        show_progress: bool = False,
+        workers: Optional[int] = None
     ) -> List[DitherResult]:
         """
         Batch dither multiple images with same palette.
 
+        The palette is converted once. Large batches are split across
+        worker processes, which read the frames from shared memory.
+
         Args:
             images: List of source images
             palette: Shared palette
             show_progress: Print progress (for large batches)
+            workers: Worker processes (default: CPU count, 1 = serial)
 
         Returns:
-            List of DitherResults
+            List of DitherResults, in input order
         """
-        results = []
         total = len(images)
+        frames = [np.asarray(img if img.mode == 'RGB' else img.convert('RGB'))
+                  for img in images]
+        palette_array, cells = self._prepare_palette(palette)
+
+        last = 0
+
+        def report(done: int):
+            nonlocal last
+            if done // 10 > last // 10:
+                print(f"  Dithered {done}/{total} images...")
+            last = done
+
+        outputs = map_frames(_dither_frame, frames,
+                             args=(self, palette, palette_array, cells),
+                             workers=workers, min_pixels=BATCH_PARALLEL_MIN_PIXELS,
+                             progress=report if show_progress else None)
+
+        return [
+            DitherResult(
+                image=self._create_indexed_image(indices, palette),
+                indices=indices,
+                palette=palette
+            )
+            for indices, _ in outputs
+        ]
 
-        for i, img in enumerate(images):
-            results.append(self.dither(img, palette))
-
-            if show_progress and (i + 1) % 10 == 0:
-                print(f"  Dithered {i + 1}/{total} images...")
-
-        return results
+    def _prepare_palette(
+        self,
+        palette: List[RGB]
+    ) -> Tuple[np.ndarray, Optional[Tuple[np.ndarray, np.ndarray]]]:
+        """Float32 palette and, for large palettes, its RGB cells."""
+        palette_array = np.array(palette, dtype=np.float32)
+        # A plain scan is as fast for small palettes
+        cells = None
+        if self.method != 'none' and len(palette) > CELL_SEARCH_MIN_COLORS:
+            cells = get_palette_lookup(palette, 'RGB').rgb_cells()
+        return palette_array, cells
 
-    def _dither_none(
+    def _dither_array(
         self,
         pixels: np.ndarray,
-        palette: np.ndarray
+        palette: List[RGB],
+        palette_array: np.ndarray,
+        cells
     ) -> np.ndarray:
-        """Direct quantization without dithering."""
-        height, width = pixels.shape[:2]
-        output = np.zeros((height, width), dtype=np.uint8)
-
-        for y in range(height):
-            for x in range(width):
-                r, g, b = pixels[y, x]
-                output[y, x] = _find_nearest_color_fast(r, g, b, palette)
+        """Dither an (H, W, 3) RGB array to palette indices."""
+        if self.method == 'none':
+            return get_palette_lookup(palette, 'RGB').nearest(pixels).astype(np.uint8)
 
-        return output
+        pixels = pixels.astype(np.float32)
+        if self.method == 'ordered':
+            return ordered_dither_numba(
+                pixels, palette_array, self.bayer_matrix, self.strength, cells
+            )
+        elif self.method == 'atkinson':
+            return atkinson_dither_numba(pixels, palette_array, cells, self.serpentine)
+        else:  # floyd-steinberg
+            return floyd_steinberg_numba(pixels, palette_array, cells, self.serpentine)
 
     def _create_indexed_image(
         self,
@@ -466,8 +772,7 @@ class DitherEngine:
     ) -> Image.Image:
         """Create PIL indexed image from index array."""
         height, width = indices.shape
-        result = Image.new('P', (width, height))
-        result.putdata(indices.flatten().tolist())
+        result = Image.frombytes('P', (width, height), indices.astype(np.uint8).tobytes())
 
         # Set palette (pad to 256 colors)
         flat_palette = []
@@ -479,6 +784,17 @@ class DitherEngine:
         return result
 
 
+def _dither_frame(
+    pixels: np.ndarray,
+    engine: DitherEngine,
+    palette: List[RGB],
+    palette_array: np.ndarray,
+    cells
+) -> Tuple[np.ndarray, None]:
+    """map_frames worker: dither one RGB frame."""
+    return engine._dither_array(pixels, palette, palette_array, cells), None
+
+
 # =============================================================================
 # CONVENIENCE FUNCTIONS
 # =============================================================================
@@ -0,0 +1,197 @@
+"""
+Shared-Memory Frame Pool for Batch Quantization.
+
+Runs a per-frame function over a batch of images in worker processes.
+Frames travel through one shared memory block instead of being pickled,
+and every worker writes its (H, W) uint8 results into a second block, so
+only small per-frame extras (error sums and the like) cross the pipe.
+
+Key Features:
+- Frames packed back to back into one input and one output segment
+- Contiguous chunks balanced by pixel count, results in input order
+- Serial fallback for small batches or when processes are unavailable
+- One Numba thread per worker (the processes supply the parallelism)
+
+Dependencies:
+    Required: numpy
+    Optional: numba (limits worker threads when present)
+
+Usage:
+    from tools.pipeline.quantization.frame_pool import map_frames
+
+    # func(pixels, *args) -> ((H, W) uint8 array, extra)
+    results = map_frames(func, [np.asarray(img) for img in images], args=(palette,))
+    for indices, extra in results:
+        ...
+"""
+
+import os
+from concurrent.futures import ProcessPoolExecutor
+from multiprocessing import get_context, shared_memory
+from typing import Any, Callable, List, Optional, Sequence, Tuple
+
+import numpy as np
+
+try:
+    import numba
+    NUMBA_AVAILABLE = True
+except ImportError:
+    NUMBA_AVAILABLE = False
+
+
+# =============================================================================
+# CONSTANTS
+# =============================================================================
+
+# Chunks per worker, so uneven frames still keep every worker busy
+CHUNKS_PER_WORKER = 4
+
+# (input offset, output offset, height, width) of one frame
+FrameSlot = Tuple[int, int, int, int]
+
+
+# =============================================================================
+# WORKER
+# =============================================================================
+
+def _init_worker():
+    """Process pool initializer: one Numba thread per process."""
+    if NUMBA_AVAILABLE:
+        numba.set_num_threads(1)
+
+
+def _frame_views(buffer, slots: Sequence[FrameSlot], channels: int) -> List[np.ndarray]:
+    """(H, W, channels) views of packed input frames."""
+    return [np.ndarray((height, width, channels), dtype=np.uint8, buffer=buffer, offset=offset)
+            for offset, _, height, width in slots]
+
+
+def _output_views(buffer, slots: Sequence[FrameSlot]) -> List[np.ndarray]:
+    """(H, W) views of packed output frames."""
+    return [np.ndarray((height, width), dtype=np.uint8, buffer=buffer, offset=offset)
+            for _, offset, height, width in slots]
+
+
+def _run_chunk(func: Callable, args: tuple, input_name: str, output_name: str,
+               slots: List[FrameSlot], channels: int) -> List[Any]:
+    """Process pool worker: run func over a chunk of shared frames."""
+    # Spawned workers share the parent's resource tracker, so attaching
+    # leaves the parent as the only owner that unlinks
+    source = shared_memory.SharedMemory(name=input_name)
+    target = shared_memory.SharedMemory(name=output_name)
+    try:
+        frames = _frame_views(source.buf, slots, channels)
+        outputs = _output_views(target.buf, slots)
+        extras = []
+        for frame, out in zip(frames, outputs):
+            indices, extra = func(frame, *args)
+            out[:] = indices
+            extras.append(extra)
+        # Views must be released before the segments close
+        del frames, outputs, frame, out
+        return extras
+    finally:
+        source.close()
+        target.close()
+
+
+# =============================================================================
+# BATCH MAPPING
+# =============================================================================
+
+def _chunks(sizes: Sequence[int], count: int) -> List[range]:
+    """Split frame indices into up to count contiguous runs of similar size."""
+    total = sum(sizes)
+    chunks, start, filled = [], 0, 0
+    for i, size in enumerate(sizes):
+        filled += size
+        # Close the run once it reaches its share of the total
+        if filled * count >= total * (len(chunks) + 1) or i == len(sizes) - 1:
+            chunks.append(range(start, i + 1))
+            start = i + 1
+    return chunks
+
+
+def map_frames(func: Callable[..., Tuple[np.ndarray, Any]],
+               frames: Sequence[np.ndarray],
+               args: tuple = (),
+               workers: Optional[int] = None,
+               min_pixels: int = 0,
+               progress: Optional[Callable[[int], None]] = None) -> List[Tuple[np.ndarray, Any]]:
+    """
+    Apply func to every frame, in a process pool if worthwhile.
+
+    Args:
+        func: Module-level func(pixels, *args) -> ((H, W) uint8 array, extra);
+            must be picklable, like args
+        frames: (H, W, C) uint8 frames, all with the same channel count
+        args: Extra arguments, sent once per chunk
+        workers: Processes (default: CPU count); 1 runs serially
+        min_pixels: Total pixels below which the batch runs serially
+        progress: Called with the number of finished frames
+
+    Returns:
+        (indices, extra) per frame, in input order
+    """
+    frames = [np.ascontiguousarray(frame, dtype=np.uint8) for frame in frames]
+    workers = workers or os.cpu_count() or 1
+    sizes = [frame.size for frame in frames]
+
+    if workers > 1 and len(frames) > 1 and sum(sizes) >= min_pixels:
+        try:
+            return _map_pool(func, frames, args, min(workers, len(frames)), progress)
+        except OSError as e:
+            # No process or shared memory support (sandboxes, some platforms)
+            print(f"[WARN] Process pool unavailable, processing serially: {e}")
+
+    results = []
+    for frame in frames:
+        results.append(func(frame, *args))
+        if progress:
+            progress(len(results))
+    return results
+
+
+def _map_pool(func: Callable, frames: List[np.ndarray], args: tuple,
+              workers: int, progress: Optional[Callable[[int], None]]) -> List[Tuple[np.ndarray, Any]]:
+    """map_frames through shared memory and a process pool."""
+    channels = frames[0].shape[2]
+    slots: List[FrameSlot] = []
+    in_offset = out_offset = 0
+    for frame in frames:
+        height, width = frame.shape[:2]
+        slots.append((in_offset, out_offset, height, width))
+        in_offset += frame.size
+        out_offset += height * width
+
+    source = shared_memory.SharedMemory(create=True, size=max(1, in_offset))
+    target = shared_memory.SharedMemory(create=True, size=max(1, out_offset))
+    try:
+        for frame, view in zip(frames, _frame_views(source.buf, slots, channels)):
+            view[:] = frame
+        del view
+
+        # Spawned workers: Numba's thread pools are not fork-safe
+        chunks = _chunks([frame.size for frame in frames], workers * CHUNKS_PER_WORKER)
+        extras: List[Any] = [None] * len(frames)
+        with ProcessPoolExecutor(max_workers=workers, mp_context=get_context('spawn'),
+                                 initializer=_init_worker) as pool:
+            futures = [
+                (chunk, pool.submit(_run_chunk, func, args, source.name, target.name,
+                                    [slots[i] for i in chunk], channels))
+                for chunk in chunks
+            ]
+            done = 0
+            for chunk, future in futures:
+                extras[chunk.start:chunk.stop] = future.result()
+                done += len(chunk)
+                if progress:
+                    progress(done)
+
+        return [(indices.copy(), extra)
+                for indices, extra in zip(_output_views(target.buf, slots), extras)]
+    finally:
+        source.close()
+        source.unlink()
+        target.close()
+        target.unlink()
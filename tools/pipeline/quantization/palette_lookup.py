@@ -0,0 +1,394 @@
+"""
+Palette Lookup Acceleration for Nearest-Colour Search.
+
+Every quantizer in the pipeline asks the same question millions of times:
+"which palette entry is closest to this colour?". This module answers it
+once per distinct colour and shares the answer across call sites.
+
+Key Features:
+- One PaletteLookup per (palette, metric), cached by get_palette_lookup()
+- Batch queries: distinct colours are found with np.unique and matched in
+  one vectorized distance pass, so a sprite sheet with a few thousand
+  colours costs a few thousand matches instead of one per pixel
+- Exact integer colours are memoized across calls, so repeated frames and
+  sheets sharing a palette only pay for colours never seen before
+- RGB cell lists for float queries (error-diffusion dithering): the RGB
+  cube is split into 16x16x16 cells and each cell keeps only the palette
+  entries that can be nearest anywhere inside it, typically 1-4 of them
+
+Results match a linear scan of the palette exactly, including ties (the
+lowest palette index wins).
+
+Metrics follow calculate_color_distance(): 'RGB', 'CIELab', 'CIEDE2000'
+and 'CAM02-UCS' when colorspacious is installed (otherwise it falls back
+to 'CIELab', as there).
+
+Usage:
+    from tools.pipeline.quantization.palette_lookup import get_palette_lookup
+
+    lookup = get_palette_lookup(palette, 'CIEDE2000')
+    indices = lookup.nearest(pixels)          # (H, W, 3) -> (H, W)
+    idx = lookup.nearest_one((200, 50, 50))
+
+    # Cell lists for the Numba dithering kernels
+    offsets, candidates = get_palette_lookup(palette, 'RGB').rgb_cells()
+"""
+
+from functools import lru_cache
+from typing import Dict, List, Optional, Sequence, Tuple
+
+import numpy as np
+
+from .color_kernels import srgb_to_lab, delta_e_matrix
+
+# Optional import for CAM02-UCS
+try:
+    import colorspacious
+    COLORSPACIOUS_AVAILABLE = True
+except ImportError:
+    COLORSPACIOUS_AVAILABLE = False
+
+
+# Type aliases
+RGB = Tuple[int, int, int]
+
+#: Bits of each channel that select an RGB cell (16 cells per axis)
+CELL_BITS = 4
+CELL_SHIFT = 8 - CELL_BITS
+CELLS_PER_AXIS = 1 << CELL_BITS
+
+#: Most integer colours one lookup memoizes (about 24 MB)
+MEMO_LIMIT = 1 << 20
+
+# Rows per vectorized distance pass (bounds the (rows, palette) matrix)
+_CHUNK = 1 << 15
+
+
+# =============================================================================
+# METRICS
+# =============================================================================
+
+def resolve_metric(metric: str) -> str:
+    """
+    Metric actually used for a requested method.
+
+    Mirrors calculate_color_distance(): CAM02-UCS needs colorspacious and
+    falls back to CIELab Euclidean without it.
+    """
+    if metric in ('RGB', 'CIEDE2000'):
+        return metric
+    if metric == 'CAM02-UCS' and COLORSPACIOUS_AVAILABLE:
+        return 'CAM02-UCS'
+    return 'CIELab'
+
+
+# =============================================================================
+# PALETTE LOOKUP
+# =============================================================================
+
+class PaletteLookup:
+    """
+    Nearest-colour search structure for one palette and metric.
+
+    Build through get_palette_lookup() so instances are shared; a lookup
+    never changes after construction apart from its memo of answered
+    integer colours.
+
+    Attributes:
+        palette: (K, 3) float64 palette colours
+        metric: Resolved distance metric
+    """
+
+    def __init__(self, palette: Sequence[RGB], metric: str = 'RGB'):
+        """
+        Build a lookup.
+
+        Args:
+            palette: Palette colours (0-255 per channel)
+            metric: 'RGB', 'CIELab', 'CIEDE2000' or 'CAM02-UCS'
+        """
+        if len(palette) == 0:
+            raise ValueError("Palette cannot be empty")
+
+        self.palette = np.array([c[:3] for c in palette], dtype=np.float64)
+        self.metric = resolve_metric(metric)
+
+        # Euclidean metrics compare in a fixed coordinate space
+        if self.metric == 'RGB':
+            self._coords = self.palette
+        elif self.metric in ('CIELab', 'CIEDE2000'):
+            self._coords = srgb_to_lab(self.palette)
+        else:
+            self._coords = self.palette / 255.0
+
+        # Memo of answered 24-bit colours, sorted by key: (keys, index, dist).
+        # Replaced whole in one assignment so concurrent readers never see
+        # arrays from different generations.
+        self._memo: Tuple[np.ndarray, np.ndarray, np.ndarray] = (
+            np.empty(0, dtype=np.int64),
+            np.empty(0, dtype=np.intp),
+            np.empty(0, dtype=np.float64),
+        )
+        self._scalar_memo: Dict[RGB, Tuple[int, float]] = {}
+
+        self._cells: Optional[Tuple[np.ndarray, np.ndarray]] = None
+        self._cell_lists: Optional[List[List[int]]] = None
+
+    def __len__(self) -> int:
+        return len(self.palette)
+
+    # -------------------------------------------------------------------------
+    # Distance passes
+    # -------------------------------------------------------------------------
+
+    def _match(self, colors: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
+        """Nearest index and distance for (M, 3) colours, in chunks."""
+        count = len(colors)
+        index = np.empty(count, dtype=np.intp)
+        dist = np.empty(count, dtype=np.float64)
+        rows = np.arange(min(count, _CHUNK))
+
+        for start in range(0, count, _CHUNK):
+            chunk = colors[start:start + _CHUNK]
+            d = self._distances(chunk)
+            best = np.argmin(d, axis=1)
+            index[start:start + len(chunk)] = best
+            dist[start:start + len(chunk)] = d[rows[:len(chunk)], best]
+
+        if self.metric in ('RGB', 'CIELab'):
+            np.sqrt(dist, out=dist)
+        return index, dist
+
+    def _distances(self, colors: np.ndarray) -> np.ndarray:
+        """(M, K) distances; squared for the Euclidean metrics."""
+        if self.metric == 'RGB':
+            q = colors
+        elif self.metric == 'CIELab':
+            q = srgb_to_lab(colors)
+        elif self.metric == 'CIEDE2000':
+            return delta_e_matrix(srgb_to_lab(colors), self._coords)
+        else:
+            return colorspacious.deltaE(colors[:, np.newaxis] / 255.0, self._coords[np.newaxis],
+                                        input_space="sRGB1")
+
+        diff = q[:, np.newaxis, :] - self._coords[np.newaxis, :, :]
+        return np.einsum('mkc,mkc->mk', diff, diff)
+
+    # -------------------------------------------------------------------------
+    # Queries
+    # -------------------------------------------------------------------------
+
+    def nearest(self, colors: np.ndarray) -> np.ndarray:
+        """
+        Nearest palette index for every colour.
+
+        Args:
+            colors: (..., 3) colours; uint8 / integer colours use the memo,
+                float colours are matched directly
+
+        Returns:
+            (...) intp palette indices
+        """
+        return self.nearest_with_distance(colors)[0]
+
+    def nearest_with_distance(self, colors: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Nearest palette index and its distance for every colour.
+
+        Distances are in the metric's units (RGB / Lab Euclidean, Delta E).
+
+        Args:
+            colors: (..., 3) colours
+
+        Returns:
+            ((...) intp indices, (...) float64 distances)
+        """
+        colors = np.asarray(colors)
+        shape = colors.shape[:-1]
+        flat = colors.reshape(-1, colors.shape[-1])[:, :3]
+
+        if np.issubdtype(flat.dtype, np.integer) and (
+                flat.size == 0 or (flat.min() >= 0 and flat.max() <= 255)):
+            index, dist = self._nearest_integer(flat)
+        else:
+            index, dist = self._match(flat.astype(np.float64))
+        return index.reshape(shape), dist.reshape(shape)
+
+    def _nearest_integer(self, flat: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
+        """Distinct 24-bit colours, answered from the memo where possible."""
+        c = flat.astype(np.int64)
+        keys = (c[:, 0] << 16) | (c[:, 1] << 8) | c[:, 2]
+        unique, inverse = np.unique(keys, return_inverse=True)
+
+        index = np.empty(len(unique), dtype=np.intp)
+        dist = np.empty(len(unique), dtype=np.float64)
+        known = np.zeros(len(unique), dtype=bool)
+        memo_keys, memo_index, memo_dist = self._memo
+        if len(memo_keys):
+            pos = np.minimum(np.searchsorted(memo_keys, unique), len(memo_keys) - 1)
+            known = memo_keys[pos] == unique
+            index[known] = memo_index[pos[known]]
+            dist[known] = memo_dist[pos[known]]
+
+        missing = ~known
+        if missing.any():
+            new_keys = unique[missing]
+            colors = np.stack([new_keys >> 16, (new_keys >> 8) & 0xFF, new_keys & 0xFF], axis=1)
+            new_index, new_dist = self._match(colors.astype(np.float64))
+            index[missing], dist[missing] = new_index, new_dist
+
+            # Merge into the sorted memo (a racing writer's additions may
+            # be lost, which only costs a later recompute)
+            if len(memo_keys) + len(new_keys) <= MEMO_LIMIT:
+                at = np.searchsorted(memo_keys, new_keys)
+                self._memo = (
+                    np.insert(memo_keys, at, new_keys),
+                    np.insert(memo_index, at, new_index),
+                    np.insert(memo_dist, at, new_dist),
+                )
+
+        return index[inverse.reshape(-1)], dist[inverse.reshape(-1)]
+
+    def nearest_one(self, rgb: Sequence[float]) -> int:
+        """Nearest palette index for a single colour."""
+        return self.nearest_one_with_distance(rgb)[0]
+
+    def nearest_one_with_distance(self, rgb: Sequence[float]) -> Tuple[int, float]:
+        """
+        Nearest palette index and distance for a single colour.
+
+        Integer colours are memoized; float colours are matched against the
+        RGB cell candidates (RGB metric) or the whole palette.
+        """
+        key = tuple(rgb[:3])
+        hit = self._scalar_memo.get(key)
+        if hit is not None:
+            return hit
+
+        if self.metric == 'RGB' and all(0 <= v <= 255 for v in key):
+            best, best_dist = 0, float('inf')
+            for i in self.cell_candidates(*key):
+                p = self.palette[i]
+                d = (key[0] - p[0]) ** 2 + (key[1] - p[1]) ** 2 + (key[2] - p[2]) ** 2
+                if d < best_dist:
+                    best, best_dist = int(i), d
+            result = (best, best_dist ** 0.5)
+        else:
+            index, dist = self._match(np.array([key], dtype=np.float64))
+            result = (int(index[0]), float(dist[0]))
+
+        if len(self._scalar_memo) < MEMO_LIMIT and all(isinstance(v, (int, np.integer)) for v in key):
+            self._scalar_memo[key] = result
+        return result
+
+    # -------------------------------------------------------------------------
+    # RGB cell lists
+    # -------------------------------------------------------------------------
+
+    def rgb_cells(self) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Candidate lists for RGB Euclidean search of float colours in 0-255.
+
+        A palette entry is a candidate for a cell if its closest possible
+        distance to the cell is within the smallest worst-case distance of
+        any entry, so the true nearest (and every tie) is always a
+        candidate. Candidates are kept in palette order.
+
+        Returns:
+            (offsets, candidates) int32 arrays in CSR form: the candidates
+            of cell i are candidates[offsets[i]:offsets[i + 1]], with
+            i = (r >> CELL_SHIFT) * 256 + (g >> CELL_SHIFT) * 16 + (b >> CELL_SHIFT)
+        """
+        if self._cells is None:
+            self._cells = build_rgb_cells(self.palette)
+        return self._cells
+
+    def cell_candidates(self, r: float, g: float, b: float) -> List[int]:
+        """
+        Palette indices that can be RGB-nearest to a colour in 0-255.
+
+        Scanning these in order with a strict '<' gives the same answer as
+        scanning the whole palette.
+        """
+        if self._cell_lists is None:
+            offsets, candidates = self.rgb_cells()
+            self._cell_lists = [candidates[offsets[c]:offsets[c + 1]].tolist()
+                                for c in range(len(offsets) - 1)]
+        return self._cell_lists[_cell_index(r, g, b)]
+
+
+def _cell_index(r: float, g: float, b: float) -> int:
+    """Cell of a colour clamped to 0-255."""
+    last = CELLS_PER_AXIS - 1
+    return ((min(int(r) >> CELL_SHIFT, last) << (2 * CELL_BITS))
+            | (min(int(g) >> CELL_SHIFT, last) << CELL_BITS)
+            | min(int(b) >> CELL_SHIFT, last))
+
+
+def build_rgb_cells(palette: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Build RGB cell candidate lists for a palette (see PaletteLookup.rgb_cells).
+
+    Args:
+        palette: (K, 3) palette colours, 0-255
+
+    Returns:
+        (offsets, candidates) int32 arrays
+    """
+    palette = np.asarray(palette, dtype=np.float64)[:, :3]
+    size = 256 // CELLS_PER_AXIS
+    axis = np.arange(CELLS_PER_AXIS, dtype=np.float64) * size
+    lo = np.stack(np.meshgrid(axis, axis, axis, indexing='ij'), axis=-1).reshape(-1, 1, 3)
+    hi = lo + size
+
+    p = palette[np.newaxis]
+    near = np.maximum(np.maximum(lo - p, p - hi), 0.0)
+    far = np.maximum(np.abs(p - lo), np.abs(p - hi))
+    dmin = (near * near).sum(axis=2)
+    dmax = (far * far).sum(axis=2)
+
+    # Slack keeps float32 / float64 rounding from dropping a tied entry
+    bound = dmax.min(axis=1, keepdims=True)
+    keep = dmin <= bound * (1 + 1e-6) + 1e-3
+
+    cells, entries = np.nonzero(keep)
+    offsets = np.zeros(len(lo) + 1, dtype=np.int32)
+    np.cumsum(np.bincount(cells, minlength=len(lo)), out=offsets[1:])
+    return offsets, entries.astype(np.int32)
+
+
+# =============================================================================
+# SHARED CACHE
+# =============================================================================
+
+def _palette_key(palette: Sequence[RGB]) -> Tuple[RGB, ...]:
+    return tuple((int(c[0]), int(c[1]), int(c[2])) for c in palette)
+
+
+@lru_cache(maxsize=64)
+def _cached_lookup(palette: Tuple[RGB, ...], metric: str) -> PaletteLookup:
+    return PaletteLookup(palette, metric)
+
+
+def get_palette_lookup(palette: Sequence[RGB], metric: str = 'RGB') -> PaletteLookup:
+    """
+    Shared PaletteLookup for a palette and metric.
+
+    Lookups are cached by palette contents and resolved metric, so every
+    caller quantizing to the same palette shares one memo.
+
+    Args:
+        palette: Palette colours (0-255 per channel)
+        metric: 'RGB', 'CIELab', 'CIEDE2000' or 'CAM02-UCS'
+
+    Returns:
+        PaletteLookup
+    """
+    if len(palette) == 0:
+        raise ValueError("Palette cannot be empty")
+    return _cached_lookup(_palette_key(palette), resolve_metric(metric))
+
+
+def clear_palette_lookups():
+    """Drop all cached lookups (and their memos)."""
+    _cached_lookup.cache_clear()
@@ -8,15 +8,16 @@ algorithms (CIEDE2000, CAM02-UCS).
 Phase: 0.7 (Foundation)
 
 Key Features:
-- CIEDE2000 color difference (most perceptually accurate)
+- CIEDE2000 color difference (most perceptually accurate, built in)
 - CAM02-UCS uniform color space
 - K-means clustering for optimal palette extraction
-- Fallback to RGB when optional dependencies unavailable
+- Array kernels for whole-image conversion (see color_kernels.py)
+- Process-pool batch quantization (quantize_batch)
 
 Dependencies:
     Required: numpy, pillow
-    Optional: colour-science (pip install colour-science)
-              colorspacious (pip install colorspacious)
+    Optional: colorspacious (pip install colorspacious) for CAM02-UCS
+              scikit-learn for k-means palette extraction
 
 Usage:
     from tools.pipeline.quantization import (
@@ -44,7 +45,12 @@ from dataclasses import dataclass
 import numpy as np
 from PIL import Image
 
-# Optional imports for advanced color science
+from .color_kernels import srgb_to_lab, lab_to_srgb, delta_e_cie76, delta_e_ciede2000
+from .frame_pool import map_frames
+from .palette_lookup import get_palette_lookup
+
+# Optional imports for advanced color science (CIEDE2000 is built in;
+# colour-science is only reported for callers that check the flag)
 try:
     import colour
     COLOUR_AVAILABLE = True
@@ -63,6 +69,10 @@ RGB = Tuple[int, int, int]
 LAB = Tuple[float, float, float]
 ColorMethod = Literal['CIEDE2000', 'CAM02-UCS', 'CIELab', 'RGB']
 
+# quantize_batch totals below these many pixels run in-process
+BATCH_PARALLEL_MIN_PIXELS = 1 << 22
+BATCH_PARALLEL_MIN_PIXELS_DITHERED = 1 << 16
+
 
 # =============================================================================
 # COLOR SPACE CONVERSION
@@ -72,8 +82,8 @@ def rgb_to_lab(rgb: RGB) -> LAB:
     """
     Convert RGB (0-255) to CIELab color space.
 
-    Uses colour-science if available, otherwise falls back to approximate
-    sRGB->XYZ->Lab conversion.
+    Scalar wrapper around color_kernels.srgb_to_lab (sRGB -> XYZ (D65) ->
+    Lab); convert whole images with srgb_to_lab directly.
 
     Args:
         rgb: RGB tuple with values 0-255
@@ -81,49 +91,7 @@ def rgb_to_lab(rgb: RGB) -> LAB:
     Returns:
         LAB tuple (L: 0-100, a: -128 to 128, b: -128 to 128)
     """
-    # Normalize to 0-1
-    r, g, b = rgb[0] / 255.0, rgb[1] / 255.0, rgb[2] / 255.0
-
-    if COLOUR_AVAILABLE:
-        # Use colour-science for accurate conversion
-        rgb_array = np.array([r, g, b])
-        xyz = colour.sRGB_to_XYZ(rgb_array)
-        lab = colour.XYZ_to_Lab(xyz)
-        return (float(lab[0]), float(lab[1]), float(lab[2]))
-
-    # Fallback: approximate sRGB -> XYZ -> Lab
-    # Apply gamma correction
-    def linearize(c):
-        if c > 0.04045:
-            return ((c + 0.055) / 1.055) ** 2.4
-        return c / 12.92
-
-    r_lin = linearize(r)
-    g_lin = linearize(g)
-    b_lin = linearize(b)
-
-    # sRGB to XYZ (D65 illuminant)
-    x = r_lin * 0.4124564 + g_lin * 0.3575761 + b_lin * 0.1804375
-    y = r_lin * 0.2126729 + g_lin * 0.7151522 + b_lin * 0.0721750
-    z = r_lin * 0.0193339 + g_lin * 0.1191920 + b_lin * 0.9503041
-
-    # Reference white D65
-    xn, yn, zn = 0.95047, 1.0, 1.08883
-
-    # XYZ to Lab
-    def f(t):
-        if t > 0.008856:
-            return t ** (1/3)
-        return (903.3 * t + 16) / 116
-
-    fx = f(x / xn)
-    fy = f(y / yn)
-    fz = f(z / zn)
-
-    L = 116 * fy - 16
-    a = 500 * (fx - fy)
-    b_val = 200 * (fy - fz)
-
+    L, a, b_val = srgb_to_lab(np.array(rgb[:3], dtype=np.float64)).tolist()
     return (L, a, b_val)
 
 
@@ -131,59 +99,15 @@ def lab_to_rgb(lab: LAB) -> RGB:
     """
     Convert CIELab to RGB (0-255).
 
+    Scalar wrapper around color_kernels.lab_to_srgb.
+
     Args:
         lab: LAB tuple (L: 0-100, a/b: approximately -128 to 128)
 
     Returns:
         RGB tuple with values 0-255, clamped to valid range
     """
-    L, a, b_val = lab
-
-    if COLOUR_AVAILABLE:
-        lab_array = np.array([L, a, b_val])
-        xyz = colour.Lab_to_XYZ(lab_array)
-        rgb = colour.XYZ_to_sRGB(xyz)
-        # Clamp and convert to 0-255
-        rgb = np.clip(rgb, 0, 1) * 255
-        return (int(rgb[0]), int(rgb[1]), int(rgb[2]))
-
-    # Fallback: Lab -> XYZ -> sRGB
-    # Reference white D65
-    xn, yn, zn = 0.95047, 1.0, 1.08883
-
-    fy = (L + 16) / 116
-    fx = a / 500 + fy
-    fz = fy - b_val / 200
-
-    def f_inv(t):
-        if t > 0.206893:
-            return t ** 3
-        return (116 * t - 16) / 903.3
-
-    x = xn * f_inv(fx)
-    y = yn * f_inv(fy)
-    z = zn * f_inv(fz)
-
-    # XYZ to sRGB
-    r_lin = x * 3.2404542 + y * -1.5371385 + z * -0.4985314
-    g_lin = x * -0.9692660 + y * 1.8760108 + z * 0.0415560
-    b_lin = x * 0.0556434 + y * -0.2040259 + z * 1.0572252
-
-    # Apply gamma
-    def gamma(c):
-        if c > 0.0031308:
-            return 1.055 * (c ** (1/2.4)) - 0.055
-        return 12.92 * c
-
-    r = gamma(r_lin)
-    g = gamma(g_lin)
-    b = gamma(b_lin)
-
-    # Clamp and convert to 0-255
-    r = int(max(0, min(255, r * 255)))
-    g = int(max(0, min(255, g * 255)))
-    b = int(max(0, min(255, b * 255)))
-
+    r, g, b = lab_to_srgb(np.array(lab[:3], dtype=np.float64)).astype(int).tolist()
     return (r, g, b)
 
 
@@ -203,7 +127,7 @@ def calculate_color_distance(
         c1: First RGB color (0-255)
         c2: Second RGB color (0-255)
         method: Distance calculation method:
-            - 'CIEDE2000': Most perceptually accurate (requires colour-science)
+            - 'CIEDE2000': Most perceptually accurate
             - 'CAM02-UCS': Uniform color space (requires colorspacious)
             - 'CIELab': Simple Euclidean in Lab space
             - 'RGB': Fast Euclidean in RGB space (least accurate)
@@ -218,15 +142,10 @@ def calculate_color_distance(
         db = c1[2] - c2[2]
         return math.sqrt(dr*dr + dg*dg + db*db)
 
-    if method == 'CIEDE2000' and COLOUR_AVAILABLE:
+    if method == 'CIEDE2000':
         # Industry standard for perceptual color difference
-        lab1 = rgb_to_lab(c1)
-        lab2 = rgb_to_lab(c2)
-        return float(colour.delta_E(
-            np.array(lab1),
-            np.array(lab2),
-            method='CIE 2000'
-        ))
+        lab = srgb_to_lab(np.array([c1[:3], c2[:3]], dtype=np.float64))
+        return float(delta_e_ciede2000(lab[0], lab[1]))
 
     if method == 'CAM02-UCS' and COLORSPACIOUS_AVAILABLE:
         # Uniform color space - good for palette design
@@ -237,13 +156,9 @@ def calculate_color_distance(
             input_space="sRGB1"
         ))
 
-    # Fallback to CIELab Euclidean
-    lab1 = rgb_to_lab(c1)
-    lab2 = rgb_to_lab(c2)
-    dL = lab1[0] - lab2[0]
-    da = lab1[1] - lab2[1]
-    db = lab1[2] - lab2[2]
-    return math.sqrt(dL*dL + da*da + db*db)
+    # CIELab Euclidean (also the CAM02-UCS fallback)
+    lab = srgb_to_lab(np.array([c1[:3], c2[:3]], dtype=np.float64))
+    return float(delta_e_cie76(lab[0], lab[1]))
 
 
 def find_nearest_perceptual(
@@ -270,16 +185,7 @@ def find_nearest_perceptual(
     if not palette:
         raise ValueError("Palette cannot be empty")
 
-    min_dist = float('inf')
-    best_idx = 0
-
-    for idx, pal_color in enumerate(palette):
-        dist = calculate_color_distance(rgb, pal_color, method)
-        if dist < min_dist:
-            min_dist = dist
-            best_idx = idx
-
-    return best_idx
+    return get_palette_lookup(palette, method).nearest_one(rgb)
 
 
 def find_nearest_rgb(rgb: RGB, palette: List[RGB]) -> int:
@@ -337,17 +243,14 @@ def extract_optimal_palette(
         image = image.convert('RGB')
 
     # Get pixel data
-    pixels = list(image.getdata())
+    pixels = np.asarray(image).reshape(-1, 3)
 
     # Sample if image is large
     if len(pixels) > sample_size:
         import random
-        pixels = random.sample(pixels, sample_size)
-
-    # Remove fully transparent pixels if RGBA
-    pixels = [p for p in pixels if len(p) < 4 or p[3] > 128]
+        pixels = pixels[random.sample(range(len(pixels)), sample_size)]
 
-    if not pixels:
+    if not len(pixels):
         # Fallback: return grayscale ramp
         step = 255 // (num_colors - 1) if num_colors > 1 else 255
         return [(i * step, i * step, i * step) for i in range(num_colors)]
@@ -355,12 +258,12 @@ def extract_optimal_palette(
     if method == 'kmeans':
         return _extract_kmeans(pixels, num_colors)
     elif method == 'median_cut':
-        return _extract_median_cut(pixels, num_colors)
+        return _extract_median_cut([tuple(p) for p in pixels.tolist()], num_colors)
     else:  # octree
         return _extract_octree(image, num_colors)
 
 
-def _extract_kmeans(pixels: List[RGB], num_colors: int) -> List[RGB]:
+def _extract_kmeans(pixels: np.ndarray, num_colors: int) -> List[RGB]:
     """K-means clustering in Lab space for optimal palette."""
     try:
         from sklearn.cluster import KMeans
@@ -368,26 +271,23 @@ def _extract_kmeans(pixels: List[RGB], num_colors: int) -> List[RGB]:
     except ImportError:
         SKLEARN_AVAILABLE = False
 
+    pixels = np.asarray(pixels, dtype=np.uint8)[:, :3]
+
     if SKLEARN_AVAILABLE:
         # Convert to Lab for perceptually uniform clustering
-        lab_pixels = np.array([rgb_to_lab(p[:3]) for p in pixels])
+        lab_pixels = srgb_to_lab(pixels)
 
         kmeans = KMeans(n_clusters=num_colors, random_state=42, n_init=10)
         kmeans.fit(lab_pixels)
 
         # Convert cluster centers back to RGB
-        palette = []
-        for center in kmeans.cluster_centers_:
-            rgb = lab_to_rgb((center[0], center[1], center[2]))
-            palette.append(rgb)
-
-        return palette
+        centers = lab_to_srgb(kmeans.cluster_centers_).astype(int)
+        return [(r, g, b) for r, g, b in centers.tolist()]
 
     # Fallback: simple uniform sampling
-    pixels_array = np.array([p[:3] for p in pixels])
     # Take evenly spaced samples
-    indices = np.linspace(0, len(pixels_array) - 1, num_colors, dtype=int)
-    return [tuple(pixels_array[i]) for i in indices]
+    indices = np.linspace(0, len(pixels) - 1, num_colors, dtype=int)
+    return [tuple(int(v) for v in pixels[i]) for i in indices]
 
 
 def _extract_median_cut(pixels: List[RGB], num_colors: int) -> List[RGB]:
@@ -527,19 +427,70 @@ class PerceptualQuantizer:
         if image.mode != 'RGB':
             image = image.convert('RGB')
 
-        width, height = image.size
-        pixels = np.array(image)
-        output = np.zeros((height, width), dtype=np.uint8)
-        total_error = 0.0
+        output, total_error = self._quantize_array(np.array(image), palette, dither)
+
+        return QuantizationResult(
+            image=self._indexed_image(output, palette),
+            palette=palette,
+            color_map=output,
+            error_sum=total_error
+        )
 
+    def quantize_batch(
+        self,
+        images: List[Image.Image],
+        palette: List[RGB],
+        dither: bool = False,
+        workers: Optional[int] = None
+    ) -> List[QuantizationResult]:
+        """
+        Quantize many images to one palette.
+
+        Large batches are split across worker processes, which read the
+        frames from shared memory (see frame_pool.map_frames).
+
+        Args:
+            images: Source images
+            palette: Target palette colors
+            dither: Apply Floyd-Steinberg dithering
+            workers: Worker processes (default: CPU count, 1 = serial)
+
+        Returns:
+            QuantizationResults, in input order
+        """
+        frames = [np.asarray(img if img.mode == 'RGB' else img.convert('RGB'))
+                  for img in images]
+        # Dithering matches pixel by pixel in Python, so it pays off sooner
+        min_pixels = BATCH_PARALLEL_MIN_PIXELS_DITHERED if dither else BATCH_PARALLEL_MIN_PIXELS
+        outputs = map_frames(_quantize_frame, frames, args=(self, palette, dither),
+                             workers=workers, min_pixels=min_pixels)
+
+        return [
+            QuantizationResult(
+                image=self._indexed_image(output, palette),
+                palette=palette,
+                color_map=output,
+                error_sum=total_error
+            )
+            for output, total_error in outputs
+        ]
+
+    def _quantize_array(
+        self,
+        pixels: np.ndarray,
+        palette: List[RGB],
+        dither: bool
+    ) -> Tuple[np.ndarray, float]:
+        """Quantize an (H, W, 3) RGB array to palette indices."""
         if dither:
-            output, total_error = self._quantize_dithered(pixels, palette)
-        else:
-            output, total_error = self._quantize_direct(pixels, palette)
+            return self._quantize_dithered(pixels, palette)
+        return self._quantize_direct(pixels, palette)
 
-        # Create indexed image
-        result_img = Image.new('P', (width, height))
-        result_img.putdata(output.flatten().tolist())
+    @staticmethod
+    def _indexed_image(output: np.ndarray, palette: List[RGB]) -> Image.Image:
+        """Indexed image with the palette padded to 256 colors."""
+        height, width = output.shape
+        result_img = Image.frombytes('P', (width, height), output.astype(np.uint8).tobytes())
 
         # Set palette
         flat_palette = []
@@ -548,13 +499,7 @@ class PerceptualQuantizer:
         # Pad to 768 bytes (256 colors * 3)
         flat_palette.extend([0] * (768 - len(flat_palette)))
         result_img.putpalette(flat_palette)
-
-        return QuantizationResult(
-            image=result_img,
-            palette=palette,
-            color_map=output,
-            error_sum=total_error
-        )
+        return result_img
 
     def _quantize_direct(
         self,
@@ -562,18 +507,13 @@ class PerceptualQuantizer:
         palette: List[RGB]
     ) -> Tuple[np.ndarray, float]:
         """Direct quantization without dithering."""
-        height, width = pixels.shape[:2]
-        output = np.zeros((height, width), dtype=np.uint8)
-        total_error = 0.0
+        output = get_palette_lookup(palette, self.method).nearest(pixels)
 
-        for y in range(height):
-            for x in range(width):
-                rgb = tuple(pixels[y, x])
-                idx = find_nearest_perceptual(rgb, palette, self.method)
-                output[y, x] = idx
-                total_error += calculate_color_distance(rgb, palette[idx], 'RGB')
+        # Error is always reported as RGB Euclidean distance
+        diff = pixels.astype(np.float64) - np.array(palette, dtype=np.float64)[output]
+        total_error = float(np.sqrt((diff * diff).sum(axis=-1)).sum())
 
-        return output, total_error
+        return output.astype(np.uint8), total_error
 
     def _quantize_dithered(
         self,
@@ -587,6 +527,7 @@ class PerceptualQuantizer:
         total_error = 0.0
 
         strength = self.dither_strength
+        lookup = get_palette_lookup(palette, self.method)
 
         for y in range(height):
             for x in range(width):
@@ -594,7 +535,7 @@ class PerceptualQuantizer:
                 old_pixel = np.clip(old_pixel, 0, 255)
                 rgb = (int(old_pixel[0]), int(old_pixel[1]), int(old_pixel[2]))
 
-                idx = find_nearest_perceptual(rgb, palette, self.method)
+                idx = lookup.nearest_one(rgb)
                 new_pixel = np.array(palette[idx], dtype=np.float32)
                 output[y, x] = idx
 
@@ -641,16 +582,23 @@ class PerceptualQuantizer:
         return self.quantize(image, palette, dither=dither)
 
 
+def _quantize_frame(
+    pixels: np.ndarray,
+    quantizer: PerceptualQuantizer,
+    palette: List[RGB],
+    dither: bool
+) -> Tuple[np.ndarray, float]:
+    """map_frames worker: quantize one RGB frame."""
+    return quantizer._quantize_array(pixels, palette, dither)
+
+
 # =============================================================================
 # UTILITY FUNCTIONS
 # =============================================================================
 
 def get_available_methods() -> List[str]:
     """Return list of available color distance methods."""
-    methods = ['RGB', 'CIELab']
-
-    if COLOUR_AVAILABLE:
-        methods.append('CIEDE2000')
+    methods = ['RGB', 'CIELab', 'CIEDE2000']
 
     if COLORSPACIOUS_AVAILABLE:
         methods.append('CAM02-UCS')
@@ -660,8 +608,4 @@ def get_available_methods() -> List[str]:
 
 def get_recommended_method() -> ColorMethod:
     """Return best available color distance method."""
-    if COLOUR_AVAILABLE:
-        return 'CIEDE2000'
-    if COLORSPACIOUS_AVAILABLE:
-        return 'CAM02-UCS'
-    return 'CIELab'
+    return 'CIEDE2000'
@@ -61,6 +61,8 @@ from enum import Enum
 from datetime import datetime
 from pathlib import Path
 
+from .dependency_graph import write_if_changed
+
 
 class Compression(Enum):
     """
@@ -685,16 +687,22 @@ class SGDKResourceGenerator:
 
         content = "\n".join(lines)
 
-        # Write to file
-        output_dir = os.path.dirname(output_path)
-        if output_dir:
-            os.makedirs(output_dir, exist_ok=True)
-
-        with open(output_path, 'w', encoding='utf-8') as f:
-            f.write(content)
+        # Leave an identical file (timestamp aside) untouched so make does
+        # not rerun rescomp
+        write_if_changed(output_path, content, volatile_prefix="// Generated:")
 
         return content
 
+    def resource_paths(self) -> List[str]:
+        """
+        Files referenced by the .res file, in output order.
+
+        These are the inputs of the .res build step in a DependencyGraph.
+        """
+        groups = [self.palettes, self.sprites, self.tilesets, self.maps,
+                  self.images, self.music, self.sounds, self.binaries]
+        return [res.path for group in groups for res in group]
+
     def get_summary(self) -> Dict[str, int]:
         """Get summary of registered resources."""
         return {
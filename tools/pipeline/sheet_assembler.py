@@ -22,6 +22,8 @@ import json
 import math
 import os
 
+import numpy as np
+
 # Lazy imports for optional dependencies
 PIL_Image = None
 
@@ -127,6 +129,159 @@ class PackingAlgorithm(Enum):
     ROW = "row"                  # Simple row-by-row (for uniform sizes)
 
 
+class MaxRectsHeuristic(Enum):
+    """Free-rectangle choice for MaxRects packing."""
+    BEST_SHORT_SIDE_FIT = "bssf"  # Smallest leftover on the shorter side
+    BEST_LONG_SIDE_FIT = "blsf"   # Smallest leftover on the longer side
+    BEST_AREA_FIT = "baf"         # Smallest free rectangle that fits
+    CONTACT_POINT = "contact"     # Most edge contact with placed frames
+    BEST = "best"                 # Try every heuristic, keep the densest
+
+
+# =============================================================================
+# MaxRects Bin
+# =============================================================================
+
+class MaxRectsBin:
+    """
+    One MaxRects bin (Jukka Jylänki, "A Thousand Ways to Pack the Bin").
+
+    Tracks the maximal free rectangles of the bin. Placing a rectangle
+    splits every free rectangle it overlaps into up to four remainders,
+    then drops remainders contained in another free rectangle. Free and
+    used rectangles live in NumPy arrays, so scoring and splitting are
+    vectorized and thousands of frames pack without per-pair Python loops.
+    """
+
+    def __init__(self, width: int, height: int,
+                 heuristic: MaxRectsHeuristic = MaxRectsHeuristic.BEST_SHORT_SIDE_FIT):
+        if heuristic == MaxRectsHeuristic.BEST:
+            raise ValueError("MaxRectsBin needs a concrete heuristic")
+        self.width = width
+        self.height = height
+        self.heuristic = heuristic
+        self.used_area = 0
+        # Rows of (x, y, w, h)
+        self._free = np.array([[0, 0, width, height]], dtype=np.int64)
+        self._used = np.empty((0, 4), dtype=np.int64)
+
+    @property
+    def free_rects(self) -> List[Tuple[int, int, int, int]]:
+        """Current maximal free rectangles as (x, y, w, h)."""
+        return [tuple(int(v) for v in rect) for rect in self._free]
+
+    @property
+    def occupancy(self) -> float:
+        """Fraction of the bin covered by placed rectangles."""
+        return self.used_area / (self.width * self.height)
+
+    def find_position(self, width: int, height: int) -> Optional[Tuple[int, int]]:
+        """Best top-left position for a width x height rectangle, or None."""
+        free = self._free
+        fits = (free[:, 2] >= width) & (free[:, 3] >= height)
+        if not fits.any():
+            return None
+        cand = free[fits]
+
+        leftover_w = cand[:, 2] - width
+        leftover_h = cand[:, 3] - height
+        short = np.minimum(leftover_w, leftover_h)
+        long = np.maximum(leftover_w, leftover_h)
+
+        if self.heuristic == MaxRectsHeuristic.BEST_SHORT_SIDE_FIT:
+            keys = (long, short)
+        elif self.heuristic == MaxRectsHeuristic.BEST_LONG_SIDE_FIT:
+            keys = (short, long)
+        elif self.heuristic == MaxRectsHeuristic.BEST_AREA_FIT:
+            keys = (short, cand[:, 2] * cand[:, 3])
+        else:
+            keys = (-self._contact(cand[:, 0], cand[:, 1], width, height),)
+
+        # lexsort's last key is primary; ties go to the top-left-most position
+        best = np.lexsort((cand[:, 0], cand[:, 1]) + keys)[0]
+        return int(cand[best, 0]), int(cand[best, 1])
+
+    def insert(self, width: int, height: int) -> Optional[Tuple[int, int]]:
+        """Place a rectangle at its best position; None when it does not fit."""
+        pos = self.find_position(width, height)
+        if pos is not None:
+            self.place(pos[0], pos[1], width, height)
+        return pos
+
+    def place(self, x: int, y: int, width: int, height: int) -> None:
+        """Mark a rectangle as used and update the free list."""
+        free = self._free
+        fx, fy, fw, fh = free.T
+        right, bottom = x + width, y + height
+
+        hit = (fx < right) & (fx + fw > x) & (fy < bottom) & (fy + fh > y)
+        kept = free[~hit]
+        fx, fy, fw, fh = free[hit].T
+
+        at_right = np.full_like(fx, right)
+        at_bottom = np.full_like(fy, bottom)
+
+        # Up to four maximal remainders per overlapped free rectangle
+        pieces = np.concatenate([
+            np.stack([fx, fy, x - fx, fh], axis=1)[x > fx],
+            np.stack([at_right, fy, fx + fw - right, fh], axis=1)[right < fx + fw],
+            np.stack([fx, fy, fw, y - fy], axis=1)[y > fy],
+            np.stack([fx, at_bottom, fw, fy + fh - bottom], axis=1)[bottom < fy + fh],
+        ])
+        self._free = np.concatenate([kept, self._prune(pieces, kept)])
+
+        self._used = np.vstack([self._used, [x, y, width, height]])
+        self.used_area += width * height
+
+    @staticmethod
+    def _prune(pieces: np.ndarray, kept: np.ndarray) -> np.ndarray:
+        """
+        Drop new pieces contained in another free rectangle.
+
+        Untouched rectangles were already maximal, and every new piece lies
+        inside an old free rectangle, so only the new pieces can be
+        redundant: compare them with each other and with the kept list.
+        """
+        if not len(pieces):
+            return pieces
+
+        def inside(a, b):
+            # a[i] contained in b[j], as an (len(a), len(b)) matrix
+            return ((a[:, None, 0] >= b[None, :, 0]) &
+                    (a[:, None, 1] >= b[None, :, 1]) &
+                    (a[:, None, 0] + a[:, None, 2] <= b[None, :, 0] + b[None, :, 2]) &
+                    (a[:, None, 1] + a[:, None, 3] <= b[None, :, 1] + b[None, :, 3]))
+
+        redundant = inside(pieces, kept).any(axis=1) if len(kept) else \
+            np.zeros(len(pieces), dtype=bool)
+
+        among = inside(pieces, pieces)
+        np.fill_diagonal(among, False)
+        # Identical pieces contain each other: keep the first copy
+        duplicate = among & among.T
+        among &= ~np.triu(duplicate)
+        redundant |= among.any(axis=1)
+        return pieces[~redundant]
+
+    def _contact(self, xs: np.ndarray, ys: np.ndarray,
+                 width: int, height: int) -> np.ndarray:
+        """Edge length shared with the bin border and placed rectangles."""
+        score = (np.where(xs == 0, height, 0) + np.where(xs + width == self.width, height, 0) +
+                 np.where(ys == 0, width, 0) + np.where(ys + height == self.height, width, 0))
+        if not len(self._used):
+            return score
+
+        ux, uy, uw, uh = (c[None, :] for c in self._used.T)
+        x0, y0 = xs[:, None], ys[:, None]
+        x1, y1 = x0 + width, y0 + height
+
+        span_y = np.clip(np.minimum(y1, uy + uh) - np.maximum(y0, uy), 0, None)
+        span_x = np.clip(np.minimum(x1, ux + uw) - np.maximum(x0, ux), 0, None)
+        side = (ux == x1) | (ux + uw == x0)
+        flat = (uy == y1) | (uy + uh == y0)
+        return score + (span_y * side).sum(axis=1) + (span_x * flat).sum(axis=1)
+
+
 # =============================================================================
 # Sprite Sheet Assembler
 # =============================================================================
@@ -136,7 +291,8 @@ class SpriteSheetAssembler:
     Pack individual sprite frames into optimized sprite sheets.
 
     Features:
-    - Multiple bin-packing algorithms
+    - Multiple bin-packing algorithms (MaxRects with several heuristics)
+    - Multi-page output when frames overflow one sheet
     - Power-of-2 dimensions (VRAM friendly)
     - Configurable padding
     - Hotspot/pivot point support
@@ -158,6 +314,7 @@ class SpriteSheetAssembler:
         power_of_2: bool = True,
         algorithm: PackingAlgorithm = PackingAlgorithm.SHELF_BEST_FIT,
         background_color: Tuple[int, int, int, int] = (0, 0, 0, 0),
+        heuristic: MaxRectsHeuristic = MaxRectsHeuristic.BEST_SHORT_SIDE_FIT,
     ):
         """
         Initialize the assembler.
@@ -169,6 +326,7 @@ class SpriteSheetAssembler:
             power_of_2: Constrain dimensions to powers of 2
             algorithm: Packing algorithm to use
             background_color: RGBA background color (default transparent)
+            heuristic: Free-rectangle choice for MAXRECTS (BEST tries all)
         """
         self.max_width = max_width
         self.max_height = max_height
@@ -176,6 +334,7 @@ class SpriteSheetAssembler:
         self.power_of_2 = power_of_2
         self.algorithm = algorithm
         self.background_color = background_color
+        self.heuristic = heuristic
 
         # Frames to pack: (image, name, hotspot, metadata)
         self._frames: List[Tuple[Any, str, Tuple[int, int], Dict]] = []
@@ -249,8 +408,6 @@ class SpriteSheetAssembler:
         Returns:
             Tuple of (sheet_image, SheetLayout)
         """
-        Image = _ensure_pil()
-
         if not self._frames:
             raise ValueError("No frames to assemble")
 
@@ -266,6 +423,33 @@ class SpriteSheetAssembler:
         else:
             layout = self._pack_shelf(best_fit=True)
 
+        return self._render(layout, range(len(self._frames)))
+
+    def assemble_pages(self) -> List[Tuple['PIL_Image.Image', SheetLayout]]:
+        """
+        Pack all frames into as many max_width x max_height sheets as needed.
+
+        Pages are always packed with MaxRects (using self.heuristic), which
+        fills each page as tightly as it can before opening the next one.
+
+        Returns:
+            List of (sheet_image, SheetLayout), one per page
+        """
+        if not self._frames:
+            raise ValueError("No frames to assemble")
+
+        pages = []
+        for entries in self._maxrects_pages(self.heuristic):
+            indices = [index for index, _, _ in entries]
+            layout = self._layout_from(entries)
+            pages.append(self._render(layout, indices))
+        return pages
+
+    def _render(self, layout: SheetLayout,
+                indices) -> Tuple['PIL_Image.Image', SheetLayout]:
+        """Round the layout up if needed and paste its frames."""
+        Image = _ensure_pil()
+
         # Adjust to power of 2 if requested
         if self.power_of_2:
             layout.width = self._next_power_of_2(layout.width)
@@ -275,8 +459,8 @@ class SpriteSheetAssembler:
         sheet = Image.new('RGBA', (layout.width, layout.height), self.background_color)
 
         # Place each frame
-        for i, placement in enumerate(layout.frames):
-            img, _, _, _ = self._frames[i]
+        for index, placement in zip(indices, layout.frames):
+            img, _, _, _ = self._frames[index]
             sheet.paste(img, (placement.x, placement.y))
 
         return sheet, layout
@@ -423,66 +607,96 @@ class SpriteSheetAssembler:
         """
         MaxRects bin-packing algorithm.
 
-        More complex but achieves better packing density.
-        Uses the "Best Short Side Fit" heuristic.
+        More complex but achieves better packing density. Uses
+        self.heuristic; BEST keeps the densest of all heuristics.
         """
-        # Sort by area (largest first)
-        indexed_frames = list(enumerate(self._frames))
-        indexed_frames.sort(key=lambda x: x[1][0].width * x[1][0].height, reverse=True)
+        pages = self._maxrects_pages(self.heuristic)
+        if len(pages) > 1:
+            raise ValueError(
+                f"Frames don't fit in {self.max_width}x{self.max_height} sheet "
+                f"(need {len(pages)} pages, use assemble_pages())"
+            )
 
-        # Free rectangles (initially the whole sheet)
-        free_rects = [(self.padding, self.padding,
-                       self.max_width - self.padding,
-                       self.max_height - self.padding)]
+        placed = {index: (x, y) for index, x, y in pages[0]}
+        return self._layout_from(
+            [(index, *placed[index]) for index in range(len(self._frames))]
+        )
 
-        placements: List[Optional[FramePlacement]] = [None] * len(self._frames)
+    def _maxrects_pages(self,
+                        heuristic: MaxRectsHeuristic) -> List[List[Tuple[int, int, int]]]:
+        """
+        Pack frames into MaxRects pages.
 
-        for orig_idx, (img, name, hotspot, meta) in indexed_frames:
-            w, h = img.width + self.padding, img.height + self.padding
-
-            # Find best rectangle (Best Short Side Fit)
-            best_rect = None
-            best_short_side = float('inf')
-            best_idx = -1
-
-            for rect_idx, (rx, ry, rw, rh) in enumerate(free_rects):
-                if w <= rw and h <= rh:
-                    short_side = min(rw - w, rh - h)
-                    if short_side < best_short_side:
-                        best_short_side = short_side
-                        best_rect = (rx, ry, rw, rh)
-                        best_idx = rect_idx
-
-            if best_rect is None:
+        Returns:
+            Per page, a list of (frame_index, x, y)
+        """
+        if heuristic == MaxRectsHeuristic.BEST:
+            candidates = [
+                self._maxrects_pages(h) for h in MaxRectsHeuristic
+                if h != MaxRectsHeuristic.BEST
+            ]
+            return min(candidates, key=self._pages_cost)
+
+        pad = self.padding
+        bin_w, bin_h = self.max_width - pad, self.max_height - pad
+
+        # Largest first; long side breaks ties so strips go in early
+        order = sorted(
+            range(len(self._frames)),
+            key=lambda i: (self._frames[i][0].width * self._frames[i][0].height,
+                           max(self._frames[i][0].width, self._frames[i][0].height)),
+            reverse=True,
+        )
+
+        bins: List[MaxRectsBin] = []
+        pages: List[List[Tuple[int, int, int]]] = []
+        for index in order:
+            img, name = self._frames[index][0], self._frames[index][1]
+            w, h = img.width + pad, img.height + pad
+            if w > bin_w or h > bin_h:
                 raise ValueError(
                     f"Frame '{name}' ({img.width}x{img.height}) doesn't fit"
                 )
 
-            rx, ry, rw, rh = best_rect
-
-            # Place the frame
-            placements[orig_idx] = FramePlacement(
+            for page, page_bin in enumerate(bins):
+                pos = page_bin.insert(w, h)
+                if pos is not None:
+                    break
+            else:
+                bins.append(MaxRectsBin(bin_w, bin_h, heuristic))
+                pages.append([])
+                page, pos = len(bins) - 1, bins[-1].insert(w, h)
+
+            pages[page].append((index, pos[0] + pad, pos[1] + pad))
+
+        return pages
+
+    def _pages_cost(self, pages: List[List[Tuple[int, int, int]]]) -> Tuple[int, int, int]:
+        """Sort key for packings: fewer pages, then less sheet area."""
+        area = trimmed = 0
+        for entries in pages:
+            width = max(x + self._frames[i][0].width for i, x, _ in entries) + self.padding
+            height = max(y + self._frames[i][0].height for i, _, y in entries) + self.padding
+            trimmed += width * height
+            if self.power_of_2:
+                width = self._next_power_of_2(width)
+                height = self._next_power_of_2(height)
+            area += width * height
+        return len(pages), area, trimmed
+
+    def _layout_from(self, entries: List[Tuple[int, int, int]]) -> SheetLayout:
+        """Build a SheetLayout from (frame_index, x, y) positions."""
+        placements = []
+        for index, x, y in entries:
+            img, name, hotspot, meta = self._frames[index]
+            placements.append(FramePlacement(
                 name=name,
-                x=rx, y=ry,
+                x=x, y=y,
                 width=img.width, height=img.height,
                 hotspot_x=hotspot[0], hotspot_y=hotspot[1],
                 source_path=meta.get('source'),
                 metadata={k: v for k, v in meta.items() if k != 'source'}
-            )
-
-            # Split the rectangle
-            del free_rects[best_idx]
-
-            # Right remainder
-            if rw - w > 0:
-                free_rects.append((rx + w, ry, rw - w, rh))
-
-            # Bottom remainder
-            if rh - h > 0:
-                free_rects.append((rx, ry + h, w, rh - h))
-
-            # Merge overlapping free rectangles (simplified)
-            free_rects = self._merge_rects(free_rects)
+            ))
 
         # Calculate final dimensions
         max_width = max(p.x + p.width for p in placements) + self.padding
@@ -496,23 +710,6 @@ class SpriteSheetAssembler:
             power_of_2=self.power_of_2
         )
 
-    def _merge_rects(self, rects: List[Tuple]) -> List[Tuple]:
-        """Remove fully contained rectangles."""
-        result = []
-        for i, r1 in enumerate(rects):
-            contained = False
-            for j, r2 in enumerate(rects):
-                if i != j:
-                    # Check if r1 is contained in r2
-                    if (r1[0] >= r2[0] and r1[1] >= r2[1] and
-                        r1[0] + r1[2] <= r2[0] + r2[2] and
-                        r1[1] + r1[3] <= r2[1] + r2[3]):
-                        contained = True
-                        break
-            if not contained:
-                result.append(r1)
-        return result
-
     @staticmethod
     def _next_power_of_2(n: int) -> int:
         """Return the next power of 2 >= n."""
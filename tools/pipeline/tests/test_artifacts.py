@@ -0,0 +1,251 @@
+"""
+Tests for core/artifacts.py - stage memoization.
+
+Tests:
+- ArtifactStore get/put, misses, corrupt entries, clear
+- Size budget with least-recently-used eviction
+- Keys change with inputs and parameters only
+- Output file capture and restore
+- Pipeline._process_image re-runs only the stages whose inputs changed
+"""
+
+import os
+import pytest
+from pathlib import Path
+from PIL import Image
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.core import Pipeline, PipelineConfig, SafeguardConfig, EventEmitter
+from pipeline.core.artifacts import (
+    ArtifactStore, snapshot_dir, read_written, restore_files
+)
+
+
+class TestArtifactStore:
+    """Tests for ArtifactStore."""
+
+    def test_roundtrip(self, temp_dir):
+        """Stored artifacts load back unchanged."""
+        store = ArtifactStore(Path(temp_dir) / "store")
+        key = ArtifactStore.make_key("palette", ["abc"], {"colors": 16})
+        store.put(key, ([1, 2, 3], {"a.bin": b"\x01"}))
+
+        assert store.get(key) == ([1, 2, 3], {"a.bin": b"\x01"})
+        assert store.stats() == {"hits": 1, "misses": 0, "evictions": 0}
+
+    def test_miss(self, temp_dir):
+        """Unknown keys are misses."""
+        store = ArtifactStore(Path(temp_dir) / "store")
+        assert store.get("0" * 64) is None
+        assert store.stats()["misses"] == 1
+
+    def test_corrupt_entry_is_miss(self, temp_dir):
+        """Truncated entries are treated as misses."""
+        store = ArtifactStore(Path(temp_dir) / "store")
+        key = ArtifactStore.make_key("detect", ["abc"], {})
+        store.put(key, ("value", {}))
+        store._path(key).write_bytes(b"\x80")
+
+        assert store.get(key) is None
+
+    def test_clear(self, temp_dir):
+        """clear() removes every entry."""
+        store = ArtifactStore(Path(temp_dir) / "store")
+        for i in range(3):
+            store.put(ArtifactStore.make_key("s", [str(i)], {}), (i, {}))
+
+        assert store.clear() == 3
+        assert store.get(ArtifactStore.make_key("s", ["0"], {})) is None
+
+    def test_evicts_least_recently_used(self, temp_dir):
+        """Going over budget drops the entries not read for longest."""
+        store = ArtifactStore(Path(temp_dir) / "store", max_bytes=10_000)
+        keys = [ArtifactStore.make_key("s", [str(i)], {}) for i in range(3)]
+        for i, key in enumerate(keys):
+            store.put(key, (i, {"out.bin": bytes(3_000)}))
+            os.utime(store._path(key), ns=(i * 10**9, i * 10**9))
+        store.get(keys[0])  # Now the most recently used
+
+        store.put(ArtifactStore.make_key("s", ["3"], {}), (3, {"out.bin": bytes(3_000)}))
+
+        assert store.get(keys[0]) is not None
+        assert store.get(keys[1]) is None
+        assert store.stats()["evictions"] >= 1
+        assert store.size() <= 10_000
+
+    def test_size_tracks_puts_and_clear(self, temp_dir):
+        """size() matches the bytes on disk."""
+        store = ArtifactStore(Path(temp_dir) / "store")
+        store.put(ArtifactStore.make_key("s", [], {}), (0, {"a": bytes(500)}))
+        on_disk = sum(p.stat().st_size for p in store.cache_dir.glob("*/*.pkl"))
+
+        assert store.size() == on_disk
+        store.clear()
+        assert store.size() == 0
+
+    def test_key_depends_on_everything(self):
+        """Stage, inputs and parameters all change the key."""
+        base = ArtifactStore.make_key("convert", ["a", "b"], {"size": 32})
+
+        assert base == ArtifactStore.make_key("convert", ["a", "b"], {"size": 32})
+        assert base != ArtifactStore.make_key("export", ["a", "b"], {"size": 32})
+        assert base != ArtifactStore.make_key("convert", ["a", "c"], {"size": 32})
+        assert base != ArtifactStore.make_key("convert", ["a", "b"], {"size": 16})
+
+    def test_key_ignores_param_order(self):
+        """Parameter dict order does not matter."""
+        assert ArtifactStore.make_key("s", [], {"a": 1, "b": 2}) == \
+            ArtifactStore.make_key("s", [], {"b": 2, "a": 1})
+
+
+class TestOutputFiles:
+    """Tests for output file capture."""
+
+    def test_read_written(self, temp_dir):
+        """Only new or rewritten files are captured."""
+        out = Path(temp_dir)
+        (out / "old.txt").write_bytes(b"old")
+        before = snapshot_dir(out)
+        (out / "new.txt").write_bytes(b"new")
+        (out / "old.txt").write_bytes(b"changed")
+
+        assert read_written(out, before) == {"new.txt": b"new", "old.txt": b"changed"}
+
+    def test_same_stat_rewrite(self, temp_dir):
+        """A same-size rewrite within mtime resolution is still captured."""
+        out = Path(temp_dir)
+        path = out / "tiles.bin"
+        path.write_bytes(b"\x01\x02")
+        stat = path.stat()
+        before = snapshot_dir(out)
+        path.write_bytes(b"\x03\x04")
+        os.utime(path, ns=(stat.st_atime_ns, stat.st_mtime_ns))
+
+        assert read_written(out, before) == {"tiles.bin": b"\x03\x04"}
+
+    def test_untouched_files_ignored(self, temp_dir):
+        """Files left alone are not captured."""
+        out = Path(temp_dir)
+        (out / "keep.txt").write_bytes(b"keep")
+        before = snapshot_dir(out)
+
+        assert read_written(out, before) == {}
+
+    def test_restore(self, temp_dir):
+        """Recorded files are written back, creating the directory."""
+        out = Path(temp_dir) / "out"
+        restore_files(out, {"a.bin": b"\x01\x02"})
+        assert (out / "a.bin").read_bytes() == b"\x01\x02"
+
+
+class TestStageMemoization:
+    """Tests for memoized Pipeline._process_image stages."""
+
+    STAGES = ["preprocess", "palette", "detect", "convert", "export"]
+
+    @pytest.fixture
+    def setup(self, temp_dir, monkeypatch):
+        """Pipeline with counting stand-ins for every stage."""
+        config = PipelineConfig(
+            safeguards=SafeguardConfig(
+                dry_run=True,
+                cache_dir=str(Path(temp_dir) / ".cache")
+            )
+        )
+        source = Path(temp_dir) / "sprite.png"
+        Image.new("RGBA", (32, 32), (200, 40, 40, 255)).save(source)
+        calls = []
+
+        def make_pipeline():
+            pipeline = Pipeline(config, event_emitter=EventEmitter())
+
+            def preprocess(img):
+                calls.append("preprocess")
+                return img.crop((0, 0, 16, 16))
+
+            def palette(img):
+                calls.append("palette")
+                return [0x000, 0x00E]
+
+            def detect(img, category):
+                calls.append("detect")
+                return ["sprite"]
+
+            def convert(img, sprites, palette, output_dir):
+                calls.append("convert")
+                (Path(output_dir) / "sprite.bin").write_bytes(b"\x12\x34")
+                return [{"tile_size": 2}]
+
+            def export(results, palette, output_dir, input_path):
+                calls.append("export")
+                (Path(output_dir) / "metadata.json").write_text("{}")
+                return {"sprites_count": len(results)}
+
+            monkeypatch.setattr(pipeline, "_preprocess_image", preprocess)
+            monkeypatch.setattr(pipeline, "_extract_palette", palette)
+            monkeypatch.setattr(pipeline, "_detect_sprites", detect)
+            monkeypatch.setattr(pipeline, "_convert_sprites", convert)
+            monkeypatch.setattr(pipeline, "_export_results", export)
+            return pipeline
+
+        return config, source, calls, make_pipeline
+
+    def test_warm_run_skips_all_stages(self, setup, temp_dir):
+        """A second identical run loads every stage."""
+        config, source, calls, make_pipeline = setup
+        out = Path(temp_dir) / "out"
+
+        first = make_pipeline()._process_image(str(source), str(out))
+        assert calls == self.STAGES
+
+        calls.clear()
+        second = make_pipeline()._process_image(str(source), str(out))
+        assert calls == []
+        assert second == first
+
+    def test_export_setting_reruns_export_only(self, setup, temp_dir):
+        """Changing an export option keeps upstream stages cached."""
+        config, source, calls, make_pipeline = setup
+        out = Path(temp_dir) / "out"
+        make_pipeline()._process_image(str(source), str(out))
+
+        calls.clear()
+        config.export.generate_res_file = not config.export.generate_res_file
+        make_pipeline()._process_image(str(source), str(out))
+        assert calls == ["export"]
+
+    def test_source_change_reruns_everything(self, setup, temp_dir):
+        """New source content invalidates every stage."""
+        config, source, calls, make_pipeline = setup
+        out = Path(temp_dir) / "out"
+        make_pipeline()._process_image(str(source), str(out))
+
+        calls.clear()
+        Image.new("RGBA", (32, 32), (0, 0, 255, 255)).save(source)
+        make_pipeline()._process_image(str(source), str(out))
+        assert calls == self.STAGES
+
+    def test_cached_files_restored(self, setup, temp_dir):
+        """Cache hits write the stage's output files back."""
+        config, source, calls, make_pipeline = setup
+        out = Path(temp_dir) / "out"
+        make_pipeline()._process_image(str(source), str(out))
+        (out / "sprite.bin").unlink()
+        (out / "metadata.json").unlink()
+
+        make_pipeline()._process_image(str(source), str(out))
+        assert (out / "sprite.bin").read_bytes() == b"\x12\x34"
+        assert (out / "metadata.json").read_text() == "{}"
+
+    def test_disabled(self, setup, temp_dir):
+        """cache_stages=False always runs every stage."""
+        config, source, calls, make_pipeline = setup
+        config.processing.cache_stages = False
+        out = Path(temp_dir) / "out"
+        make_pipeline()._process_image(str(source), str(out))
+
+        calls.clear()
+        make_pipeline()._process_image(str(source), str(out))
+        assert calls == self.STAGES
@@ -0,0 +1,120 @@
+"""
+Tests for core/batch.py - concurrent Pipeline.process_batch.
+
+Tests:
+- Chain planning (same output directory, CPU/I-O classification, order)
+- Parallel batches match sequential results and event sequences
+- Process pool path for CPU-bound files
+"""
+
+import pytest
+from pathlib import Path
+from PIL import Image
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.core import Pipeline, PipelineConfig, SafeguardConfig, EventEmitter
+from pipeline.core.batch import plan_batch, is_cpu_bound
+
+
+def _config(temp_dir, **kwargs):
+    return PipelineConfig(
+        safeguards=SafeguardConfig(
+            dry_run=True,
+            cache_dir=str(Path(temp_dir) / ".cache")
+        ),
+        **kwargs
+    )
+
+
+def _run(config, input_dir, output_dir, workers):
+    """Run a batch, returning (results, [(type, message, data)] events)."""
+    events = []
+    emitter = EventEmitter()
+    emitter.on_all(events.append)
+    results = Pipeline(config, event_emitter=emitter).process_batch(
+        str(input_dir), str(output_dir), workers=workers
+    )
+    return results, [(e.type, getattr(e, 'message', None), e.data) for e in events]
+
+
+class TestPlanBatch:
+    """Tests for plan_batch and is_cpu_bound."""
+
+    def test_png_cpu_bound_offline(self, temp_dir):
+        """PNGs are CPU-bound without an online AI provider."""
+        assert is_cpu_bound(Path("a.png"), _config(temp_dir))
+        assert is_cpu_bound(Path("a.png"), _config(temp_dir, ai_provider="groq",
+                                                     offline_mode=True))
+
+    def test_png_io_bound_with_ai(self, temp_dir):
+        """AI analysis makes PNGs I/O-bound."""
+        assert not is_cpu_bound(Path("a.png"), _config(temp_dir, ai_provider="groq"))
+
+    def test_aseprite_io_bound(self, temp_dir):
+        """Aseprite exports are I/O-bound."""
+        assert not is_cpu_bound(Path("a.ase"), _config(temp_dir))
+        assert not is_cpu_bound(Path("a.ASEPRITE"), _config(temp_dir))
+
+    def test_same_stem_shares_chain(self, temp_dir):
+        """Files writing the same output directory run in one ordered chain."""
+        files = [Path("hero.png"), Path("slime.png"), Path("hero.ase")]
+        chains = plan_batch(files, "out", _config(temp_dir))
+
+        assert len(chains) == 2
+        hero = next(c for c in chains if 0 in c.indices)
+        assert hero.indices == [0, 2]
+        assert [Path(out).name for _, out in hero.jobs] == ["hero", "hero"]
+        assert not hero.cpu_bound
+
+    def test_largest_chain_first(self, temp_dir):
+        """Chains are ordered by input size, largest first."""
+        small = Path(temp_dir) / "small.png"
+        large = Path(temp_dir) / "large.png"
+        small.write_bytes(b"x" * 10)
+        large.write_bytes(b"x" * 1000)
+
+        chains = plan_batch([small, large], "out", _config(temp_dir))
+
+        assert [c.indices for c in chains] == [[1], [0]]
+        assert chains[0].cost == 1000
+
+
+class TestProcessBatch:
+    """Tests for Pipeline.process_batch."""
+
+    def test_threads_match_sequential(self, temp_dir):
+        """Parallel results and events equal a sequential run."""
+        input_dir = Path(temp_dir) / "in"
+        input_dir.mkdir()
+        for name in ["c", "a", "b", "d"]:
+            # No pre-exported JSON: each file fails the same way
+            (input_dir / f"{name}.ase").write_bytes(b"\0" * 16)
+        config = _config(temp_dir)
+
+        serial, serial_events = _run(config, input_dir, Path(temp_dir) / "s", 1)
+        parallel, parallel_events = _run(config, input_dir, Path(temp_dir) / "p", 3)
+
+        assert serial["failed"] == 4
+        assert [f["file"] for f in parallel["files"]] == [f["file"] for f in serial["files"]]
+        assert [f.get("error") for f in parallel["files"]] == \
+            [f.get("error") for f in serial["files"]]
+        assert parallel_events == serial_events
+
+    def test_process_pool(self, temp_dir):
+        """CPU-bound files run in worker processes with the same results."""
+        input_dir = Path(temp_dir) / "in"
+        input_dir.mkdir()
+        for i in range(3):
+            Image.new("RGBA", (16, 16), (i * 80, 0, 0, 255)).save(input_dir / f"s{i}.png")
+        (input_dir / "s0.ase").write_bytes(b"\0" * 16)
+        config = _config(temp_dir)
+
+        serial, serial_events = _run(config, input_dir, Path(temp_dir) / "s", 1)
+        parallel, parallel_events = _run(config, input_dir, Path(temp_dir) / "p", 2)
+
+        assert parallel["succeeded"] + parallel["failed"] == 4
+        assert [(f["file"], f["success"], f.get("error")) for f in parallel["files"]] == \
+            [(f["file"], f["success"], f.get("error")) for f in serial["files"]]
+        assert [e[:2] for e in parallel_events] == [e[:2] for e in serial_events]
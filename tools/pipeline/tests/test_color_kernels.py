@@ -0,0 +1,173 @@
+"""
+Tests for quantization/color_kernels.py - array color-science kernels.
+
+Tests:
+- CIEDE2000 against the Sharma, Wu & Dalal (2005) test data
+- NumPy and Numba CIEDE2000 matrix paths agree
+- sRGB <-> Lab array conversion against the scalar wrappers
+- Scalar wrappers in perceptual.py and palette_converter agree
+"""
+
+import pytest
+import numpy as np
+from pathlib import Path
+from PIL import Image
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.quantization import color_kernels
+from pipeline.quantization.color_kernels import (
+    srgb_to_lab,
+    lab_to_srgb,
+    delta_e_cie76,
+    delta_e_ciede2000,
+    delta_e_matrix,
+)
+from pipeline.quantization.perceptual import (
+    rgb_to_lab,
+    lab_to_rgb,
+    calculate_color_distance,
+    extract_optimal_palette,
+)
+from pipeline import palette_converter
+
+
+# (Lab 1, Lab 2, Delta E 2000), Sharma et al. Table 1
+SHARMA_PAIRS = [
+ ((50.0000, 2.6772, -79.7751), (50.0000, 0.0000, -82.7485), 2.0425),
+ ((50.0000, 3.1571, -77.2803), (50.0000, 0.0000, -82.7485), 2.8615),
+ ((50.0000, 2.8361, -74.0200), (50.0000, 0.0000, -82.7485), 3.4412),
+ ((50.0000, -1.3802, -84.2814), (50.0000, 0.0000, -82.7485), 1.0000),
+ ((50.0000, -1.1848, -84.8006), (50.0000, 0.0000, -82.7485), 1.0000),
+ ((50.0000, -0.9009, -85.5211), (50.0000, 0.0000, -82.7485), 1.0000),
+ ((50.0000, 0.0000, 0.0000), (50.0000, -1.0000, 2.0000), 2.3669),
+ ((50.0000, -1.0000, 2.0000), (50.0000, 0.0000, 0.0000), 2.3669),
+ ((50.0000, 2.4900, -0.0010), (50.0000, -2.4900, 0.0009), 7.1792),
+ ((50.0000, 2.4900, -0.0010), (50.0000, -2.4900, 0.0010), 7.1792),
+ ((50.0000, 2.4900, -0.0010), (50.0000, -2.4900, 0.0011), 7.2195),
+ ((50.0000, 2.4900, -0.0010), (50.0000, -2.4900, 0.0012), 7.2195),
+ ((50.0000, -0.0010, 2.4900), (50.0000, 0.0009, -2.4900), 4.8045),
+ ((50.0000, -0.0010, 2.4900), (50.0000, 0.0010, -2.4900), 4.8045),
+ ((50.0000, -0.0010, 2.4900), (50.0000, 0.0011, -2.4900), 4.7461),
+ ((50.0000, 2.5000, 0.0000), (50.0000, 0.0000, -2.5000), 4.3065),
+ ((50.0000, 2.5000, 0.0000), (73.0000, 25.0000, -18.0000), 27.1492),
+ ((50.0000, 2.5000, 0.0000), (61.0000, -5.0000, 29.0000), 22.8977),
+ ((50.0000, 2.5000, 0.0000), (56.0000, -27.0000, -3.0000), 31.9030),
+ ((50.0000, 2.5000, 0.0000), (58.0000, 24.0000, 15.0000), 19.4535),
+ ((50.0000, 2.5000, 0.0000), (50.0000, 3.1736, 0.5854), 1.0000),
+ ((50.0000, 2.5000, 0.0000), (50.0000, 3.2972, 0.0000), 1.0000),
+ ((50.0000, 2.5000, 0.0000), (50.0000, 1.8634, 0.5757), 1.0000),
+ ((50.0000, 2.5000, 0.0000), (50.0000, 3.2592, 0.3350), 1.0000),
+ ((60.2574, -34.0099, 36.2677), (60.4626, -34.1751, 39.4387), 1.2644),
+ ((63.0109, -31.0961, -5.8663), (62.8187, -29.7946, -4.0864), 1.2630),
+ ((61.2901, 3.7196, -5.3901), (61.4292, 2.2480, -4.9620), 1.8731),
+ ((35.0831, -44.1164, 3.7933), (35.0232, -40.0716, 1.5901), 1.8645),
+ ((22.7233, 20.0904, -46.6940), (23.0331, 14.9730, -42.5619), 2.0373),
+ ((36.4612, 47.8580, 18.3852), (36.2715, 50.5065, 21.2231), 1.4146),
+ ((90.8027, -2.0831, 1.4410), (91.1528, -1.6435, 0.0447), 1.4441),
+ ((90.9257, -0.5406, -0.9208), (88.6381, -0.8985, -0.7239), 1.5381),
+ ((6.7747, -0.2908, -2.4247), (5.8714, -0.0985, -2.2286), 0.6377),
+ ((2.0776, 0.0795, -1.1350), (0.9033, -0.0636, -0.5514), 0.9082),
+]
+
+
+@pytest.fixture
+def rng():
+    return np.random.default_rng(3)
+
+
+# =============================================================================
+# Delta E Tests
+# =============================================================================
+
+class TestCIEDE2000:
+    """CIEDE2000 reproduces the reference data."""
+
+    def test_sharma_pairs(self):
+        lab1 = np.array([p[0] for p in SHARMA_PAIRS])
+        lab2 = np.array([p[1] for p in SHARMA_PAIRS])
+        expected = np.array([p[2] for p in SHARMA_PAIRS])
+        assert delta_e_ciede2000(lab1, lab2) == pytest.approx(expected, abs=1e-4)
+
+    def test_symmetric(self):
+        lab1 = np.array([p[0] for p in SHARMA_PAIRS])
+        lab2 = np.array([p[1] for p in SHARMA_PAIRS])
+        assert delta_e_ciede2000(lab1, lab2) == pytest.approx(delta_e_ciede2000(lab2, lab1))
+
+    def test_matrix_matches_pairwise(self, rng):
+        lab1 = srgb_to_lab(rng.integers(0, 256, size=(50, 3), dtype=np.uint8))
+        lab2 = srgb_to_lab(rng.integers(0, 256, size=(20, 3), dtype=np.uint8))
+        expected = delta_e_ciede2000(lab1[:, None], lab2[None])
+        assert delta_e_matrix(lab1, lab2) == pytest.approx(expected, abs=1e-9)
+        assert delta_e_matrix(lab1, lab2, 'CIE76') == pytest.approx(
+            delta_e_cie76(lab1[:, None], lab2[None]))
+
+    def test_numpy_fallback_matches(self, rng, monkeypatch):
+        lab1 = srgb_to_lab(rng.integers(0, 256, size=(30, 3), dtype=np.uint8))
+        lab2 = srgb_to_lab(rng.integers(0, 256, size=(16, 3), dtype=np.uint8))
+        fast = delta_e_matrix(lab1, lab2)
+        monkeypatch.setattr(color_kernels, 'NUMBA_AVAILABLE', False)
+        assert delta_e_matrix(lab1, lab2) == pytest.approx(fast, abs=1e-9)
+
+    def test_unknown_method(self):
+        with pytest.raises(ValueError):
+            delta_e_matrix(np.zeros((1, 3)), np.zeros((1, 3)), 'CIE94')
+
+    def test_scalar_distance(self):
+        c1, c2 = (200, 30, 60), (180, 60, 40)
+        lab = srgb_to_lab(np.array([c1, c2], dtype=np.uint8))
+        assert calculate_color_distance(c1, c2, 'CIEDE2000') == pytest.approx(
+            float(delta_e_ciede2000(lab[0], lab[1])))
+        assert calculate_color_distance(c1, c2, 'CIELab') == pytest.approx(
+            float(delta_e_cie76(lab[0], lab[1])))
+
+
+# =============================================================================
+# Conversion Tests
+# =============================================================================
+
+class TestConversion:
+    """Array conversion agrees with the scalar wrappers."""
+
+    def test_uint8_table_matches_float_path(self, rng):
+        rgb = rng.integers(0, 256, size=(500, 3), dtype=np.uint8)
+        assert srgb_to_lab(rgb) == pytest.approx(srgb_to_lab(rgb.astype(np.float64)), abs=1e-12)
+
+    def test_image_shape(self, rng):
+        image = rng.integers(0, 256, size=(6, 9, 3), dtype=np.uint8)
+        assert srgb_to_lab(image).shape == (6, 9, 3)
+
+    def test_scalar_wrappers(self, rng):
+        for rgb in rng.integers(0, 256, size=(40, 3)).tolist():
+            lab = srgb_to_lab(np.array(rgb, dtype=np.float64))
+            assert rgb_to_lab(tuple(rgb)) == pytest.approx(tuple(lab))
+            assert palette_converter.rgb_to_lab(*rgb) == pytest.approx(tuple(lab))
+            assert lab_to_rgb(tuple(lab)) == pytest.approx(tuple(rgb), abs=1)
+
+    def test_reference_white(self):
+        L, a, b = rgb_to_lab((255, 255, 255))
+        assert L == pytest.approx(100, abs=1e-3)
+        assert abs(a) < 1e-2 and abs(b) < 1e-2
+
+    def test_roundtrip(self, rng):
+        rgb = rng.integers(0, 256, size=(1000, 3), dtype=np.uint8)
+        assert np.abs(lab_to_srgb(srgb_to_lab(rgb)) - rgb).max() < 0.01
+
+
+# =============================================================================
+# Palette Extraction Tests
+# =============================================================================
+
+class TestKMeansExtraction:
+    """k-means extraction works on arrays end to end."""
+
+    def test_extracts_requested_colors(self, rng):
+        pytest.importorskip("sklearn")
+        blocks = np.repeat(rng.integers(0, 256, size=(4, 1, 3), dtype=np.uint8), 64, axis=1)
+        image = Image.fromarray(np.repeat(blocks, 16, axis=0))
+        palette = extract_optimal_palette(image, num_colors=4)
+        found = sorted(palette)
+        expected = sorted(tuple(int(v) for v in c) for c in blocks[:, 0])
+        for got, want in zip(found, expected):
+            assert got == pytest.approx(want, abs=1)
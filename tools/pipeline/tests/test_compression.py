@@ -7,6 +7,7 @@ Tests Genesis-compatible compression algorithms including:
 - RLE compression/decompression
 - Auto format selection
 - Round-trip integrity
+- Decompression cost estimates
 """
 
 import pytest
@@ -17,6 +18,7 @@ sys.path.insert(0, str(Path(__file__).parent.parent.parent))
 
 from pipeline.genesis_compression import (
     CompressionFormat,
+    CompressionLevel,
     CompressionResult,
     GenesisCompressor,
     KosinskiCompressor,
@@ -29,7 +31,13 @@ from pipeline.genesis_compression import (
     compress_rle,
     decompress_rle,
     auto_select_format,
+    HashChainMatchFinder,
+    NATIVE_AVAILABLE,
+    CompressionCache,
+    DecompressionCost,
+    estimate_decompression_cost,
 )
+from pipeline.genesis_compression import genesis_compress
 
 
 class TestCompressionFormat:
@@ -145,6 +153,169 @@ class TestKosinskiCompressor:
         assert decompressed == data
 
 
+    def test_long_repetitive_data(self, compressor):
+        """Matches must stay within the 12-bit distance field beyond 4 KB."""
+        data = bytes(5000)
+        compressed = compressor.compress(data)
+        assert compressor.decompress(compressed) == data
+
+
+class TestHashChainMatchFinder:
+    """Tests that the indexed match finder equals a brute-force window scan."""
+
+    @staticmethod
+    def _brute_force(data, pos, window_size, max_match):
+        best_offset, best_length = 0, 0
+        max_len = min(max_match, len(data) - pos)
+        for offset in range(max(0, pos - window_size), pos):
+            length = 0
+            while length < max_len and data[offset + length] == data[pos + length]:
+                length += 1
+            if length > best_length:
+                best_offset, best_length = offset, length
+        return best_offset, best_length
+
+    @pytest.mark.parametrize("seed", [1, 2, 3])
+    def test_matches_brute_force(self, seed):
+        """Every reported match should equal the brute-force result."""
+        import random
+        rng = random.Random(seed)
+        # Low-entropy tile-like data produces long chains and ties
+        data = bytes(rng.choice(b'\x00\x11\x12\x21\x22') for _ in range(1500))
+        finder = HashChainMatchFinder(data, 256, 18, 3)
+
+        for pos in range(len(data)):
+            offset, length = finder.find(pos)
+            ref_offset, ref_length = self._brute_force(data, pos, 256, 18)
+            if ref_length >= 3:
+                assert (offset, length) == (ref_offset, ref_length)
+            else:
+                assert length < 3
+
+    def test_window_limit(self):
+        """Matches beyond the window should not be reported."""
+        data = b'ABCD' + bytes(300) + b'ABCD'
+        finder = HashChainMatchFinder(data, 256, 18, 3)
+        assert finder.find(len(data) - 4)[1] < 3
+
+
+class TestCompressionLevel:
+    """Tests for greedy / lazy / optimal parse levels."""
+
+    @staticmethod
+    def _samples():
+        import random
+        rng = random.Random(7)
+        noisy = bytes(rng.choice(b'\x00\x01\x10\x11\x12\x21') for _ in range(3000))
+        tiles = [bytes(rng.choice(b'\x00\x11\x22\x12') for _ in range(32)) for _ in range(6)]
+        bank = b''.join(rng.choice(tiles) for _ in range(80))
+        return [noisy, bank, bytes(range(256)) * 4]
+
+    @pytest.mark.parametrize("codec", [KosinskiCompressor, LZSSCompressor])
+    @pytest.mark.parametrize("level", list(CompressionLevel))
+    def test_roundtrip(self, codec, level):
+        """Every level should decode with the default decompressor."""
+        for data in self._samples():
+            compressed = codec(level=level).compress(data)
+            assert codec().decompress(compressed) == data
+
+    @pytest.mark.parametrize("codec", [KosinskiCompressor, LZSSCompressor])
+    def test_optimal_not_larger(self, codec):
+        """Optimal parse should never be larger than greedy or lazy."""
+        for data in self._samples():
+            greedy = len(codec(level=CompressionLevel.GREEDY).compress(data))
+            lazy = len(codec(level=CompressionLevel.LAZY).compress(data))
+            optimal = len(codec(level=CompressionLevel.OPTIMAL).compress(data))
+            # Optimal up to the padding of the final flag byte
+            assert optimal <= min(greedy, lazy) + 1
+
+    def test_optimal_beats_greedy(self):
+        """Optimal should find savings greedy misses on noisy data."""
+        data = self._samples()[0]
+        greedy = len(compress_kosinski(data))
+        optimal = len(compress_kosinski(data, level=CompressionLevel.OPTIMAL))
+        assert optimal < greedy
+
+    def test_level_from_string(self):
+        """Levels should be accepted by value."""
+        assert KosinskiCompressor(level="lazy").level == CompressionLevel.LAZY
+
+    def test_genesis_compressor_level(self):
+        """GenesisCompressor output should decode with a default instance."""
+        data = self._samples()[0]
+        result = GenesisCompressor(level=CompressionLevel.OPTIMAL).compress(
+            data, CompressionFormat.LZSS)
+        assert result.success
+        assert GenesisCompressor().decompress(result.data, result.format) == data
+
+
+@pytest.mark.skipif(not NATIVE_AVAILABLE, reason="native kernels not built")
+class TestNativeKernels:
+    """Fuzz tests that the C kernels match the pure Python codecs exactly."""
+
+    CODECS = [
+        lambda native, level: KosinskiCompressor(level=level, use_native=native),
+        lambda native, level: KosinskiCompressor(window_size=256, max_match=10,
+                                                 level=level, use_native=native),
+        lambda native, level: LZSSCompressor(level=level, use_native=native),
+        lambda native, level: LZSSCompressor(window_bits=8, length_bits=3,
+                                             min_match=2, level=level,
+                                             use_native=native),
+    ]
+
+    @staticmethod
+    def _random_inputs(seed, count=25):
+        import random
+        rng = random.Random(seed)
+        for _ in range(count):
+            alphabet = bytes(rng.sample(range(256), rng.randint(1, 12)))
+            size = rng.choice([0, 1, 2, 3, 17, 100, 1000, 5000])
+            yield bytes(rng.choice(alphabet) for _ in range(size))
+        yield rng.randbytes(4096)
+        yield bytes(20000)
+
+    @pytest.mark.parametrize("codec", range(len(CODECS)))
+    @pytest.mark.parametrize("level", list(CompressionLevel))
+    def test_lz_matches_python(self, codec, level):
+        """Native output should be byte-identical and round-trip."""
+        make = self.CODECS[codec]
+        native, python = make(True, level), make(False, level)
+        assert native._native and not python._native
+
+        for data in self._random_inputs(codec):
+            compressed = native.compress(data)
+            assert compressed == python.compress(data)
+            assert native.decompress(compressed) == data
+
+    def test_rle_matches_python(self):
+        """Native RLE should be byte-identical and round-trip."""
+        native, python = RLECompressor(), RLECompressor(use_native=False)
+        for data in self._random_inputs(5):
+            compressed = native.compress(data)
+            assert compressed == python.compress(data)
+            assert native.decompress(compressed) == data
+
+    def test_garbage_decompress_matches_python(self):
+        """Malformed streams should decode the same way as in Python."""
+        import random
+        rng = random.Random(11)
+        pairs = [(self.CODECS[i](True, CompressionLevel.GREEDY),
+                  self.CODECS[i](False, CompressionLevel.GREEDY))
+                 for i in range(len(self.CODECS))]
+        pairs.append((RLECompressor(), RLECompressor(use_native=False)))
+
+        for _ in range(50):
+            garbage = rng.randbytes(rng.randint(0, 64))
+            for native, python in pairs:
+                assert native.decompress(garbage) == python.decompress(garbage)
+
+    def test_fallback_flag(self):
+        """Unsupported configurations should fall back to Python."""
+        assert GenesisCompressor().native
+        assert not GenesisCompressor(use_native=False).native
+        assert not LZSSCompressor(window_bits=14, length_bits=4)._native
+
+
 class TestLZSSCompressor:
     """Tests for LZSS compression."""
 
@@ -315,6 +486,99 @@ class TestGenesisCompressor:
             assert result.success, f"{name} failed"
 
 
+class TestCompressionCache:
+    """Tests for the content-addressed cache and batched format comparison."""
+
+    @staticmethod
+    def _banks():
+        import random
+        rng = random.Random(5)
+        tiles = [bytes(rng.choice(b'\x00\x11\x12\x21') for _ in range(32))
+                 for _ in range(8)]
+        return [b''.join(rng.choice(tiles) for _ in range(40)) for _ in range(4)]
+
+    @staticmethod
+    def _payloads(report):
+        return {name: result.data for name, result in report.items()}
+
+    def test_warm_cache_hits(self, temp_dir):
+        """Second comparison should be served entirely from disk."""
+        data = self._banks()[0]
+        compressor = GenesisCompressor(cache=CompressionCache(temp_dir))
+
+        cold = compressor.compare_formats(data)
+        assert compressor.cache.stats() == {"hits": 0, "misses": 3}
+
+        warm = compressor.compare_formats(data)
+        assert compressor.cache.stats() == {"hits": 3, "misses": 3}
+        assert self._payloads(warm) == self._payloads(cold)
+        assert list(warm) == list(cold)
+
+    def test_cache_shared_with_compress(self, temp_dir):
+        """compress() should reuse entries written by compare_formats()."""
+        data = self._banks()[1]
+        compressor = GenesisCompressor(cache=CompressionCache(temp_dir))
+        report = compressor.compare_formats(data)
+
+        result = compressor.compress(data, CompressionFormat.LZSS)
+        assert compressor.cache.hits == 1
+        assert result.data == report['lzss'].data
+
+    def test_key_includes_parameters(self, temp_dir):
+        """Different parse levels must not share cache entries."""
+        data = self._banks()[2]
+        cache = CompressionCache(temp_dir)
+        GenesisCompressor(cache=cache).compare_formats(data)
+
+        optimal = GenesisCompressor(level=CompressionLevel.OPTIMAL, cache=cache)
+        result = optimal.compress(data, CompressionFormat.KOSINSKI)
+        assert result.data == compress_kosinski(data, level=CompressionLevel.OPTIMAL)
+
+    def test_clear(self, temp_dir):
+        """clear() should remove every entry."""
+        cache = CompressionCache(temp_dir)
+        GenesisCompressor(cache=cache).compare_formats(self._banks()[0])
+        assert cache.clear() == 3
+        assert cache.get(CompressionCache.make_key("0" * 64, "rle")) is None
+
+    def test_batch_matches_serial(self, monkeypatch):
+        """Pooled batch comparison should equal per-buffer serial results."""
+        monkeypatch.setattr(genesis_compress, 'PARALLEL_MIN_BYTES', 0)
+        monkeypatch.setattr(genesis_compress, 'PARALLEL_MIN_BYTES_NATIVE', 0)
+        banks = self._banks() + [b'']
+
+        pooled = GenesisCompressor(workers=2).compare_formats_batch(banks)
+        serial = GenesisCompressor(workers=1)
+
+        assert len(pooled) == len(banks)
+        for data, report in zip(banks, pooled):
+            assert self._payloads(report) == self._payloads(serial.compare_formats(data))
+
+    def test_pool_reused_until_close(self, monkeypatch):
+        """One pool serves every call until close()."""
+        monkeypatch.setattr(genesis_compress, 'PARALLEL_MIN_BYTES', 0)
+        monkeypatch.setattr(genesis_compress, 'PARALLEL_MIN_BYTES_NATIVE', 0)
+        compressor = GenesisCompressor(workers=2)
+        try:
+            compressor.compare_formats(self._banks()[0])
+            pool = compressor._executor
+            compressor.compare_formats(self._banks()[1])
+            assert pool is not None and compressor._executor is pool
+        finally:
+            compressor.close()
+
+        assert compressor._executor is None
+        compressor.close()  # Closing twice is harmless
+
+    def test_measured_auto_select(self, temp_dir):
+        """auto_select_format with a compressor should pick the smallest codec."""
+        data = self._banks()[3]
+        compressor = GenesisCompressor(cache=CompressionCache(temp_dir))
+        best = min(compressor.compare_formats(data).values(),
+                   key=lambda r: r.output_size)
+        assert auto_select_format(data, compressor) == best.format
+
+
 class TestAutoSelectFormat:
     """Tests for auto_select_format function."""
 
@@ -335,6 +599,41 @@ class TestAutoSelectFormat:
         assert fmt == CompressionFormat.KOSINSKI
 
 
+class TestDecompressionCost:
+    """Tests for estimate_decompression_cost."""
+
+    DATA = (bytes(range(64)) * 4 + b'\x00' * 256 + bytes(range(0, 256, 3))) * 2
+
+    @pytest.mark.parametrize("fmt", [CompressionFormat.KOSINSKI,
+                                     CompressionFormat.LZSS,
+                                     CompressionFormat.RLE])
+    def test_stream_walk_matches_output(self, fmt):
+        """Walking the token stream accounts for every output byte."""
+        compressed = GenesisCompressor().compress(self.DATA, fmt).data
+        cost = estimate_decompression_cost(compressed, fmt)
+
+        assert isinstance(cost, DecompressionCost)
+        assert cost.output_size == len(self.DATA)
+        assert cost.cycles > 0
+        assert cost.scanlines == pytest.approx(cost.cycles / 488)
+
+    def test_raw_is_cheapest(self):
+        """Uncompressed data costs less than any codec."""
+        compressor = GenesisCompressor()
+        raw = estimate_decompression_cost(self.DATA, CompressionFormat.NONE).cycles
+        for fmt in (CompressionFormat.KOSINSKI, CompressionFormat.RLE):
+            compressed = compressor.compress(self.DATA, fmt).data
+            assert estimate_decompression_cost(compressed, fmt).cycles > raw
+
+    def test_longer_matches_cost_less(self):
+        """A run decodes cheaper than the same size of varied data."""
+        compressor = GenesisCompressor()
+        run = compressor.compress(b'\x00' * 1024, CompressionFormat.KOSINSKI).data
+        mixed = compressor.compress(bytes(range(256)) * 4, CompressionFormat.KOSINSKI).data
+        assert (estimate_decompression_cost(run, CompressionFormat.KOSINSKI).cycles <
+                estimate_decompression_cost(mixed, CompressionFormat.KOSINSKI).cycles)
+
+
 class TestConvenienceFunctions:
     """Tests for module-level convenience functions."""
 
@@ -477,3 +776,35 @@ class TestRealWorldData:
 
         decompressed = compressor.decompress(result.data, result.format)
         assert decompressed == tilemap
+
+
+class TestBenchmark:
+    """Tests for the compression benchmark helpers."""
+
+    def test_benchmark_data(self):
+        """Each codec should report sizes, throughput and a clean round-trip."""
+        from pipeline.genesis_compression.benchmark import benchmark_data, format_report
+
+        data = bytes([0x11, 0x22, 0x00, 0x00] * 256)
+        results = benchmark_data(data, "tiles", repeat=1)
+
+        assert [r.format for r in results] == [
+            CompressionFormat.KOSINSKI, CompressionFormat.LZSS, CompressionFormat.RLE
+        ]
+        assert all(r.roundtrip_ok for r in results)
+        assert all(r.input_size == len(data) for r in results)
+        assert "TOTAL" in format_report(results)
+
+    def test_load_tile_bank_png(self, temp_dir):
+        """Images should be packed as 4bpp tiles (32 bytes per 8x8 tile)."""
+        from PIL import Image
+        from pipeline.genesis_compression.benchmark import load_tile_bank
+
+        img = Image.new('P', (16, 12), 3)
+        img.putpalette([i * 16 for i in range(16) for _ in range(3)])
+        path = Path(temp_dir) / "bank.png"
+        img.save(path)
+
+        data = load_tile_bank(path)
+        assert len(data) == 4 * 32  # 16x12 pads to 2x2 tiles
+        assert data[0] == 0x33
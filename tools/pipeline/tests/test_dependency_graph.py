@@ -0,0 +1,332 @@
+"""
+Tests for dependency_graph.py - incremental rebuilds.
+
+Tests:
+- write_if_changed leaves identical files (and timestamps) untouched
+- Steps run in dependency order, only downstream of the change
+- Early cutoff when an output comes out byte-identical
+- Failures block dependents and are retried
+- Persistence, cycle detection and concurrent queries
+- SGDK .res / palette header generators keep unchanged files
+- watch_assets builds the sheet -> sprite/tileset -> .res and palette header chain
+"""
+
+import os
+import pytest
+from pathlib import Path
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.dependency_graph import DependencyGraph, write_if_changed
+from pipeline.sgdk_resources import SGDKResourceGenerator
+from pipeline.palette_manager import PaletteManager
+from PIL import Image
+
+
+def _age(path: Path):
+    """Push a file's mtime into the past so rewrites are detectable."""
+    os.utime(path, ns=(0, 10**9))
+
+
+class TestWriteIfChanged:
+    """Tests for write_if_changed."""
+
+    def test_identical_not_written(self, temp_dir):
+        """Byte-identical content keeps the old mtime."""
+        path = Path(temp_dir) / "out" / "a.bin"
+        assert write_if_changed(path, b"\x01\x02")
+        _age(path)
+
+        assert not write_if_changed(path, b"\x01\x02")
+        assert path.stat().st_mtime_ns == 10**9
+
+    def test_changed_written(self, temp_dir):
+        """Different content replaces the file."""
+        path = Path(temp_dir) / "a.txt"
+        write_if_changed(path, "one")
+        assert write_if_changed(path, "two")
+        assert path.read_text() == "two"
+
+    def test_volatile_lines_ignored(self, temp_dir):
+        """Timestamp lines do not count as a change."""
+        path = Path(temp_dir) / "a.h"
+        write_if_changed(path, "// Generated: 1\nint x;", volatile_prefix="// Generated:")
+
+        assert not write_if_changed(path, "// Generated: 2\nint x;",
+                                    volatile_prefix="// Generated:")
+        assert write_if_changed(path, "// Generated: 3\nint y;",
+                                volatile_prefix="// Generated:")
+
+
+class TestDependencyGraph:
+    """Tests for DependencyGraph.update."""
+
+    @pytest.fixture
+    def chain(self, temp_dir):
+        """sheet.png -> tiles.bin -> resources.res -> resources.h, plus an unrelated step."""
+        root = Path(temp_dir)
+        (root / "sheet.png").write_bytes(b"sheet")
+        (root / "other.png").write_bytes(b"other")
+        calls = []
+        graph = DependencyGraph(root / "deps.json", root=root)
+
+        def copy_upper(inputs, outputs, params):
+            calls.append(outputs[0].name)
+            data = b"".join(p.read_bytes() for p in inputs)
+            write_if_changed(outputs[0], data.upper()[:params.get("limit", 100)])
+
+        graph.register_rule("copy", copy_upper)
+        graph.add_step("tiles", "copy", ["sheet.png"], ["tiles.bin"], {"limit": 3})
+        graph.add_step("res", "copy", ["tiles.bin"], ["resources.res"])
+        graph.add_step("header", "copy", ["resources.res"], ["resources.h"])
+        graph.add_step("other", "copy", ["other.png"], ["other.bin"])
+        graph.build_all()
+        calls.clear()
+        return root, graph, calls
+
+    def test_build_all(self, chain):
+        """Initial build produces every output."""
+        root, graph, calls = chain
+        assert (root / "resources.h").read_bytes() == b"SHE"
+        assert (root / "other.bin").read_bytes() == b"OTHER"
+
+    def test_touch_rebuilds_nothing(self, chain):
+        """A save with identical content runs no rules."""
+        root, graph, calls = chain
+        (root / "sheet.png").write_bytes(b"sheet")
+
+        report = graph.update([root / "sheet.png"])
+        assert calls == []
+        assert report.rebuilt == []
+
+    def test_change_rebuilds_downstream_in_order(self, chain):
+        """An edit rebuilds its chain only, producers first."""
+        root, graph, calls = chain
+        (root / "sheet.png").write_bytes(b"new")
+
+        report = graph.update([root / "sheet.png"])
+        assert calls == ["tiles.bin", "resources.res", "resources.h"]
+        assert report.changed_outputs == ["tiles.bin", "resources.res", "resources.h"]
+        assert (root / "resources.h").read_bytes() == b"NEW"
+
+    def test_identical_output_cuts_off(self, chain):
+        """Downstream steps skip when an output is byte-identical."""
+        root, graph, calls = chain
+        _age(root / "resources.res")
+        # Only the first 3 bytes reach tiles.bin, so this changes nothing downstream
+        (root / "sheet.png").write_bytes(b"sheet2")
+
+        report = graph.update([root / "sheet.png"])
+        assert calls == ["tiles.bin"]
+        assert report.changed_outputs == []
+        assert set(report.up_to_date) == {"res", "header"}
+        assert (root / "resources.res").stat().st_mtime_ns == 10**9
+
+    def test_missing_output_rebuilt(self, chain):
+        """A deleted output is regenerated even with unchanged inputs."""
+        root, graph, calls = chain
+        (root / "resources.h").unlink()
+
+        graph.update([root / "sheet.png"])
+        assert calls == ["resources.h"]
+
+    def test_failure_blocks_and_retries(self, chain):
+        """A failing step blocks dependents and runs again next time."""
+        root, graph, calls = chain
+        graph.register_rule("copy", lambda i, o, p: (_ for _ in ()).throw(ValueError("bad")))
+        (root / "sheet.png").write_bytes(b"new")
+
+        report = graph.update([root / "sheet.png"])
+        assert report.failed == {"tiles": "bad"}
+        assert report.blocked == ["res", "header"]
+
+        calls_after = []
+        graph.register_rule("copy", lambda i, o, p: calls_after.append(o[0].name)
+                            or write_if_changed(o[0], i[0].read_bytes()))
+        graph.update([root / "sheet.png"])
+        assert calls_after == ["tiles.bin", "resources.res", "resources.h"]
+
+    def test_failed_step_retried_when_inputs_unchanged(self, chain):
+        """A failed step is retried even though its inputs have not changed since."""
+        root, graph, calls = chain
+        copy = graph._rules["copy"]
+
+        def fail_res(inputs, outputs, params):
+            if outputs[0].name == "resources.res":
+                raise ValueError("bad")
+            copy(inputs, outputs, params)
+
+        graph.register_rule("copy", fail_res)
+        (root / "sheet.png").write_bytes(b"new")
+        report = graph.update([root / "sheet.png"])
+        assert report.failed == {"res": "bad"}
+        assert (root / "resources.res").read_bytes() == b"SHE"
+
+        graph.register_rule("copy", copy)
+        calls.clear()
+        report = graph.build_all()
+        assert "res" in report.rebuilt
+        assert (root / "resources.h").read_bytes() == b"NEW"
+
+    def test_persisted(self, chain):
+        """A reloaded graph remembers hashes and skips unchanged work."""
+        root, graph, calls = chain
+        reloaded = DependencyGraph(root / "deps.json", root=root)
+        reloaded.register_rule("copy", lambda i, o, p: calls.append(o[0].name))
+
+        assert set(reloaded.steps) == {"tiles", "res", "header", "other"}
+        assert reloaded.update([root / "sheet.png"]).rebuilt == []
+        assert calls == []
+
+    def test_redefined_step_reruns(self, chain):
+        """Changing a step's params forces it to run."""
+        root, graph, calls = chain
+        graph.add_step("tiles", "copy", ["sheet.png"], ["tiles.bin"], {"limit": 5})
+
+        graph.update([root / "sheet.png"])
+        assert calls == ["tiles.bin", "resources.res", "resources.h"]
+
+    def test_duplicate_producer_rejected(self, chain):
+        """Two steps cannot write the same file."""
+        root, graph, calls = chain
+        with pytest.raises(ValueError):
+            graph.add_step("dup", "copy", ["other.png"], ["tiles.bin"])
+
+    def test_cycle_detected(self, temp_dir):
+        """Cycles are reported instead of looping."""
+        graph = DependencyGraph(root=temp_dir)
+        graph.add_step("a", "copy", ["x"], ["y"])
+        graph.add_step("b", "copy", ["y"], ["x"])
+        with pytest.raises(ValueError, match="cycle"):
+            graph.affected(["x"])
+
+
+    def test_queries_while_adding_steps(self, temp_dir):
+        """tracks() from one thread is safe while another adds steps."""
+        import threading
+        graph = DependencyGraph(root=temp_dir)
+        errors = []
+
+        def add():
+            for i in range(3000):
+                graph.add_step(f"s{i}", "copy", [f"in{i}.png"], [f"out{i}.bin"])
+
+        def query():
+            try:
+                for i in range(3000):
+                    graph.tracks(f"in{i}.png")
+                    graph.producer(f"out{i}.bin")
+            except RuntimeError as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=add)] + [threading.Thread(target=query) for _ in range(3)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        assert errors == []
+        assert graph.tracks("in2999.png")
+
+
+class TestGenerators:
+    """Generators leave unchanged outputs untouched."""
+
+    def test_res_file_kept(self, temp_dir):
+        """Regenerating an identical .res keeps its mtime."""
+        path = Path(temp_dir) / "resources.res"
+        gen = SGDKResourceGenerator()
+        gen.add_palette("pal_player", "res/player_pal.png")
+        gen.add_sprite("spr_player", "res/player.png", 4, 4)
+        gen.generate(str(path))
+        _age(path)
+
+        gen.generate(str(path))
+        assert path.stat().st_mtime_ns == 10**9
+
+        gen.add_tileset("ts_level", "res/level.png")
+        gen.generate(str(path))
+        assert "ts_level" in path.read_text()
+
+    def test_resource_paths(self):
+        """resource_paths lists every referenced file."""
+        gen = SGDKResourceGenerator()
+        gen.add_sprite("spr_player", "res\\player.png", 4, 4)
+        gen.add_palette("pal_player", "res/player_pal.png")
+        assert gen.resource_paths() == ["res/player_pal.png", "res/player.png"]
+
+    def test_palette_header_kept(self, temp_dir):
+        """Re-exporting identical palettes keeps the header's mtime."""
+        path = Path(temp_dir) / "palettes.h"
+        manager = PaletteManager('genesis')
+        manager.define_slot(0, "player", [(0, 0, 0), (255, 0, 0)])
+        manager.export_c_header(str(path))
+        _age(path)
+
+        manager.export_c_header(str(path))
+        assert path.stat().st_mtime_ns == 10**9
+
+
+class TestWatchChain:
+    """watch_assets --deps builds the whole chain as graph steps."""
+
+    @pytest.fixture
+    def project(self, temp_dir, monkeypatch):
+        import watch_assets
+
+        # Stand-ins for the real converters: outputs follow the source bytes
+        def sprite(path, output_path):
+            write_if_changed(output_path, path.read_bytes())
+
+        def tileset(path, output_dir):
+            write_if_changed(output_dir / f"{path.stem}_tilemap.json", path.read_bytes())
+
+        monkeypatch.setattr(watch_assets, "process_sprite", sprite)
+        monkeypatch.setattr(watch_assets, "process_tileset", tileset)
+
+        root = Path(temp_dir)
+        Image.new('RGB', (32, 32), (200, 40, 40)).save(root / "hero.png")
+        Image.new('RGB', (16, 8), (40, 200, 40)).save(root / "level.png")
+        manager = PaletteManager('genesis')
+        manager.define_slot(0, "player", [(0, 0, 0), (255, 0, 0)])
+        manager.save(str(root / "palettes.json"))
+
+        graph = DependencyGraph(root / "deps.json", root=root)
+        sprites = watch_assets.make_graph_processor(graph, 'sprite', root / "palettes.json")
+        tilesets = watch_assets.make_graph_processor(graph, 'tileset')
+        sprites(root / "hero.png")
+        tilesets(root / "level.png")
+        return root, graph, manager
+
+    def test_chain_built(self, project):
+        root, graph, _ = project
+        res = (root / "output" / "resources.res").read_text()
+
+        assert 'spr_hero "sprites/hero.png" 4 4' in res
+        assert 'ts_level "../level.png"' in res
+        assert "pal_player" in (root / "output" / "palettes.h").read_text()
+        assert (root / "output" / "tilesets" / "level" / "level_tilemap.json").exists()
+        assert set(graph.steps["res"].inputs) == {"output/sprites/hero.png", "level.png"}
+
+    def test_edit_keeps_res(self, project):
+        """A sprite edit rebuilds the sprite; the identical .res is not rewritten."""
+        root, graph, _ = project
+        res = root / "output" / "resources.res"
+        _age(res)
+
+        Image.new('RGB', (32, 32), (40, 40, 200)).save(root / "hero.png")
+        report = graph.update([root / "hero.png"])
+
+        assert report.rebuilt == ["sprite:" + str(root / "hero.png"), "res"]
+        assert report.changed_outputs == ["output/sprites/hero.png"]
+        assert res.stat().st_mtime_ns == 10**9
+
+    def test_palette_edit(self, project):
+        """Palette definitions rebuild palettes.h only."""
+        root, graph, manager = project
+        manager.define_slot(1, "enemy", [(0, 0, 0), (0, 0, 255)])
+        manager.save(str(root / "palettes.json"))
+
+        report = graph.update([root / "palettes.json"])
+        assert report.rebuilt == ["palettes"]
+        assert "pal_enemy" in (root / "output" / "palettes.h").read_text()
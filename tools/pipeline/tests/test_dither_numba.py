@@ -5,7 +5,8 @@ Tests Numba-accelerated dithering including:
 - Floyd-Steinberg dithering
 - Ordered (Bayer) dithering
 - Atkinson dithering
-- DitherEngine class
+- Wavefront schedule and serpentine scan for error diffusion
+- DitherEngine class, including process-pool batches
 """
 
 import pytest
@@ -16,6 +17,8 @@ import sys
 from pathlib import Path
 sys.path.insert(0, str(Path(__file__).parent.parent.parent))
 
+from pipeline.quantization import dither_numba
+from pipeline.quantization.palette_lookup import PaletteLookup
 from pipeline.quantization.dither_numba import (
     get_bayer_matrix,
     floyd_steinberg_numba,
@@ -172,6 +175,82 @@ class TestAtkinsonDitherNumba:
         assert result.max() < len(simple_palette)
 
 
+class TestWavefront:
+    """The wavefront kernels reproduce the serial scan exactly."""
+
+    KERNELS = {
+        'floyd-steinberg': (dither_numba._floyd_steinberg_serial,
+                            dither_numba._floyd_steinberg_wavefront,
+                            floyd_steinberg_numba),
+        'atkinson': (dither_numba._atkinson_serial,
+                     dither_numba._atkinson_wavefront,
+                     atkinson_dither_numba),
+    }
+
+    @pytest.mark.parametrize("method", sorted(KERNELS))
+    @pytest.mark.parametrize("shape", [(1, 9), (2, 2), (7, 1), (23, 41)])
+    @pytest.mark.parametrize("block", [1, 2, 5, 64])
+    def test_matches_serial(self, method, shape, block):
+        serial, wavefront, _ = self.KERNELS[method]
+        rng = np.random.default_rng(block)
+        # Out-of-range values exercise the clamp
+        pixels = (rng.random(shape + (3,)) * 300 - 20).astype(np.float32)
+        palette = rng.integers(0, 256, size=(40, 3)).astype(np.float32)
+        cells = PaletteLookup([tuple(c) for c in palette.astype(int)]).rgb_cells()
+
+        for c in (None, cells):
+            assert (wavefront(pixels, palette, c, block)
+                    == serial(pixels, palette, c, False)).all()
+
+    @pytest.mark.parametrize("method", sorted(KERNELS))
+    def test_public_function_dispatches(self, method, monkeypatch):
+        serial, _, public = self.KERNELS[method]
+        rng = np.random.default_rng(3)
+        pixels = (rng.random((30, 50, 3)) * 255).astype(np.float32)
+        palette = rng.integers(0, 256, size=(8, 3)).astype(np.float32)
+
+        monkeypatch.setattr(dither_numba, '_wavefront_block', lambda h, w, serpentine: 4)
+        assert (public(pixels, palette) == serial(pixels, palette, None, False)).all()
+
+    def test_serial_for_small_or_serpentine(self):
+        assert dither_numba._wavefront_block(16, 16, False) == 0
+        assert dither_numba._wavefront_block(1024, 1024, True) == 0
+
+
+class TestSerpentine:
+    """Serpentine scan alternates row direction."""
+
+    @pytest.mark.parametrize("method", sorted(TestWavefront.KERNELS))
+    def test_first_row_matches_raster(self, method, genesis_palette):
+        serial = TestWavefront.KERNELS[method][0]
+        pixels = (np.random.default_rng(4).random((12, 20, 3)) * 255).astype(np.float32)
+        palette = np.array(genesis_palette, dtype=np.float32)
+
+        raster = serial(pixels, palette, None, False)
+        serpentine = serial(pixels, palette, None, True)
+
+        assert (serpentine[0] == raster[0]).all()
+        assert not (serpentine == raster).all()
+        assert serpentine.max() < len(genesis_palette)
+
+    def test_single_row_reversed_is_mirrored(self, genesis_palette):
+        # Row 1 of a serpentine scan sees no error from a black row 0 and
+        # scans right-to-left, so it mirrors a raster scan of the flipped row
+        rng = np.random.default_rng(5)
+        pixels = np.zeros((2, 24, 3), dtype=np.float32)
+        pixels[1] = rng.random((24, 3)) * 255
+        palette = np.array(genesis_palette, dtype=np.float32)
+
+        serpentine = floyd_steinberg_numba(pixels, palette, serpentine=True)
+        flipped = floyd_steinberg_numba(pixels[1:, ::-1].copy(), palette)
+        assert (serpentine[1] == flipped[0][::-1]).all()
+
+    def test_engine_option(self, test_image_gradient, genesis_palette):
+        engine = DitherEngine(method='atkinson', serpentine=True)
+        result = engine.dither(test_image_gradient, genesis_palette)
+        assert result.indices.shape == (test_image_gradient.height, test_image_gradient.width)
+
+
 class TestDitherEngine:
     """Tests for DitherEngine class."""
 
@@ -234,6 +313,23 @@ class TestDitherEngine:
         for result in results:
             assert isinstance(result, DitherResult)
 
+    def test_dither_batch_workers_match_serial(self, genesis_palette, monkeypatch):
+        """Worker processes give the same results, in input order."""
+        rng = np.random.default_rng(6)
+        images = [Image.fromarray(rng.integers(0, 256, size=(h, w, 3), dtype=np.uint8))
+                  for h, w in [(12, 20), (5, 9), (30, 4), (16, 16)]]
+        images.append(images[0].convert('RGBA'))
+        engine = DitherEngine(method='floyd-steinberg')
+        expected = [engine.dither(img, genesis_palette) for img in images]
+
+        monkeypatch.setattr(dither_numba, 'BATCH_PARALLEL_MIN_PIXELS', 0)
+        results = engine.dither_batch(images, genesis_palette, workers=2)
+
+        for got, want in zip(results, expected):
+            assert (got.indices == want.indices).all()
+            assert got.image.tobytes() == want.image.tobytes()
+            assert got.image.getpalette() == want.image.getpalette()
+
     def test_dither_converts_rgba(self, simple_palette):
         """Should handle RGBA images."""
         rgba_img = Image.new('RGBA', (8, 8), (255, 0, 0, 255))
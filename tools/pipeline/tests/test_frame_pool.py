@@ -0,0 +1,84 @@
+"""
+Tests for quantization/frame_pool.py - shared-memory frame batches.
+
+Tests:
+- Chunking by pixel count
+- Serial path, result order and progress
+- Fallback when the process pool is unavailable
+"""
+
+import pytest
+import numpy as np
+from pathlib import Path
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.quantization import frame_pool
+from pipeline.quantization.frame_pool import map_frames
+
+
+def _first_channel(pixels, offset):
+    """Frame function: channel 0 plus an offset, and the frame sum."""
+    return pixels[..., 0] + offset, int(pixels.sum())
+
+
+@pytest.fixture
+def frames():
+    rng = np.random.default_rng(2)
+    return [rng.integers(0, 200, size=(h, w, 3), dtype=np.uint8)
+            for h, w in [(4, 6), (9, 2), (1, 1), (16, 16), (3, 7)]]
+
+
+# =============================================================================
+# Chunking Tests
+# =============================================================================
+
+class TestChunks:
+    """Chunks are contiguous, cover every frame and balance pixels."""
+
+    @pytest.mark.parametrize("count", [1, 2, 3, 8, 20])
+    def test_cover_in_order(self, count):
+        sizes = [5, 1, 1, 30, 2, 2, 9, 4]
+        chunks = frame_pool._chunks(sizes, count)
+        assert [i for chunk in chunks for i in chunk] == list(range(len(sizes)))
+        assert len(chunks) <= count
+
+    def test_balanced(self):
+        chunks = frame_pool._chunks([1] * 100, 4)
+        assert [len(chunk) for chunk in chunks] == [25, 25, 25, 25]
+
+
+# =============================================================================
+# Mapping Tests
+# =============================================================================
+
+class TestMapFrames:
+    """map_frames keeps input order on every path."""
+
+    def test_serial(self, frames):
+        progress = []
+        results = map_frames(_first_channel, frames, args=(5,), workers=1,
+                             progress=progress.append)
+
+        assert progress == [1, 2, 3, 4, 5]
+        for frame, (indices, total) in zip(frames, results):
+            assert (indices == frame[..., 0] + 5).all()
+            assert total == int(frame.sum())
+
+    def test_small_batch_stays_serial(self, frames, monkeypatch):
+        def fail(*args):
+            raise AssertionError("pool used")
+        monkeypatch.setattr(frame_pool, '_map_pool', fail)
+        map_frames(_first_channel, frames, args=(0,), workers=4, min_pixels=10 ** 6)
+
+    def test_pool_unavailable_falls_back(self, frames, monkeypatch, capsys):
+        def unavailable(*args):
+            raise OSError("no semaphores")
+        monkeypatch.setattr(frame_pool, '_map_pool', unavailable)
+
+        results = map_frames(_first_channel, frames, args=(1,), workers=4)
+
+        assert "[WARN]" in capsys.readouterr().out
+        assert all((indices == frame[..., 0] + 1).all()
+                   for frame, (indices, _) in zip(frames, results))
@@ -0,0 +1,265 @@
+"""
+Tests for ai_providers/cache.py - persistent generation cache.
+
+Tests:
+- Keys are stable under prompt whitespace and sensitive to config,
+  input images, provider and model
+- Cached results replay without calling the provider, at zero cost
+- Unseeded requests are never cached
+- Images are stored once in the blob store
+- Failed results are not cached
+- LRU eviction keeps the store under max_bytes
+- ProviderRegistry wraps providers only when a cache is set
+- AIAnalyzer answers repeated analyses from the cache
+"""
+
+import os
+import time
+import pytest
+from pathlib import Path
+from unittest.mock import MagicMock
+from PIL import Image
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.ai_providers import (
+    GenerationCache,
+    CachedProvider,
+    GenerationConfig,
+    GenerationProvider,
+    GenerationResult,
+    ProviderCapability,
+    ProviderRegistry,
+)
+from pipeline.ai_providers.cache import default_generation_cache
+
+
+def _image(color, size=(16, 16)):
+    return Image.new("RGBA", size, color)
+
+
+def _provider(name="Mock (model-a)", image=None, success=True):
+    provider = MagicMock(spec=GenerationProvider)
+    provider.name = name
+    provider.is_available = True
+    provider.capabilities = ProviderCapability.TEXT_TO_IMAGE
+    provider.generate.side_effect = lambda prompt, config=None: GenerationResult(
+        success=success,
+        image=image or _image((255, 0, 0, 255)) if success else None,
+        errors=[] if success else ["boom"],
+        provider="mock",
+        cost_usd=0.02,
+    )
+    return provider
+
+
+SEEDED = GenerationConfig(seed=1234)
+
+
+@pytest.fixture
+def cache(tmp_path):
+    return GenerationCache(tmp_path / "gen")
+
+
+class TestCacheKey:
+    """Tests for key canonicalisation."""
+
+    def test_prompt_whitespace_ignored(self):
+        a = GenerationCache.make_key("generate", "p", prompt="pixel  art\nknight ")
+        b = GenerationCache.make_key("generate", "p", prompt="pixel art knight")
+        assert a == b
+
+    def test_sensitive_to_request(self):
+        base = dict(operation="generate", provider="p", model="m", prompt="knight",
+                    config=GenerationConfig(width=32, height=32))
+        key = GenerationCache.make_key(**base)
+
+        variants = [
+            dict(base, prompt="wizard"),
+            dict(base, provider="q"),
+            dict(base, model="n"),
+            dict(base, config=GenerationConfig(width=32, height=32, seed=7)),
+            dict(base, config=GenerationConfig(width=32, height=32, palette=[0x000, 0xEEE])),
+            dict(base, images=[_image((0, 0, 0, 255))]),
+        ]
+        keys = {GenerationCache.make_key(**v) for v in variants}
+        assert key not in keys and len(keys) == len(variants)
+
+    def test_images_hashed_by_pixels(self):
+        a = GenerationCache.make_key("upscale", "p", images=[_image((1, 2, 3, 255))])
+        b = GenerationCache.make_key("upscale", "p", images=[_image((1, 2, 3, 255))])
+        c = GenerationCache.make_key("upscale", "p", images=[_image((1, 2, 4, 255))])
+        assert a == b != c
+
+    def test_style_reference_by_content(self, tmp_path):
+        ref = tmp_path / "ref.png"
+        _image((9, 9, 9, 255)).save(ref)
+        key = lambda: GenerationCache.make_key(
+            "generate", "p", config=GenerationConfig(style_reference=str(ref)))
+
+        before = key()
+        _image((8, 8, 8, 255)).save(ref)
+        assert key() != before
+
+
+class TestGenerationCache:
+    """Tests for storing and replaying results."""
+
+    def test_replay(self, cache):
+        provider = _provider()
+        cached = CachedProvider(provider, cache, "mock")
+
+        first = cached.generate("knight", GenerationConfig(width=16, height=16, seed=3))
+        second = cached.generate("knight ", GenerationConfig(width=16, height=16, seed=3))
+
+        assert provider.generate.call_count == 1
+        assert second.success
+        assert second.image.tobytes() == first.image.tobytes()
+        assert second.cost_usd == 0.0 and first.cost_usd == 0.02
+        assert any("Replayed" in w for w in second.warnings)
+        assert cache.stats() == {"hits": 1, "misses": 1, "evictions": 0}
+
+    def test_replay_across_instances(self, cache):
+        """A new process (new cache object) replays what an old one stored."""
+        CachedProvider(_provider(), cache, "mock").generate("knight", SEEDED)
+
+        provider = _provider()
+        result = CachedProvider(provider, GenerationCache(cache.cache_dir),
+                                "mock").generate("knight", SEEDED)
+        assert result.success and provider.generate.call_count == 0
+
+    def test_unseeded_not_cached(self, cache):
+        """seed=None asks for a new random image every call."""
+        provider = _provider()
+        cached = CachedProvider(provider, cache, "mock")
+
+        for config in (None, GenerationConfig(width=16, height=16), None):
+            assert cached.generate("knight", config).success
+        assert provider.generate.call_count == 3
+        assert cache.stats() == {"hits": 0, "misses": 0, "evictions": 0}
+        assert not list(cache.records_dir.glob("*/*.json"))
+
+    def test_frames_and_views(self, cache):
+        frames = [_image((i, 0, 0, 255)) for i in range(3)]
+        result = GenerationResult(success=True, frames=frames, frame_durations=[100] * 3,
+                                  views={"front": frames[0], "back": frames[1]})
+        cache.put("k" * 64, result)
+
+        replay = cache.get("k" * 64)
+        assert [f.tobytes() for f in replay.frames] == [f.tobytes() for f in frames]
+        assert replay.views["back"].tobytes() == frames[1].tobytes()
+        assert replay.frame_durations == [100] * 3
+
+    def test_blobs_deduplicated(self, cache):
+        shared = _image((5, 5, 5, 255))
+        cache.put("a" * 64, GenerationResult(success=True, frames=[shared, shared]))
+        cache.put("b" * 64, GenerationResult(success=True, image=shared))
+
+        assert len(list(cache.blobs_dir.glob("*/*.png"))) == 1
+
+    def test_failures_not_cached(self, cache):
+        provider = _provider(success=False)
+        cached = CachedProvider(provider, cache, "mock")
+
+        cached.generate("knight", SEEDED)
+        cached.generate("knight", SEEDED)
+        assert provider.generate.call_count == 2
+
+    def test_model_change_misses(self, cache):
+        """Switching checkpoint (reflected in the provider name) is a new key."""
+        provider = _provider()
+        cached = CachedProvider(provider, cache, "sd_local")
+        cached.generate("knight", SEEDED)
+        provider.name = "Mock (model-b)"
+        cached.generate("knight", SEEDED)
+        assert provider.generate.call_count == 2
+
+    def test_lru_eviction(self, tmp_path):
+        cache = GenerationCache(tmp_path / "gen", max_bytes=6000)
+        for i in range(12):
+            # Noisy images so each blob is a few hundred bytes
+            image = Image.frombytes("RGBA", (16, 16), os.urandom(16 * 16 * 4))
+            cache.put(f"{i:064x}", GenerationResult(success=True, image=image))
+            # Age records so use order is unambiguous
+            stamp = time.time() - 100 + i
+            os.utime(cache._record_path(f"{i:064x}"), (stamp, stamp))
+
+        assert cache.size() <= 6000
+        assert cache.evictions > 0
+        assert cache.get(f"{0:064x}") is None           # Oldest went first
+        assert cache.get(f"{11:064x}") is not None      # Newest stays
+        live = sum(1 for _ in cache.records_dir.glob("*/*.json"))
+        assert live >= 3                                # Only what was needed
+        assert len(list(cache.blobs_dir.glob("*/*.png"))) == live
+
+    def test_clear(self, cache):
+        cache.put("a" * 64, GenerationResult(success=True, image=_image((1, 1, 1, 255))))
+        assert cache.clear() == 1
+        assert cache.size() == 0 and cache.get("a" * 64) is None
+
+    def test_record_max_age(self, cache):
+        cache.put_record("r" * 64, {"result": {"sprites": [1]}})
+        assert cache.get_record("r" * 64)["result"] == {"sprites": [1]}
+        assert cache.get_record("r" * 64, max_age=-1) is None
+
+
+class TestRegistryCache:
+    """Tests for ProviderRegistry integration."""
+
+    def test_uncached_by_default(self):
+        registry = ProviderRegistry()
+        provider = _provider()
+        registry.register("mock", provider)
+        assert registry.get("mock") is provider
+
+    def test_cached_registry(self, cache):
+        registry = ProviderRegistry(cache=cache)
+        provider = _provider()
+        registry.register("mock", provider)
+        registry.set_fallback_order(["mock"])
+
+        wrapped = registry.get("MOCK")
+        assert isinstance(wrapped, CachedProvider) and wrapped.wrapped is provider
+        assert registry.get("mock") is wrapped
+        assert wrapped in registry.get_available()
+
+        for _ in range(3):
+            assert registry.generate_with_fallback("knight", SEEDED, preferred="mock").success
+        assert provider.generate.call_count == 1
+        registry.generate_with_fallback("knight", preferred="mock")
+        assert provider.generate.call_count == 2
+
+    def test_reregister_replaces_wrapper(self, cache):
+        registry = ProviderRegistry(cache=cache)
+        registry.register("mock", _provider())
+        old = registry.get("mock")
+        replacement = _provider()
+        registry.register("mock", replacement)
+        assert registry.get("mock").wrapped is replacement and registry.get("mock") is not old
+
+    def test_env_disables_default(self, monkeypatch, tmp_path):
+        monkeypatch.setenv("ARDK_GENERATION_CACHE", "off")
+        assert default_generation_cache() is None
+        monkeypatch.setenv("ARDK_GENERATION_CACHE", str(tmp_path / "c"))
+        assert default_generation_cache().cache_dir == tmp_path / "c"
+
+
+class TestAnalyzerCache:
+    """Tests for AIAnalyzer's use of the cache."""
+
+    def test_analyze_prompt_cached(self, tmp_path):
+        from pipeline.ai import AIAnalyzer
+
+        analyzer = AIAnalyzer(cache_dir=str(tmp_path / "ai"), offline_mode=True)
+        vision = MagicMock()
+        vision.name = "mock-vision"
+        vision.available = True
+        vision.analyze_prompt.return_value = {"answer": 42}
+        analyzer.providers = [vision]
+
+        img = _image((3, 3, 3, 255))
+        assert analyzer.analyze_prompt(img, "what is this?") == {"answer": 42}
+        assert analyzer.analyze_prompt(img, "what  is this?") == {"answer": 42}
+        assert analyzer.analyze_prompt(img, "something else") == {"answer": 42}
+        assert vision.analyze_prompt.call_count == 2
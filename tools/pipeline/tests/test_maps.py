@@ -0,0 +1,364 @@
+"""
+Tests for maps.py - Tiled map loading and SGDK export.
+
+Tests:
+- Tile data decoding (CSV, base64, zlib, gzip) into NumPy arrays
+- Flip flag splitting, including diagonal flips
+- TileLayer list compatibility and accessors
+- TMX and JSON parsing
+- Vectorized tilemap entries and collision match the per-tile reference
+- Chunked export: grid, deduplication, edge padding, per-chunk compression
+"""
+
+import base64
+import gzip
+import json
+import struct
+import zlib
+import numpy as np
+import pytest
+from pathlib import Path
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.maps import (
+    TileLayer, Tileset, TiledMap, TiledParser, SGDKMapExporter, CollisionExporter,
+    MapExportConfig, TileProperties, CollisionType, split_gids, decode_tile_data,
+    FLIPPED_HORIZONTALLY_FLAG, FLIPPED_VERTICALLY_FLAG, FLIPPED_DIAGONALLY_FLAG,
+)
+from pipeline.genesis_compression import CompressionFormat, GenesisCompressor
+
+
+H = FLIPPED_HORIZONTALLY_FLAG
+V = FLIPPED_VERTICALLY_FLAG
+D = FLIPPED_DIAGONALLY_FLAG
+
+RAW = [0, 1, 2 | H, 3 | V, 4 | H | V, 5 | D, 0 | H]
+
+
+def _encode(gids, compression=''):
+    raw = struct.pack(f'<{len(gids)}I', *gids)
+    if compression == 'zlib':
+        raw = zlib.compress(raw)
+    elif compression == 'gzip':
+        raw = gzip.compress(raw)
+    return base64.b64encode(raw).decode()
+
+
+def _tmx(data_elem, width=4, height=2):
+    return f'''<?xml version="1.0" encoding="UTF-8"?>
+<map version="1.10" orientation="orthogonal" width="{width}" height="{height}"
+     tilewidth="8" tileheight="8">
+ <tileset firstgid="1" name="ground" tilewidth="8" tileheight="8" tilecount="4" columns="4">
+  <image source="ground.png" width="32" height="8"/>
+ </tileset>
+ <layer id="1" name="main" width="{width}" height="{height}">
+  {data_elem}
+ </layer>
+</map>
+'''
+
+
+def _random_map(seed=0, width=64, height=32):
+    """Map with two tilesets, flips, empty cells and GIDs past every tileset."""
+    rng = np.random.default_rng(seed)
+    raw = rng.integers(0, 40, width * height).astype(np.uint32)
+    raw[rng.random(width * height) < 0.2] = 0
+    flags = np.array([0, H, V, H | V, D], dtype=np.uint32)
+    raw |= flags[rng.integers(0, len(flags), width * height)]
+
+    ground = Tileset(name="ground", first_gid=1, tile_width=8, tile_height=8,
+                     image_path="ground.png", tile_count=20)
+    ground.tile_properties[2] = TileProperties(local_id=2, collision=CollisionType.SOLID)
+    deco = Tileset(name="deco", first_gid=21, tile_width=8, tile_height=8,
+                   image_path="deco.png", tile_count=10)
+    layer = TileLayer.from_gids("main", width, height, raw)
+    return TiledMap(width=width, height=height, tile_width=8, tile_height=8,
+                    layers=[layer], tilesets=[ground, deco])
+
+
+class TestDecoding:
+    """Tests for decode_tile_data and split_gids."""
+
+    @pytest.mark.parametrize("compression", ['', 'zlib', 'gzip'])
+    def test_base64(self, compression):
+        """Base64 payloads decode to the original GIDs."""
+        decoded = decode_tile_data(_encode(RAW, compression), 'base64', compression)
+        assert decoded.dtype == np.uint32
+        assert decoded.tolist() == RAW
+
+    def test_csv(self):
+        """CSV with Tiled's line breaks decodes, including flag bits."""
+        text = "\n" + ",".join(map(str, RAW[:4])) + ",\n" + ",".join(map(str, RAW[4:])) + "\n"
+        assert decode_tile_data(text, 'csv').tolist() == RAW
+
+    def test_csv_malformed(self):
+        """Junk fields, negatives and overflow are rejected, not misread."""
+        for text in ("1,2,x,4", "1,-2", "1,4294967296", "1;2", "1.5,2"):
+            with pytest.raises(ValueError):
+                decode_tile_data(text, 'csv')
+
+    def test_expected_count(self):
+        """A payload with the wrong number of GIDs is rejected."""
+        text = ",".join(map(str, RAW))
+        assert len(decode_tile_data(text, 'csv', expected_count=len(RAW))) == len(RAW)
+        with pytest.raises(ValueError, match="expected"):
+            decode_tile_data(text + ",0", 'csv', expected_count=len(RAW))
+        with pytest.raises(ValueError, match="expected"):
+            decode_tile_data(_encode(RAW[:-1]), 'base64', expected_count=len(RAW))
+
+    def test_unsupported(self):
+        """Unknown encodings and compressions are rejected."""
+        with pytest.raises(ValueError):
+            decode_tile_data("", 'xml')
+        with pytest.raises(ValueError):
+            decode_tile_data(_encode(RAW), 'base64', 'zstd')
+
+    def test_split_gids(self):
+        """Flags are split out and GIDs are cleaned."""
+        gid, flip_h, flip_v, flip_d = split_gids(RAW)
+        assert gid.tolist() == [0, 1, 2, 3, 4, 5, 0]
+        assert flip_h.tolist() == [False, False, True, False, True, False, True]
+        assert flip_v.tolist() == [False, False, False, True, True, False, False]
+        assert flip_d.tolist() == [False, False, False, False, False, True, False]
+
+
+class TestTileLayer:
+    """Tests for TileLayer storage."""
+
+    def test_lists_converted(self):
+        """List data is stored as arrays; missing flags are padded."""
+        layer = TileLayer(name="bg", width=2, height=2, data=[1, 2, 3, 4], flip_h=[True])
+
+        assert layer.data.dtype == np.uint32
+        assert layer.flip_h.tolist() == [True, False, False, False]
+        assert layer.flip_v.tolist() == [False] * 4
+        assert layer.flip_d.tolist() == [False] * 4
+
+    def test_accessors(self):
+        """get_tile/get_flip return plain Python values and handle bounds."""
+        layer = TileLayer.from_gids("bg", 2, 2, [1, 2 | H, 3 | V, 0])
+
+        assert layer.get_tile(1, 0) == 2 and type(layer.get_tile(1, 0)) is int
+        assert layer.get_flip(1, 0) == (True, False)
+        assert layer.get_flip(0, 1) == (False, True)
+        assert layer.get_tile(5, 5) == 0
+        assert layer.get_flip(-1, 0) == (False, False)
+        assert layer.grid.tolist() == [[1, 2], [3, 0]]
+
+
+class TestParsing:
+    """Tests for TMX and JSON parsing."""
+
+    @pytest.mark.parametrize("compression", ['', 'zlib', 'gzip'])
+    def test_tmx_base64(self, temp_dir, compression):
+        """Compressed TMX layers load with flags split."""
+        attrs = 'encoding="base64"' + (f' compression="{compression}"' if compression else '')
+        path = Path(temp_dir) / "level.tmx"
+        path.write_text(_tmx(f'<data {attrs}>{_encode(RAW, compression)}</data>', 7, 1))
+
+        layer = TiledParser().load(str(path)).layers[0]
+        assert layer.data.tolist() == [0, 1, 2, 3, 4, 5, 0]
+        assert layer.flip_d.tolist()[5]
+
+    def test_tmx_short_payload(self, temp_dir):
+        """Encoded data that does not fill the layer is an error, not padding."""
+        path = Path(temp_dir) / "level.tmx"
+        path.write_text(_tmx(f'<data encoding="base64">{_encode(RAW)}</data>'))
+        with pytest.raises(ValueError, match="expected 8"):
+            TiledParser().load(str(path))
+
+    def test_tmx_csv_and_xml_tiles(self, temp_dir):
+        """CSV and per-tile XML data load identically."""
+        csv_path = Path(temp_dir) / "csv.tmx"
+        csv_path.write_text(_tmx(f'<data encoding="csv">{",".join(map(str, RAW))}</data>', 7, 1))
+        xml_path = Path(temp_dir) / "xml.tmx"
+        xml_path.write_text(_tmx('<data>' + ''.join(f'<tile gid="{g}"/>' for g in RAW) + '</data>',
+                                 7, 1))
+
+        a = TiledParser().load(str(csv_path)).layers[0]
+        b = TiledParser().load(str(xml_path)).layers[0]
+        assert a.data.tolist() == b.data.tolist()
+        assert a.flip_h.tolist() == b.flip_h.tolist()
+
+    def test_json_array_and_base64(self, temp_dir):
+        """JSON layers accept GID arrays and base64 strings."""
+        base = {"width": 7, "height": 1, "tilewidth": 8, "tileheight": 8, "tilesets": []}
+        as_array = dict(base, layers=[{"type": "tilelayer", "name": "a", "width": 7,
+                                       "height": 1, "data": RAW}])
+        as_b64 = dict(base, layers=[{"type": "tilelayer", "name": "a", "width": 7,
+                                     "height": 1, "encoding": "base64",
+                                     "compression": "zlib", "data": _encode(RAW, 'zlib')}])
+        (Path(temp_dir) / "a.tmj").write_text(json.dumps(as_array))
+        (Path(temp_dir) / "b.tmj").write_text(json.dumps(as_b64))
+
+        a = TiledParser().load(str(Path(temp_dir) / "a.tmj")).layers[0]
+        b = TiledParser().load(str(Path(temp_dir) / "b.tmj")).layers[0]
+        assert a.data.tolist() == b.data.tolist() == [0, 1, 2, 3, 4, 5, 0]
+        assert a.flip_v.tolist() == b.flip_v.tolist()
+
+
+class TestExport:
+    """Vectorized export matches the per-tile reference."""
+
+    def test_tilemap_entries(self):
+        """Every cell equals _build_tilemap_entry."""
+        tiled_map = _random_map()
+        layer = tiled_map.layers[0]
+        exporter = SGDKMapExporter()
+        config = MapExportConfig(output_dir="unused", palette_index=2, base_tile_index=100)
+
+        entries = exporter._build_tilemap_entries(layer, config, tiled_map)
+        expected = [
+            exporter._build_tilemap_entry(int(g), bool(h), bool(v), 2, 100, tiled_map)
+            for g, h, v in zip(layer.data, layer.flip_h, layer.flip_v)
+        ]
+        assert entries.dtype == np.uint16
+        assert entries.tolist() == expected
+
+    def test_binary_and_header(self, temp_dir):
+        """Binary and header files hold the reference entries."""
+        tiled_map = _random_map(width=8, height=3)
+        tiled_map.source_path = "world.tmx"
+        layer = tiled_map.layers[0]
+        exporter = SGDKMapExporter()
+        result = exporter.export_map(tiled_map, MapExportConfig(
+            output_dir=temp_dir, include_collision=False, include_objects=False))
+        assert result.success, result.errors
+
+        expected = [exporter._build_tilemap_entry(int(g), bool(h), bool(v), 0, 0, tiled_map)
+                    for g, h, v in zip(layer.data, layer.flip_h, layer.flip_v)]
+        assert Path(result.tilemap_bin).read_bytes() == struct.pack(f'<{len(expected)}H', *expected)
+
+        header = Path(result.map_header).read_text()
+        first_row = "    " + ", ".join(f"0x{e:04X}" for e in expected[:8]) + ","
+        assert first_row in header.splitlines()
+
+    def test_collision(self):
+        """Collision extraction matches the per-tile rules."""
+        tiled_map = _random_map(seed=3)
+        tiled_map.layers[0].name = "collision"
+        exporter = CollisionExporter()
+
+        collision = exporter.extract_tile_collision(tiled_map)
+        expected = [exporter._tile_collision_value(tiled_map, int(g))
+                    for g in tiled_map.layers[0].data]
+        assert collision == expected
+
+        props = exporter.extract_from_tileset_properties(tiled_map, "collision")
+        assert props.count(CollisionType.SOLID.value) == \
+            int(np.count_nonzero(tiled_map.layers[0].data == 3))
+
+    def test_diagonal_flip_warning(self):
+        """Rotated tiles are reported since the VDP cannot rotate."""
+        tiled_map = _random_map()
+        result = SGDKMapExporter().validate_map(tiled_map)
+        assert any("rotated tiles" in w for w in result.warnings)
+
+
+class TestChunkedExport:
+    """Tests for chunked streaming export."""
+
+    @staticmethod
+    def _level(width=40, height=20):
+        """Repeating 8x8 pattern, so most 8x8 chunks are duplicates."""
+        tiled_map = _random_map(width=8, height=8)
+        pattern = tiled_map.layers[0]
+        raw = np.tile(pattern.data.reshape(8, 8), (-(-height // 8), -(-width // 8)))
+        tiled_map.layers[0] = TileLayer.from_gids("main", width, height,
+                                                  raw[:height, :width].ravel())
+        tiled_map.width, tiled_map.height = width, height
+        tiled_map.source_path = "level.tmx"
+        return tiled_map
+
+    @staticmethod
+    def _export(tiled_map, temp_dir, **kwargs):
+        config = MapExportConfig(output_dir=temp_dir, include_collision=False,
+                                 include_objects=False, **kwargs)
+        result = SGDKMapExporter().export_map(tiled_map, config)
+        assert result.success, result.errors
+        return result, config
+
+    def _decode(self, chunked, index):
+        """Unpack one chunk from the layer's data file."""
+        chunk = chunked.chunks[index]
+        data = Path(chunked.data_path).read_bytes()[chunk.offset:chunk.offset + chunk.size]
+        raw = GenesisCompressor().decompress(data, chunk.format)
+        return np.frombuffer(raw, dtype='>u2')
+
+    def test_chunks_rebuild_layer(self, temp_dir):
+        """Decoding the chunk grid reproduces the tilemap, padded with zeros."""
+        tiled_map = self._level(width=20, height=12)
+        result, config = self._export(tiled_map, temp_dir, chunk_size=8)
+        chunked = result.chunked_layers[0]
+        assert (chunked.chunks_x, chunked.chunks_y) == (3, 2)
+
+        rebuilt = np.zeros((16, 24), dtype=np.uint16)
+        for cell, index in enumerate(chunked.chunk_map):
+            cy, cx = divmod(cell, chunked.chunks_x)
+            rebuilt[cy * 8:cy * 8 + 8, cx * 8:cx * 8 + 8] = self._decode(chunked, index).reshape(8, 8)
+
+        entries = SGDKMapExporter()._build_tilemap_entries(
+            tiled_map.layers[0], config, tiled_map).reshape(12, 20)
+        assert rebuilt[:12, :20].tolist() == entries.tolist()
+        assert not rebuilt[12:].any() and not rebuilt[:, 20:].any()
+
+    def test_duplicates_stored_once(self, temp_dir):
+        """Identical chunks share one table entry."""
+        result, _ = self._export(self._level(), temp_dir, chunk_size=8)
+        chunked = result.chunked_layers[0]
+
+        # 5x3 grid: full pattern chunks, right/bottom edges padded
+        assert len(chunked.chunk_map) == 15
+        assert len(chunked.chunks) < 15
+        assert sum(c.uses for c in chunked.chunks) == 15
+        assert chunked.stored_bytes < chunked.raw_bytes
+
+    def test_index_table(self, temp_dir):
+        """Chunks are word-aligned and the header lists every entry."""
+        result, _ = self._export(self._level(), temp_dir, chunk_size=8)
+        chunked = result.chunked_layers[0]
+        header = Path(result.map_header).read_text()
+
+        assert all(c.offset % 2 == 0 for c in chunked.chunks)
+        assert chunked.chunks[-1].offset + chunked.chunks[-1].size <= \
+            Path(chunked.data_path).stat().st_size
+        assert "#define LEVEL_MAIN_CHUNKS_X 5" in header
+        assert f"const MapChunk level_main_chunks[{len(chunked.chunks)}]" in header
+        for chunk in chunked.chunks:
+            assert f"{{ 0x{chunk.offset:06X}, {chunk.size}, MAP_CHUNK_{chunk.format.name}, 0 }}," in header
+
+    @pytest.mark.parametrize("fmt", ["rle", "kosinski", "none"])
+    def test_fixed_format(self, temp_dir, fmt):
+        """A fixed chunk format is used for every chunk and still round-trips."""
+        result, _ = self._export(self._level(), temp_dir, chunk_size=8, chunk_format=fmt)
+        chunked = result.chunked_layers[0]
+
+        assert {c.format for c in chunked.chunks} == {CompressionFormat(fmt)}
+        assert all(len(self._decode(chunked, i)) == 64 for i in range(len(chunked.chunks)))
+
+    def test_auto_never_grows(self, temp_dir):
+        """Auto keeps chunks raw when compression would not help."""
+        result, _ = self._export(_random_map(seed=5, width=16, height=16), temp_dir,
+                                 chunk_size=4)
+        for chunk in result.chunked_layers[0].chunks:
+            assert chunk.size <= chunk.raw_size
+            assert (chunk.format == CompressionFormat.NONE) == (chunk.size == chunk.raw_size)
+            assert chunk.cycles > 0
+
+    def test_oversized_chunk_rejected(self, temp_dir):
+        """Chunk sizes that do not fit MapChunk.size (u16) fail loudly."""
+        tiled_map = self._level()
+        result, config = self._export(tiled_map, temp_dir, chunk_size=8)
+        chunked = result.chunked_layers[0]
+        chunked.chunks[0].size = 0x10000
+        with pytest.raises(ValueError, match="u16"):
+            SGDKMapExporter()._chunk_header(tiled_map, "level", config, [chunked])
+
+    def test_res_entry(self, temp_dir):
+        """Chunk data is included uncompressed in the resource file."""
+        tiled_map = self._level()
+        _, config = self._export(tiled_map, temp_dir, chunk_size=8)
+        res = SGDKMapExporter()._generate_res_entry(tiled_map, "level", config)
+        assert 'BIN level_main_chunk_data "level_main_chunks.bin" NONE' in res
@@ -0,0 +1,164 @@
+"""
+Tests for quantization/palette_lookup.py - shared nearest-colour lookup.
+
+Tests:
+- PaletteLookup against a linear palette scan (integer and float colours)
+- Tie-breaking on duplicate palette entries
+- Memo reuse across calls and under concurrent readers
+- RGB cell candidate lists, in Python and in the dithering kernels
+- Shared cache
+"""
+
+import pytest
+import numpy as np
+from pathlib import Path
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.quantization.palette_lookup import (
+    PaletteLookup,
+    get_palette_lookup,
+    clear_palette_lookups,
+)
+from pipeline.quantization.perceptual import calculate_color_distance
+from pipeline.quantization.dither_numba import (
+    floyd_steinberg_numba,
+    ordered_dither_numba,
+    get_bayer_matrix,
+)
+
+
+# =============================================================================
+# Fixtures
+# =============================================================================
+
+@pytest.fixture
+def rng():
+    return np.random.default_rng(11)
+
+
+@pytest.fixture
+def palette(rng):
+    return [tuple(int(v) for v in c) for c in rng.integers(0, 256, size=(40, 3))]
+
+
+def _scan(rgb, palette, method):
+    """Reference linear scan (first minimum wins)."""
+    dists = [calculate_color_distance(tuple(float(v) for v in rgb), p, method) for p in palette]
+    return int(np.argmin(dists))
+
+
+# =============================================================================
+# Lookup Tests
+# =============================================================================
+
+class TestPaletteLookup:
+    """Lookups agree with a linear scan."""
+
+    @pytest.mark.parametrize("method", ['RGB', 'CIELab', 'CIEDE2000'])
+    def test_integer_colors_match_scan(self, rng, palette, method):
+        colors = rng.integers(0, 256, size=(300, 3), dtype=np.uint8)
+        lookup = PaletteLookup(palette, method)
+        expected = [_scan(c, palette, method) for c in colors]
+        assert lookup.nearest(colors).tolist() == expected
+
+    def test_float_colors_match_scan(self, rng, palette):
+        colors = rng.uniform(0, 255, size=(300, 3))
+        lookup = PaletteLookup(palette, 'RGB')
+        expected = [_scan(c, palette, 'RGB') for c in colors]
+        assert lookup.nearest(colors).tolist() == expected
+        assert [lookup.nearest_one(tuple(c)) for c in colors] == expected
+
+    def test_image_shape_preserved(self, rng, palette):
+        image = rng.integers(0, 256, size=(7, 5, 3), dtype=np.uint8)
+        assert PaletteLookup(palette).nearest(image).shape == (7, 5)
+
+    def test_duplicates_pick_lowest_index(self):
+        palette = [(0, 0, 0), (255, 255, 255), (0, 0, 0), (255, 255, 255)]
+        lookup = PaletteLookup(palette)
+        colors = np.array([[10, 10, 10], [250, 250, 250]], dtype=np.uint8)
+        assert lookup.nearest(colors).tolist() == [0, 1]
+        assert lookup.nearest(colors.astype(np.float32)).tolist() == [0, 1]
+
+    def test_distance_units(self, palette):
+        lookup = PaletteLookup(palette, 'RGB')
+        idx, dist = lookup.nearest_one_with_distance((12, 200, 90))
+        assert dist == pytest.approx(calculate_color_distance((12, 200, 90), palette[idx], 'RGB'))
+
+    def test_memo_reused_across_calls(self, rng, palette):
+        lookup = PaletteLookup(palette)
+        first = rng.integers(0, 256, size=(200, 3), dtype=np.uint8)
+        second = np.concatenate([first[:100], rng.integers(0, 256, size=(100, 3), dtype=np.uint8)])
+
+        expected = [_scan(c, palette, 'RGB') for c in second]
+        lookup.nearest(first)
+        assert lookup.nearest(second).tolist() == expected
+        assert len(lookup._memo[0]) == len(np.unique(np.concatenate([first, second]), axis=0))
+
+    def test_concurrent_readers(self, rng, palette):
+        """Threads sharing one lookup always get scan-exact answers."""
+        from concurrent.futures import ThreadPoolExecutor
+
+        lookup = PaletteLookup(palette)
+        batches = [rng.integers(0, 256, size=(300, 3), dtype=np.uint8) for _ in range(16)]
+        expected = [lookup._match(b.astype(np.float64))[0].tolist() for b in batches]
+        with ThreadPoolExecutor(max_workers=8) as pool:
+            results = list(pool.map(lambda b: lookup.nearest(b).tolist(), batches * 4))
+        assert results == expected * 4
+
+    def test_empty_palette(self):
+        with pytest.raises(ValueError):
+            get_palette_lookup([], 'RGB')
+
+
+# =============================================================================
+# Cell Candidate Tests
+# =============================================================================
+
+class TestRGBCells:
+    """Cell candidate lists never lose the nearest entry."""
+
+    def test_every_cell_has_candidates(self, palette):
+        offsets, candidates = PaletteLookup(palette).rgb_cells()
+        assert len(offsets) == 16 ** 3 + 1
+        assert (np.diff(offsets) > 0).all()
+        assert candidates.max() < len(palette)
+
+    def test_cell_boundaries(self, palette):
+        lookup = PaletteLookup(palette)
+        values = [0, 15, 15.999, 16, 127.5, 239.9, 240, 255]
+        for r in values:
+            for g in values:
+                for b in values:
+                    assert lookup.nearest_one((r, g, b)) == _scan((r, g, b), palette, 'RGB')
+
+    @pytest.mark.parametrize("count", [4, 64, 256])
+    def test_kernels_match_full_scan(self, rng, count):
+        palette = rng.integers(0, 256, size=(count, 3)).astype(np.float32)
+        pixels = rng.uniform(0, 255, size=(24, 40, 3)).astype(np.float32)
+        cells = PaletteLookup([tuple(c) for c in palette.astype(int)]).rgb_cells()
+
+        assert (floyd_steinberg_numba(pixels, palette, cells)
+                == floyd_steinberg_numba(pixels, palette)).all()
+        bayer = get_bayer_matrix(4)
+        assert (ordered_dither_numba(pixels, palette, bayer, 1.0, cells)
+                == ordered_dither_numba(pixels, palette, bayer, 1.0)).all()
+
+
+# =============================================================================
+# Cache Tests
+# =============================================================================
+
+class TestSharedCache:
+    """get_palette_lookup shares one lookup per palette and metric."""
+
+    def test_same_palette_shared(self, palette):
+        clear_palette_lookups()
+        assert get_palette_lookup(palette, 'RGB') is get_palette_lookup(list(palette), 'RGB')
+        assert get_palette_lookup(palette, 'RGB') is not get_palette_lookup(palette, 'CIELab')
+
+    def test_fallback_metrics_share_lookup(self, palette):
+        lookup = get_palette_lookup(palette, 'CAM02-UCS')
+        if lookup.metric == 'CIELab':
+            assert lookup is get_palette_lookup(palette, 'CIELab')
@@ -6,6 +6,7 @@ Tests perceptual color science functions including:
 - Color distance calculations
 - find_nearest_perceptual
 - extract_optimal_palette
+- PerceptualQuantizer.quantize_batch
 """
 
 import pytest
@@ -24,7 +25,9 @@ from pipeline.quantization.perceptual import (
     find_nearest_rgb,
     COLOUR_AVAILABLE,
     COLORSPACIOUS_AVAILABLE,
+    PerceptualQuantizer,
 )
+from pipeline.quantization import perceptual
 
 
 class TestRgbToLab:
@@ -209,3 +212,35 @@ class TestOptionalDependencies:
         # Should not raise, even if optional deps missing
         dist = calculate_color_distance(c1, c2, method='CIEDE2000')
         assert dist > 0
+
+
+class TestQuantizeBatch:
+    """Tests for PerceptualQuantizer.quantize_batch."""
+
+    @pytest.fixture
+    def images(self):
+        rng = np.random.default_rng(8)
+        return [Image.fromarray(rng.integers(0, 256, size=(h, w, 3), dtype=np.uint8))
+                for h, w in [(6, 10), (12, 3), (8, 8)]]
+
+    @pytest.mark.parametrize("dither", [False, True])
+    def test_serial_matches_quantize(self, images, genesis_palette, dither):
+        quantizer = PerceptualQuantizer(method='CIELab')
+        results = quantizer.quantize_batch(images, genesis_palette, dither=dither, workers=1)
+
+        for img, result in zip(images, results):
+            expected = quantizer.quantize(img, genesis_palette, dither=dither)
+            assert (result.color_map == expected.color_map).all()
+            assert result.error_sum == expected.error_sum
+            assert result.image.tobytes() == expected.image.tobytes()
+
+    def test_workers_match_quantize(self, images, genesis_palette, monkeypatch):
+        """Worker processes give the same results, in input order."""
+        quantizer = PerceptualQuantizer(method='CIEDE2000')
+        monkeypatch.setattr(perceptual, 'BATCH_PARALLEL_MIN_PIXELS', 0)
+        results = quantizer.quantize_batch(images, genesis_palette, workers=2)
+
+        for img, result in zip(images, results):
+            expected = quantizer.quantize(img, genesis_palette)
+            assert (result.color_map == expected.color_map).all()
+            assert result.error_sum == expected.error_sum
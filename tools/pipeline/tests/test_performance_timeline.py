@@ -0,0 +1,199 @@
+"""
+Tests for performance.py - sprite timeline analysis.
+
+Tests:
+- Per-line counts match analyze_sprite_layout frame by frame
+- Drop-outs follow VDP link order (sprite and pixel limits)
+- Raw SAT dumps: positions, sizes and link chains
+- Worst-frame ranking, pass/fail and the timeline heatmap
+"""
+
+import random
+import numpy as np
+import pytest
+from pathlib import Path
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.performance import (
+    PerformanceBudgetCalculator,
+    SpriteTimeline,
+    SeverityLevel,
+    analyze_sprite_timeline,
+)
+
+
+def _sat_frame(entries, sprites=80):
+    """SAT bytes for one frame: entries are (x, y, w, h, link)."""
+    words = np.zeros((sprites, 4), dtype='>u2')
+    for i, (x, y, w, h, link) in enumerate(entries):
+        size = ((w // 8 - 1) << 2) | (h // 8 - 1)
+        words[i] = (y + 128, (size << 8) | link, 0, x + 128)
+    return words.tobytes()
+
+
+def _row(count, y=100, w=8, h=8):
+    """count sprites side by side on the same lines."""
+    return [{'x': i * w, 'y': y, 'width': w, 'height': h} for i in range(count)]
+
+
+@pytest.fixture
+def calculator():
+    return PerformanceBudgetCalculator()
+
+
+class TestTimelineCounts:
+    """Tests for per-line sprite counts and coverage."""
+
+    def test_matches_single_layout(self, calculator):
+        rng = random.Random(3)
+        frames = [
+            [{'x': rng.randrange(-16, 320), 'y': rng.randrange(-32, 240),
+              'width': rng.choice([8, 16, 24, 32]), 'height': rng.choice([8, 16, 24, 32])}
+             for _ in range(rng.randrange(0, 81))]
+            for _ in range(40)
+        ]
+        report = calculator.analyze_timeline(frames)
+
+        for i, sprites in enumerate(frames):
+            single = calculator.analyze_sprite_layout(sprites)
+            expected = [single.sprites_per_scanline.get(line, 0) for line in range(224)]
+            assert report.sprite_counts[i].tolist() == expected
+        assert report.sprites_per_frame.tolist() == [len(f) for f in frames]
+
+    def test_pixel_coverage(self, calculator):
+        report = calculator.analyze_timeline([_row(3, y=10, w=32, h=16)])
+        assert report.pixel_counts[0, 10] == 96
+        assert report.pixel_counts[0, 25] == 96
+        assert report.pixel_counts[0, 26] == 0
+
+    def test_empty_frames(self, calculator):
+        report = calculator.analyze_timeline([[], _row(2)])
+        assert report.sprite_counts.shape == (2, 224)
+        assert report.passed
+
+
+class TestDropOuts:
+    """Tests for link-order drop-out resolution."""
+
+    def test_sprite_limit(self, calculator):
+        report = calculator.analyze_timeline([_row(22)])
+
+        assert report.dropped[0, 100] == 2
+        assert report.dropped[0, 99] == 0
+        # The last two in link order lose all 8 of their lines
+        assert np.flatnonzero(report.dropped_by_slot[0]).tolist() == [20, 21]
+        assert report.worst_frames[0].dropped_sprites == [20, 21]
+        assert not report.passed
+
+    def test_pixel_limit(self, calculator):
+        """Eleven 32px sprites fill 320px after ten: the eleventh vanishes."""
+        report = calculator.analyze_timeline([_row(11, w=32)])
+        assert report.sprite_counts[0, 100] == 11
+        assert report.dropped[0, 100] == 1
+        assert report.worst_frames[0].dropped_sprites == [10]
+
+    def test_link_order_decides(self, calculator):
+        """Reordering the link chain changes which SAT entry is dropped."""
+        entries = [(i * 8, 50, 8, 8, i + 1) for i in range(21)]
+        entries[-1] = (160, 50, 8, 8, 0)
+        in_order = SpriteTimeline.from_sat(_sat_frame(entries))
+
+        # Chain 0 -> 20 -> 1 -> 2 ... -> 19: entry 19 is now last
+        relinked = [list(e) for e in entries]
+        relinked[0][4] = 20
+        relinked[20][4] = 1
+        relinked[19][4] = 0
+        reordered = SpriteTimeline.from_sat(_sat_frame([tuple(e) for e in relinked]))
+
+        assert calculator.analyze_timeline(in_order).worst_frames[0].dropped_sprites == [20]
+        assert calculator.analyze_timeline(reordered).worst_frames[0].dropped_sprites == [19]
+
+    def test_chunking(self, calculator):
+        """Results do not depend on how many frames are processed at once."""
+        frames = [_row(20 + i % 5, y=i % 200) for i in range(30)]
+        whole = calculator.analyze_timeline(frames)
+
+        calculator.TIMELINE_CHUNK_CELLS = 1
+        chunked = calculator.analyze_timeline(frames)
+        assert np.array_equal(whole.dropped, chunked.dropped)
+        assert np.array_equal(whole.dropped_by_slot, chunked.dropped_by_slot)
+
+
+class TestSpriteTimeline:
+    """Tests for capture loading."""
+
+    def test_sat_fields(self):
+        data = _sat_frame([(10, 20, 16, 32, 1), (-8, 200, 32, 8, 0)])
+        timeline = SpriteTimeline.from_sat(data)
+
+        assert timeline.frame_count == 1
+        assert timeline.visible[0].tolist() == [True, True] + [False] * 78
+        assert (timeline.x[0, 0], timeline.y[0, 0]) == (10, 20)
+        assert (timeline.width[0, 0], timeline.height[0, 0]) == (16, 32)
+        assert (timeline.x[0, 1], timeline.width[0, 1], timeline.height[0, 1]) == (-8, 32, 8)
+
+    def test_multiple_frames(self):
+        data = _sat_frame([(0, 0, 8, 8, 0)]) + _sat_frame([(0, 0, 8, 8, 2), (0, 0, 8, 8, 0),
+                                                          (0, 0, 8, 8, 1)])
+        timeline = SpriteTimeline.from_sat(data)
+        assert timeline.visible.sum(axis=1).tolist() == [1, 3]
+        assert timeline.sat_index[1, :3].tolist() == [0, 2, 1]
+
+    def test_bad_length(self):
+        with pytest.raises(ValueError, match="multiple of 640"):
+            SpriteTimeline.from_sat(b"\0" * 100)
+
+    def test_npz_round_trip(self, tmp_path, calculator):
+        timeline = SpriteTimeline.from_frames([_row(21), _row(3)])
+        path = tmp_path / "capture.npz"
+        np.savez(path, x=timeline.x, y=timeline.y, width=timeline.width,
+                 height=timeline.height, visible=timeline.visible)
+
+        loaded = SpriteTimeline.from_file(path)
+        assert np.array_equal(
+            calculator.analyze_timeline(loaded).dropped,
+            calculator.analyze_timeline(timeline).dropped,
+        )
+
+
+class TestTimelineReport:
+    """Tests for ranking, warnings and the heatmap."""
+
+    def test_worst_frames_ranked(self, calculator):
+        frames = [_row(5), _row(23), _row(19), _row(21)]
+        report = calculator.analyze_timeline(frames, worst=3)
+
+        assert [f.frame for f in report.worst_frames] == [1, 3, 2]
+        assert report.worst_frames[0].peak_sprites == 23
+        assert report.frames_with_drops == 2
+        assert "Frame 1" in report.summary()
+
+    def test_too_many_sprites(self, calculator):
+        frames = [[{'x': 0, 'y': i * 2, 'width': 8, 'height': 8} for i in range(81)]]
+        report = analyze_sprite_timeline(frames)
+        assert any(w.severity == SeverityLevel.CRITICAL for w in report.warnings)
+        assert not report.passed
+
+    def test_heatmap(self, calculator):
+        report = calculator.analyze_timeline([_row(5), _row(11, w=32), _row(22)])
+        img = calculator.generate_timeline_heatmap(report, scale=1)
+
+        assert img.size == (3, 224)
+        assert img.getpixel((0, 0)) == (32, 32, 32)
+        assert img.getpixel((0, 100))[1] > 0 and img.getpixel((0, 100))[0] == 0  # Green
+        assert img.getpixel((1, 100)) == (255, 0, 255)    # Pixel-limit drop
+        assert img.getpixel((2, 100)) == (255, 0, 255)
+
+    def test_heatmap_bins_long_captures(self, calculator):
+        frames = [_row(2)] * 99 + [_row(22)]
+        report = calculator.analyze_timeline(frames)
+        img = calculator.generate_timeline_heatmap(report, max_width=10, scale=1)
+
+        assert img.size == (10, 224)
+        assert img.getpixel((9, 100)) == (255, 0, 255)    # Worst value survives binning
+
+    def test_layout_heatmap_unchanged(self, calculator):
+        img = calculator.generate_heatmap(_row(12), scale=1)
+        assert img.getpixel((300, 101)) == (int(200 + 0.4 * 55), int(200 - 0.4 * 50), 0)
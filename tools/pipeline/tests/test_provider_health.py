@@ -0,0 +1,201 @@
+"""
+Tests for ai_providers/health.py - provider health monitoring.
+
+Tests:
+- Routing reads the health table: one probe per provider per TTL,
+  however many lookups
+- Stale entries are re-probed; the background thread keeps them fresh
+- Repeated generation failures mark a provider unhealthy until a probe
+  succeeds again
+- Probe errors and StableDiffusion re-probing
+"""
+
+import time
+import pytest
+from pathlib import Path
+from PIL import Image
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.ai_providers import (
+    GenerationProvider,
+    GenerationResult,
+    HealthMonitor,
+    ProviderCapability,
+    ProviderRegistry,
+    StableDiffusionLocalProvider,
+)
+
+
+class ProbedProvider(GenerationProvider):
+    """Local provider that counts availability checks."""
+
+    def __init__(self, label, up=True, works=True):
+        self.label = label
+        self.up = up
+        self.works = works
+        self.availability_checks = 0
+        self.probes = 0
+
+    @property
+    def name(self):
+        return f"Probed ({self.label})"
+
+    @property
+    def capabilities(self):
+        return ProviderCapability.TEXT_TO_IMAGE
+
+    @property
+    def is_available(self):
+        self.availability_checks += 1
+        return self.up
+
+    def probe(self):
+        self.probes += 1
+        return self.up, "up" if self.up else "down"
+
+    def generate(self, prompt, config=None):
+        if not self.works:
+            return GenerationResult(success=False, errors=["HTTP 500"], provider=self.label)
+        return GenerationResult(success=True, image=Image.new("RGB", (8, 8)), provider=self.label)
+
+
+def _registry(*providers, monitor=None, background=False):
+    registry = ProviderRegistry()
+    registry._initialized = True  # Built-in providers would probe real services
+    for provider in providers:
+        registry.register(provider.label, provider)
+    registry.set_fallback_order([p.label for p in providers])
+    if monitor is not None:
+        registry.enable_health_monitor(monitor, background=background)
+    return registry
+
+
+class TestHealthTable:
+    """Tests for routing from the health table."""
+
+    def test_without_monitor_checks_every_time(self):
+        provider = ProbedProvider("a")
+        registry = _registry(provider)
+        for _ in range(50):
+            registry.get_best_provider()
+        assert provider.availability_checks >= 50
+
+    def test_one_probe_per_ttl(self):
+        a, b = ProbedProvider("a"), ProbedProvider("b", up=False)
+        registry = _registry(a, b, monitor=HealthMonitor(ttl=60))
+
+        for _ in range(1000):
+            assert registry.get_best_provider() is a
+            assert registry.get_available_names() == ["a"]
+
+        assert a.probes == 1 and b.probes == 1
+        assert a.availability_checks == 0 and b.availability_checks == 0
+
+    def test_stale_entries_reprobed(self):
+        provider = ProbedProvider("a")
+        monitor = HealthMonitor(ttl=0.05)
+        registry = _registry(provider, monitor=monitor)
+
+        registry.get_available()
+        provider.up = False
+        assert registry.get_available_names() == ["a"]   # Still fresh
+        time.sleep(0.1)
+        assert registry.get_available_names() == []      # Re-probed
+        assert provider.probes == 2
+
+    def test_background_refresh(self):
+        provider = ProbedProvider("a")
+        monitor = HealthMonitor(interval=0.05, ttl=60)
+        registry = _registry(provider, monitor=monitor, background=True)
+        try:
+            assert monitor.running
+            assert provider.probes == 1          # Warmed on start
+            provider.up = False
+            time.sleep(0.3)
+            assert registry.get_available_names() == []
+            assert provider.probes >= 3
+        finally:
+            registry.enable_health_monitor(None)
+        assert not monitor.running
+
+    def test_status_includes_health(self):
+        provider = ProbedProvider("a")
+        registry = _registry(provider, monitor=HealthMonitor())
+        status = registry.status()["a"]
+        assert status["available"] is True
+        assert status["health"]["healthy"] is True
+        assert status["health"]["probe_latency_ms"] >= 0
+
+
+class TestFailureTracking:
+    """Tests for marking providers unhealthy."""
+
+    def test_repeated_failures_mark_unhealthy(self):
+        flaky = ProbedProvider("flaky", works=False)
+        backup = ProbedProvider("backup")
+        monitor = HealthMonitor(ttl=60, failure_threshold=3)
+        registry = _registry(flaky, backup, monitor=monitor)
+
+        for _ in range(3):
+            assert registry.generate_with_fallback("knight").provider == "backup"
+        assert monitor.get("flaky").healthy is False
+        assert "consecutive failures" in monitor.get("flaky").message
+
+        # No longer tried at all
+        assert registry.get_best_provider().name == backup.name
+        assert registry.get_available_names() == ["backup"]
+
+    def test_probe_success_restores(self):
+        flaky = ProbedProvider("flaky", works=False)
+        monitor = HealthMonitor(ttl=60, failure_threshold=2)
+        registry = _registry(flaky, monitor=monitor)
+
+        registry.generate_with_fallback("knight")
+        registry.generate_with_fallback("knight")
+        assert registry.get_available_names() == []
+
+        flaky.works = True
+        monitor.report("flaky", True)                    # Calls alone do not restore
+        assert registry.get_available_names() == []
+
+        monitor.probe_all({"flaky": flaky})
+        assert registry.get_available_names() == ["flaky"]
+        assert registry.generate_with_fallback("knight").success
+
+    def test_intermittent_failures_tolerated(self):
+        provider = ProbedProvider("a")
+        monitor = HealthMonitor(failure_threshold=3)
+        monitor.probe("a", provider)
+        for success in (False, False, True, False, False, True):
+            monitor.report("a", success)
+        assert monitor.get("a").healthy
+
+    def test_probe_exception_is_unhealthy(self):
+        class Broken(ProbedProvider):
+            def probe(self):
+                raise RuntimeError("no route to host")
+
+        monitor = HealthMonitor()
+        entry = monitor.probe("broken", Broken("broken"))
+        assert not entry.healthy and "no route" in entry.message
+
+
+class TestProviderProbes:
+    """Tests for GenerationProvider.probe implementations."""
+
+    def test_default_probe_uses_is_available(self):
+        provider = ProbedProvider("a", up=False)
+        ok, message = GenerationProvider.probe(provider)
+        assert not ok and "unavailable" in message
+
+    def test_sd_probe_rechecks(self, monkeypatch):
+        sd = StableDiffusionLocalProvider(api_url="http://127.0.0.1:9")
+        state = {"up": False}
+        monkeypatch.setattr(sd, "_check_availability", lambda: state["up"])
+
+        assert sd.probe()[0] is False
+        state["up"] = True
+        assert sd.probe()[0] is True
+        assert sd.is_available is True
@@ -0,0 +1,253 @@
+"""
+Tests for hedged requests in ProviderRegistry.generate_with_fallback.
+
+Tests:
+- LatencyHistogram percentiles and decay
+- HedgePolicy delays: default until enough samples, then adaptive
+- A slow preferred provider is raced by the next one; first success wins
+- Fast answers and failures do not wait for the hedge delay
+- BudgetTracker limits stop hedges; successful calls are charged
+- Serial mode (no hedge) is unchanged
+"""
+
+import threading
+import time
+import pytest
+from pathlib import Path
+from PIL import Image
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.ai_providers import (
+    GenerationConfig,
+    GenerationProvider,
+    GenerationResult,
+    HedgePolicy,
+    LatencyHistogram,
+    ProviderCapability,
+    ProviderRegistry,
+)
+from pipeline.core.safeguards import BudgetTracker
+
+
+class StubProvider(GenerationProvider):
+    """Local provider that answers after a fixed delay."""
+
+    def __init__(self, label, delay=0.0, success=True, cost=0.0):
+        self.label = label
+        self.delay = delay
+        self.success = success
+        self.cost = cost
+        self.calls = 0
+        self.finished = threading.Event()
+
+    @property
+    def name(self):
+        return f"Stub ({self.label})"
+
+    @property
+    def capabilities(self):
+        return ProviderCapability.TEXT_TO_IMAGE
+
+    @property
+    def is_available(self):
+        return True
+
+    def generate(self, prompt, config=None):
+        self.calls += 1
+        time.sleep(self.delay)
+        self.finished.set()
+        if not self.success:
+            return GenerationResult(success=False, errors=["stub failure"], provider=self.label)
+        return GenerationResult(success=True, image=Image.new("RGB", (8, 8)),
+                                provider=self.label, cost_usd=self.cost)
+
+    def estimate_cost(self, config):
+        return self.cost
+
+
+def _registry(*providers):
+    registry = ProviderRegistry()
+    for provider in providers:
+        registry.register(provider.label, provider)
+    registry.set_fallback_order([p.label for p in providers])
+    return registry
+
+
+FAST_HEDGE = HedgePolicy(default_delay=0.1, min_delay=0.01)
+
+
+class TestLatencyHistogram:
+    """Tests for the latency histogram."""
+
+    def test_percentiles(self):
+        histogram = LatencyHistogram()
+        for ms in range(1, 101):
+            histogram.record(ms / 100)   # 0.01 .. 1.0 s
+
+        assert histogram.count == 100
+        assert histogram.percentile(0.5) == pytest.approx(0.5, rel=0.25)
+        assert histogram.percentile(0.9) == pytest.approx(0.9, rel=0.25)
+        assert histogram.percentile(1.0) >= 1.0
+
+    def test_empty(self):
+        assert LatencyHistogram().percentile(0.9) is None
+
+    def test_decay_follows_recent(self):
+        """After a provider speeds up, old slow samples fade out."""
+        histogram = LatencyHistogram(max_samples=100)
+        for _ in range(100):
+            histogram.record(5.0)
+        for _ in range(400):
+            histogram.record(0.2)
+        assert histogram.percentile(0.9) < 0.3
+
+
+class TestHedgePolicy:
+    """Tests for hedge delay selection."""
+
+    def test_default_until_samples(self):
+        policy = HedgePolicy(default_delay=7.0, min_samples=5)
+        histogram = LatencyHistogram()
+        for _ in range(4):
+            histogram.record(0.5)
+        assert policy.delay_for(None) == 7.0
+        assert policy.delay_for(histogram) == 7.0
+
+        histogram.record(0.5)
+        assert policy.delay_for(histogram) == pytest.approx(0.5, rel=0.25)
+
+    def test_clamped(self):
+        policy = HedgePolicy(min_delay=1.0, max_delay=2.0, min_samples=1)
+        fast, slow = LatencyHistogram(), LatencyHistogram()
+        fast.record(0.01)
+        slow.record(60.0)
+        assert policy.delay_for(fast) == 1.0
+        assert policy.delay_for(slow) == 2.0
+
+
+class TestHedgedFallback:
+    """Tests for racing providers."""
+
+    def test_slow_provider_is_hedged(self):
+        slow = StubProvider("slow", delay=1.0)
+        fast = StubProvider("fast", delay=0.05)
+        registry = _registry(slow, fast)
+
+        start = time.perf_counter()
+        result = registry.generate_with_fallback("knight", hedge=FAST_HEDGE)
+        elapsed = time.perf_counter() - start
+
+        assert result.success and result.provider == "fast"
+        assert elapsed < 0.5
+        assert slow.calls == 1 and fast.calls == 1
+
+    def test_fast_answer_not_hedged(self):
+        quick = StubProvider("quick", delay=0.01)
+        backup = StubProvider("backup")
+        registry = _registry(quick, backup)
+
+        result = registry.generate_with_fallback("knight", hedge=HedgePolicy(default_delay=1.0))
+        assert result.provider == "quick"
+        assert backup.calls == 0
+
+    def test_failure_falls_back_immediately(self):
+        broken = StubProvider("broken", delay=0.01, success=False)
+        backup = StubProvider("backup")
+        registry = _registry(broken, backup)
+
+        start = time.perf_counter()
+        result = registry.generate_with_fallback("knight", hedge=HedgePolicy(default_delay=5.0))
+        assert result.provider == "backup"
+        assert time.perf_counter() - start < 1.0
+
+    def test_all_fail(self):
+        registry = _registry(StubProvider("a", success=False), StubProvider("b", success=False))
+        result = registry.generate_with_fallback("knight", hedge=FAST_HEDGE)
+        assert not result.success
+        assert len(result.errors) == 2
+
+    def test_not_started_providers_cancelled(self):
+        """With max_parallel=2, a third provider is never started once one wins."""
+        slow = StubProvider("slow", delay=0.5)
+        medium = StubProvider("medium", delay=0.1)
+        third = StubProvider("third")
+        registry = _registry(slow, medium, third)
+
+        policy = HedgePolicy(default_delay=0.05, min_delay=0.01, max_parallel=2)
+        result = registry.generate_with_fallback("knight", hedge=policy)
+        time.sleep(0.1)
+        assert result.provider == "medium"
+        assert third.calls == 0
+
+    def test_hedge_delay_adapts(self):
+        """Latency learned from earlier calls sets the hedge delay."""
+        slow = StubProvider("slow", delay=0.02)
+        backup = StubProvider("backup")
+        registry = _registry(slow, backup)
+        for _ in range(5):
+            registry.generate_with_fallback("knight")
+        assert registry.latency("slow").count == 5
+
+        # Usually 20 ms; now it stalls, and the hedge fires long before the default
+        slow.delay = 1.0
+        policy = HedgePolicy(default_delay=30.0, min_delay=0.01)
+        start = time.perf_counter()
+        result = registry.generate_with_fallback("knight", hedge=policy)
+        assert result.provider == "backup"
+        assert time.perf_counter() - start < 0.5
+        assert "latency" in registry.status()["slow"]
+
+    def test_serial_mode_waits(self):
+        slow = StubProvider("slow", delay=0.3)
+        fast = StubProvider("fast")
+        registry = _registry(slow, fast)
+
+        result = registry.generate_with_fallback("knight")
+        assert result.provider == "slow"
+        assert fast.calls == 0
+
+
+class TestHedgeBudget:
+    """Tests for BudgetTracker integration."""
+
+    def test_hedge_respects_cost_limit(self):
+        """No hedge when the budget cannot cover both requests."""
+        budget = BudgetTracker(max_generations=10, max_cost=0.05, persist=False)
+        slow = StubProvider("slow", delay=0.3, cost=0.03)
+        backup = StubProvider("backup", cost=0.03)
+        registry = _registry(slow, backup)
+
+        result = registry.generate_with_fallback("knight", hedge=FAST_HEDGE, budget=budget)
+
+        assert result.provider == "slow"
+        assert backup.calls == 0
+        assert budget.state.cost_used == pytest.approx(0.03)
+
+    def test_losers_still_charged(self):
+        """A raced request that also succeeds was billed, so it is recorded."""
+        budget = BudgetTracker(max_generations=10, max_cost=1.0, persist=False)
+        slow = StubProvider("slow", delay=0.3, cost=0.02)
+        fast = StubProvider("fast", cost=0.01)
+        registry = _registry(slow, fast)
+
+        result = registry.generate_with_fallback("knight", hedge=FAST_HEDGE, budget=budget)
+        assert result.provider == "fast"
+
+        assert slow.finished.wait(2.0)
+        time.sleep(0.05)
+        assert budget.state.generations_used == 2
+        assert budget.state.cost_used == pytest.approx(0.03)
+
+    def test_exhausted_budget(self):
+        budget = BudgetTracker(max_generations=1, max_cost=1.0, persist=False)
+        budget.record_generation(0.0)
+        provider = StubProvider("only")
+        registry = _registry(provider)
+
+        for hedge in (None, FAST_HEDGE):
+            result = registry.generate_with_fallback("knight", hedge=hedge, budget=budget)
+            assert not result.success
+            assert "budget" in result.errors[0]
+        assert provider.calls == 0
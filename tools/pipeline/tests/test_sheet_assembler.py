@@ -0,0 +1,165 @@
+"""
+Tests for sheet_assembler.py - sprite sheet packing.
+
+Tests:
+- MaxRectsBin keeps maximal, non-redundant free rectangles
+- Every heuristic places frames without overlap and inside the bin
+- Contact-point placement hugs edges and placed frames
+- MAXRECTS assembly with padding, pages and BEST heuristic selection
+"""
+
+import random
+import pytest
+from pathlib import Path
+from PIL import Image
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.sheet_assembler import (
+    SpriteSheetAssembler, PackingAlgorithm, MaxRectsHeuristic, MaxRectsBin,
+)
+
+
+HEURISTICS = [h for h in MaxRectsHeuristic if h != MaxRectsHeuristic.BEST]
+
+
+def _overlaps(a, b):
+    ax, ay, aw, ah = a
+    bx, by, bw, bh = b
+    return ax < bx + bw and bx < ax + aw and ay < by + bh and by < ay + ah
+
+
+def _contains(outer, inner):
+    return (inner[0] >= outer[0] and inner[1] >= outer[1] and
+            inner[0] + inner[2] <= outer[0] + outer[2] and
+            inner[1] + inner[3] <= outer[1] + outer[3])
+
+
+def _sizes(count, seed=0):
+    rng = random.Random(seed)
+    return [(rng.choice([8, 16, 24, 32, 48]), rng.choice([8, 16, 24, 32]))
+            for _ in range(count)]
+
+
+def _assembler(sizes, **kwargs):
+    kwargs.setdefault("algorithm", PackingAlgorithm.MAXRECTS)
+    assembler = SpriteSheetAssembler(**kwargs)
+    for i, size in enumerate(sizes):
+        # Distinct colour per frame so pasted pixels can be traced back
+        assembler.add_frame(Image.new("RGBA", size, (i % 256, i // 256, 1, 255)), f"f{i}")
+    return assembler
+
+
+class TestMaxRectsBin:
+    """Tests for the free-rectangle bookkeeping."""
+
+    def test_split_keeps_maximal_rects(self):
+        """A rectangle in the middle leaves four overlapping maximal strips."""
+        bin = MaxRectsBin(100, 100)
+        bin.place(40, 40, 20, 20)
+
+        assert sorted(bin.free_rects) == sorted([
+            (0, 0, 40, 100), (60, 0, 40, 100), (0, 0, 100, 40), (0, 60, 100, 40),
+        ])
+
+    @pytest.mark.parametrize("heuristic", HEURISTICS)
+    def test_invariants(self, heuristic):
+        """Placements never overlap; free rects are disjoint from them and maximal."""
+        bin = MaxRectsBin(128, 128, heuristic)
+        placed = []
+        for w, h in _sizes(80, seed=1):
+            pos = bin.insert(w, h)
+            if pos is not None:
+                rect = (*pos, w, h)
+                assert rect[0] + w <= 128 and rect[1] + h <= 128
+                assert not any(_overlaps(rect, other) for other in placed)
+                placed.append(rect)
+
+        free = bin.free_rects
+        assert not any(_overlaps(f, p) for f in free for p in placed)
+        assert not any(i != j and _contains(b, a)
+                       for i, a in enumerate(free) for j, b in enumerate(free))
+        assert bin.used_area == sum(w * h for _, _, w, h in placed)
+
+    def test_fills_exactly(self):
+        """Equal tiles fill the bin completely."""
+        bin = MaxRectsBin(64, 64)
+        assert all(bin.insert(16, 16) is not None for _ in range(16))
+        assert bin.occupancy == 1.0
+        assert bin.insert(1, 1) is None
+
+    def test_contact_point_hugs_neighbours(self):
+        """Contact point picks the spot touching the most placed edges."""
+        bin = MaxRectsBin(100, 100, MaxRectsHeuristic.CONTACT_POINT)
+        bin.place(0, 0, 40, 40)
+        bin.place(60, 0, 40, 40)
+
+        # The gap touches both frames and the top border (60) versus 40 at (0, 40)
+        assert bin.insert(20, 20) == (40, 0)
+
+    def test_best_rejected(self):
+        """A single bin needs a concrete heuristic."""
+        with pytest.raises(ValueError):
+            MaxRectsBin(8, 8, MaxRectsHeuristic.BEST)
+
+
+class TestMaxRectsAssembly:
+    """Tests for SpriteSheetAssembler with MAXRECTS."""
+
+    @pytest.mark.parametrize("heuristic", list(MaxRectsHeuristic))
+    def test_padding_and_pixels(self, heuristic):
+        """Frames keep their padding and land at their placements."""
+        sizes = _sizes(40, seed=2)
+        sheet, layout = _assembler(sizes, padding=2, heuristic=heuristic).assemble()
+
+        rects = [(f.x, f.y, f.width, f.height) for f in layout.frames]
+        grown = [(x - 2, y - 2, w + 2, h + 2) for x, y, w, h in rects]
+        assert not any(_overlaps(a, b) for i, a in enumerate(grown) for b in grown[i + 1:])
+        assert all(x >= 2 and y >= 2 for x, y, _, _ in rects)
+
+        for i, frame in enumerate(layout.frames):
+            assert frame.name == f"f{i}"
+            assert sheet.getpixel((frame.x, frame.y))[:2] == (i % 256, i // 256)
+
+    def test_overflow_needs_pages(self):
+        """assemble() refuses to overflow and points at assemble_pages()."""
+        with pytest.raises(ValueError, match="assemble_pages"):
+            _assembler([(32, 32)] * 20, max_width=64, max_height=64).assemble()
+
+    def test_pages(self):
+        """assemble_pages() spreads frames over full pages, each frame once."""
+        sizes = [(32, 32)] * 20
+        pages = _assembler(sizes, max_width=64, max_height=64).assemble_pages()
+
+        assert len(pages) == 5
+        names = sorted(f.name for _, layout in pages for f in layout.frames)
+        assert names == sorted(f"f{i}" for i in range(20))
+        for sheet, layout in pages:
+            assert sheet.size == (64, 64)
+            for frame in layout.frames:
+                index = int(frame.name[1:])
+                assert sheet.getpixel((frame.x + 31, frame.y + 31))[0] == index
+
+    def test_oversized_frame(self):
+        """A frame larger than a page is reported by name."""
+        with pytest.raises(ValueError, match="f1"):
+            _assembler([(8, 8), (300, 8)]).assemble_pages()
+
+    def test_best_is_densest(self):
+        """BEST is never larger than any single heuristic."""
+        sizes = _sizes(120, seed=4)
+        areas = {}
+        for heuristic in MaxRectsHeuristic:
+            pages = _assembler(sizes, max_width=128, max_height=128, power_of_2=False,
+                               heuristic=heuristic).assemble_pages()
+            areas[heuristic] = (len(pages), sum(l.width * l.height for _, l in pages))
+
+        assert areas[MaxRectsHeuristic.BEST] == min(areas.values())
+
+    def test_many_frames(self):
+        """Thousands of frames pack densely across pages."""
+        sizes = _sizes(2000, seed=5)
+        pages = _assembler(sizes, max_width=512, max_height=512).assemble_pages()
+        used = sum(w * h for w, h in sizes)
+        assert used / (len(pages) * 512 * 512) > 0.75
@@ -0,0 +1,156 @@
+"""
+Tests for optimization/tile_dedup.py - shared tile dedup core.
+
+Tests:
+- Byte-layout flips against pixel-level flips for every packed format
+- dedup_tiles against a raster-order search for every flip setting
+- Hash collision fallback
+"""
+
+import pytest
+import numpy as np
+from pathlib import Path
+
+import sys
+sys.path.insert(0, str(Path(__file__).parent.parent.parent))
+
+from pipeline.optimization import FORMAT_LAYOUTS, TileLayout, TileTransform, dedup_tiles
+from pipeline.optimization import tile_dedup
+
+
+# =============================================================================
+# Reference Encoders (8x8 indexed pixels -> packed bytes)
+# =============================================================================
+
+def _encode_genesis(pixels):
+    return bytes((int(row[c]) << 4) | int(row[c + 1]) for row in pixels for c in range(0, 8, 2))
+
+
+def _plane_byte(row, plane):
+    return sum(((int(p) >> plane) & 1) << (7 - c) for c, p in enumerate(row))
+
+
+def _encode_nes(pixels):
+    return bytes(_plane_byte(row, plane) for plane in range(2) for row in pixels)
+
+
+def _encode_snes(pixels):
+    return bytes(_plane_byte(row, base + plane)
+                 for base in (0, 2) for row in pixels for plane in range(2))
+
+
+ENCODERS = {
+    'genesis': (_encode_genesis, 16),
+    'nes': (_encode_nes, 4),
+    'gameboy': (_encode_nes, 4),
+    'snes': (_encode_snes, 16),
+}
+
+PIXEL_FLIPS = {
+    TileTransform.NORMAL: lambda p: p,
+    TileTransform.FLIP_H: lambda p: p[:, ::-1],
+    TileTransform.FLIP_V: lambda p: p[::-1],
+    TileTransform.FLIP_HV: lambda p: p[::-1, ::-1],
+}
+
+
+def _random_tiles(rng, count, colors, bases=6):
+    """Tiles drawn from a few base tiles with random flips."""
+    base = rng.integers(0, colors, size=(bases, 8, 8))
+    tiles = []
+    for _ in range(count):
+        tile = base[rng.integers(bases)]
+        tiles.append(PIXEL_FLIPS[TileTransform(rng.integers(4))](tile))
+    return tiles
+
+
+def _reference_dedup(encoded, layout, allow_h, allow_v):
+    """Raster-order search, checking NORMAL, FLIP_H, FLIP_V, FLIP_HV in turn."""
+    lookup, refs = {}, []
+    for tile in encoded:
+        for transform in layout.transforms(allow_h, allow_v):
+            index = lookup.get(layout.flip_bytes(tile, transform))
+            if index is not None:
+                refs.append((index, transform))
+                break
+        else:
+            refs.append((len(lookup), TileTransform.NORMAL))
+            lookup[tile] = len(lookup)
+    return refs
+
+
+# =============================================================================
+# Layout Tests
+# =============================================================================
+
+class TestTileLayout:
+    """Byte-level flips agree with pixel-level flips."""
+
+    @pytest.mark.parametrize("fmt", sorted(ENCODERS))
+    def test_flip_matches_pixel_flip(self, fmt):
+        encode, colors = ENCODERS[fmt]
+        layout = TileLayout.for_format(fmt)
+        tiles = _random_tiles(np.random.default_rng(1), 20, colors)
+        batch = np.array([list(encode(t)) for t in tiles], dtype=np.uint8)
+
+        for transform, flip in PIXEL_FLIPS.items():
+            expected = [encode(flip(t)) for t in tiles]
+            assert [layout.flip_bytes(encode(t), transform) for t in tiles] == expected
+            assert [row.tobytes() for row in layout.flip(batch, transform)] == expected
+
+    def test_chunky_rgba_flip(self):
+        pixels = np.random.default_rng(2).integers(0, 256, size=(8, 8, 4), dtype=np.uint8)
+        layout = TileLayout.chunky(8, 8, 4)
+        for transform, flip in PIXEL_FLIPS.items():
+            flipped = layout.flip(pixels.reshape(1, -1), transform)
+            assert flipped.tobytes() == np.ascontiguousarray(flip(pixels)).tobytes()
+
+    def test_unknown_format(self):
+        with pytest.raises(ValueError):
+            TileLayout.for_format('virtualboy')
+
+
+# =============================================================================
+# Dedup Tests
+# =============================================================================
+
+class TestDedupTiles:
+    """dedup_tiles reproduces the raster-order search."""
+
+    @pytest.mark.parametrize("fmt", sorted(ENCODERS))
+    @pytest.mark.parametrize("allow_h,allow_v", [(True, True), (True, False),
+                                                  (False, True), (False, False)])
+    def test_matches_reference(self, fmt, allow_h, allow_v):
+        encode, colors = ENCODERS[fmt]
+        layout = FORMAT_LAYOUTS[fmt]
+        encoded = [encode(t) for t in _random_tiles(np.random.default_rng(3), 200, colors)]
+        rows = np.frombuffer(b''.join(encoded), dtype=np.uint8).reshape(len(encoded), -1)
+
+        result = dedup_tiles(rows, layout, allow_h, allow_v)
+        refs = _reference_dedup(encoded, layout, allow_h, allow_v)
+
+        assert list(zip(result.tile_indices.tolist(), result.transforms.tolist())) == refs
+        assert result.unique_count == len(set(i for i, _ in refs))
+        assert sum(result.transform_counts().values()) == len(encoded)
+        assert result.reference_counts().sum() == len(encoded)
+
+    def test_empty(self):
+        result = dedup_tiles(np.empty((0, 32), dtype=np.uint8), FORMAT_LAYOUTS['genesis'])
+        assert result.unique_count == 0
+        assert len(result.tile_indices) == 0
+
+    def test_hash_collision_falls_back_to_exact_grouping(self, monkeypatch):
+        encode, colors = ENCODERS['genesis']
+        layout = FORMAT_LAYOUTS['genesis']
+        encoded = [encode(t) for t in _random_tiles(np.random.default_rng(4), 50, colors)]
+        rows = np.frombuffer(b''.join(encoded), dtype=np.uint8).reshape(len(encoded), -1)
+        expected = dedup_tiles(rows, layout)
+
+        # Every key hashes the same
+        monkeypatch.setattr(tile_dedup, '_hash_rows',
+                            lambda words: np.zeros(len(words), dtype=np.uint64))
+        result = dedup_tiles(rows, layout)
+
+        assert result.unique_indices.tolist() == expected.unique_indices.tolist()
+        assert result.tile_indices.tolist() == expected.tile_indices.tolist()
+        assert result.transforms.tolist() == expected.transforms.tolist()
@@ -4,6 +4,15 @@ File Watcher for Asset Pipeline.
 Monitors file system for asset changes and triggers pipeline processing with
 debouncing and hot reload support.
 
+Scheduling:
+    Filesystem events and debounce deadlines wake a bounded pool of worker
+    threads; nothing polls. Events are merged per asset group (files that
+    share a directory and base name, e.g. hero.aseprite + hero.png), so a
+    burst of saves runs the group once, and a group never runs on two
+    workers at once. The asset open in the editor (set_focus) is debounced
+    for only focus_debounce_seconds and jumps the queue, so it reloads
+    immediately even while a bulk import occupies the other workers.
+
 Usage:
     >>> from pipeline.watch import AssetWatcher, WatchConfig
     >>> config = WatchConfig(
@@ -14,6 +23,7 @@ Usage:
     >>> watcher = AssetWatcher(config)
     >>> watcher.on_change = lambda event: print(f"Changed: {event.path}")
     >>> watcher.start()
+    >>> watcher.set_focus('assets/sprites/hero.png')  # editor's current file
     >>> # ... watcher runs in background ...
     >>> watcher.stop()
 """
@@ -29,6 +39,8 @@ from collections import deque
 from watchdog.observers import Observer
 from watchdog.events import FileSystemEventHandler, FileSystemEvent
 
+from ..dependency_graph import DependencyGraph
+
 
 class ChangeType(Enum):
     """Type of file change."""
@@ -101,6 +113,8 @@ class WatchConfig:
         hot_reload_enabled: Enable hot reload to emulator/runtime
         hot_reload_command: Command to trigger hot reload
         safety: Safety limits (None = no limits)
+        workers: Worker threads processing changes in parallel
+        focus_debounce_seconds: Debounce for the asset open in the editor
     """
     watch_dirs: List[str]
     extensions: List[str] = field(default_factory=lambda: ['.png', '.aseprite', '.bmp'])
@@ -110,6 +124,8 @@ class WatchConfig:
     hot_reload_enabled: bool = False
     hot_reload_command: Optional[str] = None
     safety: Optional[SafetyConfig] = field(default_factory=SafetyConfig)
+    workers: int = 4
+    focus_debounce_seconds: float = 0.05
 
 
 class RateLimiter:
@@ -233,6 +249,23 @@ class CircuitBreaker:
             return max(0.0, remaining)
 
 
+@dataclass
+class _PendingGroup:
+    """Asset group waiting out its debounce."""
+    paths: Set[str] = field(default_factory=set)
+    deadline: float = 0.0
+
+
+@dataclass
+class _Job:
+    """Asset group being processed by a worker."""
+    group: str
+    paths: List[str]
+    focused: bool
+    deadline: Optional[float] = None  # Timeout of the running callback
+    abandoned: bool = False           # Timed out; worker exits when it returns
+
+
 class AssetWatcher(FileSystemEventHandler):
     """
     Watch for asset changes and trigger pipeline processing.
@@ -241,6 +274,8 @@ class AssetWatcher(FileSystemEventHandler):
     - Debouncing (wait for file write to complete)
     - Hash-based change detection (skip duplicate writes)
     - Selective processing (only changed files)
+    - Event-driven worker pool with per-group coalescing
+    - Editor focus priority (set_focus)
     - Hot reload hooks (optional emulator reload)
 
     Usage:
@@ -266,12 +301,24 @@ class AssetWatcher(FileSystemEventHandler):
 
         # Internal state
         self._observer: Optional[Observer] = None
-        self._pending: Dict[str, float] = {}  # path -> timestamp
         self._file_hashes: Dict[str, str] = {}  # path -> hash
         self._lock = threading.Lock()
-        self._debounce_thread: Optional[threading.Thread] = None
         self._stop_event = threading.Event()
 
+        # Scheduler state (guarded by _cond, which shares _lock)
+        self._cond = threading.Condition(self._lock)
+        # The watchdog waits on its own condition: a notify() meant for one
+        # idle worker must never be consumed by it instead
+        self._watchdog_cond = threading.Condition(self._lock)
+        self._pending: Dict[str, _PendingGroup] = {}  # group -> debouncing paths
+        self._ready: Dict[str, Set[str]] = {}         # group -> paths, FIFO
+        self._active: List[_Job] = []
+        self._focus: Optional[str] = None             # group open in the editor
+        self._hold_until = 0.0                        # error backoff
+        self._circuit_paused = False
+        self._batch: List[FileChangeEvent] = []
+        self._workers: List[threading.Thread] = []
+
         # Safety features
         self._rate_limiter: Optional[RateLimiter] = None
         self._circuit_breaker: Optional[CircuitBreaker] = None
@@ -333,10 +380,14 @@ class AssetWatcher(FileSystemEventHandler):
         # Start observer
         self._observer.start()
 
-        # Start debounce thread
+        # Start worker pool (plus a timeout watchdog)
         self._stop_event.clear()
-        self._debounce_thread = threading.Thread(target=self._debounce_loop, daemon=True)
-        self._debounce_thread.start()
+        for _ in range(max(1, self.config.workers)):
+            self._start_worker()
+        if self.config.safety and self.config.safety.max_processing_time_seconds > 0:
+            watchdog = threading.Thread(target=self._watchdog_loop, daemon=True)
+            self._workers.append(watchdog)
+            watchdog.start()
 
         print("✓ Watcher started. Press Ctrl+C to stop.")
 
@@ -347,10 +398,14 @@ class AssetWatcher(FileSystemEventHandler):
 
         print("\nStopping asset watcher...")
 
-        # Stop debounce thread
-        self._stop_event.set()
-        if self._debounce_thread:
-            self._debounce_thread.join(timeout=2.0)
+        # Stop workers (a callback still running is abandoned)
+        with self._cond:
+            self._stop_event.set()
+            self._cond.notify_all()
+            self._watchdog_cond.notify_all()
+        for worker in self._workers:
+            worker.join(timeout=2.0)
+        self._workers = []
 
         # Stop observer
         self._observer.stop()
@@ -390,14 +445,56 @@ class AssetWatcher(FileSystemEventHandler):
         else:
             return
 
-        # Check queue depth limit
-        with self._lock:
-            if self.config.safety and len(self._pending) >= self.config.safety.max_queue_depth:
-                # Queue is full, drop this change
-                return
+        with self._cond:
+            group = self._group_key(path)
+            entry = self._pending.get(group)
 
-            self._pending[str(path)] = time.time()
+            if entry is None or str(path) not in entry.paths:
+                # Check queue depth limit
+                if self.config.safety and self._queued() >= self.config.safety.max_queue_depth:
+                    # Queue is full, drop this change
+                    return
+                entry = self._pending.setdefault(group, _PendingGroup())
+                entry.paths.add(str(path))
+
+            # Each event in a burst pushes the group's deadline back
+            entry.deadline = time.time() + self._debounce_for(group)
             self.changes_detected += 1
+            self._cond.notify()
+
+    def set_focus(self, path: Optional[Any]):
+        """
+        Mark the asset open in the editor.
+
+        Its group is debounced for focus_debounce_seconds only and is
+        processed before any other ready group.
+
+        Args:
+            path: File open in the editor (None to clear)
+        """
+        with self._cond:
+            self._focus = self._group_key(Path(path)) if path else None
+            entry = self._pending.get(self._focus)
+            if entry is not None:
+                entry.deadline = min(entry.deadline,
+                                     time.time() + self.config.focus_debounce_seconds)
+            self._cond.notify()
+
+    @staticmethod
+    def _group_key(path: Path) -> str:
+        """Asset group: directory plus base name (hero.png, hero.aseprite)."""
+        return str(path.parent / path.name.split('.')[0])
+
+    def _debounce_for(self, group: str) -> float:
+        """Debounce window for a group."""
+        if group == self._focus:
+            return min(self.config.focus_debounce_seconds, self.config.debounce_seconds)
+        return self.config.debounce_seconds
+
+    def _queued(self) -> int:
+        """Paths waiting in the debounce and ready queues."""
+        return (sum(len(entry.paths) for entry in self._pending.values())
+                + sum(len(paths) for paths in self._ready.values()))
 
     def _should_ignore(self, path: Path) -> bool:
         """Check if path matches ignore patterns."""
@@ -409,88 +506,213 @@ class AssetWatcher(FileSystemEventHandler):
                 return True
         return False
 
-    def _debounce_loop(self):
-        """Background thread that processes pending changes after debounce."""
-        batch: List[FileChangeEvent] = []
+    # =========================================================================
+    # SCHEDULER
+    # =========================================================================
+
+    def _start_worker(self):
+        """Add a worker thread to the pool."""
+        worker = threading.Thread(target=self._worker_loop, daemon=True)
+        self._workers.append(worker)
+        worker.start()
+
+    def _worker_loop(self):
+        """Worker thread: run ready groups until the watcher stops."""
+        while True:
+            with self._cond:
+                job = self._next_job()
+            if job is None or not self._run_job(job):
+                return
+
+    def _next_job(self) -> Optional[_Job]:
+        """
+        Wait for the next group to process (called with _cond held).
 
+        Sleeps until a filesystem event, a debounce deadline, a finished
+        job or the end of an error pause, whichever comes first.
+
+        Returns:
+            Job to run, or None once the watcher stops
+        """
         while not self._stop_event.is_set():
-            time.sleep(0.1)  # Check every 100ms
-
-            # Check circuit breaker
-            if self._circuit_breaker and self._circuit_breaker.is_open():
-                remaining = self._circuit_breaker.get_cooldown_remaining()
-                if remaining > 0:
-                    # Still in cooldown
-                    continue
+            now = time.time()
+
+            # Promote groups whose debounce has passed
+            wake: Optional[float] = None
+            for group, entry in list(self._pending.items()):
+                if entry.deadline <= now:
+                    self._ready.setdefault(group, set()).update(entry.paths)
+                    del self._pending[group]
                 else:
-                    # Cooldown finished, circuit closed
-                    print(f"\n✓ Circuit breaker reset after cooldown")
-
-            current_time = time.time()
-            to_process: List[str] = []
-
-            # Find files ready to process (past debounce time)
-            with self._lock:
-                for file_path, timestamp in list(self._pending.items()):
-                    if current_time - timestamp >= self.config.debounce_seconds:
-                        to_process.append(file_path)
-                        del self._pending[file_path]
-
-            # Process each file
-            for file_path in to_process:
-                # Rate limiting check
-                if self._rate_limiter and not self._rate_limiter.is_allowed():
-                    self.changes_rate_limited += 1
-                    # Put back in pending queue for later
-                    with self._lock:
-                        self._pending[file_path] = time.time()
-                    continue
-
-                event = self._create_change_event(Path(file_path))
-
-                if event is None:
-                    continue
-
-                # Check if file actually changed (hash comparison)
-                if self._is_duplicate_change(event):
-                    self.changes_skipped += 1
-                    continue
-
-                # File size check
-                if not self._check_file_size(event.path):
-                    self.changes_too_large += 1
-                    print(f"⚠ Skipped (too large): {event.path.name}")
-                    continue
-
-                self.changes_processed += 1
-                batch.append(event)
-
-                # Call change callback with timeout
-                if self.on_change:
-                    success = self._process_with_timeout(event)
-
-                    # Update circuit breaker
+                    wake = entry.deadline if wake is None else min(wake, entry.deadline)
+
+            pause = self._pause_remaining(now)
+            if pause > 0:
+                wake = now + pause if wake is None else min(wake, now + pause)
+            else:
+                job = self._pick_job()
+                if job is not None:
+                    return job
+
+            self._cond.wait(None if wake is None else max(0.0, wake - now))
+        return None
+
+    def _watchdog_loop(self):
+        """Abandon callbacks that exceed the processing timeout."""
+        with self._watchdog_cond:
+            while not self._stop_event.is_set():
+                now = time.time()
+                self._expire_jobs(now)
+                deadlines = [job.deadline for job in self._active if job.deadline is not None]
+                self._watchdog_cond.wait(max(0.0, min(deadlines) - now) if deadlines else None)
+
+    def _pause_remaining(self, now: float) -> float:
+        """Seconds until dispatching may resume (error backoff, circuit breaker)."""
+        if self._circuit_breaker and self._circuit_breaker.is_open():
+            self._circuit_paused = True
+            return max(self._circuit_breaker.get_cooldown_remaining(), 0.01)
+        if self._circuit_paused:
+            self._circuit_paused = False
+            print(f"\n✓ Circuit breaker reset after cooldown")
+        return max(0.0, self._hold_until - now)
+
+    def _pick_job(self) -> Optional[_Job]:
+        """Take the focused group if ready, else the oldest idle ready group."""
+        running = {job.group for job in self._active}
+        candidates = [group for group in self._ready if group not in running]
+        if not candidates:
+            return None
+
+        group = self._focus if self._focus in candidates else candidates[0]
+        job = _Job(group=group, paths=sorted(self._ready.pop(group)),
+                   focused=group == self._focus)
+        self._active.append(job)
+        return job
+
+    def _expire_jobs(self, now: float):
+        """Abandon callbacks over the processing timeout (called with _cond held)."""
+        for job in list(self._active):
+            if job.deadline is None or now < job.deadline:
+                continue
+
+            job.abandoned = True
+            self._active.remove(job)
+            self.changes_timed_out += 1
+            print(f"⚠ Timeout processing {Path(job.paths[0]).name} "
+                  f"(>{self.config.safety.max_processing_time_seconds}s)")
+            self._record_failure()
+
+            # The stuck worker exits when its callback returns
+            self._start_worker()
+
+    def _record_failure(self):
+        """Pause dispatching after an error and update the circuit breaker."""
+        if self.config.safety:
+            self._hold_until = time.time() + self.config.safety.error_backoff_seconds
+        if self._circuit_breaker and self._circuit_breaker.record_error():
+            self.circuit_breaker_trips += 1
+            print(f"\n⚠ Circuit breaker opened after {self._circuit_breaker.max_errors} errors")
+            print(f"   Pausing for {self._circuit_breaker.cooldown_seconds}s...")
+
+    def _run_job(self, job: _Job) -> bool:
+        """
+        Process one asset group.
+
+        Returns:
+            False if the job timed out (its worker has been replaced)
+        """
+        processed: List[FileChangeEvent] = []
+
+        for i, file_path in enumerate(job.paths):
+            # Rate limiting check
+            if self._rate_limiter and not self._rate_limiter.is_allowed():
+                self.changes_rate_limited += 1
+                # Put the rest back in the pending queue for later
+                with self._cond:
+                    entry = self._pending.setdefault(job.group, _PendingGroup())
+                    entry.paths.update(job.paths[i:])
+                    entry.deadline = time.time() + self._debounce_for(job.group)
+                break
+
+            event = self._create_change_event(Path(file_path))
+
+            if event is None:
+                continue
+
+            # Check if file actually changed (hash comparison)
+            if self._is_duplicate_change(event):
+                self.changes_skipped += 1
+                continue
+
+            # File size check
+            if not self._check_file_size(event.path):
+                self.changes_too_large += 1
+                print(f"⚠ Skipped (too large): {event.path.name}")
+                continue
+
+            self.changes_processed += 1
+            processed.append(event)
+
+            if not self.on_change:
+                continue
+
+            with self._cond:
+                if self.config.safety and self.config.safety.max_processing_time_seconds > 0:
+                    job.deadline = time.time() + self.config.safety.max_processing_time_seconds
+                    self._watchdog_cond.notify()
+
+            success = self._call_on_change(event)
+
+            with self._cond:
+                job.deadline = None
+                if job.abandoned:
+                    return False
+                if success:
                     if self._circuit_breaker:
-                        if success:
-                            self._circuit_breaker.record_success()
-                        else:
-                            should_open = self._circuit_breaker.record_error()
-                            if should_open:
-                                self.circuit_breaker_trips += 1
-                                print(f"\n⚠ Circuit breaker opened after {self._circuit_breaker.max_errors} errors")
-                                print(f"   Pausing for {self._circuit_breaker.cooldown_seconds}s...")
-                                break  # Stop processing this batch
-
-            # Call batch callback if we processed anything
-            if batch and self.on_batch_complete:
-                try:
-                    self.on_batch_complete(batch.copy())
-                except Exception as e:
-                    if self.on_error:
-                        self.on_error(e)
-                    else:
-                        print(f"Error in batch callback: {e}")
-                batch.clear()
+                        self._circuit_breaker.record_success()
+                else:
+                    self._record_failure()
+                    if self._circuit_breaker and self._circuit_breaker.is_open():
+                        break  # Stop processing this group
+
+        with self._cond:
+            self._active.remove(job)
+            self._batch.extend(processed)
+
+            # Reload right after the edited asset, or once a burst has drained
+            idle = not (self._pending or self._ready or self._active)
+            batch: List[FileChangeEvent] = []
+            if self._batch and (job.focused or idle):
+                batch, self._batch = self._batch, []
+            self._cond.notify_all()
+
+        # Call batch callback if we processed anything
+        if batch and self.on_batch_complete:
+            try:
+                self.on_batch_complete(batch)
+            except Exception as e:
+                if self.on_error:
+                    self.on_error(e)
+                else:
+                    print(f"Error in batch callback: {e}")
+        return True
+
+    def _call_on_change(self, event: FileChangeEvent) -> bool:
+        """
+        Run the change callback on this worker.
+
+        Returns:
+            True if processing succeeded
+        """
+        try:
+            self.on_change(event)
+            return True
+        except Exception as e:
+            if self.on_error:
+                self.on_error(e)
+            else:
+                print(f"Error processing {event.path}: {e}")
+            return False
 
     def _create_change_event(self, path: Path) -> Optional[FileChangeEvent]:
         """Create change event for path."""
@@ -570,67 +792,6 @@ class AssetWatcher(FileSystemEventHandler):
         except Exception:
             return False
 
-    def _process_with_timeout(self, event: FileChangeEvent) -> bool:
-        """
-        Process event with timeout protection.
-
-        Args:
-            event: Event to process
-
-        Returns:
-            True if processing succeeded
-        """
-        if not self.config.safety or self.config.safety.max_processing_time_seconds <= 0:
-            # No timeout, process normally
-            try:
-                self.on_change(event)
-                return True
-            except Exception as e:
-                if self.on_error:
-                    self.on_error(e)
-                else:
-                    print(f"Error processing {event.path}: {e}")
-
-                # Apply error backoff
-                if self.config.safety:
-                    time.sleep(self.config.safety.error_backoff_seconds)
-                return False
-
-        # Process with timeout
-        result = {'success': False, 'exception': None}
-
-        def target():
-            try:
-                self.on_change(event)
-                result['success'] = True
-            except Exception as e:
-                result['exception'] = e
-
-        thread = threading.Thread(target=target, daemon=True)
-        thread.start()
-        thread.join(timeout=self.config.safety.max_processing_time_seconds)
-
-        if thread.is_alive():
-            # Timeout occurred
-            self.changes_timed_out += 1
-            print(f"⚠ Timeout processing {event.path.name} (>{self.config.safety.max_processing_time_seconds}s)")
-
-            # Apply error backoff
-            time.sleep(self.config.safety.error_backoff_seconds)
-            return False
-
-        if result['exception']:
-            if self.on_error:
-                self.on_error(result['exception'])
-            else:
-                print(f"Error processing {event.path}: {result['exception']}")
-
-            # Apply error backoff
-            time.sleep(self.config.safety.error_backoff_seconds)
-            return False
-
-        return result['success']
-
     def _print_statistics(self):
         """Print watcher statistics."""
         print("\nStatistics:")
@@ -682,6 +843,11 @@ class PipelineWatcher(AssetWatcher):
 
     Automatically processes changed assets through the pipeline.
 
+    With a DependencyGraph, files the graph tracks are rebuilt through it:
+    only the downstream steps whose inputs actually changed run (sheet →
+    tiles → .res → headers), and hot reload is skipped when no output
+    changed. Untracked files go to processor_func as before.
+
     Usage:
         >>> from pipeline.watch import PipelineWatcher, WatchConfig
         >>> config = WatchConfig(watch_dirs=['assets/sprites'])
@@ -692,7 +858,8 @@ class PipelineWatcher(AssetWatcher):
     def __init__(self,
                  config: WatchConfig,
                  processor_func: Callable[[Path], None],
-                 enable_hot_reload: bool = False):
+                 enable_hot_reload: bool = False,
+                 graph: Optional[DependencyGraph] = None):
         """
         Initialize pipeline watcher.
 
@@ -700,10 +867,15 @@ class PipelineWatcher(AssetWatcher):
             config: Watch configuration
             processor_func: Function to process changed files
             enable_hot_reload: Enable hot reload after processing
+            graph: Dependency graph for incremental rebuilds (optional)
         """
         super().__init__(config)
         self.processor_func = processor_func
         self.enable_hot_reload = enable_hot_reload
+        self.graph = graph
+
+        # Outputs changed since the last hot reload (graph mode)
+        self._changed_outputs: Set[str] = set()
 
         # Set up callbacks
         self.on_change = self._process_change
@@ -721,18 +893,46 @@ class PipelineWatcher(AssetWatcher):
         print(f"Change type: {event.change_type.value}")
         print(f"{'='*60}")
 
+        if self.graph is not None and self.graph.tracks(event.path):
+            self._rebuild_dependents(event.path)
+            return
+
         try:
             start_time = time.time()
             self.processor_func(event.path)
             duration = time.time() - start_time
             print(f"✓ Processed in {duration:.2f}s")
+            if self.graph is not None:
+                # Untracked file: no way to tell whether outputs changed
+                with self._lock:
+                    self._changed_outputs.add(str(event.path))
         except Exception as e:
             print(f"✗ Error: {e}")
             import traceback
             traceback.print_exc()
 
+    def _rebuild_dependents(self, path: Path):
+        """Rebuild the graph steps downstream of a changed file."""
+        start_time = time.time()
+        report = self.graph.update([path])
+        duration = time.time() - start_time
+
+        for step_id, error in report.failed.items():
+            print(f"✗ {step_id}: {error}")
+        print(f"{'✓' if report.success else '✗'} {report.summary()} in {duration:.2f}s")
+
+        with self._lock:
+            self._changed_outputs.update(report.changed_outputs)
+
     def _on_batch_complete(self, events: List[FileChangeEvent]):
         """Trigger hot reload after batch processing."""
         if self.enable_hot_reload:
             print(f"\nBatch complete ({len(events)} files)")
+            if self.graph is not None:
+                with self._lock:
+                    changed = bool(self._changed_outputs)
+                    self._changed_outputs.clear()
+                if not changed:
+                    print("No outputs changed, skipping hot reload")
+                    return
             self.trigger_hot_reload()
@@ -0,0 +1,178 @@
+"""
+Test suite for ARDKBuilder asset processing.
+
+Tests change detection (mtime/size fast path, hash fallback), in-process
+and pooled asset jobs, ordered output merging and error aggregation.
+"""
+
+import os
+import pytest
+import sys
+import tempfile
+import shutil
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from ardk_build import ARDKBuilder, DEFAULT_PROJECT_CONFIG
+
+
+# Stand-in for tools/unified_pipeline.py
+FAKE_PIPELINE = '''
+import os
+
+class UnifiedPipeline:
+    def __init__(self, target_size=32, platform="nes", **kwargs):
+        self.platform = platform
+
+    def _infer_type(self, path):
+        return "misc"
+
+    def process(self, input_path, output_dir, category=None):
+        name = os.path.basename(input_path)
+        print("processing", name)
+        if name.startswith("bad"):
+            raise ValueError("cannot process " + name)
+        stem = os.path.splitext(name)[0]
+        with open(os.path.join(output_dir, stem + ".chr"), "w") as f:
+            f.write(self.platform)
+        with open(os.path.join(output_dir, "metadata.json"), "w") as f:
+            f.write(name)
+        return {}
+'''
+
+
+# =============================================================================
+# Fixtures
+# =============================================================================
+
+@pytest.fixture
+def project():
+    """Project root with a fake asset pipeline and two sprites."""
+    root = Path(tempfile.mkdtemp())
+    (root / "tools").mkdir()
+    (root / "tools" / "unified_pipeline.py").write_text(FAKE_PIPELINE)
+    sprites = root / "gfx" / "sprites"
+    sprites.mkdir(parents=True)
+    (sprites / "a.png").write_bytes(b"a")
+    (sprites / "b.png").write_bytes(b"b")
+    yield root
+    shutil.rmtree(root, ignore_errors=True)
+
+
+def make_builder(root, jobs=1):
+    config = dict(DEFAULT_PROJECT_CONFIG, asset_dirs=["gfx/sprites"])
+    return ARDKBuilder(root, config, jobs=jobs)
+
+
+def assets(root):
+    return root / "build" / "nes" / "assets"
+
+
+# =============================================================================
+# Change Detection
+# =============================================================================
+
+def test_unchanged_stat_skips_hashing(project, monkeypatch):
+    """Matching mtime and size never read the file."""
+    builder = make_builder(project)
+    assert builder.process_assets("nes")
+
+    builder = make_builder(project)
+    monkeypatch.setattr(builder, "_hash_file",
+                        lambda path: pytest.fail("hashed an unchanged file"))
+    sprite = project / "gfx" / "sprites" / "a.png"
+    assert not builder._file_changed(sprite)
+
+
+def test_touched_file_not_rebuilt(project):
+    """New mtime with identical content falls back to the hash."""
+    builder = make_builder(project)
+    assert builder.process_assets("nes")
+    builder._save_cache()
+
+    sprite = project / "gfx" / "sprites" / "a.png"
+    stat = sprite.stat()
+    os.utime(sprite, ns=(stat.st_atime_ns, stat.st_mtime_ns + 10**9))
+
+    builder = make_builder(project)
+    assert not builder._file_changed(sprite)
+    assert builder.file_hashes["gfx/sprites/a.png"]["mtime_ns"] == stat.st_mtime_ns + 10**9
+
+
+def test_legacy_hash_cache(project):
+    """Caches holding bare MD5 strings still match unchanged files."""
+    builder = make_builder(project)
+    sprite = project / "gfx" / "sprites" / "a.png"
+    builder.file_hashes = {"gfx/sprites/a.png": builder._hash_file(sprite)}
+
+    assert not builder._file_changed(sprite)
+
+
+# =============================================================================
+# Asset Jobs
+# =============================================================================
+
+def test_process_assets_in_process(project):
+    """Jobs run without a subprocess and merge in source order."""
+    builder = make_builder(project)
+    assert builder.process_assets("nes")
+
+    out = assets(project)
+    assert (out / "a.chr").read_text() == "nes"
+    assert (out / "b.chr").read_text() == "nes"
+    # Shared outputs hold the last source, as in a sequential build
+    glob_order = [p.name for p in (project / "gfx" / "sprites").glob("**/*.png")]
+    assert (out / "metadata.json").read_text() == glob_order[-1]
+
+
+def test_only_changed_files_rerun(project, capsys):
+    """Second build processes only the edited PNG."""
+    builder = make_builder(project)
+    assert builder.process_assets("nes")
+    builder._save_cache()
+    capsys.readouterr()
+
+    (project / "gfx" / "sprites" / "b.png").write_bytes(b"bb")
+    builder = make_builder(project)
+    assert builder.process_assets("nes")
+
+    out = capsys.readouterr().out
+    assert "Processing: b.png" in out
+    assert "Processing: a.png" not in out
+
+
+def test_errors_reported_together(project, capsys):
+    """Every failure is reported; good assets are still built."""
+    sprites = project / "gfx" / "sprites"
+    (sprites / "bad1.png").write_bytes(b"x")
+    (sprites / "bad2.png").write_bytes(b"y")
+
+    builder = make_builder(project)
+    assert not builder.process_assets("nes")
+
+    out = capsys.readouterr().out
+    assert "Asset pipeline errors (2)" in out
+    assert "cannot process bad1.png" in out
+    assert "cannot process bad2.png" in out
+    assert (assets(project) / "a.chr").exists()
+
+    # Failed assets are retried next build
+    builder = make_builder(project)
+    assert builder._file_changed(sprites / "bad1.png")
+    assert not builder._file_changed(sprites / "a.png")
+
+
+def test_process_pool_matches_serial(project):
+    """Pooled build produces the same outputs as the in-process one."""
+    (project / "gfx" / "sprites" / "bad.png").write_bytes(b"x")
+
+    serial = make_builder(project, jobs=1)
+    assert not serial.process_assets("nes")
+    expected = {p.name: p.read_bytes() for p in assets(project).iterdir()}
+    shutil.rmtree(project / "build")
+
+    pooled = make_builder(project, jobs=2)
+    assert not pooled.process_assets("nes")
+    assert {p.name: p.read_bytes() for p in assets(project).iterdir()} == expected
+    assert set(pooled.file_hashes) == {"gfx/sprites/a.png", "gfx/sprites/b.png"}
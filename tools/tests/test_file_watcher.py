@@ -1,20 +1,25 @@
 """
 Test suite for AssetWatcher.
 
-Tests file watching, debouncing, hash-based change detection, and hot reload hooks.
+Tests file watching, debouncing, hash-based change detection, hot reload hooks,
+dependency-graph rebuilds, and the worker-pool scheduler (coalescing, editor
+focus priority, timeouts).
 """
 
 import pytest
+import threading
 import time
 import tempfile
 import shutil
 from pathlib import Path
 from PIL import Image
+from watchdog.events import FileModifiedEvent
 
 from pipeline.watch import (
     AssetWatcher, WatchConfig, SafetyConfig, FileChangeEvent,
     ChangeType, PipelineWatcher, RateLimiter, CircuitBreaker
 )
+from pipeline.dependency_graph import DependencyGraph, write_if_changed
 
 
 # =============================================================================
@@ -309,6 +314,37 @@ def test_pipeline_watcher_hot_reload_enabled(watch_config):
     assert watcher.on_batch_complete is not None
 
 
+def test_pipeline_watcher_dependency_graph(watch_config, temp_dir):
+    """Tracked files rebuild through the graph; no output change, no reload."""
+    source = temp_dir / 'hero.png'
+    source.write_bytes(b'hero')
+    graph = DependencyGraph(root=temp_dir)
+    graph.register_rule('copy', lambda inputs, outputs, params:
+                        write_if_changed(outputs[0], inputs[0].read_bytes()[:2]))
+    graph.add_step('hero', 'copy', [source], [temp_dir / 'hero.bin'])
+    graph.build_all()
+
+    untracked = []
+    watcher = PipelineWatcher(watch_config, processor_func=untracked.append,
+                              enable_hot_reload=True, graph=graph)
+    reloads = []
+    watcher.trigger_hot_reload = lambda: reloads.append(1)
+
+    def edit(data):
+        source.write_bytes(data)
+        event = FileChangeEvent(path=source, change_type=ChangeType.MODIFIED,
+                                timestamp=time.time())
+        watcher._process_change(event)
+        watcher._on_batch_complete([event])
+
+    edit(b'heRO')    # Output bytes unchanged
+    assert reloads == []
+    edit(b'HERO')
+    assert reloads == [1]
+    assert (temp_dir / 'hero.bin').read_bytes() == b'HE'
+    assert untracked == []
+
+
 # =============================================================================
 # Integration Tests
 # =============================================================================
@@ -618,5 +654,183 @@ def test_watcher_safety_statistics(temp_dir):
         watcher.stop()
 
 
+# =============================================================================
+# Scheduler Tests
+# =============================================================================
+
+def _touch(watcher, path: Path, data: bytes):
+    """Write a file and deliver its event directly (no observer latency)."""
+    path.write_bytes(data)
+    watcher.on_any_event(FileModifiedEvent(str(path)))
+
+
+def _scheduler_watcher(temp_dir, **kwargs):
+    config = WatchConfig(watch_dirs=[str(temp_dir)], extensions=['.png', '.aseprite'],
+                         **kwargs)
+    watcher = AssetWatcher(config)
+    watcher._observer = object()  # Workers only; events are injected
+    for _ in range(max(1, config.workers)):
+        watcher._start_worker()
+    if config.safety and config.safety.max_processing_time_seconds > 0:
+        watchdog = threading.Thread(target=watcher._watchdog_loop, daemon=True)
+        watcher._workers.append(watchdog)
+        watchdog.start()
+    return watcher
+
+
+def _shutdown(watcher):
+    with watcher._cond:
+        watcher._stop_event.set()
+        watcher._cond.notify_all()
+        watcher._watchdog_cond.notify_all()
+    for worker in watcher._workers:
+        worker.join(timeout=2.0)
+
+
+def test_group_key():
+    """Files sharing directory and base name form one group."""
+    key = AssetWatcher._group_key
+    assert key(Path('a/hero.png')) == key(Path('a/hero.aseprite'))
+    assert key(Path('a/hero.png')) != key(Path('b/hero.png'))
+    assert key(Path('a/hero.png')) != key(Path('a/hero_idle.png'))
+
+
+def test_burst_coalesced(temp_dir):
+    """A burst of saves to one asset group runs once per file."""
+    watcher = _scheduler_watcher(temp_dir, debounce_seconds=0.2)
+    calls = []
+    watcher.on_change = lambda event: calls.append(event.path.name)
+    try:
+        for i in range(5):
+            _touch(watcher, temp_dir / 'hero.png', bytes([i]))
+            _touch(watcher, temp_dir / 'hero.aseprite', bytes([i]))
+        time.sleep(0.6)
+        assert sorted(calls) == ['hero.aseprite', 'hero.png']
+        assert watcher.changes_detected == 10
+    finally:
+        _shutdown(watcher)
+
+
+def test_focus_jumps_bulk_queue(temp_dir):
+    """The focused asset is processed promptly while a bulk import runs."""
+    watcher = _scheduler_watcher(temp_dir, debounce_seconds=0.05, workers=2)
+    done = {}
+
+    def on_change(event):
+        if event.path.name.startswith('bulk'):
+            time.sleep(0.1)
+        done[event.path.name] = time.time()
+
+    watcher.on_change = on_change
+    try:
+        for i in range(40):
+            _touch(watcher, temp_dir / f'bulk_{i:02d}.png', bytes([i]))
+        time.sleep(0.2)
+
+        watcher.set_focus(temp_dir / 'hero.png')
+        saved = time.time()
+        _touch(watcher, temp_dir / 'hero.png', b'hero')
+        time.sleep(0.4)
+
+        assert done['hero.png'] - saved < 0.3
+        assert len([n for n in done if n.startswith('bulk')]) < 40
+    finally:
+        _shutdown(watcher)
+
+
+def test_focus_short_debounce(temp_dir):
+    """The focused asset skips the normal debounce window."""
+    watcher = _scheduler_watcher(temp_dir, debounce_seconds=2.0)
+    done = []
+    watcher.on_change = lambda event: done.append(time.time())
+    try:
+        watcher.set_focus(str(temp_dir / 'hero.png'))
+        saved = time.time()
+        _touch(watcher, temp_dir / 'hero.png', b'hero')
+        time.sleep(0.3)
+        assert done and done[0] - saved < 0.2
+    finally:
+        _shutdown(watcher)
+
+
+def test_group_never_runs_twice_at_once(temp_dir):
+    """New edits to a running group wait for it to finish."""
+    watcher = _scheduler_watcher(temp_dir, debounce_seconds=0.02, workers=4)
+    running = []
+    overlaps = []
+
+    def on_change(event):
+        if running:
+            overlaps.append(event.path.name)
+        running.append(1)
+        time.sleep(0.15)
+        running.pop()
+
+    watcher.on_change = on_change
+    try:
+        _touch(watcher, temp_dir / 'hero.png', b'1')
+        time.sleep(0.05)
+        _touch(watcher, temp_dir / 'hero.png', b'2')
+        time.sleep(0.5)
+        assert overlaps == []
+        assert watcher.changes_processed == 2
+    finally:
+        _shutdown(watcher)
+
+
+def test_timeout_replaces_worker(temp_dir):
+    """A stuck callback is abandoned and the pool keeps processing."""
+    safety = SafetyConfig(max_processing_time_seconds=0.2, error_backoff_seconds=0.0)
+    watcher = _scheduler_watcher(temp_dir, debounce_seconds=0.02, workers=1, safety=safety)
+    done = []
+
+    def on_change(event):
+        if event.path.name == 'stuck.png':
+            time.sleep(1.0)
+        done.append(event.path.name)
+
+    watcher.on_change = on_change
+    try:
+        _touch(watcher, temp_dir / 'stuck.png', b's')
+        time.sleep(0.1)
+        _touch(watcher, temp_dir / 'next.png', b'n')
+        time.sleep(0.5)
+        assert watcher.changes_timed_out == 1
+        assert done == ['next.png']
+    finally:
+        _shutdown(watcher)
+
+
+def test_timeout_with_idle_workers(temp_dir):
+    """Idle workers do not swallow the wake-up that arms the watchdog."""
+    safety = SafetyConfig(max_processing_time_seconds=0.2, error_backoff_seconds=0.0)
+    watcher = _scheduler_watcher(temp_dir, debounce_seconds=0.02, workers=4, safety=safety)
+    release = threading.Event()
+    watcher.on_change = lambda event: release.wait(2.0)
+    try:
+        _touch(watcher, temp_dir / 'stuck.png', b's')
+        time.sleep(0.5)
+        assert watcher.changes_timed_out == 1
+        assert not watcher._active
+    finally:
+        release.set()
+        _shutdown(watcher)
+
+
+def test_batch_callback_after_burst(temp_dir):
+    """on_batch_complete fires once a burst has drained."""
+    watcher = _scheduler_watcher(temp_dir, debounce_seconds=0.05, workers=2)
+    batches = []
+    watcher.on_change = lambda event: None
+    watcher.on_batch_complete = lambda events: batches.append(len(events))
+    try:
+        for i in range(6):
+            _touch(watcher, temp_dir / f'tile_{i}.png', bytes([i]))
+        time.sleep(0.4)
+        assert sum(batches) == 6
+    finally:
+        _shutdown(watcher)
+
+
 if __name__ == '__main__':
     pytest.main([__file__, '-v'])
@@ -0,0 +1,308 @@
+"""
+Test suite for the pooled HTTP transport and PixelLabClient concurrency.
+
+Runs against a local mock server. Tests keep-alive reuse, per-host
+concurrency limits, 429/5xx retry with backoff (and no resending of
+billed POSTs), recovery from dropped keep-alive connections, the async entry point, and concurrent
+PixelLab sub-requests under the max_calls safeguard.
+"""
+
+import asyncio
+import base64
+import io
+import json
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import urlsplit, parse_qs
+
+import pytest
+from PIL import Image
+
+from asset_generators.http_transport import PooledHTTPTransport, RetryPolicy
+from asset_generators import pixellab_client
+from asset_generators.pixellab_client import PixelLabClient
+
+
+FAST_RETRY = RetryPolicy(max_attempts=4, base_delay=0.01, max_delay=0.05)
+
+
+# =============================================================================
+# Mock Server
+# =============================================================================
+
+def _png_b64() -> str:
+    buffer = io.BytesIO()
+    Image.new('RGBA', (16, 16), (255, 0, 0, 255)).save(buffer, format='PNG')
+    return base64.b64encode(buffer.getvalue()).decode()
+
+
+class MockAPI(ThreadingHTTPServer):
+    """Threaded server that records connections, hits and concurrency."""
+    daemon_threads = True
+
+    def __init__(self):
+        super().__init__(('127.0.0.1', 0), MockHandler)
+        self.lock = threading.Lock()
+        self.connections = 0
+        self.hits = {}
+        self.in_flight = 0
+        self.peak = 0
+        self.delay = 0.0
+
+    @property
+    def url(self):
+        return f"http://127.0.0.1:{self.server_address[1]}"
+
+    def hit(self, path):
+        with self.lock:
+            self.hits[path] = self.hits.get(path, 0) + 1
+            return self.hits[path]
+
+
+class MockHandler(BaseHTTPRequestHandler):
+    protocol_version = 'HTTP/1.1'     # Keep-alive
+
+    def setup(self):
+        super().setup()
+        with self.server.lock:
+            self.server.connections += 1
+
+    def log_message(self, *args):
+        pass
+
+    def _reply(self, status, payload, headers=None):
+        body = json.dumps(payload).encode()
+        self.send_response(status)
+        self.send_header('Content-Type', 'application/json')
+        self.send_header('Content-Length', str(len(body)))
+        for name, value in (headers or {}).items():
+            self.send_header(name, value)
+        self.end_headers()
+        self.wfile.write(body)
+
+    def _handle(self):
+        parts = urlsplit(self.path)
+        query = parse_qs(parts.query)
+        length = int(self.headers.get('Content-Length') or 0)
+        if length:
+            self.rfile.read(length)
+        count = self.server.hit(parts.path)
+
+        with self.server.lock:
+            self.server.in_flight += 1
+            self.server.peak = max(self.server.peak, self.server.in_flight)
+        try:
+            time.sleep(float(query.get('delay', [self.server.delay])[0]))
+        finally:
+            with self.server.lock:
+                self.server.in_flight -= 1
+
+        if parts.path == '/flaky' and count <= int(query['fail'][0]):
+            self._reply(429, {'error': 'slow down'}, {'Retry-After': '0'})
+        elif parts.path == '/down':
+            self._reply(503, {'error': 'maintenance'})
+        elif parts.path == '/busy':
+            self._reply(503, {'error': 'busy'}, {'Retry-After': '0'})
+        elif parts.path == '/bad-gateway':
+            self._reply(502, {'error': 'upstream'})
+        elif parts.path == '/drop':
+            # Looks like keep-alive to the client, but the server hangs up
+            self._reply(200, {'n': count})
+            self.close_connection = True
+        elif parts.path == '/v1/rotate':
+            self._reply(200, {'image': _png_b64(), 'cost_usd': 0.01})
+        else:
+            self._reply(200, {'n': count})
+
+    do_GET = _handle
+    do_POST = _handle
+
+
+@pytest.fixture
+def server():
+    api = MockAPI()
+    thread = threading.Thread(target=api.serve_forever, args=(0.05,), daemon=True)
+    thread.start()
+    yield api
+    api.shutdown()
+    api.server_close()
+
+
+@pytest.fixture
+def transport():
+    t = PooledHTTPTransport(max_per_host=4, timeout=5, retry=FAST_RETRY)
+    yield t
+    t.close()
+
+
+# =============================================================================
+# Transport Tests
+# =============================================================================
+
+def test_keep_alive_reuses_connection(server, transport):
+    """Sequential requests share one pooled connection."""
+    for i in range(10):
+        response = transport.request('GET', f"{server.url}/ping")
+        assert response.ok and response.json() == {'n': i + 1}
+
+    assert server.connections == 1
+    assert transport.stats == {'requests': 10, 'connections': 1, 'retries': 0}
+
+
+def test_per_host_limit(server):
+    """No more than max_per_host requests are in flight at once."""
+    transport = PooledHTTPTransport(max_per_host=2, timeout=5)
+    try:
+        calls = [lambda: transport.request('GET', f"{server.url}/work?delay=0.1")] * 8
+        start = time.time()
+        responses = transport.gather(calls)
+        elapsed = time.time() - start
+    finally:
+        transport.close()
+
+    assert all(r.ok for r in responses)
+    assert server.peak == 2
+    assert elapsed >= 0.35            # Four waves of two
+    assert server.connections <= 2
+
+
+def test_retry_after_429(server, transport):
+    """Rate-limited requests back off and succeed."""
+    response = transport.request('GET', f"{server.url}/flaky?fail=2")
+
+    assert response.ok
+    assert response.attempts == 3
+    assert transport.stats['retries'] == 2
+
+
+def test_retry_gives_up(server, transport):
+    """A persistent 5xx is returned after max_attempts tries."""
+    response = transport.request('GET', f"{server.url}/down")
+
+    assert response.status == 503
+    assert response.attempts == FAST_RETRY.max_attempts
+    assert server.hits['/down'] == FAST_RETRY.max_attempts
+
+
+def test_post_5xx_not_resent(server, transport):
+    """A POST that may have been processed (and billed) is sent once."""
+    for path in ('/bad-gateway', '/down'):
+        response = transport.request('POST', f"{server.url}{path}", body=b'{}')
+        assert response.status in (502, 503)
+        assert response.attempts == 1
+        assert server.hits[path] == 1
+    assert transport.stats['retries'] == 0
+
+
+def test_post_retried_when_refused(server, transport):
+    """POSTs retry on 429, or 503 with Retry-After: the server did no work."""
+    assert transport.request('POST', f"{server.url}/flaky?fail=2", body=b'{}').ok
+    response = transport.request('POST', f"{server.url}/busy", body=b'{}')
+    assert response.attempts == FAST_RETRY.max_attempts
+
+    # Callers can vouch for an idempotent POST
+    transport.request('POST', f"{server.url}/bad-gateway", body=b'{}', idempotent=True)
+    assert server.hits['/bad-gateway'] == FAST_RETRY.max_attempts
+
+
+def test_retry_delay_jitter():
+    """Delays stay under the exponential cap and honour Retry-After."""
+    policy = RetryPolicy(base_delay=1.0, max_delay=10.0)
+    for attempt in range(6):
+        assert 0 <= policy.delay(attempt) <= min(10.0, 2 ** attempt)
+    assert policy.delay(0, retry_after='5') >= 5
+    assert policy.delay(0, retry_after='60') == 10.0
+    assert policy.delay(0, retry_after='Wed, 21 Oct 2015 07:28:00 GMT') <= 1.0
+
+
+def test_dropped_keep_alive_reconnects(server, transport):
+    """A pooled connection closed by the server is replaced transparently."""
+    assert transport.request('GET', f"{server.url}/drop").ok
+    time.sleep(0.05)
+    assert transport.request('GET', f"{server.url}/ping").ok
+    assert server.connections == 2
+
+
+def test_dropped_keep_alive_post(server, transport):
+    """A POST never goes out on a pooled connection the server has closed."""
+    assert transport.request('POST', f"{server.url}/drop", body=b'{}').ok
+    time.sleep(0.05)
+    assert transport.request('POST', f"{server.url}/ping", body=b'{}').ok
+    assert server.connections == 2
+    assert server.hits['/ping'] == 1
+
+
+def test_request_async(server, transport):
+    """request_async() runs requests concurrently under asyncio."""
+    async def fetch_all():
+        return await asyncio.gather(*[
+            transport.request_async('GET', f"{server.url}/work?delay=0.2") for _ in range(4)
+        ])
+
+    start = time.time()
+    responses = asyncio.run(fetch_all())
+    assert all(r.ok for r in responses)
+    assert time.time() - start < 0.6
+
+
+def test_gather_reraises(transport):
+    """gather() surfaces errors from its calls."""
+    def boom():
+        raise ValueError("boom")
+
+    with pytest.raises(ValueError):
+        transport.gather([lambda: 1, boom])
+
+
+# =============================================================================
+# PixelLabClient Tests
+# =============================================================================
+
+@pytest.fixture
+def client_factory(server, tmp_path, monkeypatch):
+    monkeypatch.setattr(pixellab_client, 'PIXELLAB_API_V1', f"{server.url}/v1")
+    monkeypatch.setattr(PixelLabClient, 'LOCK_FILE', tmp_path / 'pixellab.lock')
+    clients = []
+
+    def make(**kwargs):
+        client = PixelLabClient(api_key='test', **kwargs)
+        client._transport.retry = FAST_RETRY
+        clients.append(client)
+        return client
+
+    yield make
+    for client in clients:
+        client.close()
+
+
+def test_directions_run_concurrently(server, client_factory):
+    """An 8-direction set takes about one sub-request, not seven."""
+    server.delay = 0.3
+    client = client_factory(max_calls=7)
+    reference = Image.new('RGBA', (32, 32), (0, 0, 255, 255))
+
+    start = time.time()
+    results = client.generate_directional_sprites(reference, directions=8, width=32, height=32)
+    elapsed = time.time() - start
+
+    assert list(results) == [d.value for d in pixellab_client.Direction]
+    assert all(r.success for r in results.values())
+    assert server.hits['/v1/rotate'] == 7
+    assert elapsed < 0.3 * 3
+    assert client._call_count == 7
+    assert client.get_session_cost() == pytest.approx(0.07)
+
+
+def test_concurrent_calls_respect_max_calls(server, client_factory):
+    """Concurrent sub-requests cannot overrun the call budget."""
+    client = client_factory(max_calls=3)
+    reference = Image.new('RGBA', (32, 32))
+
+    results = client.generate_directional_sprites(reference, directions=8, width=32, height=32)
+    failed = [r for r in results.values() if not r.success]
+
+    assert server.hits['/v1/rotate'] == 3
+    assert len(failed) == 4
+    assert all("call limit" in r.error for r in failed)
+    assert client._call_count == 3
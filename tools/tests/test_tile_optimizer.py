@@ -7,14 +7,19 @@ Tests tile deduplication, flip detection, VRAM tracking, and batch processing.
 import pytest
 from PIL import Image, ImageDraw
 from pathlib import Path
+import random
 import tempfile
 import shutil
 
+import numpy as np
+
 from pipeline.optimization import (
     TileOptimizer,
+    TileReference,
     TileTransform,
     OptimizedTileBank,
     BatchTileOptimizer,
+    BKTree,
 )
 
 
@@ -170,6 +175,58 @@ def test_flip_disabled():
     assert result_no_flip.unique_tile_count >= result_flip.unique_tile_count
 
 
+@pytest.mark.parametrize("mirror_x,mirror_y", [
+    (True, True), (True, False), (False, True), (False, False),
+])
+def test_bulk_dedup_matches_per_tile_search(mirror_x, mirror_y):
+    """Vectorized dedup should equal the per-tile hash search it replaces."""
+    rng = random.Random(4)
+
+    # Sheet of a few base tiles placed with random flips
+    bases = []
+    for _ in range(6):
+        tile = Image.new('RGBA', (8, 8), (0, 0, 0, 0))
+        draw = ImageDraw.Draw(tile)
+        for _ in range(5):
+            x, y = rng.randrange(8), rng.randrange(8)
+            draw.point((x, y), fill=(rng.randrange(256), 0, 255, 255))
+        bases.append(tile)
+
+    img = Image.new('RGBA', (64, 48), (0, 0, 0, 0))
+    for y in range(0, 48, 8):
+        for x in range(0, 64, 8):
+            tile = rng.choice(bases)
+            if rng.random() < 0.5:
+                tile = tile.transpose(Image.FLIP_LEFT_RIGHT)
+            if rng.random() < 0.5:
+                tile = tile.transpose(Image.FLIP_TOP_BOTTOM)
+            img.paste(tile, (x, y))
+
+    optimizer = TileOptimizer(allow_mirror_x=mirror_x, allow_mirror_y=mirror_y)
+    result = optimizer.optimize_image(img)
+
+    # Reference: raster-order search with _find_tile_match
+    reference = TileOptimizer(allow_mirror_x=mirror_x, allow_mirror_y=mirror_y)
+    unique, seen, refs = [], {}, []
+    for y in range(0, 48, 8):
+        for x in range(0, 64, 8):
+            tile = img.crop((x, y, x + 8, y + 8))
+            ref = reference._find_tile_match(tile, unique, seen)
+            if ref is None:
+                seen[reference._hash_tile(tile)] = (len(unique), TileTransform.NORMAL)
+                ref = TileReference(len(unique), TileTransform.NORMAL)
+                unique.append(tile)
+            refs.append(ref)
+
+    assert [(r.index, r.transform) for r in result.tile_map] == \
+           [(r.index, r.transform) for r in refs]
+    assert [t.tobytes() for t in result.unique_tiles] == [t.tobytes() for t in unique]
+    assert result.stats.h_flip_matches == reference._h_flip_count
+    assert result.stats.v_flip_matches == reference._v_flip_count
+    assert result.stats.hv_flip_matches == reference._hv_flip_count
+    assert result.reconstruct_image().tobytes() == img.tobytes()
+
+
 # =============================================================================
 # VRAM Budget Tests
 # =============================================================================
@@ -200,6 +257,14 @@ def test_check_vram_budget():
     assert used > available
 
 
+def test_vram_budget_uses_tile_format():
+    """Budgets count tiles in the platform's format, not RGBA."""
+    assert TileOptimizer(platform='genesis').get_max_tiles_for_budget() == 2048
+    assert TileOptimizer(platform='nes').get_max_tiles_for_budget() == 512
+    assert TileOptimizer(platform='genesis', tile_width=16,
+                         tile_height=16).vram_bytes_per_tile == 128
+
+
 def test_platform_vram_limits():
     """Test different platform VRAM limits."""
     platforms = ['genesis', 'nes', 'snes', 'gameboy', 'gba']
@@ -210,6 +275,129 @@ def test_platform_vram_limits():
         assert optimizer.get_max_tiles_for_budget() > 0
 
 
+# =============================================================================
+# Lossy Merge Tests
+# =============================================================================
+
+def _noisy_sheet(seed, bases=8, grid=(8, 8), max_noise=3):
+    """Sheet of a few base tiles, each copy with a little pixel noise and random flips."""
+    rng = np.random.default_rng(seed)
+    colors = rng.integers(0, 256, size=(6, 4), dtype=np.uint8)
+    colors[:, 3] = 255
+    base_tiles = rng.integers(0, 6, size=(bases, 8, 8))
+
+    rows, cols = grid
+    indices = np.zeros((rows * 8, cols * 8), dtype=np.intp)
+    for ty in range(rows):
+        for tx in range(cols):
+            tile = base_tiles[rng.integers(bases)].copy()
+            for _ in range(rng.integers(0, max_noise + 1)):
+                tile[rng.integers(8), rng.integers(8)] = rng.integers(6)
+            if rng.random() < 0.5:
+                tile = tile[:, ::-1]
+            indices[ty * 8:ty * 8 + 8, tx * 8:tx * 8 + 8] = tile
+    return Image.fromarray(colors[indices], 'RGBA')
+
+
+def _tile_errors(result, img):
+    """Differing pixels per tile between the reconstruction and the original."""
+    diff = (np.asarray(result.reconstruct_image()) != np.asarray(img)).any(axis=2)
+    h, w = diff.shape
+    return diff.reshape(h // 8, 8, w // 8, 8).sum(axis=(1, 3)).ravel()
+
+
+def test_bk_tree_nearest_matches_brute_force():
+    """BK-tree nearest neighbour agrees with a linear scan."""
+    rng = random.Random(7)
+    distance = lambda a, b: bin(a ^ b).count('1')
+    values = [rng.getrandbits(24) for _ in range(300)]
+
+    tree = BKTree(distance)
+    for key, value in enumerate(values):
+        tree.add(key, value)
+
+    for _ in range(50):
+        query = rng.getrandbits(24)
+        for radius in (0, 3, 6, 24):
+            candidates = [(distance(query, v), k) for k, v in enumerate(values)
+                          if distance(query, v) <= radius]
+            assert tree.nearest(query, radius) == (min(candidates) if candidates else None)
+
+
+def test_pixel_distance_truecolor():
+    """Tiles with more than 256 colours count each differing pixel once."""
+    from pipeline.optimization.tile_merge import pack_tiles, pixel_distance
+
+    rng = np.random.default_rng(7)
+    tiles = rng.integers(0, 256, size=(8, 64, 3), dtype=np.uint8)
+    tiles[1] = tiles[0]
+    tiles[1, 10] ^= 1                       # One pixel differs...
+    tiles[2] = tiles[0]
+    tiles[2, 11:14] ^= 1                    # ...and three neighbours
+
+    packed, bits = pack_tiles(tiles)
+    assert bits & (bits - 1) == 0
+    ints = [int.from_bytes(row.tobytes(), 'little') for row in packed]
+    distance = pixel_distance(64, bits)
+    for i in range(len(tiles)):
+        for j in range(len(tiles)):
+            expected = int((tiles[i] != tiles[j]).any(axis=1).sum())
+            assert distance(ints[i], ints[j]) == expected
+
+
+def test_merge_threshold():
+    """Tiles within the threshold merge; each tile stays within it."""
+    img = _noisy_sheet(1)
+    lossless = TileOptimizer().optimize_image(img)
+    result = TileOptimizer(merge_threshold=3).optimize_image(img)
+
+    assert lossless.stats.lossy_merges == 0
+    assert result.unique_tile_count < lossless.unique_tile_count
+    assert result.stats.lossy_merges == lossless.unique_tile_count - result.unique_tile_count
+    assert 0 < result.stats.max_merge_error <= 3
+    assert _tile_errors(result, img).max() == result.stats.max_merge_error
+
+
+def test_merge_uses_flips():
+    """A flipped near-duplicate merges onto the original with a flip."""
+    img = _noisy_sheet(2, bases=1, grid=(1, 8), max_noise=0)
+    pixels = np.array(img)
+    pixels[0, 8:16] = pixels[0, 8:16][::-1]  # Perturb one row of one tile
+    img = Image.fromarray(pixels, 'RGBA')
+
+    result = TileOptimizer(merge_threshold=8, allow_mirror_y=False).optimize_image(img)
+    assert result.unique_tile_count == 1
+    assert _tile_errors(result, img).max() <= 8
+
+
+def test_fit_vram_budget():
+    """Closest tiles merge until the bank fits the budget."""
+    img = _noisy_sheet(3, bases=12, grid=(8, 16))
+    lossless = TileOptimizer().optimize_image(img)
+
+    budget_tiles = 20
+    optimizer = TileOptimizer(vram_budget=budget_tiles * 32, fit_vram_budget=True)  # 4bpp
+    result = optimizer.optimize_image(img)
+
+    assert lossless.unique_tile_count > budget_tiles
+    assert result.unique_tile_count == budget_tiles
+    fits, _, _ = optimizer.check_vram_budget(result.unique_tile_count)
+    assert fits
+    assert _tile_errors(result, img).max() == result.stats.max_merge_error
+
+
+def test_fit_vram_budget_respects_max_distance():
+    """max_merge_distance stops merging even if the budget is not met."""
+    img = _noisy_sheet(4, bases=12, grid=(8, 16))
+    optimizer = TileOptimizer(vram_budget=4 * 32, fit_vram_budget=True,
+                              max_merge_distance=2)
+    result = optimizer.optimize_image(img)
+
+    assert result.unique_tile_count > 4
+    assert 0 < result.stats.max_merge_error <= 2
+    assert _tile_errors(result, img).max() == result.stats.max_merge_error
+
+
 # =============================================================================
 # Reconstruction Tests
 # =============================================================================
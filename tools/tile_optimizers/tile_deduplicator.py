@@ -7,10 +7,15 @@ Reduces CHR usage by 20-40% by:
 - Detecting vertical flip matches
 - Detecting 180-degree rotation matches (H+V flip)
 - Tracking flip flags in tile map for rendering
+
+Matching runs on the shared dedup core (pipeline.optimization.dedup_tiles),
+the same engine behind TileOptimizer and the Genesis tilemap exporter.
 """
 
 import hashlib
+import sys
 from dataclasses import dataclass, field
+from pathlib import Path
 from typing import Dict, List, Optional, Tuple
 import numpy as np
 
@@ -19,6 +24,10 @@ try:
 except ImportError:
     raise ImportError("PIL required: pip install pillow")
 
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from pipeline.optimization.tile_dedup import TileLayout, TileTransform, dedup_tiles
+
 
 # =============================================================================
 # Data Classes
@@ -58,6 +67,15 @@ class TileRef:
     y: int = 0
 
 
+# TileFlags for each dedup-core transform
+_TRANSFORM_FLAGS = {
+    TileTransform.NORMAL: lambda: TileFlags(),
+    TileTransform.FLIP_H: lambda: TileFlags(horizontal_flip=True),
+    TileTransform.FLIP_V: lambda: TileFlags(vertical_flip=True),
+    TileTransform.FLIP_HV: lambda: TileFlags(horizontal_flip=True, vertical_flip=True),
+}
+
+
 @dataclass
 class OptimizedTile:
     """A unique tile after deduplication."""
@@ -142,56 +160,41 @@ class TileDeduplicator:
             )
 
         # Deduplicate with flip detection
-        unique_tiles: List[OptimizedTile] = []
-        tile_map: List[TileRef] = []
-        tile_hash_map: Dict[str, Tuple[int, TileFlags]] = {}
-
-        flip_stats = {
-            'direct_match': 0,
-            'h_flip_match': 0,
-            'v_flip_match': 0,
-            'hv_flip_match': 0,
-            'unique': 0,
-        }
-
-        for tile_info in all_tiles:
-            x, y, pixels = tile_info
-            match = self._find_match(pixels, tile_hash_map)
-
-            if match is not None:
-                tile_id, flags = match
-                unique_tiles[tile_id].reference_count += 1
+        layout = TileLayout.chunky(self.tile_width, self.tile_height, name='indexed')
+        tiles = np.stack([pixels for _, _, pixels in all_tiles])
+        dedup = dedup_tiles(tiles.astype(np.uint8, copy=False), layout,
+                            allow_h=self.enable_h_flip, allow_v=self.enable_v_flip)
 
-                if not flags.horizontal_flip and not flags.vertical_flip:
-                    flip_stats['direct_match'] += 1
-                elif flags.horizontal_flip and not flags.vertical_flip:
-                    flip_stats['h_flip_match'] += 1
-                elif not flags.horizontal_flip and flags.vertical_flip:
-                    flip_stats['v_flip_match'] += 1
-                else:
-                    flip_stats['hv_flip_match'] += 1
+        reference_counts = dedup.reference_counts()
+        unique_tiles: List[OptimizedTile] = []
+        for tile_id, index in enumerate(dedup.unique_indices.tolist()):
+            pixels = all_tiles[index][2]
+            unique_tiles.append(OptimizedTile(
+                tile_id=tile_id,
+                pixels=pixels.copy(),
+                hash=self._compute_hash(pixels),
+                reference_count=int(reference_counts[tile_id]),
+            ))
 
-            else:
-                # New unique tile
-                tile_id = len(unique_tiles)
-                tile_hash = self._compute_hash(pixels)
-                tile_hash_map[tile_hash] = (tile_id, TileFlags())
-
-                unique_tiles.append(OptimizedTile(
-                    tile_id=tile_id,
-                    pixels=pixels.copy(),
-                    hash=tile_hash,
-                    reference_count=1,
-                ))
-                match = (tile_id, TileFlags())
-                flip_stats['unique'] += 1
-
-            tile_map.append(TileRef(
-                tile_id=match[0],
-                flags=match[1],
+        tile_map = [
+            TileRef(
+                tile_id=tile_id,
+                flags=_TRANSFORM_FLAGS[transform](),
                 x=x,
                 y=y,
-            ))
+            )
+            for (x, y, _), tile_id, transform in zip(
+                all_tiles, dedup.tile_indices.tolist(), dedup.transforms.tolist())
+        ]
+
+        counts = dedup.transform_counts()
+        flip_stats = {
+            'direct_match': counts[TileTransform.NORMAL] - dedup.unique_count,
+            'h_flip_match': counts[TileTransform.FLIP_H],
+            'v_flip_match': counts[TileTransform.FLIP_V],
+            'hv_flip_match': counts[TileTransform.FLIP_HV],
+            'unique': dedup.unique_count,
+        }
 
         # Calculate savings
         original_count = len(all_tiles)
@@ -268,65 +271,26 @@ class TileDeduplicator:
         indexed: np.ndarray,
     ) -> List[Tuple[int, int, np.ndarray]]:
         """Extract all tiles from indexed image."""
+        tensor = self._tile_tensor(indexed)
+        tiles_x = indexed.shape[1] // self.tile_width
+
+        return [
+            ((i % tiles_x) * self.tile_width, (i // tiles_x) * self.tile_height, tile)
+            for i, tile in enumerate(tensor)
+        ]
+
+    def _tile_tensor(self, indexed: np.ndarray) -> np.ndarray:
+        """Whole tiles of the indexed image as a (N, tile_height, tile_width) array."""
         height, width = indexed.shape
-        tiles = []
 
-        # Calculate tile grid
+        # Calculate tile grid (partial edge tiles are dropped)
         tiles_x = width // self.tile_width
         tiles_y = height // self.tile_height
 
-        for ty in range(tiles_y):
-            for tx in range(tiles_x):
-                x = tx * self.tile_width
-                y = ty * self.tile_height
-
-                tile_pixels = indexed[
-                    y:y + self.tile_height,
-                    x:x + self.tile_width
-                ]
-
-                if tile_pixels.shape == (self.tile_height, self.tile_width):
-                    tiles.append((x, y, tile_pixels))
-
-        return tiles
-
-    def _find_match(
-        self,
-        pixels: np.ndarray,
-        hash_map: Dict[str, Tuple[int, TileFlags]],
-    ) -> Optional[Tuple[int, TileFlags]]:
-        """Find matching tile in hash map, including flipped versions."""
-
-        # Check direct match
-        tile_hash = self._compute_hash(pixels)
-        if tile_hash in hash_map:
-            return hash_map[tile_hash]
-
-        # Check horizontal flip
-        if self.enable_h_flip:
-            flipped_h = np.fliplr(pixels)
-            h_hash = self._compute_hash(flipped_h)
-            if h_hash in hash_map:
-                orig_id, _ = hash_map[h_hash]
-                return (orig_id, TileFlags(horizontal_flip=True))
-
-        # Check vertical flip
-        if self.enable_v_flip:
-            flipped_v = np.flipud(pixels)
-            v_hash = self._compute_hash(flipped_v)
-            if v_hash in hash_map:
-                orig_id, _ = hash_map[v_hash]
-                return (orig_id, TileFlags(vertical_flip=True))
-
-        # Check both flips (180 degree rotation)
-        if self.enable_h_flip and self.enable_v_flip:
-            flipped_hv = np.flipud(np.fliplr(pixels))
-            hv_hash = self._compute_hash(flipped_hv)
-            if hv_hash in hash_map:
-                orig_id, _ = hash_map[hv_hash]
-                return (orig_id, TileFlags(horizontal_flip=True, vertical_flip=True))
-
-        return None
+        grid = indexed[:tiles_y * self.tile_height, :tiles_x * self.tile_width]
+        grid = grid.reshape(tiles_y, self.tile_height, tiles_x, self.tile_width)
+        return np.ascontiguousarray(grid.transpose(0, 2, 1, 3)).reshape(
+            tiles_y * tiles_x, self.tile_height, self.tile_width)
 
     def _compute_hash(self, pixels: np.ndarray) -> str:
         """Compute unique hash for tile pixels."""
@@ -10,16 +10,25 @@ Usage:
     python watch_assets.py assets/sprites assets/tilesets --debounce 2.0
     python watch_assets.py assets/ --hot-reload --reload-cmd "make reload"
     python watch_assets.py assets/ --extensions .png .aseprite --recursive
+    python watch_assets.py assets/ --workers 8 --focus assets/sprites/hero.png
+    python watch_assets.py assets/sprites --processor sprite --deps .ardk_cache/deps.json
+    python watch_assets.py assets/ --processor sprite --deps deps.json --palettes assets/palettes.json
 """
 
+import io
+import os
 import sys
 import signal
+import threading
 from pathlib import Path
+from typing import List, Optional
 
 # Add pipeline to path
 sys.path.insert(0, str(Path(__file__).parent))
 
 from pipeline.watch import AssetWatcher, WatchConfig, SafetyConfig, PipelineWatcher, FileChangeEvent
+from pipeline.dependency_graph import DependencyGraph, write_if_changed
+from pipeline.sgdk_resources import SGDKResourceGenerator
 from pipeline.cli_utils import (
     create_parser,
     add_common_args,
@@ -34,7 +43,28 @@ from pipeline.cli_utils import (
 # Processors
 # =============================================================================
 
-def process_sprite(path: Path):
+OUTPUT_DIR = Path("output")
+RESOURCES_PATH = OUTPUT_DIR / "resources.res"
+PALETTES_HEADER_PATH = OUTPUT_DIR / "palettes.h"
+
+# Processed sprites are scaled to this many pixels square
+SPRITE_SIZE = 32
+
+# Sources the sprite and tileset processors can read
+IMAGE_EXTENSIONS = {'.png', '.bmp'}
+
+
+def sprite_output_path(path: Path) -> Path:
+    """Where process_sprite writes a sprite."""
+    return OUTPUT_DIR / "sprites" / path.name
+
+
+def tileset_output_path(path: Path) -> Path:
+    """Tile map written by process_tileset (tracked output of its graph step)."""
+    return OUTPUT_DIR / "tilesets" / path.stem / f"{path.stem}_tilemap.json"
+
+
+def process_sprite(path: Path, output_path: Optional[Path] = None):
     """Process sprite through pipeline."""
     from pipeline.processing import SpriteConverter
     from pipeline.platforms import GenesisConfig
@@ -46,19 +76,20 @@ def process_sprite(path: Path):
     converter = SpriteConverter(platform=GenesisConfig)
 
     # Scale and convert
-    scaled = converter.scale_sprite(img, target_size=32)
+    scaled = converter.scale_sprite(img, target_size=SPRITE_SIZE)
     indexed = converter.index_sprite(scaled)
 
-    # Save output
-    output_dir = Path("output") / "sprites"
-    output_dir.mkdir(parents=True, exist_ok=True)
-    output_path = output_dir / path.name
-    indexed.save(output_path)
-
-    print(f"  → Saved to {output_path}")
+    # Save output; identical bytes keep the old file and its mtime
+    output_path = output_path or sprite_output_path(path)
+    buffer = io.BytesIO()
+    indexed.save(buffer, format='PNG')
+    if write_if_changed(output_path, buffer.getvalue()):
+        print(f"  → Saved to {output_path}")
+    else:
+        print(f"  → Unchanged: {output_path}")
 
 
-def process_tileset(path: Path):
+def process_tileset(path: Path, output_dir: Optional[Path] = None):
     """Process tileset through pipeline."""
     from pipeline.optimization import TileOptimizer
     from PIL import Image
@@ -73,7 +104,7 @@ def process_tileset(path: Path):
           f"({result.stats.savings_percent:.1f}% savings)")
 
     # Save optimized tiles
-    output_dir = Path("output") / "tilesets" / path.stem
+    output_dir = output_dir or tileset_output_path(path).parent
     output_dir.mkdir(parents=True, exist_ok=True)
     result.save_tiles(str(output_dir), prefix=path.stem)
     result.save_tile_map(str(output_dir / f"{path.stem}_tilemap.json"))
@@ -86,6 +117,101 @@ def process_generic(path: Path):
     print(f"  Changed: {path.name}")
 
 
+def process_palettes(path: Path, header_path: Path):
+    """Export PaletteManager definitions (JSON) as an SGDK C header."""
+    from pipeline.palette_manager import PaletteManager
+
+    manager = PaletteManager()
+    manager.load(str(path))
+    # Identical palettes keep the header's mtime
+    manager.export_c_header(str(header_path))
+
+
+def resource_generator(sprites: List[str], tilesets: List[str]) -> SGDKResourceGenerator:
+    """.res entries for processed sprites and tileset sheets (paths relative to the .res)."""
+    gen = SGDKResourceGenerator()
+    tiles = SPRITE_SIZE // 8
+    for path in sprites:
+        gen.add_sprite(f"spr_{Path(path).stem}", path, tiles, tiles)
+    for path in tilesets:
+        gen.add_tileset(f"ts_{Path(path).stem}", path)
+    return gen
+
+
+# =============================================================================
+# Dependency Graph
+# =============================================================================
+
+def make_graph_processor(graph: DependencyGraph, kind: str = 'sprite',
+                         palettes: Optional[Path] = None):
+    """
+    Processor that records each asset as a step in the build chain:
+
+        hero.png      -> output/sprites/hero.png --+
+        level.png     -> output/tilesets/level/*  +--> output/resources.res
+        palettes.json -> output/palettes.h
+
+    The first change to a source adds its step, re-declares the .res step
+    with the new resource list (inputs from SGDKResourceGenerator.resource_paths)
+    and builds both; later changes are routed through the graph by
+    PipelineWatcher, so only affected outputs are rebuilt and identical
+    ones are left untouched.
+
+    Args:
+        graph: Dependency graph (loaded steps from earlier sessions are kept)
+        kind: 'sprite' or 'tileset': how new sources are processed
+        palettes: PaletteManager JSON to export as palettes.h (built now)
+    """
+    graph.register_rule(
+        'sprite', lambda inputs, outputs, params: process_sprite(inputs[0], outputs[0])
+    )
+    graph.register_rule(
+        'tileset', lambda inputs, outputs, params: process_tileset(inputs[0], outputs[0].parent)
+    )
+    graph.register_rule(
+        'res', lambda inputs, outputs, params: resource_generator(
+            params['sprites'], params['tilesets']).generate(str(outputs[0]))
+    )
+    graph.register_rule(
+        'palettes', lambda inputs, outputs, params: process_palettes(inputs[0], outputs[0])
+    )
+    declare_lock = threading.Lock()
+    res_dir = (graph.root / RESOURCES_PATH).parent
+
+    def res_relative(key: str) -> str:
+        return Path(os.path.relpath(graph.resolve(key), res_dir)).as_posix()
+
+    def declare_resources():
+        # Workers adding sources concurrently must not drop each other's entries
+        with declare_lock:
+            sprites = [res_relative(step.outputs[0]) for step in graph.steps_with_rule('sprite')]
+            tilesets = [res_relative(step.inputs[0]) for step in graph.steps_with_rule('tileset')]
+            gen = resource_generator(sprites, tilesets)
+            graph.add_step('res', 'res', [res_dir / path for path in gen.resource_paths()],
+                           [RESOURCES_PATH], {'sprites': sprites, 'tilesets': tilesets})
+
+    def check(report):
+        if not report.success:
+            raise RuntimeError("; ".join(report.failed.values()))
+
+    if palettes is not None:
+        graph.add_step('palettes', 'palettes', [palettes], [PALETTES_HEADER_PATH])
+        check(graph.update([palettes]))
+
+    def process(path: Path):
+        if path.suffix.lower() not in IMAGE_EXTENSIONS:
+            print(f"  Skipped (not an image): {path.name}")
+            return
+        if kind == 'tileset':
+            graph.add_step(f"tileset:{path}", 'tileset', [path], [tileset_output_path(path)])
+        else:
+            graph.add_step(f"sprite:{path}", 'sprite', [path], [sprite_output_path(path)])
+        declare_resources()
+        check(graph.update([path]))
+
+    return process
+
+
 # =============================================================================
 # Main
 # =============================================================================
@@ -142,6 +268,10 @@ Processors:
     watch_group.add_argument('--ignore', nargs='+',
                        default=['*.tmp', '.*', '*~'],
                        help='Patterns to ignore (default: *.tmp .* *~)')
+    watch_group.add_argument('--workers', type=int, default=4,
+                       help='Files processed in parallel (default: 4)')
+    watch_group.add_argument('--focus', metavar='FILE',
+                       help='Asset open in the editor; processed first with a short debounce')
 
     # Processing
     parser.add_argument('--processor', choices=['sprite', 'tileset', 'generic'],
@@ -153,6 +283,12 @@ Processors:
                        help='Enable hot reload after processing')
     parser.add_argument('--reload-cmd',
                        help='Command to run for hot reload (e.g., "make reload")')
+    parser.add_argument('--deps', metavar='FILE',
+                       help='Dependency graph file; rebuild only affected outputs '
+                            '(sprites/tilesets, resources.res, palettes.h) '
+                            'and skip hot reload when nothing changed')
+    parser.add_argument('--palettes', metavar='FILE',
+                       help='PaletteManager JSON exported to palettes.h (with --deps)')
 
     # Safety options (additional)
     safety_group = parser.add_argument_group('safety (additional)')
@@ -205,16 +341,30 @@ Processors:
     # Get debounce from CLI or config
     debounce = args.debounce if args.debounce else config.watch.debounce
 
+    # The palette file is a graph input: watch it too
+    watch_dirs = list(args.directories)
+    extensions = list(args.extensions)
+    palettes = Path(args.palettes) if args.palettes and args.deps else None
+    if palettes is not None:
+        if not palettes.exists():
+            vprint.error(f"Palette file does not exist: {palettes}")
+            return 1
+        if palettes.suffix not in extensions:
+            extensions.append(palettes.suffix)
+        if not any(palettes.resolve().is_relative_to(Path(d).resolve()) for d in watch_dirs):
+            watch_dirs.append(str(palettes.parent))
+
     # Create watch config
     watch_config = WatchConfig(
-        watch_dirs=args.directories,
-        extensions=args.extensions,
+        watch_dirs=watch_dirs,
+        extensions=extensions,
         debounce_seconds=debounce,
         recursive=not args.no_recursive,
         ignore_patterns=args.ignore,
         hot_reload_enabled=args.hot_reload,
         hot_reload_command=args.reload_cmd,
         safety=safety,
+        workers=args.workers,
     )
 
     # Create watcher
@@ -231,12 +381,21 @@ Processors:
         watcher.on_change = on_change
     else:
         # Use pipeline watcher
+        graph = None
+        if args.deps:
+            graph = DependencyGraph(args.deps)
+            processor_func = make_graph_processor(graph, args.processor, palettes)
+
         watcher = PipelineWatcher(
             watch_config,
             processor_func=processor_func,
-            enable_hot_reload=args.hot_reload
+            enable_hot_reload=args.hot_reload,
+            graph=graph,
         )
 
+    if args.focus:
+        watcher.set_focus(args.focus)
+
     # Set up signal handler for graceful shutdown
     def signal_handler(sig, frame):
         vprint.info("\nReceived interrupt signal")